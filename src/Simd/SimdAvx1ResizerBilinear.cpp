@@ -43,7 +43,8 @@ namespace Simd
             int32_t prev = -2;
             size_t rsa = AlignLo(rs, Avx::F);
             size_t rsh = AlignLo(rs, Sse41::F);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
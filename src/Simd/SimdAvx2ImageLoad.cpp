@@ -71,6 +71,7 @@ namespace Simd
                 case SimdPixelFormatBgra32: _toBgra = Avx2::GrayToBgra; break;
                 case SimdPixelFormatRgb24: _toAny = Avx2::GrayToBgr; break;
                 case SimdPixelFormatRgba32: _toBgra = Avx2::GrayToBgra; break;
+                case SimdPixelFormatInt16: _reorder = Avx2::Reorder16bit; break;
                 default: break;
                 }
             }
@@ -124,6 +125,20 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImagePfmLoader::ImagePfmLoader(const ImageLoaderParam& param)
+            : Sse41::ImagePfmLoader(param)
+        {
+        }
+
+        void ImagePfmLoader::SetConverters()
+        {
+            Sse41::ImagePfmLoader::SetConverters();
+            if (_image.width >= A)
+                _reorder = Avx2::Reorder32bit;
+        }
+
+        //---------------------------------------------------------------------
+
         ImageLoader* CreateImageLoader(const ImageLoaderParam& param)
         {
             switch (param.file)
@@ -132,8 +147,9 @@ namespace Simd
             case SimdImageFilePgmBin: return new ImagePgmBinLoader(param);
             case SimdImageFilePpmTxt: return new ImagePpmTxtLoader(param);
             case SimdImageFilePpmBin: return new ImagePpmBinLoader(param);
-            case SimdImageFilePng: return new Sse41::ImagePngLoader(param);
-            case SimdImageFileJpeg: return new Base::ImageJpegLoader(param);
+            case SimdImageFilePng: return new ImagePngLoader(param);
+            case SimdImageFileJpeg: return new ImageJpegLoader(param);
+            case SimdImageFilePfm: return new ImagePfmLoader(param);
             default:
                 return NULL;
             }
@@ -0,0 +1,404 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdUnpack.h"
+#include "Simd/SimdInterleave.h"
+#include "Simd/SimdYuvToBgr.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) 
+    namespace Avx2
+    {
+        SIMD_INLINE int JpegF2F(float x)
+        {
+            return int(x * 4096 + 0.5f);
+        }
+
+        SIMD_INLINE __m256i JpegConst(int x, int y)
+        {
+            return _mm256_unpacklo_epi16(_mm256_set1_epi16(x), _mm256_set1_epi16(y));
+        }
+
+        SIMD_INLINE void JpegRot(__m256i x, __m256i y, __m256i c0, __m256i c1, __m256i* out0, __m256i* out1)
+        {
+            __m256i lo = _mm256_unpacklo_epi16(x, y);
+            __m256i hi = _mm256_unpackhi_epi16(x, y);
+            out0[0] = _mm256_madd_epi16(lo, c0);
+            out0[1] = _mm256_madd_epi16(hi, c0);
+            out1[0] = _mm256_madd_epi16(lo, c1);
+            out1[1] = _mm256_madd_epi16(hi, c1);
+        }
+
+        SIMD_INLINE void JpegWiden(__m256i in, __m256i* out)
+        {
+            out[0] = _mm256_srai_epi32(_mm256_unpacklo_epi16(_mm256_setzero_si256(), in), 4);
+            out[1] = _mm256_srai_epi32(_mm256_unpackhi_epi16(_mm256_setzero_si256(), in), 4);
+        }
+
+        SIMD_INLINE void JpegAdd(const __m256i* a, const __m256i* b, __m256i* sum)
+        {
+            sum[0] = _mm256_add_epi32(a[0], b[0]);
+            sum[1] = _mm256_add_epi32(a[1], b[1]);
+        }
+
+        SIMD_INLINE void JpegSub(const __m256i* a, const __m256i* b, __m256i* dif)
+        {
+            dif[0] = _mm256_sub_epi32(a[0], b[0]);
+            dif[1] = _mm256_sub_epi32(a[1], b[1]);
+        }
+
+        template<int shift> SIMD_INLINE void JpegButterfly(const __m256i* a, const __m256i* b, __m256i bias, __m256i& out0, __m256i& out1)
+        {
+            __m256i lo = _mm256_add_epi32(a[0], bias);
+            __m256i hi = _mm256_add_epi32(a[1], bias);
+            out0 = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_add_epi32(lo, b[0]), shift), _mm256_srai_epi32(_mm256_add_epi32(hi, b[1]), shift));
+            out1 = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_sub_epi32(lo, b[0]), shift), _mm256_srai_epi32(_mm256_sub_epi32(hi, b[1]), shift));
+        }
+
+        template<int shift> SIMD_INLINE void JpegIdctPass(__m256i* r, __m256i bias)
+        {
+            __m256i t0e[2], t1e[2], t2e[2], t3e[2], x0[2], x1[2], x2[2], x3[2];
+            JpegRot(r[2], r[6], JpegConst(JpegF2F(0.5411961f), JpegF2F(0.5411961f) + JpegF2F(-1.847759065f)),
+                JpegConst(JpegF2F(0.5411961f) + JpegF2F(0.765366865f), JpegF2F(0.5411961f)), t2e, t3e);
+            JpegWiden(_mm256_add_epi16(r[0], r[4]), t0e);
+            JpegWiden(_mm256_sub_epi16(r[0], r[4]), t1e);
+            JpegAdd(t0e, t3e, x0);
+            JpegSub(t0e, t3e, x3);
+            JpegAdd(t1e, t2e, x1);
+            JpegSub(t1e, t2e, x2);
+
+            __m256i y0o[2], y1o[2], y2o[2], y3o[2], y4o[2], y5o[2], x4[2], x5[2], x6[2], x7[2];
+            JpegRot(r[7], r[3], JpegConst(JpegF2F(-1.961570560f) + JpegF2F(0.298631336f), JpegF2F(-1.961570560f)),
+                JpegConst(JpegF2F(-1.961570560f), JpegF2F(-1.961570560f) + JpegF2F(3.072711026f)), y0o, y2o);
+            JpegRot(r[5], r[1], JpegConst(JpegF2F(-0.390180644f) + JpegF2F(2.053119869f), JpegF2F(-0.390180644f)),
+                JpegConst(JpegF2F(-0.390180644f), JpegF2F(-0.390180644f) + JpegF2F(1.501321110f)), y1o, y3o);
+            JpegRot(_mm256_add_epi16(r[1], r[7]), _mm256_add_epi16(r[3], r[5]), JpegConst(JpegF2F(1.175875602f) + JpegF2F(-0.899976223f), JpegF2F(1.175875602f)),
+                JpegConst(JpegF2F(1.175875602f), JpegF2F(1.175875602f) + JpegF2F(-2.562915447f)), y4o, y5o);
+            JpegAdd(y0o, y4o, x4);
+            JpegAdd(y1o, y5o, x5);
+            JpegAdd(y2o, y5o, x6);
+            JpegAdd(y3o, y4o, x7);
+
+            JpegButterfly<shift>(x0, x7, bias, r[0], r[7]);
+            JpegButterfly<shift>(x1, x6, bias, r[1], r[6]);
+            JpegButterfly<shift>(x2, x5, bias, r[2], r[5]);
+            JpegButterfly<shift>(x3, x4, bias, r[3], r[4]);
+        }
+
+        SIMD_INLINE void JpegInterleave16(__m256i& a, __m256i& b)
+        {
+            __m256i t = a;
+            a = _mm256_unpacklo_epi16(t, b);
+            b = _mm256_unpackhi_epi16(t, b);
+        }
+
+        SIMD_INLINE void JpegInterleave8(__m256i& a, __m256i& b)
+        {
+            __m256i t = a;
+            a = _mm256_unpacklo_epi8(t, b);
+            b = _mm256_unpackhi_epi8(t, b);
+        }
+
+        template<bool two> SIMD_INLINE void JpegStoreRows(__m256i p, uint8_t* dst, int stride)
+        {
+            if (two)
+            {
+                p = _mm256_permute4x64_epi64(p, 0xD8);
+                _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(p));
+                _mm_storeu_si128((__m128i*)(dst + stride), _mm256_extracti128_si256(p, 1));
+            }
+            else
+            {
+                __m128i lo = _mm256_castsi256_si128(p);
+                _mm_storel_epi64((__m128i*)dst, lo);
+                _mm_storel_epi64((__m128i*)(dst + stride), _mm_shuffle_epi32(lo, 0x4E));
+            }
+        }
+
+        template<bool two> SIMD_INLINE void JpegIdctBlocks2(const int16_t* src, uint8_t* dst, int stride)
+        {
+            __m256i r[8];
+            for (size_t i = 0; i < 8; ++i)
+            {
+                __m128i lo = _mm_loadu_si128((__m128i*)src + i);
+                __m128i hi = two ? _mm_loadu_si128((__m128i*)(src + 64) + i) : lo;
+                r[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            }
+
+            JpegIdctPass<10>(r, _mm256_set1_epi32(512));
+
+            JpegInterleave16(r[0], r[4]);
+            JpegInterleave16(r[1], r[5]);
+            JpegInterleave16(r[2], r[6]);
+            JpegInterleave16(r[3], r[7]);
+            JpegInterleave16(r[0], r[2]);
+            JpegInterleave16(r[1], r[3]);
+            JpegInterleave16(r[4], r[6]);
+            JpegInterleave16(r[5], r[7]);
+            JpegInterleave16(r[0], r[1]);
+            JpegInterleave16(r[2], r[3]);
+            JpegInterleave16(r[4], r[5]);
+            JpegInterleave16(r[6], r[7]);
+
+            JpegIdctPass<17>(r, _mm256_set1_epi32(65536 + (128 << 17)));
+
+            __m256i p0 = _mm256_packus_epi16(r[0], r[1]);
+            __m256i p1 = _mm256_packus_epi16(r[2], r[3]);
+            __m256i p2 = _mm256_packus_epi16(r[4], r[5]);
+            __m256i p3 = _mm256_packus_epi16(r[6], r[7]);
+            JpegInterleave8(p0, p2);
+            JpegInterleave8(p1, p3);
+            JpegInterleave8(p0, p1);
+            JpegInterleave8(p2, p3);
+            JpegInterleave8(p0, p2);
+            JpegInterleave8(p1, p3);
+
+            JpegStoreRows<two>(p0, dst + 0 * stride, stride);
+            JpegStoreRows<two>(p2, dst + 2 * stride, stride);
+            JpegStoreRows<two>(p1, dst + 4 * stride, stride);
+            JpegStoreRows<two>(p3, dst + 6 * stride, stride);
+        }
+
+        void JpegIdctBlocks(const int16_t* src, int count, uint8_t* dst, int stride)
+        {
+            int i = 0;
+            for (; i + 2 <= count; i += 2, src += 128, dst += 16)
+                JpegIdctBlocks2<true>(src, dst, stride);
+            if (i < count)
+                JpegIdctBlocks2<false>(src, dst, stride);
+        }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE __m256i JpegUpsample(__m256i src0, __m256i src1)
+        {
+            __m256i _3 = _mm256_set1_epi16(3), _2 = _mm256_set1_epi16(2);
+            __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(UnpackU8<0>(src0), _3), _mm256_add_epi16(UnpackU8<0>(src1), _2));
+            __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(UnpackU8<1>(src0), _3), _mm256_add_epi16(UnpackU8<1>(src1), _2));
+            return _mm256_packus_epi16(_mm256_srli_epi16(lo, 2), _mm256_srli_epi16(hi, 2));
+        }
+
+        uint8_t* JpegUpsampleV2(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs)
+        {
+            int i = 0;
+            for (; i < (width & ~(A - 1)); i += A)
+                _mm256_storeu_si256((__m256i*)(dst + i), JpegUpsample(_mm256_loadu_si256((__m256i*)(src0 + i)), _mm256_loadu_si256((__m256i*)(src1 + i))));
+            for (; i < width; ++i)
+                dst[i] = uint8_t((3 * src0[i] + src1[i] + 2) >> 2);
+            return dst;
+        }
+
+        uint8_t* JpegUpsampleH2(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs)
+        {
+            if (width == 1)
+            {
+                dst[0] = dst[1] = src0[0];
+                return dst;
+            }
+            dst[0] = src0[0];
+            dst[1] = uint8_t((src0[0] * 3 + src0[1] + 2) >> 2);
+            int i = 1;
+            for (; i + A < width; i += A)
+            {
+                __m256i curr = _mm256_loadu_si256((__m256i*)(src0 + i));
+                __m256i even = JpegUpsample(curr, _mm256_loadu_si256((__m256i*)(src0 + i - 1)));
+                __m256i odd = JpegUpsample(curr, _mm256_loadu_si256((__m256i*)(src0 + i + 1)));
+                __m256i lo = _mm256_unpacklo_epi8(even, odd);
+                __m256i hi = _mm256_unpackhi_epi8(even, odd);
+                Permute2x128(lo, hi);
+                _mm256_storeu_si256((__m256i*)(dst + 2 * i) + 0, lo);
+                _mm256_storeu_si256((__m256i*)(dst + 2 * i) + 1, hi);
+            }
+            for (; i < width - 1; ++i)
+            {
+                int n = 3 * src0[i] + 2;
+                dst[i * 2 + 0] = uint8_t((n + src0[i - 1]) >> 2);
+                dst[i * 2 + 1] = uint8_t((n + src0[i + 1]) >> 2);
+            }
+            dst[i * 2 + 0] = uint8_t((src0[width - 2] * 3 + src0[width - 1] + 2) >> 2);
+            dst[i * 2 + 1] = src0[width - 1];
+            return dst;
+        }
+
+        uint8_t* JpegUpsampleHv2(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs)
+        {
+            if (width == 1)
+            {
+                dst[0] = dst[1] = uint8_t((3 * src0[0] + src1[0] + 2) >> 2);
+                return dst;
+            }
+            int i = 0, t0, t1 = 3 * src0[0] + src1[0];
+            __m256i _8 = _mm256_set1_epi16(8);
+            for (; i < ((width - 1) & ~(HA - 1)); i += HA)
+            {
+                __m256i s0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(src0 + i)));
+                __m256i s1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(src1 + i)));
+                __m256i curr = _mm256_add_epi16(_mm256_slli_epi16(s0, 2), _mm256_sub_epi16(s1, s0));
+                __m256i prev = _mm256_alignr_epi8(curr, _mm256_permute2x128_si256(curr, curr, 0x08), 14);
+                __m256i next = _mm256_alignr_epi8(_mm256_permute2x128_si256(curr, curr, 0x81), curr, 2);
+                prev = _mm256_insert_epi16(prev, t1, 0);
+                next = _mm256_insert_epi16(next, 3 * src0[i + HA] + src1[i + HA], 15);
+                __m256i curs = _mm256_add_epi16(_mm256_slli_epi16(curr, 2), _8);
+                __m256i even = _mm256_add_epi16(_mm256_sub_epi16(prev, curr), curs);
+                __m256i odd = _mm256_add_epi16(_mm256_sub_epi16(next, curr), curs);
+                __m256i lo = _mm256_srli_epi16(_mm256_unpacklo_epi16(even, odd), 4);
+                __m256i hi = _mm256_srli_epi16(_mm256_unpackhi_epi16(even, odd), 4);
+                _mm256_storeu_si256((__m256i*)(dst + i * 2), _mm256_packus_epi16(lo, hi));
+                t1 = 3 * src0[i + HA - 1] + src1[i + HA - 1];
+            }
+            t0 = t1;
+            t1 = 3 * src0[i] + src1[i];
+            dst[i * 2] = uint8_t((3 * t1 + t0 + 8) >> 4);
+            for (++i; i < width; ++i)
+            {
+                t0 = t1;
+                t1 = 3 * src0[i] + src1[i];
+                dst[i * 2 - 1] = uint8_t((3 * t0 + t1 + 8) >> 4);
+                dst[i * 2] = uint8_t((3 * t1 + t0 + 8) >> 4);
+            }
+            dst[width * 2 - 1] = uint8_t((t1 + 2) >> 2);
+            return dst;
+        }
+
+        //---------------------------------------------------------------------
+
+        template <class T, bool rgb> SIMD_INLINE void JpegYuvToBgr(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst)
+        {
+            __m256i _y = _mm256_loadu_si256((__m256i*)y);
+            __m256i _u = _mm256_loadu_si256((__m256i*)u);
+            __m256i _v = _mm256_loadu_si256((__m256i*)v);
+            __m256i blue = YuvToBlue<T>(_y, _u);
+            __m256i green = YuvToGreen<T>(_y, _u, _v);
+            __m256i red = YuvToRed<T>(_y, _v);
+            if (rgb)
+                Swap(blue, red);
+            _mm256_storeu_si256((__m256i*)dst + 0, InterleaveBgr<0>(blue, green, red));
+            _mm256_storeu_si256((__m256i*)dst + 1, InterleaveBgr<1>(blue, green, red));
+            _mm256_storeu_si256((__m256i*)dst + 2, InterleaveBgr<2>(blue, green, red));
+        }
+
+        template <class T, bool rgb> void JpegYuvToBgr(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* dst)
+        {
+            assert(width >= A);
+            size_t widthA = AlignLo(width, A);
+            for (size_t i = 0; i < widthA; i += A)
+                JpegYuvToBgr<T, rgb>(y + i, u + i, v + i, dst + 3 * i);
+            if (widthA != width)
+            {
+                size_t i = width - A;
+                JpegYuvToBgr<T, rgb>(y + i, u + i, v + i, dst + 3 * i);
+            }
+        }
+
+        template <class T, bool rgb> SIMD_INLINE void JpegYuvToBgra16(__m256i y16, __m256i u16, __m256i v16, __m256i a16, uint8_t* dst)
+        {
+            __m256i b16 = YuvToBlue16<T>(y16, u16);
+            __m256i g16 = YuvToGreen16<T>(y16, u16, v16);
+            __m256i r16 = YuvToRed16<T>(y16, v16);
+            if (rgb)
+                Swap(b16, r16);
+            __m256i bg8 = _mm256_or_si256(b16, _mm256_slli_si256(g16, 1));
+            __m256i ra8 = _mm256_or_si256(r16, a16);
+            __m256i lo = _mm256_unpacklo_epi16(bg8, ra8);
+            __m256i hi = _mm256_unpackhi_epi16(bg8, ra8);
+            Permute2x128(lo, hi);
+            _mm256_storeu_si256((__m256i*)dst + 0, lo);
+            _mm256_storeu_si256((__m256i*)dst + 1, hi);
+        }
+
+        template <class T, bool rgb> SIMD_INLINE void JpegYuvToBgra(const uint8_t* y, const uint8_t* u, const uint8_t* v, __m256i a16, uint8_t* dst)
+        {
+            __m256i _y = LoadPermuted<false>((__m256i*)y);
+            __m256i _u = LoadPermuted<false>((__m256i*)u);
+            __m256i _v = LoadPermuted<false>((__m256i*)v);
+            JpegYuvToBgra16<T, rgb>(UnpackY<T, 0>(_y), UnpackUV<T, 0>(_u), UnpackUV<T, 0>(_v), a16, dst + 0 * A);
+            JpegYuvToBgra16<T, rgb>(UnpackY<T, 1>(_y), UnpackUV<T, 1>(_u), UnpackUV<T, 1>(_v), a16, dst + 2 * A);
+        }
+
+        template <class T, bool rgb> void JpegYuvToBgra(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* dst)
+        {
+            assert(width >= A);
+            __m256i a16 = _mm256_set1_epi16(0xFF00);
+            size_t widthA = AlignLo(width, A);
+            for (size_t i = 0; i < widthA; i += A)
+                JpegYuvToBgra<T, rgb>(y + i, u + i, v + i, a16, dst + 4 * i);
+            if (widthA != width)
+            {
+                size_t i = width - A;
+                JpegYuvToBgra<T, rgb>(y + i, u + i, v + i, a16, dst + 4 * i);
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
+            : Sse41::ImageJpegLoader(param)
+        {
+            _idctBlocks = JpegIdctBlocks;
+            _upsampleV2 = JpegUpsampleV2;
+            _upsampleH2 = JpegUpsampleH2;
+            _upsampleHv2 = JpegUpsampleHv2;
+        }
+
+        void ImageJpegLoader::SetConverters()
+        {
+            Sse41::ImageJpegLoader::SetConverters();
+            if (_image.width >= A)
+            {
+                switch (_param.format)
+                {
+                case SimdPixelFormatGray8:
+                    _rgbToAny = Avx2::RgbToGray;
+                    break;
+                case SimdPixelFormatBgr24:
+                    _yuvToAny = JpegYuvToBgr<Base::Trect871, false>;
+                    _grayToAny = Avx2::GrayToBgr;
+                    _rgbToAny = Avx2::BgrToRgb;
+                    break;
+                case SimdPixelFormatBgra32:
+                    _yuvToAny = JpegYuvToBgra<Base::Trect871, false>;
+                    _grayToBgra = Avx2::GrayToBgra;
+                    _rgbToBgra = Avx2::RgbToBgra;
+                    break;
+                case SimdPixelFormatRgb24:
+                    _yuvToAny = JpegYuvToBgr<Base::Trect871, true>;
+                    _grayToAny = Avx2::GrayToBgr;
+                    break;
+                case SimdPixelFormatRgba32:
+                    _yuvToAny = JpegYuvToBgra<Base::Trect871, true>;
+                    _grayToBgra = Avx2::GrayToBgra;
+                    _rgbToBgra = Avx2::BgrToBgra;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+#endif
+}
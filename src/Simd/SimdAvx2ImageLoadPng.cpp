@@ -0,0 +1,74 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) 
+    namespace Avx2
+    {
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst)
+        {
+            size_t sizeA = AlignLo(size, A), i = 0;
+            for (; i < sizeA; i += A)
+            {
+                __m256i _src = _mm256_loadu_si256((__m256i*)(src + i));
+                __m256i _prev = _mm256_loadu_si256((__m256i*)(prev + i));
+                _mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi8(_src, _prev));
+            }
+            for (; i < size; ++i)
+                dst[i] = src[i] + prev[i];
+        }
+
+        //---------------------------------------------------------------------
+
+        ImagePngLoader::ImagePngLoader(const ImageLoaderParam& param)
+            : Sse41::ImagePngLoader(param)
+        {
+            _decodeLine[2] = PngDecodeLineUp;
+        }
+
+        void ImagePngLoader::SetConverters()
+        {
+            Sse41::ImagePngLoader::SetConverters();
+            if (_width >= A)
+            {
+                _rgbToBgr = Avx2::BgrToRgb;
+                _reorder16 = Avx2::Reorder16bit;
+                switch (_param.format)
+                {
+                case SimdPixelFormatGray8: _rgbaToAny = Avx2::RgbaToGray; break;
+                case SimdPixelFormatBgr24: _rgbaToAny = Avx2::BgraToRgb; break;
+                case SimdPixelFormatBgra32: _rgbaToAny = Avx2::BgraToRgba; break;
+                case SimdPixelFormatRgb24: _rgbaToAny = Avx2::BgraToBgr; break;
+                default: break;
+                }
+            }
+        }
+    }
+#endif
+}
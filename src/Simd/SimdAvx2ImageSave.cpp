@@ -61,6 +61,7 @@ namespace Simd
                 case SimdPixelFormatBgra32: _convert = Avx2::BgraToGray; break;
                 case SimdPixelFormatRgb24: _convert = Avx2::RgbToGray; break;
                 case SimdPixelFormatRgba32: _convert = Avx2::RgbaToGray; break;
+                case SimdPixelFormatInt16: _reorder = Avx2::Reorder16bit; break;
                 default: break;
                 }
             }
@@ -114,6 +115,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinSaver(param);
             case SimdImageFilePng: return new ImagePngSaver(param);
             case SimdImageFileJpeg: return new ImageJpegSaver(param);
+            case SimdImageFilePfm: return new Base::ImagePfmSaver(param);
             default:
                 return NULL;
             }
@@ -72,9 +72,7 @@ namespace Simd
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(0, 1);
             stream.WriteBits(1, 2);
 
             int i = 0, j;
@@ -144,8 +142,6 @@ namespace Simd
             for (; i < size; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
-            stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -356,6 +352,8 @@ namespace Simd
                 _convert = Avx2::BgrToRgb;
             else if (_param.format == SimdPixelFormatBgra32)
                 _convert = Avx2::BgraToRgba;
+            else if (_param.format == SimdPixelFormatInt16 && _size >= A)
+                _reorder = Avx2::Reorder16bit;
             _encode[0] = Avx2::EncodeLine0;
             _encode[1] = Avx2::EncodeLine1;
             _encode[2] = Avx2::EncodeLine2;
@@ -363,7 +361,9 @@ namespace Simd
             _encode[4] = Avx2::EncodeLine4;
             _encode[5] = Avx2::EncodeLine5;
             _encode[6] = Avx2::EncodeLine6;
-            _compress = Avx2::ZlibCompress;
+            if (_level > COMPRESSION_GREEDY)
+                _compress = Avx2::ZlibCompress;
+            _adler32 = Avx2::ZlibAdler32;
         }
     }
 #endif// SIMD_AVX2_ENABLE
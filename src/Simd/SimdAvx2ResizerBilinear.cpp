@@ -242,7 +242,8 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const int32_t * ix = _ix.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm256_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm256_set1_epi16(int16_t(_ay[yDst]));
@@ -291,7 +292,8 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const Idx * ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm256_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm256_set1_epi16(int16_t(_ay[yDst]));
@@ -427,7 +429,8 @@ namespace Simd
             size_t rs8 = AlignLo(rs, 8);
             size_t rs16 = AlignLo(rs, 16);
             __m256 _1 = _mm256_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -566,7 +569,8 @@ namespace Simd
             size_t rs8 = AlignLo(rs, 8);
             size_t rs16 = AlignLo(rs, 16);
             __m256 _1 = _mm256_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -757,7 +761,8 @@ namespace Simd
             int32_t prev = -2;
             size_t rsa = AlignLo(rs, Avx::F);
             size_t rsh = AlignLo(rs, Sse41::F);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -0,0 +1,105 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdResizer.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE 
+    namespace Avx2
+    {
+        ResizerFloatFilter::ResizerFloatFilter(const ResParam& param)
+            : Sse41::ResizerFloatFilter(param)
+        {
+        }
+
+        SIMD_INLINE __m256 FilterLoad(const float* src)
+        {
+            return _mm256_loadu_ps(src);
+        }
+
+        SIMD_INLINE __m256 FilterLoad(const uint16_t* src)
+        {
+            return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)src)));
+        }
+
+        template<class T> SIMD_INLINE void FilterRowY(const T* src, size_t srcStride, size_t size, const float* ay, size_t ky, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m256 ay0 = _mm256_set1_ps(ay[0]);
+            for (; i < sizeF; i += F)
+                _mm256_storeu_ps(dst + i, _mm256_mul_ps(FilterLoad(src + i), ay0));
+            for (; i < size; ++i)
+                dst[i] = ay[0] * src[i];
+            for (size_t k = 1; k < ky; ++k)
+            {
+                src += srcStride;
+                __m256 ayk = _mm256_set1_ps(ay[k]);
+                for (i = 0; i < sizeF; i += F)
+                    _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(FilterLoad(src + i), ayk, _mm256_loadu_ps(dst + i)));
+                for (; i < size; ++i)
+                    dst[i] += ay[k] * src[i];
+            }
+        }
+
+        SIMD_INLINE void FilterStore(const float* src, size_t size, uint16_t* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            for (; i < sizeF; i += F)
+            {
+                __m256i i32 = _mm256_cvtps_epi32(_mm256_loadu_ps(src + i));
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi32(_mm256_castsi256_si128(i32), _mm256_extracti128_si256(i32, 1)));
+            }
+            for (; i < size; ++i)
+                dst[i] = (uint16_t)Base::RestrictRange(Round(src[i]), 0, 0xFFFF);
+        }
+
+        template<class T> void ResizerFloatFilter::RunB(const T* src, size_t srcStride, T* dst, size_t dstStride)
+        {
+            size_t sw = _param.srcW * _param.channels, dw = _param.dstW * _param.channels;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                FilterRowY(src + _iy[dy] * srcStride, srcStride, sw, _ay.data + dy * _ky, _ky, _by.data);
+                if (_param.type == SimdResizeChannelFloat)
+                    RowX((float*)dst);
+                else
+                {
+                    RowX(_bx.data);
+                    FilterStore(_bx.data, dw, (uint16_t*)dst);
+                }
+            }
+        }
+
+        void ResizerFloatFilter::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            if (_param.type == SimdResizeChannelFloat)
+                RunB((const float*)src, srcStride / sizeof(float), (float*)dst, dstStride / sizeof(float));
+            else
+                RunB((const uint16_t*)src, srcStride / sizeof(uint16_t), (uint16_t*)dst, dstStride / sizeof(uint16_t));
+        }
+    }
+#endif //SIMD_AVX2_ENABLE 
+}
@@ -0,0 +1,101 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdExtract.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE 
+    namespace Avx2
+    {
+        ResizerByteLanczos3::ResizerByteLanczos3(const ResParam& param)
+            : Sse41::ResizerByteLanczos3(param)
+        {
+        }
+
+        SIMD_INLINE __m256i Lanczos3MulAdd(const int32_t* src, __m256i ay, __m256i sum)
+        {
+            return _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_loadu_si256((__m256i*)src), ay));
+        }
+
+        SIMD_INLINE void Lanczos3RowInt(const int32_t* const* src, size_t n, const int32_t* ay, uint8_t* dst)
+        {
+            size_t nF = AlignLo(n, F);
+            size_t i = 0;
+            if (nF)
+            {
+                static const __m256i ROUND = SIMD_MM256_SET1_EPI32(Base::BICUBIC_ROUND);
+                __m256i ay0 = _mm256_set1_epi32(ay[0]);
+                __m256i ay1 = _mm256_set1_epi32(ay[1]);
+                __m256i ay2 = _mm256_set1_epi32(ay[2]);
+                __m256i ay3 = _mm256_set1_epi32(ay[3]);
+                __m256i ay4 = _mm256_set1_epi32(ay[4]);
+                __m256i ay5 = _mm256_set1_epi32(ay[5]);
+                for (; i < nF; i += F)
+                {
+                    __m256i sum = ROUND;
+                    sum = Lanczos3MulAdd(src[0] + i, ay0, sum);
+                    sum = Lanczos3MulAdd(src[1] + i, ay1, sum);
+                    sum = Lanczos3MulAdd(src[2] + i, ay2, sum);
+                    sum = Lanczos3MulAdd(src[3] + i, ay3, sum);
+                    sum = Lanczos3MulAdd(src[4] + i, ay4, sum);
+                    sum = Lanczos3MulAdd(src[5] + i, ay5, sum);
+                    __m256i dst0 = _mm256_srai_epi32(sum, Base::BICUBIC_SHIFT);
+                    *((int64_t*)(dst + i)) = Extract64i<0>(PackI16ToU8(PackI32ToI16(dst0, K_ZERO), K_ZERO));
+                }
+            }
+            for (; i < n; ++i)
+            {
+                int32_t sum = ay[0] * src[0][i] + ay[1] * src[1][i] + ay[2] * src[2][i] + ay[3] * src[3][i] + ay[4] * src[4][i] + ay[5] * src[5][i];
+                dst[i] = Base::RestrictRange((sum + Base::BICUBIC_ROUND) >> Base::BICUBIC_SHIFT, 0, 255);
+            }
+        }
+
+        void ResizerByteLanczos3::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            int32_t prev = -2;
+            const int32_t* pb[6];
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                int32_t sy = _iy[dy];
+                for (int32_t curr = Max(sy - 2, prev); curr < sy + 4; ++curr)
+                    RowSumX(src + RestrictRange(curr, 0, (int)_param.srcH - 1) * srcStride, _bx[(curr + 2) & 7].data);
+                prev = sy + 4;
+                for (int k = 0; k < 6; ++k)
+                    pb[k] = _bx[(sy + k) & 7].data;
+                Lanczos3RowInt(pb, _param.dstW * _param.channels, _ay.data + dy * 6, dst);
+            }
+        }
+
+        void ResizerByteLanczos3::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Init();
+            RunB(src, srcStride, dst, dstStride);
+        }
+    }
+#endif //SIMD_AVX2_ENABLE 
+}
@@ -0,0 +1,186 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetDeconvolution8i.h"
+#include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && defined(SIMD_SYNET_ENABLE)  
+    namespace Avx2
+    {
+        static void RowToImgSum(const float* src, const DeconvParam8i& p, float* dst)
+        {
+            size_t C = p.dstC, CF = AlignLo(C, F);
+            memset(dst, 0, p.dstH * p.dstW * C * sizeof(float));
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx)
+                {
+                    size_t dy = sy * p.strideY - p.padY;
+                    for (size_t ky = 0; ky < p.kernelY; ky++, dy += p.dilationY)
+                    {
+                        if (dy < p.dstH)
+                        {
+                            size_t dx = sx * p.strideX - p.padX;
+                            for (size_t kx = 0; kx < p.kernelX; kx++, dx += p.dilationX)
+                            {
+                                if (dx < p.dstW)
+                                {
+                                    float* d = dst + (dy * p.dstW + dx) * C;
+                                    size_t c = 0;
+                                    for (; c < CF; c += F)
+                                        _mm256_storeu_ps(d + c, _mm256_add_ps(_mm256_loadu_ps(d + c), _mm256_loadu_ps(src + c)));
+                                    for (; c < C; ++c)
+                                        d[c] += src[c];
+                                }
+                                src += C;
+                            }
+                        }
+                        else
+                            src += p.kernelX * C;
+                    }
+                }
+            }
+        }
+
+        SynetDeconvolution8iGemm::SynetDeconvolution8iGemm(const DeconvParam8i& p)
+            : Base::SynetDeconvolution8iGemm(p, Avx2::SynetConvolution8iInit)
+        {
+            _convertDst = Avx2::SynetConvert32fTo8u;
+            _biasAndActivation = Avx::ConvolutionBiasAndActivation;
+            if (!p.IsTiled())
+                _rowToImg = RowToImgSum;
+        }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE __m256i LoadU8(const uint8_t* src)
+        {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)src));
+        }
+
+        SIMD_INLINE __m256i LoadI8(const int8_t* src)
+        {
+            return _mm256_cvtepi8_epi32(_mm_loadl_epi64((__m128i*)src));
+        }
+
+        static void DeconvolutionNhwcDepthwise(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst)
+        {
+            size_t CA = AlignLo(p.srcC, 8);
+            size_t C = p.srcC;
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx, src += C)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                        if (dy >= p.dstH)
+                            continue;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                        {
+                            size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                            if (dx >= p.dstW)
+                                continue;
+                            int32_t* d = dst + (dy * p.dstW + dx) * C;
+                            const int8_t* w = weight + (ky * p.kernelX + kx) * C;
+                            size_t c = 0;
+                            for (; c < CA; c += 8)
+                            {
+                                __m256i s = _mm256_sub_epi32(LoadU8(src + c), LoadU8(zero + c));
+                                __m256i sum = _mm256_loadu_si256((__m256i*)(d + c));
+                                _mm256_storeu_si256((__m256i*)(d + c), _mm256_add_epi32(sum, _mm256_mullo_epi32(s, LoadI8(w + c))));
+                            }
+                            for (; c < C; ++c)
+                                d[c] += (int(src[c]) - int(zero[c])) * w[c];
+                        }
+                    }
+                }
+            }
+        }
+
+        static void DeconvolutionNhwcGroup(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst)
+        {
+            size_t G = p.group, C = p.srcC / G, D = p.dstC / G, DF = AlignLo(D, F), K = p.kernelY * p.kernelX;
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx, src += p.srcC)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                        if (dy >= p.dstH)
+                            continue;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                        {
+                            size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                            if (dx >= p.dstW)
+                                continue;
+                            int32_t* d = dst + (dy * p.dstW + dx) * p.dstC;
+                            const int8_t* w = weight + (ky * p.kernelX + kx) * D;
+                            for (size_t g = 0; g < G; ++g, d += D)
+                            {
+                                for (size_t c = 0, gc = g * C; c < C; ++c, ++gc)
+                                {
+                                    int s = int(src[gc]) - int(zero[gc]);
+                                    const int8_t* wc = w + gc * K * D;
+                                    __m256i _s = _mm256_set1_epi32(s);
+                                    size_t i = 0;
+                                    for (; i < DF; i += F)
+                                        _mm256_storeu_si256((__m256i*)(d + i), _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(d + i)), _mm256_mullo_epi32(_s, LoadI8(wc + i))));
+                                    for (; i < D; ++i)
+                                        d[i] += s * wc[i];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        SynetDeconvolution8iNhwcDirect::SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p)
+            : Sse41::SynetDeconvolution8iNhwcDirect(p)
+        {
+            _convertSrc = Avx2::SynetConvert32fTo8u;
+            _convertDst = Avx2::SynetConvert32fTo8u;
+            _biasAndActivation = Avx::ConvolutionBiasAndActivation;
+            _deconvolution = p.IsDepthwise() ? DeconvolutionNhwcDepthwise : DeconvolutionNhwcGroup;
+        }
+
+        //---------------------------------------------------------------------
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
+        {
+            DeconvParam8i param(batch, conv, compatibility);
+            if (!param.Valid())
+                return NULL;
+            if (SynetDeconvolution8iNhwcDirect::Preferable(param))
+                return new SynetDeconvolution8iNhwcDirect(param);
+            return new SynetDeconvolution8iGemm(param);
+        }
+    }
+#endif
+}
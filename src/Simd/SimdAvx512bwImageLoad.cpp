@@ -69,6 +69,7 @@ namespace Simd
                 case SimdPixelFormatBgr24: _toAny = Avx512bw::GrayToBgr; break;
                 case SimdPixelFormatBgra32: _toBgra = Avx512bw::GrayToBgra; break;
                 case SimdPixelFormatRgb24: _toAny = Avx512bw::GrayToBgr; break;
+                case SimdPixelFormatInt16: _reorder = Avx512bw::Reorder16bit; break;
                 default: break;
                 }
             }
@@ -120,6 +121,20 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImagePfmLoader::ImagePfmLoader(const ImageLoaderParam& param)
+            : Avx2::ImagePfmLoader(param)
+        {
+        }
+
+        void ImagePfmLoader::SetConverters()
+        {
+            Avx2::ImagePfmLoader::SetConverters();
+            if (_image.width >= A)
+                _reorder = Avx512bw::Reorder32bit;
+        }
+
+        //---------------------------------------------------------------------
+
         ImageLoader* CreateImageLoader(const ImageLoaderParam& param)
         {
             switch (param.file)
@@ -128,8 +143,9 @@ namespace Simd
             case SimdImageFilePgmBin: return new ImagePgmBinLoader(param);
             case SimdImageFilePpmTxt: return new ImagePpmTxtLoader(param);
             case SimdImageFilePpmBin: return new ImagePpmBinLoader(param);
-            case SimdImageFilePng: return new Base::ImagePngLoader(param);
-            case SimdImageFileJpeg: return new Base::ImageJpegLoader(param);
+            case SimdImageFilePng: return new ImagePngLoader(param);
+            case SimdImageFileJpeg: return new ImageJpegLoader(param);
+            case SimdImageFilePfm: return new ImagePfmLoader(param);
             default:
                 return NULL;
             }
@@ -0,0 +1,425 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdLoad.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdUnpack.h"
+#include "Simd/SimdInterleave.h"
+#include "Simd/SimdYuvToBgr.h"
+#include "Simd/SimdAvx512bw.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) 
+    namespace Avx512bw
+    {
+        SIMD_INLINE int JpegF2F(float x)
+        {
+            return int(x * 4096 + 0.5f);
+        }
+
+        SIMD_INLINE __m512i JpegConst(int x, int y)
+        {
+            return _mm512_unpacklo_epi16(_mm512_set1_epi16(x), _mm512_set1_epi16(y));
+        }
+
+        SIMD_INLINE void JpegRot(__m512i x, __m512i y, __m512i c0, __m512i c1, __m512i* out0, __m512i* out1)
+        {
+            __m512i lo = _mm512_unpacklo_epi16(x, y);
+            __m512i hi = _mm512_unpackhi_epi16(x, y);
+            out0[0] = _mm512_madd_epi16(lo, c0);
+            out0[1] = _mm512_madd_epi16(hi, c0);
+            out1[0] = _mm512_madd_epi16(lo, c1);
+            out1[1] = _mm512_madd_epi16(hi, c1);
+        }
+
+        SIMD_INLINE void JpegWiden(__m512i in, __m512i* out)
+        {
+            out[0] = _mm512_srai_epi32(_mm512_unpacklo_epi16(_mm512_setzero_si512(), in), 4);
+            out[1] = _mm512_srai_epi32(_mm512_unpackhi_epi16(_mm512_setzero_si512(), in), 4);
+        }
+
+        SIMD_INLINE void JpegAdd(const __m512i* a, const __m512i* b, __m512i* sum)
+        {
+            sum[0] = _mm512_add_epi32(a[0], b[0]);
+            sum[1] = _mm512_add_epi32(a[1], b[1]);
+        }
+
+        SIMD_INLINE void JpegSub(const __m512i* a, const __m512i* b, __m512i* dif)
+        {
+            dif[0] = _mm512_sub_epi32(a[0], b[0]);
+            dif[1] = _mm512_sub_epi32(a[1], b[1]);
+        }
+
+        template<int shift> SIMD_INLINE void JpegButterfly(const __m512i* a, const __m512i* b, __m512i bias, __m512i& out0, __m512i& out1)
+        {
+            __m512i lo = _mm512_add_epi32(a[0], bias);
+            __m512i hi = _mm512_add_epi32(a[1], bias);
+            out0 = _mm512_packs_epi32(_mm512_srai_epi32(_mm512_add_epi32(lo, b[0]), shift), _mm512_srai_epi32(_mm512_add_epi32(hi, b[1]), shift));
+            out1 = _mm512_packs_epi32(_mm512_srai_epi32(_mm512_sub_epi32(lo, b[0]), shift), _mm512_srai_epi32(_mm512_sub_epi32(hi, b[1]), shift));
+        }
+
+        template<int shift> SIMD_INLINE void JpegIdctPass(__m512i* r, __m512i bias)
+        {
+            __m512i t0e[2], t1e[2], t2e[2], t3e[2], x0[2], x1[2], x2[2], x3[2];
+            JpegRot(r[2], r[6], JpegConst(JpegF2F(0.5411961f), JpegF2F(0.5411961f) + JpegF2F(-1.847759065f)),
+                JpegConst(JpegF2F(0.5411961f) + JpegF2F(0.765366865f), JpegF2F(0.5411961f)), t2e, t3e);
+            JpegWiden(_mm512_add_epi16(r[0], r[4]), t0e);
+            JpegWiden(_mm512_sub_epi16(r[0], r[4]), t1e);
+            JpegAdd(t0e, t3e, x0);
+            JpegSub(t0e, t3e, x3);
+            JpegAdd(t1e, t2e, x1);
+            JpegSub(t1e, t2e, x2);
+
+            __m512i y0o[2], y1o[2], y2o[2], y3o[2], y4o[2], y5o[2], x4[2], x5[2], x6[2], x7[2];
+            JpegRot(r[7], r[3], JpegConst(JpegF2F(-1.961570560f) + JpegF2F(0.298631336f), JpegF2F(-1.961570560f)),
+                JpegConst(JpegF2F(-1.961570560f), JpegF2F(-1.961570560f) + JpegF2F(3.072711026f)), y0o, y2o);
+            JpegRot(r[5], r[1], JpegConst(JpegF2F(-0.390180644f) + JpegF2F(2.053119869f), JpegF2F(-0.390180644f)),
+                JpegConst(JpegF2F(-0.390180644f), JpegF2F(-0.390180644f) + JpegF2F(1.501321110f)), y1o, y3o);
+            JpegRot(_mm512_add_epi16(r[1], r[7]), _mm512_add_epi16(r[3], r[5]), JpegConst(JpegF2F(1.175875602f) + JpegF2F(-0.899976223f), JpegF2F(1.175875602f)),
+                JpegConst(JpegF2F(1.175875602f), JpegF2F(1.175875602f) + JpegF2F(-2.562915447f)), y4o, y5o);
+            JpegAdd(y0o, y4o, x4);
+            JpegAdd(y1o, y5o, x5);
+            JpegAdd(y2o, y5o, x6);
+            JpegAdd(y3o, y4o, x7);
+
+            JpegButterfly<shift>(x0, x7, bias, r[0], r[7]);
+            JpegButterfly<shift>(x1, x6, bias, r[1], r[6]);
+            JpegButterfly<shift>(x2, x5, bias, r[2], r[5]);
+            JpegButterfly<shift>(x3, x4, bias, r[3], r[4]);
+        }
+
+        SIMD_INLINE void JpegInterleave16(__m512i& a, __m512i& b)
+        {
+            __m512i t = a;
+            a = _mm512_unpacklo_epi16(t, b);
+            b = _mm512_unpackhi_epi16(t, b);
+        }
+
+        SIMD_INLINE void JpegInterleave8(__m512i& a, __m512i& b)
+        {
+            __m512i t = a;
+            a = _mm512_unpacklo_epi8(t, b);
+            b = _mm512_unpackhi_epi8(t, b);
+        }
+
+        template<bool mask> SIMD_INLINE void JpegStoreRows(__m512i p, uint8_t* dst, int stride, __mmask64 tail)
+        {
+            p = _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), p);
+            if (mask)
+            {
+                _mm512_mask_storeu_epi8(dst, tail, p);
+                _mm512_mask_storeu_epi8(dst + stride, tail, _mm512_shuffle_i64x2(p, p, 0xEE));
+            }
+            else
+            {
+                _mm256_storeu_si256((__m256i*)dst, _mm512_castsi512_si256(p));
+                _mm256_storeu_si256((__m256i*)(dst + stride), _mm512_extracti64x4_epi64(p, 1));
+            }
+        }
+
+        template<bool mask> SIMD_INLINE void JpegIdctBlocks4(const int16_t* src, int count, uint8_t* dst, int stride)
+        {
+            __m512i r[8];
+            const int16_t* b1 = src + 64 * Min(1, count - 1);
+            const int16_t* b2 = src + 64 * Min(2, count - 1);
+            const int16_t* b3 = src + 64 * Min(3, count - 1);
+            for (size_t i = 0; i < 8; ++i)
+            {
+                __m512i b01 = _mm512_inserti32x4(_mm512_castsi128_si512(_mm_loadu_si128((__m128i*)src + i)), _mm_loadu_si128((__m128i*)b1 + i), 1);
+                __m512i b012 = _mm512_inserti32x4(b01, _mm_loadu_si128((__m128i*)b2 + i), 2);
+                r[i] = _mm512_inserti32x4(b012, _mm_loadu_si128((__m128i*)b3 + i), 3);
+            }
+
+            JpegIdctPass<10>(r, _mm512_set1_epi32(512));
+
+            JpegInterleave16(r[0], r[4]);
+            JpegInterleave16(r[1], r[5]);
+            JpegInterleave16(r[2], r[6]);
+            JpegInterleave16(r[3], r[7]);
+            JpegInterleave16(r[0], r[2]);
+            JpegInterleave16(r[1], r[3]);
+            JpegInterleave16(r[4], r[6]);
+            JpegInterleave16(r[5], r[7]);
+            JpegInterleave16(r[0], r[1]);
+            JpegInterleave16(r[2], r[3]);
+            JpegInterleave16(r[4], r[5]);
+            JpegInterleave16(r[6], r[7]);
+
+            JpegIdctPass<17>(r, _mm512_set1_epi32(65536 + (128 << 17)));
+
+            __m512i p0 = _mm512_packus_epi16(r[0], r[1]);
+            __m512i p1 = _mm512_packus_epi16(r[2], r[3]);
+            __m512i p2 = _mm512_packus_epi16(r[4], r[5]);
+            __m512i p3 = _mm512_packus_epi16(r[6], r[7]);
+            JpegInterleave8(p0, p2);
+            JpegInterleave8(p1, p3);
+            JpegInterleave8(p0, p1);
+            JpegInterleave8(p2, p3);
+            JpegInterleave8(p0, p2);
+            JpegInterleave8(p1, p3);
+
+            __mmask64 tail = TailMask64(count * 8);
+            JpegStoreRows<mask>(p0, dst + 0 * stride, stride, tail);
+            JpegStoreRows<mask>(p2, dst + 2 * stride, stride, tail);
+            JpegStoreRows<mask>(p1, dst + 4 * stride, stride, tail);
+            JpegStoreRows<mask>(p3, dst + 6 * stride, stride, tail);
+        }
+
+        void JpegIdctBlocks(const int16_t* src, int count, uint8_t* dst, int stride)
+        {
+            int i = 0;
+            for (; i + 4 <= count; i += 4, src += 256, dst += 32)
+                JpegIdctBlocks4<false>(src, 4, dst, stride);
+            if (i < count)
+                JpegIdctBlocks4<true>(src, count - i, dst, stride);
+        }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE __m512i JpegUpsample(__m512i src0, __m512i src1)
+        {
+            __m512i _3 = _mm512_set1_epi16(3), _2 = _mm512_set1_epi16(2);
+            __m512i lo = _mm512_add_epi16(_mm512_mullo_epi16(UnpackU8<0>(src0), _3), _mm512_add_epi16(UnpackU8<0>(src1), _2));
+            __m512i hi = _mm512_add_epi16(_mm512_mullo_epi16(UnpackU8<1>(src0), _3), _mm512_add_epi16(UnpackU8<1>(src1), _2));
+            return _mm512_packus_epi16(_mm512_srli_epi16(lo, 2), _mm512_srli_epi16(hi, 2));
+        }
+
+        uint8_t* JpegUpsampleV2(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs)
+        {
+            int i = 0;
+            for (; i < (width & ~(A - 1)); i += A)
+                _mm512_storeu_si512(dst + i, JpegUpsample(_mm512_loadu_si512(src0 + i), _mm512_loadu_si512(src1 + i)));
+            if (i < width)
+            {
+                __mmask64 tail = TailMask64(width - i);
+                Store<false, true>(dst + i, JpegUpsample(Load<false, true>(src0 + i, tail), Load<false, true>(src1 + i, tail)), tail);
+            }
+            return dst;
+        }
+
+        uint8_t* JpegUpsampleH2(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs)
+        {
+            if (width == 1)
+            {
+                dst[0] = dst[1] = src0[0];
+                return dst;
+            }
+            dst[0] = src0[0];
+            dst[1] = uint8_t((src0[0] * 3 + src0[1] + 2) >> 2);
+            int i = 1;
+            __m512i idx0 = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+            __m512i idx1 = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+            for (; i + A < width; i += A)
+            {
+                __m512i curr = _mm512_loadu_si512(src0 + i);
+                __m512i even = JpegUpsample(curr, _mm512_loadu_si512(src0 + i - 1));
+                __m512i odd = JpegUpsample(curr, _mm512_loadu_si512(src0 + i + 1));
+                __m512i lo = _mm512_unpacklo_epi8(even, odd);
+                __m512i hi = _mm512_unpackhi_epi8(even, odd);
+                _mm512_storeu_si512(dst + 2 * i + 0, _mm512_permutex2var_epi64(lo, idx0, hi));
+                _mm512_storeu_si512(dst + 2 * i + A, _mm512_permutex2var_epi64(lo, idx1, hi));
+            }
+            for (; i < width - 1; ++i)
+            {
+                int n = 3 * src0[i] + 2;
+                dst[i * 2 + 0] = uint8_t((n + src0[i - 1]) >> 2);
+                dst[i * 2 + 1] = uint8_t((n + src0[i + 1]) >> 2);
+            }
+            dst[i * 2 + 0] = uint8_t((src0[width - 2] * 3 + src0[width - 1] + 2) >> 2);
+            dst[i * 2 + 1] = src0[width - 1];
+            return dst;
+        }
+
+        uint8_t* JpegUpsampleHv2(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs)
+        {
+            if (width == 1)
+            {
+                dst[0] = dst[1] = uint8_t((3 * src0[0] + src1[0] + 2) >> 2);
+                return dst;
+            }
+            int i = 0, t0, t1 = 3 * src0[0] + src1[0];
+            __m512i _8 = _mm512_set1_epi16(8);
+            __m512i toPrev = SIMD_MM512_SETR_EPI16(
+                0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+                0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E);
+            __m512i toNext = SIMD_MM512_SETR_EPI16(
+                0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
+                0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x1F);
+            for (; i < ((width - 1) & ~(HA - 1)); i += HA)
+            {
+                __m512i s0 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((__m256i*)(src0 + i)));
+                __m512i s1 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((__m256i*)(src1 + i)));
+                __m512i curr = _mm512_add_epi16(_mm512_slli_epi16(s0, 2), _mm512_sub_epi16(s1, s0));
+                __m512i prev = _mm512_mask_set1_epi16(_mm512_permutexvar_epi16(toPrev, curr), 0x00000001, (short)t1);
+                __m512i next = _mm512_mask_set1_epi16(_mm512_permutexvar_epi16(toNext, curr), 0x80000000, (short)(3 * src0[i + HA] + src1[i + HA]));
+                __m512i curs = _mm512_add_epi16(_mm512_slli_epi16(curr, 2), _8);
+                __m512i even = _mm512_add_epi16(_mm512_sub_epi16(prev, curr), curs);
+                __m512i odd = _mm512_add_epi16(_mm512_sub_epi16(next, curr), curs);
+                __m512i lo = _mm512_srli_epi16(_mm512_unpacklo_epi16(even, odd), 4);
+                __m512i hi = _mm512_srli_epi16(_mm512_unpackhi_epi16(even, odd), 4);
+                _mm512_storeu_si512(dst + i * 2, _mm512_packus_epi16(lo, hi));
+                t1 = 3 * src0[i + HA - 1] + src1[i + HA - 1];
+            }
+            t0 = t1;
+            t1 = 3 * src0[i] + src1[i];
+            dst[i * 2] = uint8_t((3 * t1 + t0 + 8) >> 4);
+            for (++i; i < width; ++i)
+            {
+                t0 = t1;
+                t1 = 3 * src0[i] + src1[i];
+                dst[i * 2 - 1] = uint8_t((3 * t0 + t1 + 8) >> 4);
+                dst[i * 2] = uint8_t((3 * t1 + t0 + 8) >> 4);
+            }
+            dst[width * 2 - 1] = uint8_t((t1 + 2) >> 2);
+            return dst;
+        }
+
+        //---------------------------------------------------------------------
+
+        template <class T, bool rgb, bool mask> SIMD_INLINE void JpegYuvToBgr(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, const __mmask64* tails)
+        {
+            __m512i _y = Load<false, mask>(y, tails[0]);
+            __m512i _u = Load<false, mask>(u, tails[0]);
+            __m512i _v = Load<false, mask>(v, tails[0]);
+            __m512i blue = YuvToBlue<T>(_y, _u);
+            __m512i green = YuvToGreen<T>(_y, _u, _v);
+            __m512i red = YuvToRed<T>(_y, _v);
+            if (rgb)
+                Swap(blue, red);
+            Store<false, mask>(dst + 0 * A, InterleaveBgr<0>(blue, green, red), tails[1]);
+            Store<false, mask>(dst + 1 * A, InterleaveBgr<1>(blue, green, red), tails[2]);
+            Store<false, mask>(dst + 2 * A, InterleaveBgr<2>(blue, green, red), tails[3]);
+        }
+
+        template <class T, bool rgb> void JpegYuvToBgr(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* dst)
+        {
+            size_t widthA = AlignLo(width, A), tail = width - widthA;
+            __mmask64 tails[4];
+            tails[0] = TailMask64(tail);
+            for (size_t i = 0; i < 3; ++i)
+                tails[1 + i] = TailMask64(tail * 3 - A * i);
+            size_t i = 0;
+            for (; i < widthA; i += A)
+                JpegYuvToBgr<T, rgb, false>(y + i, u + i, v + i, dst + 3 * i, tails);
+            if (i < width)
+                JpegYuvToBgr<T, rgb, true>(y + i, u + i, v + i, dst + 3 * i, tails);
+        }
+
+        template <class T, bool rgb, bool mask> SIMD_INLINE void JpegYuvToBgra(const uint8_t* y, const uint8_t* u, const uint8_t* v, const __m512i& a, uint8_t* dst, const __mmask64* tails)
+        {
+            __m512i _y = Load<false, mask>(y, tails[0]);
+            __m512i _u = Load<false, mask>(u, tails[0]);
+            __m512i _v = Load<false, mask>(v, tails[0]);
+            __m512i b = _mm512_permutexvar_epi32(K32_PERMUTE_FOR_TWO_UNPACK, YuvToBlue<T>(_y, _u));
+            __m512i g = _mm512_permutexvar_epi32(K32_PERMUTE_FOR_TWO_UNPACK, YuvToGreen<T>(_y, _u, _v));
+            __m512i r = _mm512_permutexvar_epi32(K32_PERMUTE_FOR_TWO_UNPACK, YuvToRed<T>(_y, _v));
+            if (rgb)
+                Swap(b, r);
+            __m512i bg0 = UnpackU8<0>(b, g);
+            __m512i bg1 = UnpackU8<1>(b, g);
+            __m512i ra0 = UnpackU8<0>(r, a);
+            __m512i ra1 = UnpackU8<1>(r, a);
+            Store<false, mask>(dst + 0 * A, UnpackU16<0>(bg0, ra0), tails[1]);
+            Store<false, mask>(dst + 1 * A, UnpackU16<1>(bg0, ra0), tails[2]);
+            Store<false, mask>(dst + 2 * A, UnpackU16<0>(bg1, ra1), tails[3]);
+            Store<false, mask>(dst + 3 * A, UnpackU16<1>(bg1, ra1), tails[4]);
+        }
+
+        template <class T, bool rgb> void JpegYuvToBgra(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* dst)
+        {
+            size_t widthA = AlignLo(width, A), tail = width - widthA;
+            __mmask64 tails[5];
+            tails[0] = TailMask64(tail);
+            for (size_t i = 0; i < 4; ++i)
+                tails[1 + i] = TailMask64(tail * 4 - A * i);
+            __m512i a = _mm512_set1_epi8(-1);
+            size_t i = 0;
+            for (; i < widthA; i += A)
+                JpegYuvToBgra<T, rgb, false>(y + i, u + i, v + i, a, dst + 4 * i, tails);
+            if (i < width)
+                JpegYuvToBgra<T, rgb, true>(y + i, u + i, v + i, a, dst + 4 * i, tails);
+        }
+
+        //---------------------------------------------------------------------
+
+        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
+            : Avx2::ImageJpegLoader(param)
+        {
+            _idctBlocks = JpegIdctBlocks;
+            _upsampleV2 = JpegUpsampleV2;
+            _upsampleH2 = JpegUpsampleH2;
+            _upsampleHv2 = JpegUpsampleHv2;
+        }
+
+        void ImageJpegLoader::SetConverters()
+        {
+            Avx2::ImageJpegLoader::SetConverters();
+            switch (_param.format)
+            {
+            case SimdPixelFormatBgr24:
+                _yuvToAny = JpegYuvToBgr<Base::Trect871, false>;
+                break;
+            case SimdPixelFormatBgra32:
+                _yuvToAny = JpegYuvToBgra<Base::Trect871, false>;
+                break;
+            case SimdPixelFormatRgb24:
+                _yuvToAny = JpegYuvToBgr<Base::Trect871, true>;
+                break;
+            case SimdPixelFormatRgba32:
+                _yuvToAny = JpegYuvToBgra<Base::Trect871, true>;
+                break;
+            default:
+                break;
+            }
+            if (_image.width >= A)
+            {
+                switch (_param.format)
+                {
+                case SimdPixelFormatGray8:
+                    _rgbToAny = Avx512bw::RgbToGray;
+                    break;
+                case SimdPixelFormatBgr24:
+                    _grayToAny = Avx512bw::GrayToBgr;
+                    _rgbToAny = Avx512bw::BgrToRgb;
+                    break;
+                case SimdPixelFormatBgra32:
+                    _grayToBgra = Avx512bw::GrayToBgra;
+                    _rgbToBgra = Avx512bw::RgbToBgra;
+                    break;
+                case SimdPixelFormatRgb24:
+                    _grayToAny = Avx512bw::GrayToBgr;
+                    break;
+                case SimdPixelFormatRgba32:
+                    _grayToBgra = Avx512bw::GrayToBgra;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,80 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdAvx512bw.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) 
+    namespace Avx512bw
+    {
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst)
+        {
+            size_t sizeA = AlignLo(size, A), i = 0;
+            for (; i < sizeA; i += A)
+            {
+                __m512i _src = _mm512_loadu_si512((__m512i*)(src + i));
+                __m512i _prev = _mm512_loadu_si512((__m512i*)(prev + i));
+                _mm512_storeu_si512((__m512i*)(dst + i), _mm512_add_epi8(_src, _prev));
+            }
+            if (i < size)
+            {
+                __mmask64 tail = TailMask64(size - i);
+                __m512i _src = _mm512_maskz_loadu_epi8(tail, src + i);
+                __m512i _prev = _mm512_maskz_loadu_epi8(tail, prev + i);
+                _mm512_mask_storeu_epi8(dst + i, tail, _mm512_add_epi8(_src, _prev));
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        ImagePngLoader::ImagePngLoader(const ImageLoaderParam& param)
+            : Avx2::ImagePngLoader(param)
+        {
+            _decodeLine[2] = PngDecodeLineUp;
+        }
+
+        void ImagePngLoader::SetConverters()
+        {
+            Avx2::ImagePngLoader::SetConverters();
+            if (_width >= A)
+            {
+                _rgbToBgr = Avx512bw::BgrToRgb;
+                _reorder16 = Avx512bw::Reorder16bit;
+                switch (_param.format)
+                {
+                case SimdPixelFormatGray8: _rgbaToAny = Avx512bw::RgbaToGray; break;
+                case SimdPixelFormatBgr24: _rgbaToAny = Avx512bw::BgraToRgb; break;
+                case SimdPixelFormatBgra32: _rgbaToAny = Avx512bw::BgraToRgba; break;
+                case SimdPixelFormatRgb24: _rgbaToAny = Avx512bw::BgraToBgr; break;
+                default: break;
+                }
+            }
+        }
+    }
+#endif
+}
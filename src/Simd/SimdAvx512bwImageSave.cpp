@@ -56,6 +56,7 @@ namespace Simd
             case SimdPixelFormatBgra32: _convert = Avx512bw::BgraToGray; break;
             case SimdPixelFormatRgb24: _convert = Avx512bw::RgbToGray; break;
             case SimdPixelFormatRgba32: _convert = Avx512bw::RgbaToGray; break;
+            case SimdPixelFormatInt16: _reorder = Avx512bw::Reorder16bit; break;
             default: break;
             }
         }
@@ -102,6 +103,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinSaver(param);
             case SimdImageFilePng: return new ImagePngSaver(param);
             case SimdImageFileJpeg: return new ImageJpegSaver(param);
+            case SimdImageFilePfm: return new Base::ImagePfmSaver(param);
             default:
                 return NULL;
             }
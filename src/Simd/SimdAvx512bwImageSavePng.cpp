@@ -75,9 +75,7 @@ namespace Simd
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(0, 1);
             stream.WriteBits(1, 2);
 
             int i = 0, j;
@@ -147,8 +145,6 @@ namespace Simd
             for (; i < size; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
-            stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -387,6 +383,8 @@ namespace Simd
                 _convert = Avx512bw::BgrToRgb;
             else if (_param.format == SimdPixelFormatBgra32)
                 _convert = Avx512bw::BgraToRgba;
+            else if (_param.format == SimdPixelFormatInt16)
+                _reorder = Avx512bw::Reorder16bit;
             _encode[0] = Avx512bw::EncodeLine0;
             _encode[1] = Avx512bw::EncodeLine1;
             _encode[2] = Avx512bw::EncodeLine2;
@@ -394,7 +392,9 @@ namespace Simd
             _encode[4] = Avx512bw::EncodeLine4;
             _encode[5] = Avx512bw::EncodeLine5;
             _encode[6] = Avx512bw::EncodeLine6;
-            _compress = Avx512bw::ZlibCompress;
+            if (_level > COMPRESSION_GREEDY)
+                _compress = Avx512bw::ZlibCompress;
+            _adler32 = Avx512bw::ZlibAdler32;
         }
     }
 #endif// SIMD_AVX512BW_ENABLE
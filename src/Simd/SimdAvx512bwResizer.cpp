@@ -45,10 +45,14 @@ namespace Simd
                 return new ResizerFloatBilinear(param);
             else if (param.IsByteBicubic())
                 return new ResizerByteBicubic(param);
+            else if (param.IsByteLanczos3())
+                return new ResizerByteLanczos3(param);
             else if (param.IsByteArea2x2())
                 return new ResizerByteArea2x2(param);
             else if (param.IsByteArea1x1())
                 return new ResizerByteArea1x1(param);
+            else if (param.IsShortBicubic() || param.IsFloatBicubic() || param.IsShortArea() || param.IsFloatArea())
+                return new ResizerFloatFilter(param);
             else
                 return Avx2::ResizerInit(srcX, srcY, dstX, dstY, channels, type, method);
         }
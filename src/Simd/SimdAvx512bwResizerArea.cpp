@@ -136,7 +136,9 @@ namespace Simd
             int32_t ay0 = ay[0], ax0 = ax[0];
             size_t rowSizeA = AlignLo(rowSize, A);
             __mmask64 tail = TailMask64(rowSize - rowSizeA);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += rowRest)
+            src += iy[_yBeg] * srcStride;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += rowRest)
             {
                 int32_t * buf = _by.data;
                 size_t yn = iy[dy + 1] - iy[dy];
@@ -302,7 +304,9 @@ namespace Simd
             size_t bodyW = _param.dstW - (N == 3 ? 1 : 0), rowSize = _param.srcW * N, rowRest = dstStride - _param.dstW * N;
             const int32_t* iy = _iy.data, * ix = _ix.data, * ay = _ay.data, * ax = _ax.data;
             int32_t ay0 = ay[0], ax0 = ax[0];
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += rowRest)
+            src += iy[_yBeg] * 2 * srcStride;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += rowRest)
             {
                 int32_t* buf = _by.data;
                 size_t yn = (iy[dy + 1] - iy[dy]) * 2;
@@ -137,7 +137,8 @@ namespace Simd
             assert(_xn == 0 && _xt == _param.dstW);
             size_t step = 4 / N * 4;
             size_t body = AlignLoAny(_param.dstW, step);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -191,7 +192,8 @@ namespace Simd
             size_t step = 16;
             size_t body = AlignLoAny(_param.dstW, step);
             __mmask16 tail = TailMask16(_param.dstW - body);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -251,7 +253,8 @@ namespace Simd
             size_t step = 8;
             size_t body = AlignLoAny(_param.dstW, step);
             __mmask8 tail = TailMask8(_param.dstW - body);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -322,7 +325,8 @@ namespace Simd
             srcMaskTail[3] = tail > 3 ? 0x7 : 0x0;
             srcMaskTail[4] = TailMask8(tail);
             __mmask16 dstMaskTail = TailMask16(tail * 3);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -392,7 +396,8 @@ namespace Simd
             srcMaskTail[3] = tail > 3 ? 0xF : 0x0;
             srcMaskTail[4] = TailMask8(tail);
             __mmask16 dstMaskTail = TailMask16(tail * 4);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -516,8 +521,9 @@ namespace Simd
             size_t rowBody = AlignLo(_bx[0].size, F);
             __mmask16 rowTail = TailMask16(_bx[0].size - rowBody);
 
-            int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            int32_t prev = _iy[_yBeg] - 1;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 int32_t sy = _iy[dy], next = prev;
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
@@ -571,8 +577,9 @@ namespace Simd
             size_t rowBody = AlignLo(_bx[0].size, F);
             __mmask16 rowTail = TailMask16(_bx[0].size - rowBody);
 
-            int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            int32_t prev = _iy[_yBeg] - 1;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 int32_t sy = _iy[dy], next = prev;
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
@@ -219,7 +219,8 @@ namespace Simd
             const int32_t * ix = _ix.data;
             size_t dstW = _param.dstW;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm512_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm512_set1_epi16(int16_t(_ay[yDst]));
@@ -265,7 +266,8 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const Idx * ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm512_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm512_set1_epi16(int16_t(_ay[yDst]));
@@ -425,7 +427,8 @@ namespace Simd
             size_t rs32 = AlignLo(rs, 32);
             __mmask16 tail16 = TailMask16(rs - rs16);
             __m512 _1 = _mm512_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -555,7 +558,8 @@ namespace Simd
             size_t rs32 = AlignLo(rs, 32);
             __mmask16 tail16 = TailMask16(rs - rs16);
             __m512 _1 = _mm512_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -737,7 +741,8 @@ namespace Simd
             int32_t prev = -2;
             size_t rsa = AlignLo(rs, Avx512bw::F);
             __mmask16 tail = TailMask16(rs - rsa);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
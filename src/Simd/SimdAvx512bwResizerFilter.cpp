@@ -0,0 +1,110 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdResizer.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX512BW_ENABLE 
+    namespace Avx512bw
+    {
+        ResizerFloatFilter::ResizerFloatFilter(const ResParam& param)
+            : Avx2::ResizerFloatFilter(param)
+        {
+        }
+
+        SIMD_INLINE __m512 FilterLoad(const float* src, __mmask16 tail = -1)
+        {
+            return _mm512_maskz_loadu_ps(tail, src);
+        }
+
+        SIMD_INLINE __m512 FilterLoad(const uint16_t* src, __mmask16 tail = -1)
+        {
+            return _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(tail, src)));
+        }
+
+        template<class T> SIMD_INLINE void FilterRowY(const T* src, size_t srcStride, size_t size, const float* ay, size_t ky, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __mmask16 tail = TailMask16(size - sizeF);
+            __m512 ay0 = _mm512_set1_ps(ay[0]);
+            for (; i < sizeF; i += F)
+                _mm512_storeu_ps(dst + i, _mm512_mul_ps(FilterLoad(src + i), ay0));
+            if (tail)
+                _mm512_mask_storeu_ps(dst + i, tail, _mm512_mul_ps(FilterLoad(src + i, tail), ay0));
+            for (size_t k = 1; k < ky; ++k)
+            {
+                src += srcStride;
+                __m512 ayk = _mm512_set1_ps(ay[k]);
+                for (i = 0; i < sizeF; i += F)
+                    _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(FilterLoad(src + i), ayk, _mm512_loadu_ps(dst + i)));
+                if (tail)
+                    _mm512_mask_storeu_ps(dst + i, tail, _mm512_fmadd_ps(FilterLoad(src + i, tail), ayk, _mm512_maskz_loadu_ps(tail, dst + i)));
+            }
+        }
+
+        SIMD_INLINE void FilterStore(const float* src, uint16_t* dst, __mmask16 tail = -1)
+        {
+            __m512i i32 = _mm512_cvtps_epi32(_mm512_maskz_loadu_ps(tail, src));
+            _mm256_mask_storeu_epi16(dst, tail, _mm512_cvtusepi32_epi16(_mm512_max_epi32(i32, _mm512_setzero_si512())));
+        }
+
+        SIMD_INLINE void FilterStore(const float* src, size_t size, uint16_t* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __mmask16 tail = TailMask16(size - sizeF);
+            for (; i < sizeF; i += F)
+                FilterStore(src + i, dst + i);
+            if (tail)
+                FilterStore(src + i, dst + i, tail);
+        }
+
+        template<class T> void ResizerFloatFilter::RunB(const T* src, size_t srcStride, T* dst, size_t dstStride)
+        {
+            size_t sw = _param.srcW * _param.channels, dw = _param.dstW * _param.channels;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                FilterRowY(src + _iy[dy] * srcStride, srcStride, sw, _ay.data + dy * _ky, _ky, _by.data);
+                if (_param.type == SimdResizeChannelFloat)
+                    RowX((float*)dst);
+                else
+                {
+                    RowX(_bx.data);
+                    FilterStore(_bx.data, dw, (uint16_t*)dst);
+                }
+            }
+        }
+
+        void ResizerFloatFilter::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            if (_param.type == SimdResizeChannelFloat)
+                RunB((const float*)src, srcStride / sizeof(float), (float*)dst, dstStride / sizeof(float));
+            else
+                RunB((const uint16_t*)src, srcStride / sizeof(uint16_t), (uint16_t*)dst, dstStride / sizeof(uint16_t));
+        }
+    }
+#endif //SIMD_AVX512BW_ENABLE 
+}
@@ -0,0 +1,84 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdResizer.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX512BW_ENABLE 
+    namespace Avx512bw
+    {
+        ResizerByteLanczos3::ResizerByteLanczos3(const ResParam& param)
+            : Avx2::ResizerByteLanczos3(param)
+        {
+        }
+
+        SIMD_INLINE void Lanczos3RowInt(const int32_t* const* src, const __m512i* ay, size_t i, uint8_t* dst, __mmask16 tail = -1)
+        {
+            __m512i sum = _mm512_set1_epi32(Base::BICUBIC_ROUND);
+            for (int k = 0; k < 6; ++k)
+                sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(_mm512_maskz_loadu_epi32(tail, src[k] + i), ay[k]));
+            sum = _mm512_srai_epi32(sum, Base::BICUBIC_SHIFT);
+            _mm_mask_storeu_epi8(dst + i, tail, _mm512_cvtusepi32_epi8(_mm512_max_epi32(sum, _mm512_setzero_si512())));
+        }
+
+        SIMD_INLINE void Lanczos3RowInt(const int32_t* const* src, size_t n, const int32_t* ay, uint8_t* dst)
+        {
+            size_t nF = AlignLo(n, F), i = 0;
+            __mmask16 tail = TailMask16(n - nF);
+            __m512i _ay[6];
+            for (int k = 0; k < 6; ++k)
+                _ay[k] = _mm512_set1_epi32(ay[k]);
+            for (; i < nF; i += F)
+                Lanczos3RowInt(src, _ay, i, dst);
+            if (tail)
+                Lanczos3RowInt(src, _ay, i, dst, tail);
+        }
+
+        void ResizerByteLanczos3::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            int32_t prev = -2;
+            const int32_t* pb[6];
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                int32_t sy = _iy[dy];
+                for (int32_t curr = Max(sy - 2, prev); curr < sy + 4; ++curr)
+                    RowSumX(src + RestrictRange(curr, 0, (int)_param.srcH - 1) * srcStride, _bx[(curr + 2) & 7].data);
+                prev = sy + 4;
+                for (int k = 0; k < 6; ++k)
+                    pb[k] = _bx[(sy + k) & 7].data;
+                Lanczos3RowInt(pb, _param.dstW * _param.channels, _ay.data + dy * 6, dst);
+            }
+        }
+
+        void ResizerByteLanczos3::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Init();
+            RunB(src, srcStride, dst, dstStride);
+        }
+    }
+#endif //SIMD_AVX512BW_ENABLE 
+}
@@ -94,7 +94,8 @@ namespace Simd
         {
             size_t body = AlignLo(_param.dstW, F);
             __mmask16 tail = TailMask16(_param.dstW - body);
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const int32_t* srcRow = (int32_t*)(src + _iy[dy] * srcStride);
                 size_t dx = 0;
@@ -117,7 +118,8 @@ namespace Simd
         {
             size_t body = AlignLo(_param.dstW, 8);
             size_t tail = _param.dstW - 8;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const int64_t* srcRow = (int64_t*)(src + _iy[dy] * srcStride);
                 for (size_t dx = 0; dx < body; dx += 8)
@@ -130,7 +132,8 @@ namespace Simd
         void ResizerNearest::Shuffle32x2(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
             size_t body = _blocks - _tails;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t* srcRow = src + _iy[dy] * srcStride;
                 size_t i = 0, t = 0;
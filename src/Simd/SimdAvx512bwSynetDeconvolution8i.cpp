@@ -0,0 +1,192 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetDeconvolution8i.h"
+#include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdAvx512bw.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_SYNET_ENABLE)  
+    namespace Avx512bw
+    {
+        static void RowToImgSum(const float* src, const DeconvParam8i& p, float* dst)
+        {
+            size_t C = p.dstC, CF = AlignLo(C, F);
+            __mmask16 tail = TailMask16(C - CF);
+            memset(dst, 0, p.dstH * p.dstW * C * sizeof(float));
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx)
+                {
+                    size_t dy = sy * p.strideY - p.padY;
+                    for (size_t ky = 0; ky < p.kernelY; ky++, dy += p.dilationY)
+                    {
+                        if (dy < p.dstH)
+                        {
+                            size_t dx = sx * p.strideX - p.padX;
+                            for (size_t kx = 0; kx < p.kernelX; kx++, dx += p.dilationX)
+                            {
+                                if (dx < p.dstW)
+                                {
+                                    float* d = dst + (dy * p.dstW + dx) * C;
+                                    size_t c = 0;
+                                    for (; c < CF; c += F)
+                                        _mm512_storeu_ps(d + c, _mm512_add_ps(_mm512_loadu_ps(d + c), _mm512_loadu_ps(src + c)));
+                                    if (c < C)
+                                        _mm512_mask_storeu_ps(d + c, tail, _mm512_add_ps(_mm512_maskz_loadu_ps(tail, d + c), _mm512_maskz_loadu_ps(tail, src + c)));
+                                }
+                                src += C;
+                            }
+                        }
+                        else
+                            src += p.kernelX * C;
+                    }
+                }
+            }
+        }
+
+        SynetDeconvolution8iGemm::SynetDeconvolution8iGemm(const DeconvParam8i& p, ConvolutionInitPtr init)
+            : Base::SynetDeconvolution8iGemm(p, init)
+        {
+            _convertDst = Avx512bw::SynetConvert32fTo8u;
+            _biasAndActivation = Avx512bw::ConvolutionBiasAndActivation;
+            if (!p.IsTiled())
+                _rowToImg = RowToImgSum;
+        }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE __m512i LoadU8(const uint8_t* src, __mmask16 tail = -1)
+        {
+            return _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(tail, src));
+        }
+
+        SIMD_INLINE __m512i LoadI8(const int8_t* src, __mmask16 tail = -1)
+        {
+            return _mm512_cvtepi8_epi32(_mm_maskz_loadu_epi8(tail, src));
+        }
+
+        SIMD_INLINE void Deconvolution(const uint8_t* src, const uint8_t* zero, const int8_t* weight, int32_t* dst, __mmask16 tail = -1)
+        {
+            __m512i s = _mm512_sub_epi32(LoadU8(src, tail), LoadU8(zero, tail));
+            __m512i sum = _mm512_maskz_loadu_epi32(tail, dst);
+            _mm512_mask_storeu_epi32(dst, tail, _mm512_add_epi32(sum, _mm512_mullo_epi32(s, LoadI8(weight, tail))));
+        }
+
+        static void DeconvolutionNhwcDepthwise(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst)
+        {
+            size_t CA = AlignLo(p.srcC, F);
+            __mmask16 tail = TailMask16(p.srcC - CA);
+            size_t C = p.srcC;
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx, src += C)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                        if (dy >= p.dstH)
+                            continue;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                        {
+                            size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                            if (dx >= p.dstW)
+                                continue;
+                            int32_t* d = dst + (dy * p.dstW + dx) * C;
+                            const int8_t* w = weight + (ky * p.kernelX + kx) * C;
+                            size_t c = 0;
+                            for (; c < CA; c += F)
+                                Deconvolution(src + c, zero + c, w + c, d + c);
+                            if (c < C)
+                                Deconvolution(src + c, zero + c, w + c, d + c, tail);
+                        }
+                    }
+                }
+            }
+        }
+
+        static void DeconvolutionNhwcGroup(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst)
+        {
+            size_t G = p.group, C = p.srcC / G, D = p.dstC / G, DF = AlignLo(D, F), K = p.kernelY * p.kernelX;
+            __mmask16 tail = TailMask16(D - DF);
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx, src += p.srcC)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                        if (dy >= p.dstH)
+                            continue;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                        {
+                            size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                            if (dx >= p.dstW)
+                                continue;
+                            int32_t* d = dst + (dy * p.dstW + dx) * p.dstC;
+                            const int8_t* w = weight + (ky * p.kernelX + kx) * D;
+                            for (size_t g = 0; g < G; ++g, d += D)
+                            {
+                                for (size_t c = 0, gc = g * C; c < C; ++c, ++gc)
+                                {
+                                    int s = int(src[gc]) - int(zero[gc]);
+                                    const int8_t* wc = w + gc * K * D;
+                                    __m512i _s = _mm512_set1_epi32(s);
+                                    size_t i = 0;
+                                    for (; i < DF; i += F)
+                                        _mm512_storeu_si512(d + i, _mm512_add_epi32(_mm512_loadu_si512(d + i), _mm512_mullo_epi32(_s, LoadI8(wc + i))));
+                                    if (i < D)
+                                        _mm512_mask_storeu_epi32(d + i, tail, _mm512_add_epi32(_mm512_maskz_loadu_epi32(tail, d + i), _mm512_mullo_epi32(_s, LoadI8(wc + i, tail))));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        SynetDeconvolution8iNhwcDirect::SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p)
+            : Avx2::SynetDeconvolution8iNhwcDirect(p)
+        {
+            _convertSrc = Avx512bw::SynetConvert32fTo8u;
+            _convertDst = Avx512bw::SynetConvert32fTo8u;
+            _biasAndActivation = Avx512bw::ConvolutionBiasAndActivation;
+            _deconvolution = p.IsDepthwise() ? DeconvolutionNhwcDepthwise : DeconvolutionNhwcGroup;
+        }
+
+        //---------------------------------------------------------------------
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
+        {
+            DeconvParam8i param(batch, conv, compatibility);
+            if (!param.Valid())
+                return NULL;
+            if (SynetDeconvolution8iNhwcDirect::Preferable(param))
+                return new SynetDeconvolution8iNhwcDirect(param);
+            return new SynetDeconvolution8iGemm(param);
+        }
+    }
+#endif
+}
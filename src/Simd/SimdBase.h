@@ -36,6 +36,8 @@ namespace Simd
 
         void SetThreadNumber(size_t threadNumber);
 
+        void ParallelFor(size_t begin, size_t end, SimdParallelTaskPtr task, void * context, size_t threadNumber, size_t blockAlign);
+
         uint32_t Crc32(const void* src, size_t size);
 
         uint32_t Crc32c(const void * src, size_t size);
@@ -584,6 +586,8 @@ namespace Simd
         void SynetAdd8i(const uint8_t* aData, const float* aScale, const float* aShift, const uint8_t* bData, const float* bScale, const float* bShift,
             uint8_t* cData, const float* cScale, const float* cShift, size_t batch, size_t channels, size_t spatial, SimdTensorFormatType format, SimdSynetCompatibilityType compatibility);
 
+        size_t SynetArenaPlan(const size_t* sizes, const size_t* begins, const size_t* ends, size_t count, size_t align, size_t* offsets);
+
         void SynetConvert32fTo8u(const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility);
 
         void SynetConvert8uTo32f(const uint8_t* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, float* dst, SimdSynetCompatibilityType compatibility);
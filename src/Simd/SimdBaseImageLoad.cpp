@@ -25,8 +25,23 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 #include <stdio.h>
+#include <atomic>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define SIMD_IMAGE_LOAD_MMAP
+#endif
 
 #if defined(_MSC_VER)
 #pragma warning (push)
@@ -35,8 +50,86 @@
 
 namespace Simd
 {
+    class InputFileMapping
+    {
+    public:
+        static const size_t MIN_SIZE = 1024 * 1024;
+
+        InputFileMapping(const char* path)
+            : _data(NULL)
+            , _size(0)
+        {
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (file == INVALID_HANDLE_VALUE)
+                return;
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(file, &size) && (ULONGLONG)size.QuadPart >= (ULONGLONG)MIN_SIZE && (ULONGLONG)size.QuadPart <= (ULONGLONG)SIZE_MAX)
+            {
+                HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping)
+                {
+                    _data = (const uint8_t*)::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    if (_data)
+                        _size = (size_t)size.QuadPart;
+                    ::CloseHandle(mapping);
+                }
+            }
+            ::CloseHandle(file);
+#elif defined(SIMD_IMAGE_LOAD_MMAP)
+            int file = ::open(path, O_RDONLY);
+            if (file == -1)
+                return;
+            struct stat info;
+            if (::fstat(file, &info) == 0 && S_ISREG(info.st_mode) && (size_t)info.st_size >= MIN_SIZE)
+            {
+                void* data = ::mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+                if (data != MAP_FAILED)
+                {
+#if defined(POSIX_MADV_SEQUENTIAL)
+                    ::posix_madvise(data, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+                    _data = (const uint8_t*)data;
+                    _size = (size_t)info.st_size;
+                }
+            }
+            ::close(file);
+#endif
+        }
+
+        ~InputFileMapping()
+        {
+            if (_data)
+            {
+#if defined(_WIN32)
+                ::UnmapViewOfFile(_data);
+#elif defined(SIMD_IMAGE_LOAD_MMAP)
+                ::munmap((void*)_data, _size);
+#endif
+            }
+        }
+
+        const uint8_t* Data() const
+        {
+            return _data;
+        }
+
+        size_t Size() const
+        {
+            return _size;
+        }
+
+    private:
+        const uint8_t* _data;
+        size_t _size;
+    };
+
     uint8_t* ImageLoadFromFile(const ImageLoadFromMemoryPtr loader, const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
     {
+        InputFileMapping mapping(path);// small files are read into buffer: mapping is not profitable for them.
+        if (mapping.Data())
+            return loader(mapping.Data(), mapping.Size(), stride, width, height, format);
+
         uint8_t* data = NULL;
         ::FILE* file = ::fopen(path, "rb");
         if (file)
@@ -58,6 +151,9 @@ namespace Simd
         , size(s)
         , format(f)
         , file(SimdImageFileUndefined)
+        , scale(1)
+        , planes(1)
+        , yuvType(SimdYuvUnknown)
     {
     }
 
@@ -75,6 +171,8 @@ namespace Simd
                     file = SimdImageFilePgmBin;
                 if (data[1] == '6')
                     file = SimdImageFilePpmBin;
+                if (data[1] == 'f')
+                    file = SimdImageFilePfm;
             }
         }
         if (size >= 8)
@@ -88,11 +186,130 @@ namespace Simd
             if (data[0] == 0xFF && data[1] == 0xD8)
                 file = SimdImageFileJpeg;
         }
+        if (file == SimdImageFileUndefined)
+            return false;
+        if (file == SimdImageFilePfm)
+        {
+            if (format != SimdPixelFormatNone && format != SimdPixelFormatFloat)
+                return false;
+        }
+        else if (format == SimdPixelFormatInt16)
+        {
+            if (file != SimdImageFilePgmBin && file != SimdImageFilePng)
+                return false;
+        }
+        else if (format != SimdPixelFormatNone && format != SimdPixelFormatGray8 &&
+            format != SimdPixelFormatBgr24 && format != SimdPixelFormatBgra32 &&
+            format != SimdPixelFormatRgb24 && format != SimdPixelFormatRgba32)
+            return false;
         return
-            file != SimdImageFileUndefined && 
-                (format == SimdPixelFormatNone || format == SimdPixelFormatGray8 || 
-                format == SimdPixelFormatBgr24 || format == SimdPixelFormatBgra32 || 
-                format == SimdPixelFormatRgb24 || format == SimdPixelFormatRgba32);
+            (scale == 1 || scale == 2 || scale == 4 || scale == 8) &&
+            (planes == 1 || (file == SimdImageFileJpeg && (planes == 2 || planes == 3) && yuvType == SimdYuvTrect871));
+    }
+
+    uint8_t* ImageLoadFromMemory(const CreateImageLoaderPtr create, ImageLoaderParam& param, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
+    {
+        if (param.Validate())
+        {
+            Holder<ImageLoader> loader(create(param));
+            if (loader)
+            {
+                if (loader->FromStream())
+                    return loader->Release(stride, width, height, format);
+            }
+        }
+        return NULL;
+    }
+
+    uint8_t* ImageLoadPlanesFromMemory(const CreateImageLoaderPtr create, ImageLoaderParam& param, size_t* width, size_t* height,
+        uint8_t** y, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride)
+    {
+        if (param.Validate() && param.file == SimdImageFileJpeg)
+        {
+            Holder<ImageLoader> loader(create(param));
+            if (loader)
+            {
+                if (loader->FromStream())
+                    return static_cast<Base::ImageJpegLoader*>(&*loader)->ReleasePlanes(width, height, y, yStride, u, uStride, v, vStride);
+            }
+        }
+        return NULL;
+    }
+
+    //-------------------------------------------------------------------------
+
+    ImageDecoder::ImageDecoder(const CreateImageLoaderPtr create, SimdPixelFormatType format)
+        : _create(create)
+        , _format(format)
+    {
+        for (size_t i = 0; i <= SimdImageFilePfm; ++i)
+            _loaders[i] = NULL;
+    }
+
+    ImageDecoder::~ImageDecoder()
+    {
+        for (size_t i = 0; i <= SimdImageFilePfm; ++i)
+            if (_loaders[i])
+                delete _loaders[i];
+        for (size_t i = 0; i < _workers.size(); ++i)
+            delete _workers[i];
+    }
+
+    ImageLoader* ImageDecoder::Loader(const uint8_t* data, size_t size)
+    {
+        ImageLoaderParam param(data, size, _format);
+        if (!param.Validate())
+            return NULL;
+        ImageLoader*& loader = _loaders[param.file];
+        if (loader)
+            loader->SetData(data, size);
+        else
+            loader = _create(param);
+        return loader;
+    }
+
+    bool ImageDecoder::Probe(const uint8_t* data, size_t size, size_t* width, size_t* height, SimdPixelFormatType* format)
+    {
+        ImageLoader* loader = Loader(data, size);
+        if (loader && loader->Probe(width, height))
+        {
+            *format = loader->Format();
+            return true;
+        }
+        return false;
+    }
+
+    bool ImageDecoder::Decode(const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height)
+    {
+        ImageLoader* loader = Loader(data, size);
+        if (loader == NULL || dst == NULL || stride < width * Image::PixelSize((Image::Format)loader->Format()))
+            return false;
+        loader->SetTarget(dst, stride, width, height);
+        bool result = loader->FromStream();
+        loader->SetTarget(NULL, 0, 0, 0);
+        return result;
+    }
+
+    size_t ImageDecoder::DecodeBatch(size_t count, const uint8_t* const* data, const size_t* size, uint8_t* const* dst,
+        const size_t* stride, const size_t* width, const size_t* height, SimdBool* status)
+    {
+        size_t threads = Simd::Min(Base::GetThreadNumber(), count);
+        while (_workers.size() + 1 < threads)
+            _workers.push_back(new ImageDecoder(_create, _format));
+        std::atomic<size_t> next(0), decoded(0);
+        Parallel(0, threads, [&](size_t thread, size_t begin, size_t end)
+        {
+            ImageDecoder* decoder = thread ? _workers[thread - 1] : this;
+            for (size_t i = next++; i < count; i = next++)
+            {
+                bool result = decoder->Decode(data[i], size[i], dst[i], stride[i], width[i], height[i]);
+                if (status)
+                    status[i] = result ? SimdTrue : SimdFalse;
+                if (result)
+                    decoded++;
+            }
+        }, threads);
+        return decoded;
     }
         
     namespace Base
@@ -101,34 +318,59 @@ namespace Simd
             : ImageLoader(param)
             , _toAny(NULL)
             , _toBgra(NULL)
+            , _reorder(NULL)
+            , _max(255)
         {
         }
 
-        bool ImagePxmLoader::ReadHeader(size_t version)
+        bool ImagePxmLoader::Probe(size_t* width, size_t* height)
+        {
+            uint32_t w, h;
+            if (!ReadSize(w, h))
+                return false;
+            *width = w;
+            *height = h;
+            return true;
+        }
+
+        bool ImagePxmLoader::ReadSize(uint32_t& width, uint32_t& height)
         {
-            if (_stream.Size() < 3 ||
-                _stream.Data()[0] != 'P' ||
-                _stream.Data()[1] != '0' + version ||
-                _stream.Data()[2] != '\n')
+            if (_stream.Size() < 3 || _stream.Data()[0] != 'P' || _stream.Data()[2] != '\n')
                 return false;
             _stream.Seek(3);
-            uint32_t width, height, max;
-            if (!(_stream.ReadUnsigned(width) && _stream.ReadUnsigned(height) && _stream.ReadUnsigned(max)))
+            if (!(_stream.ReadUnsigned(width) && _stream.ReadUnsigned(height) && _stream.ReadUnsigned(_max)))
                 return false;
-            if (!(width > 0 && height > 0 && max == 255))
+            if (!(width > 0 && height > 0 && (_max == 255 || (_stream.Data()[1] == '5' && _max > 255 && _max < 65536))))
                 return false;
             uint8_t byte;
-            if (!(_stream.Read(byte) && byte == '\n'))
+            return _stream.Read(byte) && byte == '\n';
+        }
+
+        bool ImagePxmLoader::ReadHeader(size_t version)
+        {
+            uint32_t width, height;
+            if (_stream.Size() < 3 || _stream.Data()[1] != '0' + version || !ReadSize(width, height))
+                return false;
+            if (!InitImage(width, height))
                 return false;
-            _image.Recreate(width, height, (Image::Format)_param.format);
             _block = height;
             if (_param.file == SimdImageFilePgmTxt || _param.file == SimdImageFilePgmBin)
             {
-                _size = width * 1;
-                if (_param.format != SimdPixelFormatGray8)
+                _size = width * (_max > 255 ? 2 : 1);
+                if (_param.format == SimdPixelFormatInt16)
                 {
-                    _block = Simd::RestrictRange<size_t>(Base::AlgCacheL1() / _size, 1, height);
-                    _buffer.Resize(_block * _size);
+                    if (_max == 255)
+                        _buffer.Resize(_size);
+                }
+                else
+                {
+                    if (_param.format != SimdPixelFormatGray8)
+                    {
+                        _block = Simd::RestrictRange<size_t>(Base::AlgCacheL1() / width, 1, height);
+                        _buffer.Resize(_block * width);
+                    }
+                    if (_max > 255)
+                        _line.Resize(_size);
                 }
             }
             else if (_param.file == SimdImageFilePpmTxt || _param.file == SimdImageFilePpmBin)
@@ -207,21 +449,49 @@ namespace Simd
         {
             if (!ReadHeader(5))
                 return false;
-            size_t grayStride = _param.format == SimdPixelFormatGray8 ? _image.stride : _size;
+            if (_param.format == SimdPixelFormatInt16)
+            {
+                for (size_t row = 0; row < _image.height; ++row)
+                {
+                    uint16_t* dst = _image.Row<uint16_t>(row);
+                    if (_max > 255)
+                    {
+                        if (_stream.Read(_size, dst) != _size)
+                            return false;
+                        _reorder((uint8_t*)dst, _size, (uint8_t*)dst);
+                    }
+                    else
+                    {
+                        if (_stream.Read(_size, _buffer.data) != _size)
+                            return false;
+                        for (size_t col = 0; col < _image.width; ++col)
+                            dst[col] = _buffer[col] * 257;
+                    }
+                }
+                return true;
+            }
+            size_t grayStride = _param.format == SimdPixelFormatGray8 ? _image.stride : _image.width;
             for (size_t row = 0; row < _image.height;)
             {
                 size_t block = Simd::Min(row + _block, _image.height) - row;
                 uint8_t* gray = _param.format == SimdPixelFormatGray8 ? _image.Row<uint8_t>(row) : _buffer.data;
                 for (size_t b = 0; b < block; ++b)
                 {
-                    if (_stream.Read(_size, gray) != _size)
+                    if (_max > 255)
+                    {
+                        if (_stream.Read(_size, _line.data) != _size)
+                            return false;
+                        for (size_t col = 0, half = _max / 2; col < _image.width; ++col)
+                            gray[col] = uint8_t(((_line[2 * col] << 8 | _line[2 * col + 1]) * 255 + half) / _max);
+                    }
+                    else if (_stream.Read(_size, gray) != _size)
                         return false;
                     gray += grayStride;
                 }
                 if (_param.format == SimdPixelFormatBgr24 || _param.format == SimdPixelFormatRgb24)
-                    _toAny(_buffer.data, _image.width, block, _size, _image.Row<uint8_t>(row), _image.stride);
+                    _toAny(_buffer.data, _image.width, block, _image.width, _image.Row<uint8_t>(row), _image.stride);
                 if (_param.format == SimdPixelFormatBgra32 || _param.format == SimdPixelFormatRgba32)
-                    _toBgra(_buffer.data, _image.width, block, _size, _image.Row<uint8_t>(row), _image.stride, 0xFF);
+                    _toBgra(_buffer.data, _image.width, block, _image.width, _image.Row<uint8_t>(row), _image.stride, 0xFF);
                 row += block;
             }
             return true;
@@ -235,6 +505,7 @@ namespace Simd
             case SimdPixelFormatBgra32: _toBgra = Base::GrayToBgra; break;
             case SimdPixelFormatRgb24: _toAny = Base::GrayToBgr; break;
             case SimdPixelFormatRgba32: _toBgra = Base::GrayToBgra; break;
+            case SimdPixelFormatInt16: _reorder = Base::Reorder16bit; break;
             default: break;
             }
         }
@@ -334,6 +605,72 @@ namespace Simd
 
         //-------------------------------------------------------------------------
 
+        ImagePfmLoader::ImagePfmLoader(const ImageLoaderParam& param)
+            : ImageLoader(param)
+            , _reorder(NULL)
+            , _bigEndian(false)
+        {
+            if (_param.format == SimdPixelFormatNone)
+                _param.format = SimdPixelFormatFloat;
+        }
+
+        bool ImagePfmLoader::Probe(size_t* width, size_t* height)
+        {
+            uint32_t w, h;
+            if (!ReadHeader(w, h))
+                return false;
+            *width = w;
+            *height = h;
+            return true;
+        }
+
+        bool ImagePfmLoader::ReadHeader(uint32_t& width, uint32_t& height)
+        {
+            if (_stream.Size() < 3 || _stream.Data()[0] != 'P' || _stream.Data()[1] != 'f' || _stream.Data()[2] != '\n')
+                return false;
+            _stream.Seek(3);
+            if (!(_stream.ReadUnsigned(width) && _stream.ReadUnsigned(height) && width > 0 && height > 0 && _stream.SkipGap()))
+                return false;
+            _bigEndian = _stream.Current()[0] != '-';
+            if (!_stream.SkipNotGap())
+                return false;
+            uint8_t byte;
+            return _stream.Read(byte) && InputMemoryStream::IsGap(byte);
+        }
+
+        bool ImagePfmLoader::FromStream()
+        {
+            uint32_t width, height;
+            if (!ReadHeader(width, height))
+                return false;
+            size_t size = width * 4;
+            if (!(_stream.CanRead(size * height) && InitImage(width, height)))
+                return false;
+            SetConverters();
+#if defined(SIMD_BIG_ENDIAN)
+            bool reorder = !_bigEndian;
+#else
+            bool reorder = _bigEndian;
+#endif
+            const uint8_t* src = _stream.Current() + size * height;
+            for (size_t row = 0; row < height; ++row)
+            {
+                src -= size;
+                if (reorder)
+                    _reorder(src, size, _image.Row<uint8_t>(row));
+                else
+                    memcpy(_image.Row<uint8_t>(row), src, size);
+            }
+            return true;
+        }
+
+        void ImagePfmLoader::SetConverters()
+        {
+            _reorder = Base::Reorder32bit;
+        }
+
+        //-------------------------------------------------------------------------
+
         ImageLoader* CreateImageLoader(const ImageLoaderParam& param)
         {
             switch (param.file)
@@ -344,6 +681,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinLoader(param);
             case SimdImageFilePng: return new ImagePngLoader(param);
             case SimdImageFileJpeg: return new ImageJpegLoader(param);
+            case SimdImageFilePfm: return new ImagePfmLoader(param);
             default:
                 return NULL;
             }
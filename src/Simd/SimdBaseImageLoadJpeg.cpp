@@ -25,19 +25,12 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdYuvToBgr.h"
 
 namespace Simd
 {
     namespace Base
     {
-#if defined(SIMD_X64_ENABLE) && !defined(SIMD_SSE41_DISABLE)
-#define JPEG_SSE2
-        static int jpeg__sse2_available(void)
-        {
-            return 1;
-        }
-#endif
-
 #if defined(SIMD_ARM64_ENABLE) && !defined(SIMD_NEON_DISABLE)
 #define JPEG_NEON
 #endif
@@ -201,11 +194,6 @@ namespace Simd
             return a <= INT_MAX / b;
         }
 
-        static int jpeg__mad2sizes_valid(int a, int b, int add)
-        {
-            return jpeg__mul2sizes_valid(a, b) && jpeg__addsizes_valid(a * b, add);
-        }
-
         // returns 1 if "a*b*c + add" has no negative terms/factors and doesn't overflow
         static int jpeg__mad3sizes_valid(int a, int b, int c, int add)
         {
@@ -219,23 +207,6 @@ namespace Simd
                 jpeg__mul2sizes_valid(a * b * c, d) && jpeg__addsizes_valid(a * b * c * d, add);
         }
 
-        static void* jpeg__malloc_mad2(int a, int b, int add)
-        {
-            if (!jpeg__mad2sizes_valid(a, b, add)) return NULL;
-            return jpeg__malloc(a * b + add);
-        }
-
-        static void* jpeg__malloc_mad3(int a, int b, int c, int add)
-        {
-            if (!jpeg__mad3sizes_valid(a, b, c, add)) return NULL;
-            return jpeg__malloc(a * b * c + add);
-        }
-
-        static jpeg_uc jpeg__compute_y(int r, int g, int b)
-        {
-            return (jpeg_uc)(((r * 77) + (g * 150) + (29 * b)) >> 8);
-        }
-
         typedef struct
         {
             int bits_per_channel;
@@ -292,9 +263,10 @@ namespace Simd
 
                 int x, y, w2, h2;
                 jpeg_uc* data;
-                void* raw_data, * raw_coeff;
+                void* raw_data, * raw_coeff, * raw_row_coeff;
                 jpeg_uc* linebuf;
                 short* coeff;   // progressive only
+                short* row_coeff; // baseline only: blocks of one MCU row
                 int      coeff_w, coeff_h; // number of 8x8 coefficient blocks
             } img_comp[4];
 
@@ -316,10 +288,23 @@ namespace Simd
             int scan_n, order[4];
             int restart_interval, todo;
 
+            // DCT scaling: output size of every 8x8 block is block_size x block_size
+            int scale, block_size;
+            int out_x, out_y;
+
+            // component buffers (4 per component) which are kept by loader between images
+            Array8u* scratch;
+
             // kernels
-            void (*idct_block_kernel)(jpeg_uc* out, int out_stride, short data[64]);
-            void (*YCbCr_to_RGB_kernel)(jpeg_uc* out, const jpeg_uc* y, const jpeg_uc* pcb, const jpeg_uc* pcr, int count, int step);
+            void (*idct_blocks_kernel)(const short* data, int count, jpeg_uc* out, int out_stride);
+            jpeg_uc* (*resample_row_v_2_kernel)(jpeg_uc* out, jpeg_uc* in_near, jpeg_uc* in_far, int w, int hs);
+            jpeg_uc* (*resample_row_h_2_kernel)(jpeg_uc* out, jpeg_uc* in_near, jpeg_uc* in_far, int w, int hs);
             jpeg_uc* (*resample_row_hv_2_kernel)(jpeg_uc* out, jpeg_uc* in_near, jpeg_uc* in_far, int w, int hs);
+            void (*yuv_to_any_kernel)(const jpeg_uc* y, const jpeg_uc* u, const jpeg_uc* v, size_t width, jpeg_uc* dst);
+            void (*gray_to_any_kernel)(const jpeg_uc* src, size_t width, size_t height, size_t srcStride, jpeg_uc* dst, size_t dstStride);
+            void (*gray_to_bgra_kernel)(const jpeg_uc* src, size_t width, size_t height, size_t srcStride, jpeg_uc* dst, size_t dstStride, jpeg_uc alpha);
+            void (*rgb_to_any_kernel)(const jpeg_uc* src, size_t width, size_t height, size_t srcStride, jpeg_uc* dst, size_t dstStride);
+            void (*rgb_to_bgra_kernel)(const jpeg_uc* src, size_t width, size_t height, size_t srcStride, jpeg_uc* dst, size_t dstStride, jpeg_uc alpha);
         } jpeg__jpeg;
 
         static int jpeg__build_huffman(jpeg__huffman* h, int* count)
@@ -783,11 +768,11 @@ namespace Simd
    t1 += p2+p4;                                \
    t0 += p1+p3;
 
-        static void jpeg__idct_block(jpeg_uc* out, int out_stride, short data[64])
+        static void jpeg__idct_block(jpeg_uc* out, int out_stride, const short* data)
         {
             int i, val[64], * v = val;
             jpeg_uc* o;
-            short* d = data;
+            const short* d = data;
 
             // columns
             for (i = 0; i < 8; ++i, ++d, ++v) {
@@ -843,192 +828,11 @@ namespace Simd
             }
         }
 
-#ifdef JPEG_SSE2
-        // sse2 integer IDCT. not the fastest possible implementation but it
-        // produces bit-identical results to the generic C version so it's
-        // fully "transparent".
-        static void jpeg__idct_simd(jpeg_uc* out, int out_stride, short data[64])
-        {
-            // This is constructed to match our regular (generic) integer IDCT exactly.
-            __m128i row0, row1, row2, row3, row4, row5, row6, row7;
-            __m128i tmp;
-
-            // dot product constant: even elems=x, odd elems=y
-#define dct_const(x,y)  _mm_setr_epi16((x),(y),(x),(y),(x),(y),(x),(y))
-
-// out(0) = c0[even]*x + c0[odd]*y   (c0, x, y 16-bit, out 32-bit)
-// out(1) = c1[even]*x + c1[odd]*y
-#define dct_rot(out0,out1, x,y,c0,c1) \
-      __m128i c0##lo = _mm_unpacklo_epi16((x),(y)); \
-      __m128i c0##hi = _mm_unpackhi_epi16((x),(y)); \
-      __m128i out0##_l = _mm_madd_epi16(c0##lo, c0); \
-      __m128i out0##_h = _mm_madd_epi16(c0##hi, c0); \
-      __m128i out1##_l = _mm_madd_epi16(c0##lo, c1); \
-      __m128i out1##_h = _mm_madd_epi16(c0##hi, c1)
-
-   // out = in << 12  (in 16-bit, out 32-bit)
-#define dct_widen(out, in) \
-      __m128i out##_l = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), (in)), 4); \
-      __m128i out##_h = _mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), (in)), 4)
-
-   // wide add
-#define dct_wadd(out, a, b) \
-      __m128i out##_l = _mm_add_epi32(a##_l, b##_l); \
-      __m128i out##_h = _mm_add_epi32(a##_h, b##_h)
-
-   // wide sub
-#define dct_wsub(out, a, b) \
-      __m128i out##_l = _mm_sub_epi32(a##_l, b##_l); \
-      __m128i out##_h = _mm_sub_epi32(a##_h, b##_h)
-
-   // butterfly a/b, add bias, then shift by "s" and pack
-#define dct_bfly32o(out0, out1, a,b,bias,s) \
-      { \
-         __m128i abiased_l = _mm_add_epi32(a##_l, bias); \
-         __m128i abiased_h = _mm_add_epi32(a##_h, bias); \
-         dct_wadd(sum, abiased, b); \
-         dct_wsub(dif, abiased, b); \
-         out0 = _mm_packs_epi32(_mm_srai_epi32(sum_l, s), _mm_srai_epi32(sum_h, s)); \
-         out1 = _mm_packs_epi32(_mm_srai_epi32(dif_l, s), _mm_srai_epi32(dif_h, s)); \
-      }
-
-   // 8-bit interleave step (for transposes)
-#define dct_interleave8(a, b) \
-      tmp = a; \
-      a = _mm_unpacklo_epi8(a, b); \
-      b = _mm_unpackhi_epi8(tmp, b)
-
-   // 16-bit interleave step (for transposes)
-#define dct_interleave16(a, b) \
-      tmp = a; \
-      a = _mm_unpacklo_epi16(a, b); \
-      b = _mm_unpackhi_epi16(tmp, b)
-
-#define dct_pass(bias,shift) \
-      { \
-         /* even part */ \
-         dct_rot(t2e,t3e, row2,row6, rot0_0,rot0_1); \
-         __m128i sum04 = _mm_add_epi16(row0, row4); \
-         __m128i dif04 = _mm_sub_epi16(row0, row4); \
-         dct_widen(t0e, sum04); \
-         dct_widen(t1e, dif04); \
-         dct_wadd(x0, t0e, t3e); \
-         dct_wsub(x3, t0e, t3e); \
-         dct_wadd(x1, t1e, t2e); \
-         dct_wsub(x2, t1e, t2e); \
-         /* odd part */ \
-         dct_rot(y0o,y2o, row7,row3, rot2_0,rot2_1); \
-         dct_rot(y1o,y3o, row5,row1, rot3_0,rot3_1); \
-         __m128i sum17 = _mm_add_epi16(row1, row7); \
-         __m128i sum35 = _mm_add_epi16(row3, row5); \
-         dct_rot(y4o,y5o, sum17,sum35, rot1_0,rot1_1); \
-         dct_wadd(x4, y0o, y4o); \
-         dct_wadd(x5, y1o, y5o); \
-         dct_wadd(x6, y2o, y5o); \
-         dct_wadd(x7, y3o, y4o); \
-         dct_bfly32o(row0,row7, x0,x7,bias,shift); \
-         dct_bfly32o(row1,row6, x1,x6,bias,shift); \
-         dct_bfly32o(row2,row5, x2,x5,bias,shift); \
-         dct_bfly32o(row3,row4, x3,x4,bias,shift); \
-      }
-
-            __m128i rot0_0 = dct_const(jpeg__f2f(0.5411961f), jpeg__f2f(0.5411961f) + jpeg__f2f(-1.847759065f));
-            __m128i rot0_1 = dct_const(jpeg__f2f(0.5411961f) + jpeg__f2f(0.765366865f), jpeg__f2f(0.5411961f));
-            __m128i rot1_0 = dct_const(jpeg__f2f(1.175875602f) + jpeg__f2f(-0.899976223f), jpeg__f2f(1.175875602f));
-            __m128i rot1_1 = dct_const(jpeg__f2f(1.175875602f), jpeg__f2f(1.175875602f) + jpeg__f2f(-2.562915447f));
-            __m128i rot2_0 = dct_const(jpeg__f2f(-1.961570560f) + jpeg__f2f(0.298631336f), jpeg__f2f(-1.961570560f));
-            __m128i rot2_1 = dct_const(jpeg__f2f(-1.961570560f), jpeg__f2f(-1.961570560f) + jpeg__f2f(3.072711026f));
-            __m128i rot3_0 = dct_const(jpeg__f2f(-0.390180644f) + jpeg__f2f(2.053119869f), jpeg__f2f(-0.390180644f));
-            __m128i rot3_1 = dct_const(jpeg__f2f(-0.390180644f), jpeg__f2f(-0.390180644f) + jpeg__f2f(1.501321110f));
-
-            // rounding biases in column/row passes, see jpeg__idct_block for explanation.
-            __m128i bias_0 = _mm_set1_epi32(512);
-            __m128i bias_1 = _mm_set1_epi32(65536 + (128 << 17));
-
-            // load
-            row0 = _mm_load_si128((const __m128i*) (data + 0 * 8));
-            row1 = _mm_load_si128((const __m128i*) (data + 1 * 8));
-            row2 = _mm_load_si128((const __m128i*) (data + 2 * 8));
-            row3 = _mm_load_si128((const __m128i*) (data + 3 * 8));
-            row4 = _mm_load_si128((const __m128i*) (data + 4 * 8));
-            row5 = _mm_load_si128((const __m128i*) (data + 5 * 8));
-            row6 = _mm_load_si128((const __m128i*) (data + 6 * 8));
-            row7 = _mm_load_si128((const __m128i*) (data + 7 * 8));
-
-            // column pass
-            dct_pass(bias_0, 10);
-
-            {
-                // 16bit 8x8 transpose pass 1
-                dct_interleave16(row0, row4);
-                dct_interleave16(row1, row5);
-                dct_interleave16(row2, row6);
-                dct_interleave16(row3, row7);
-
-                // transpose pass 2
-                dct_interleave16(row0, row2);
-                dct_interleave16(row1, row3);
-                dct_interleave16(row4, row6);
-                dct_interleave16(row5, row7);
-
-                // transpose pass 3
-                dct_interleave16(row0, row1);
-                dct_interleave16(row2, row3);
-                dct_interleave16(row4, row5);
-                dct_interleave16(row6, row7);
-            }
-
-            // row pass
-            dct_pass(bias_1, 17);
-
-            {
-                // pack
-                __m128i p0 = _mm_packus_epi16(row0, row1); // a0a1a2a3...a7b0b1b2b3...b7
-                __m128i p1 = _mm_packus_epi16(row2, row3);
-                __m128i p2 = _mm_packus_epi16(row4, row5);
-                __m128i p3 = _mm_packus_epi16(row6, row7);
-
-                // 8bit 8x8 transpose pass 1
-                dct_interleave8(p0, p2); // a0e0a1e1...
-                dct_interleave8(p1, p3); // c0g0c1g1...
-
-                // transpose pass 2
-                dct_interleave8(p0, p1); // a0c0e0g0...
-                dct_interleave8(p2, p3); // b0d0f0h0...
-
-                // transpose pass 3
-                dct_interleave8(p0, p2); // a0b0c0d0...
-                dct_interleave8(p1, p3); // a4b4c4d4...
-
-                // store
-                _mm_storel_epi64((__m128i*) out, p0); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, _mm_shuffle_epi32(p0, 0x4e)); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, p2); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, _mm_shuffle_epi32(p2, 0x4e)); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, p1); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, _mm_shuffle_epi32(p1, 0x4e)); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, p3); out += out_stride;
-                _mm_storel_epi64((__m128i*) out, _mm_shuffle_epi32(p3, 0x4e));
-            }
-
-#undef dct_const
-#undef dct_rot
-#undef dct_widen
-#undef dct_wadd
-#undef dct_wsub
-#undef dct_bfly32o
-#undef dct_interleave8
-#undef dct_interleave16
-#undef dct_pass
-        }
-
-#endif // JPEG_SSE2
-
 #ifdef JPEG_NEON
 
         // NEON integer IDCT. should produce bit-identical
         // results to the generic C version.
-        static void jpeg__idct_simd(jpeg_uc* out, int out_stride, short data[64])
+        static void jpeg__idct_simd(jpeg_uc* out, int out_stride, const short* data)
         {
             int16x8_t row0, row1, row2, row3, row4, row5, row6, row7;
 
@@ -1232,6 +1036,81 @@ namespace Simd
 
 #endif // JPEG_NEON
 
+        static void jpeg__idct_blocks(const short* data, int count, jpeg_uc* out, int out_stride)
+        {
+            for (int i = 0; i < count; ++i, data += 64, out += 8)
+            {
+#ifdef JPEG_NEON
+                jpeg__idct_simd(out, out_stride, data);
+#else
+                jpeg__idct_block(out, out_stride, data);
+#endif
+            }
+        }
+
+        // reduced size IDCT: only low frequency NxN coefficients are used, output is sampled at centers of NxN cells
+#define JPEG__IDCT_FIX(x) ((int)((x) * 8192 + 0.5f))
+#define JPEG__IDCT_C4 JPEG__IDCT_FIX(0.353553391f)
+#define JPEG__IDCT_C2 JPEG__IDCT_FIX(0.461939766f)
+#define JPEG__IDCT_C6 JPEG__IDCT_FIX(0.191341716f)
+
+        static void jpeg__idct_block_4x4(jpeg_uc* out, int out_stride, const short* data)
+        {
+            int tmp[16], i;
+            for (i = 0; i < 4; ++i)
+            {
+                const short* d = data + i;
+                int t0 = (d[0] + d[16]) * JPEG__IDCT_C4;
+                int t1 = (d[0] - d[16]) * JPEG__IDCT_C4;
+                int t2 = d[8] * JPEG__IDCT_C2 + d[24] * JPEG__IDCT_C6;
+                int t3 = d[8] * JPEG__IDCT_C6 - d[24] * JPEG__IDCT_C2;
+                tmp[0 + i] = (t0 + t2 + 1024) >> 11;
+                tmp[4 + i] = (t1 + t3 + 1024) >> 11;
+                tmp[8 + i] = (t1 - t3 + 1024) >> 11;
+                tmp[12 + i] = (t0 - t2 + 1024) >> 11;
+            }
+            for (i = 0; i < 4; ++i, out += out_stride)
+            {
+                const int* t = tmp + 4 * i;
+                int t0 = (t[0] + t[2]) * JPEG__IDCT_C4 + (1 << 14) + (128 << 15);
+                int t1 = (t[0] - t[2]) * JPEG__IDCT_C4 + (1 << 14) + (128 << 15);
+                int t2 = t[1] * JPEG__IDCT_C2 + t[3] * JPEG__IDCT_C6;
+                int t3 = t[1] * JPEG__IDCT_C6 - t[3] * JPEG__IDCT_C2;
+                out[0] = jpeg__clamp((t0 + t2) >> 15);
+                out[1] = jpeg__clamp((t1 + t3) >> 15);
+                out[2] = jpeg__clamp((t1 - t3) >> 15);
+                out[3] = jpeg__clamp((t0 - t2) >> 15);
+            }
+        }
+
+        static void jpeg__idct_block_2x2(jpeg_uc* out, int out_stride, const short* data)
+        {
+            int t0 = data[0] + data[8] + 4 + (128 << 3), t1 = data[0] - data[8] + 4 + (128 << 3);
+            out[0] = jpeg__clamp((t0 + data[1] + data[9]) >> 3);
+            out[1] = jpeg__clamp((t0 - data[1] - data[9]) >> 3);
+            out += out_stride;
+            out[0] = jpeg__clamp((t1 + data[1] - data[9]) >> 3);
+            out[1] = jpeg__clamp((t1 - data[1] + data[9]) >> 3);
+        }
+
+        static void jpeg__idct_blocks_4x4(const short* data, int count, jpeg_uc* out, int out_stride)
+        {
+            for (int i = 0; i < count; ++i, data += 64, out += 4)
+                jpeg__idct_block_4x4(out, out_stride, data);
+        }
+
+        static void jpeg__idct_blocks_2x2(const short* data, int count, jpeg_uc* out, int out_stride)
+        {
+            for (int i = 0; i < count; ++i, data += 64, out += 2)
+                jpeg__idct_block_2x2(out, out_stride, data);
+        }
+
+        static void jpeg__idct_blocks_1x1(const short* data, int count, jpeg_uc* out, int out_stride)
+        {
+            for (int i = 0; i < count; ++i, data += 64)
+                out[i] = jpeg__clamp((data[0] + 4 + (128 << 3)) >> 3);
+        }
+
 #define JPEG__MARKER_none  0xff
         // if there's a pending marker from the entropy stream, return that
         // otherwise, fetch from the stream and get a marker. if there's no
@@ -1266,14 +1145,27 @@ namespace Simd
             // since we don't even allow 1<<30 pixels
         }
 
+        // inverse DCT of decoded blocks of first 'mcus' MCUs of MCU row 'j' of every scan component
+        static void jpeg__idct_mcu_row(jpeg__jpeg* z, int j, int mcus)
+        {
+            int k, y;
+            for (k = 0; k < z->scan_n; ++k) {
+                int n = z->order[k];
+                int h = z->img_comp[n].h, v = z->img_comp[n].v, bw = z->img_mcu_x * h;
+                for (y = 0; y < v; ++y)
+                    z->idct_blocks_kernel(z->img_comp[n].row_coeff + 64 * y * bw, mcus * h,
+                        z->img_comp[n].data + z->img_comp[n].w2 * (j * v + y) * z->block_size, z->img_comp[n].w2);
+            }
+        }
+
         static int jpeg__parse_entropy_coded_data(jpeg__jpeg* z)
         {
             jpeg__jpeg_reset(z);
             if (!z->progressive) {
                 if (z->scan_n == 1) {
                     int i, j;
-                    JPEG_SIMD_ALIGN(short, data[64]);
                     int n = z->order[0];
+                    short* row = z->img_comp[n].row_coeff;
                     // non-interleaved data, we just need to process one block at a time,
                     // in trivial scanline order
                     // number of blocks to do just depends on how many actual "pixels" this
@@ -1281,39 +1173,42 @@ namespace Simd
                     int w = (z->img_comp[n].x + 7) >> 3;
                     int h = (z->img_comp[n].y + 7) >> 3;
                     for (j = 0; j < h; ++j) {
+                        jpeg_uc* out = z->img_comp[n].data + z->img_comp[n].w2 * j * z->block_size;
                         for (i = 0; i < w; ++i) {
                             int ha = z->img_comp[n].ha;
-                            if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
+                            if (!jpeg__jpeg_decode_block(z, row + 64 * i, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
                             // every data block is an MCU, so countdown the restart interval
                             if (--z->todo <= 0) {
                                 if (z->code_bits < 24) jpeg__grow_buffer_unsafe(z);
                                 // if it's NOT a restart, then just bail, so we get corrupt data
                                 // rather than no data
-                                if (!JPEG__RESTART(z->marker)) return 1;
+                                if (!JPEG__RESTART(z->marker)) {
+                                    z->idct_blocks_kernel(row, i + 1, out, z->img_comp[n].w2);
+                                    return 1;
+                                }
                                 jpeg__jpeg_reset(z);
                             }
                         }
+                        // the whole row of blocks is transformed at once
+                        z->idct_blocks_kernel(row, w, out, z->img_comp[n].w2);
                     }
                     return 1;
                 }
                 else { // interleaved
                     int i, j, k, x, y;
-                    JPEG_SIMD_ALIGN(short, data[64]);
                     for (j = 0; j < z->img_mcu_y; ++j) {
                         for (i = 0; i < z->img_mcu_x; ++i) {
                             // scan an interleaved mcu... process scan_n components in order
                             for (k = 0; k < z->scan_n; ++k) {
                                 int n = z->order[k];
+                                int bw = z->img_mcu_x * z->img_comp[n].h;
                                 // scan out an mcu's worth of this component; that's just determined
                                 // by the basic H and V specified for the component
                                 for (y = 0; y < z->img_comp[n].v; ++y) {
                                     for (x = 0; x < z->img_comp[n].h; ++x) {
-                                        int x2 = (i * z->img_comp[n].h + x) * 8;
-                                        int y2 = (j * z->img_comp[n].v + y) * 8;
+                                        short* data = z->img_comp[n].row_coeff + 64 * (y * bw + i * z->img_comp[n].h + x);
                                         int ha = z->img_comp[n].ha;
                                         if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                                        z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
                                     }
                                 }
                             }
@@ -1321,10 +1216,14 @@ namespace Simd
                             // so now count down the restart interval
                             if (--z->todo <= 0) {
                                 if (z->code_bits < 24) jpeg__grow_buffer_unsafe(z);
-                                if (!JPEG__RESTART(z->marker)) return 1;
+                                if (!JPEG__RESTART(z->marker)) {
+                                    jpeg__idct_mcu_row(z, j, i + 1);
+                                    return 1;
+                                }
                                 jpeg__jpeg_reset(z);
                             }
                         }
+                        jpeg__idct_mcu_row(z, j, z->img_mcu_x);
                     }
                     return 1;
                 }
@@ -1410,11 +1309,10 @@ namespace Simd
                     int w = (z->img_comp[n].x + 7) >> 3;
                     int h = (z->img_comp[n].y + 7) >> 3;
                     for (j = 0; j < h; ++j) {
-                        for (i = 0; i < w; ++i) {
-                            short* data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
-                            jpeg__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
-                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
-                        }
+                        short* data = z->img_comp[n].coeff + 64 * j * z->img_comp[n].coeff_w;
+                        for (i = 0; i < w; ++i)
+                            jpeg__jpeg_dequantize(data + 64 * i, z->dequant[z->img_comp[n].tq]);
+                        z->idct_blocks_kernel(data, w, z->img_comp[n].data + z->img_comp[n].w2 * j * z->block_size, z->img_comp[n].w2);
                     }
                 }
             }
@@ -1565,24 +1463,29 @@ namespace Simd
             return 1;
         }
 
+        // get component buffer from scratch (it is reused for next images, so it only grows)
+        static void* jpeg__scratch_mad3(jpeg__jpeg* z, int comp, int kind, int a, int b, int c, int add)
+        {
+            if (!jpeg__mad3sizes_valid(a, b, c, add)) return NULL;
+            Array8u& buffer = z->scratch[comp * 4 + kind];
+            size_t size = a * b * c + add;
+            if (buffer.size < size)
+                buffer.Resize(size);
+            return buffer.data;
+        }
+
+        // component buffers are owned by scratch of loader so only references are dropped
         static int jpeg__free_jpeg_components(jpeg__jpeg* z, int ncomp, int why)
         {
             int i;
             for (i = 0; i < ncomp; ++i) {
-                if (z->img_comp[i].raw_data) {
-                    JPEG_FREE(z->img_comp[i].raw_data);
-                    z->img_comp[i].raw_data = NULL;
-                    z->img_comp[i].data = NULL;
-                }
-                if (z->img_comp[i].raw_coeff) {
-                    JPEG_FREE(z->img_comp[i].raw_coeff);
-                    z->img_comp[i].raw_coeff = 0;
-                    z->img_comp[i].coeff = 0;
-                }
-                if (z->img_comp[i].linebuf) {
-                    JPEG_FREE(z->img_comp[i].linebuf);
-                    z->img_comp[i].linebuf = NULL;
-                }
+                z->img_comp[i].raw_data = NULL;
+                z->img_comp[i].data = NULL;
+                z->img_comp[i].raw_coeff = 0;
+                z->img_comp[i].coeff = 0;
+                z->img_comp[i].raw_row_coeff = 0;
+                z->img_comp[i].row_coeff = 0;
+                z->img_comp[i].linebuf = NULL;
             }
             return why;
         }
@@ -1636,6 +1539,8 @@ namespace Simd
             // these sizes can't be more than 17 bits
             z->img_mcu_x = (s->img_x + z->img_mcu_w - 1) / z->img_mcu_w;
             z->img_mcu_y = (s->img_y + z->img_mcu_h - 1) / z->img_mcu_h;
+            z->out_x = (s->img_x + z->scale - 1) / z->scale;
+            z->out_y = (s->img_y + z->scale - 1) / z->scale;
 
             for (i = 0; i < s->img_n; ++i) {
                 // number of effective pixels (e.g. for non-interleaved MCU)
@@ -1648,25 +1553,34 @@ namespace Simd
                 //
                 // img_mcu_x, img_mcu_y: <=17 bits; comp[i].h and .v are <=4 (checked earlier)
                 // so these muls can't overflow with 32-bit ints (which we require)
-                z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * 8;
-                z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * 8;
+                z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * z->block_size;
+                z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * z->block_size;
                 z->img_comp[i].coeff = 0;
                 z->img_comp[i].raw_coeff = 0;
+                z->img_comp[i].row_coeff = 0;
+                z->img_comp[i].raw_row_coeff = 0;
                 z->img_comp[i].linebuf = NULL;
-                z->img_comp[i].raw_data = jpeg__malloc_mad2(z->img_comp[i].w2, z->img_comp[i].h2, 15);
+                z->img_comp[i].raw_data = jpeg__scratch_mad3(z, i, 0, z->img_comp[i].w2, z->img_comp[i].h2, 1, 15);
                 if (z->img_comp[i].raw_data == NULL)
                     return jpeg__free_jpeg_components(z, i + 1, jpeg__err("outofmem", "Out of memory"));
                 // align blocks for idct using mmx/sse
                 z->img_comp[i].data = (jpeg_uc*)(((size_t)z->img_comp[i].raw_data + 15) & ~15);
                 if (z->progressive) {
-                    // w2, h2 are multiples of 8 (see above)
-                    z->img_comp[i].coeff_w = z->img_comp[i].w2 / 8;
-                    z->img_comp[i].coeff_h = z->img_comp[i].h2 / 8;
-                    z->img_comp[i].raw_coeff = jpeg__malloc_mad3(z->img_comp[i].w2, z->img_comp[i].h2, sizeof(short), 15);
+                    // coefficients are stored for all 8x8 blocks regardless of DCT scaling
+                    z->img_comp[i].coeff_w = z->img_mcu_x * z->img_comp[i].h;
+                    z->img_comp[i].coeff_h = z->img_mcu_y * z->img_comp[i].v;
+                    z->img_comp[i].raw_coeff = jpeg__scratch_mad3(z, i, 1, z->img_comp[i].coeff_w * 8, z->img_comp[i].coeff_h * 8, sizeof(short), 15);
                     if (z->img_comp[i].raw_coeff == NULL)
                         return jpeg__free_jpeg_components(z, i + 1, jpeg__err("outofmem", "Out of memory"));
                     z->img_comp[i].coeff = (short*)(((size_t)z->img_comp[i].raw_coeff + 15) & ~15);
                 }
+                else {
+                    // baseline blocks are buffered per MCU row and transformed in batches
+                    z->img_comp[i].raw_row_coeff = jpeg__scratch_mad3(z, i, 2, z->img_mcu_x * z->img_comp[i].h * 8, z->img_comp[i].v * 8, sizeof(short), 63);
+                    if (z->img_comp[i].raw_row_coeff == NULL)
+                        return jpeg__free_jpeg_components(z, i + 1, jpeg__err("outofmem", "Out of memory"));
+                    z->img_comp[i].row_coeff = (short*)(((size_t)z->img_comp[i].raw_row_coeff + 63) & ~63);
+                }
             }
 
             return 1;
@@ -1712,6 +1626,7 @@ namespace Simd
             for (m = 0; m < 4; m++) {
                 j->img_comp[m].raw_data = NULL;
                 j->img_comp[m].raw_coeff = NULL;
+                j->img_comp[m].raw_row_coeff = NULL;
             }
             j->restart_interval = 0;
             if (!jpeg__decode_jpeg_header(j, JPEG__SCAN_load)) return 0;
@@ -1828,7 +1743,7 @@ namespace Simd
             return out;
         }
 
-#if defined(JPEG_SSE2) || defined(JPEG_NEON)
+#if defined(JPEG_NEON)
         static jpeg_uc* jpeg__resample_row_hv_2_simd(jpeg_uc* out, jpeg_uc* in_near, jpeg_uc* in_far, int w, int hs)
         {
             // need to generate 2x2 samples for every one in input
@@ -1844,50 +1759,6 @@ namespace Simd
             // note we can't handle the last pixel in a row in this loop
             // because we need to handle the filter boundary conditions.
             for (; i < ((w - 1) & ~7); i += 8) {
-#if defined(JPEG_SSE2)
-                // load and perform the vertical filtering pass
-                // this uses 3*x + y = 4*x + (y - x)
-                __m128i zero = _mm_setzero_si128();
-                __m128i farb = _mm_loadl_epi64((__m128i*) (in_far + i));
-                __m128i nearb = _mm_loadl_epi64((__m128i*) (in_near + i));
-                __m128i farw = _mm_unpacklo_epi8(farb, zero);
-                __m128i nearw = _mm_unpacklo_epi8(nearb, zero);
-                __m128i diff = _mm_sub_epi16(farw, nearw);
-                __m128i nears = _mm_slli_epi16(nearw, 2);
-                __m128i curr = _mm_add_epi16(nears, diff); // current row
-
-                // horizontal filter works the same based on shifted vers of current
-                // row. "prev" is current row shifted right by 1 pixel; we need to
-                // insert the previous pixel value (from t1).
-                // "next" is current row shifted left by 1 pixel, with first pixel
-                // of next block of 8 pixels added in.
-                __m128i prv0 = _mm_slli_si128(curr, 2);
-                __m128i nxt0 = _mm_srli_si128(curr, 2);
-                __m128i prev = _mm_insert_epi16(prv0, t1, 0);
-                __m128i next = _mm_insert_epi16(nxt0, 3 * in_near[i + 8] + in_far[i + 8], 7);
-
-                // horizontal filter, polyphase implementation since it's convenient:
-                // even pixels = 3*cur + prev = cur*4 + (prev - cur)
-                // odd  pixels = 3*cur + next = cur*4 + (next - cur)
-                // note the shared term.
-                __m128i bias = _mm_set1_epi16(8);
-                __m128i curs = _mm_slli_epi16(curr, 2);
-                __m128i prvd = _mm_sub_epi16(prev, curr);
-                __m128i nxtd = _mm_sub_epi16(next, curr);
-                __m128i curb = _mm_add_epi16(curs, bias);
-                __m128i even = _mm_add_epi16(prvd, curb);
-                __m128i odd = _mm_add_epi16(nxtd, curb);
-
-                // interleave even and odd pixels, then undo scaling.
-                __m128i int0 = _mm_unpacklo_epi16(even, odd);
-                __m128i int1 = _mm_unpackhi_epi16(even, odd);
-                __m128i de0 = _mm_srli_epi16(int0, 4);
-                __m128i de1 = _mm_srli_epi16(int1, 4);
-
-                // pack and write output
-                __m128i outv = _mm_packus_epi16(de0, de1);
-                _mm_storeu_si128((__m128i*) (out + i * 2), outv);
-#elif defined(JPEG_NEON)
                 // load and perform the vertical filtering pass
                 // this uses 3*x + y = 4*x + (y - x)
                 uint8x8_t farb = vld1_u8(in_far + i);
@@ -1921,7 +1792,6 @@ namespace Simd
                 o.val[0] = vqrshrun_n_s16(even, 4);
                 o.val[1] = vqrshrun_n_s16(odd, 4);
                 vst2_u8(out + i * 2, o);
-#endif
 
                 // "previous" value for next iter
                 t1 = 3 * in_near[i + 7] + in_far[i + 7];
@@ -1956,191 +1826,6 @@ namespace Simd
             return out;
         }
 
-        // this is a reduced-precision calculation of YCbCr-to-RGB introduced
-        // to make sure the code produces the same results in both SIMD and scalar
-#define jpeg__float2fixed(x)  (((int) ((x) * 4096.0f + 0.5f)) << 8)
-        static void jpeg__YCbCr_to_RGB_row(jpeg_uc* out, const jpeg_uc* y, const jpeg_uc* pcb, const jpeg_uc* pcr, int count, int step)
-        {
-            int i;
-            for (i = 0; i < count; ++i) {
-                int y_fixed = (y[i] << 20) + (1 << 19); // rounding
-                int r, g, b;
-                int cr = pcr[i] - 128;
-                int cb = pcb[i] - 128;
-                r = y_fixed + cr * jpeg__float2fixed(1.40200f);
-                g = y_fixed + (cr * -jpeg__float2fixed(0.71414f)) + ((cb * -jpeg__float2fixed(0.34414f)) & 0xffff0000);
-                b = y_fixed + cb * jpeg__float2fixed(1.77200f);
-                r >>= 20;
-                g >>= 20;
-                b >>= 20;
-                if ((unsigned)r > 255) { if (r < 0) r = 0; else r = 255; }
-                if ((unsigned)g > 255) { if (g < 0) g = 0; else g = 255; }
-                if ((unsigned)b > 255) { if (b < 0) b = 0; else b = 255; }
-                out[0] = (jpeg_uc)r;
-                out[1] = (jpeg_uc)g;
-                out[2] = (jpeg_uc)b;
-                out[3] = 255;
-                out += step;
-            }
-        }
-
-#if defined(JPEG_SSE2) || defined(JPEG_NEON)
-        static void jpeg__YCbCr_to_RGB_simd(jpeg_uc* out, jpeg_uc const* y, jpeg_uc const* pcb, jpeg_uc const* pcr, int count, int step)
-        {
-            int i = 0;
-
-#ifdef JPEG_SSE2
-            // step == 3 is pretty ugly on the final interleave, and i'm not convinced
-            // it's useful in practice (you wouldn't use it for textures, for example).
-            // so just accelerate step == 4 case.
-            if (step == 4) {
-                // this is a fairly straightforward implementation and not super-optimized.
-                __m128i signflip = _mm_set1_epi8(-0x80);
-                __m128i cr_const0 = _mm_set1_epi16((short)(1.40200f * 4096.0f + 0.5f));
-                __m128i cr_const1 = _mm_set1_epi16(-(short)(0.71414f * 4096.0f + 0.5f));
-                __m128i cb_const0 = _mm_set1_epi16(-(short)(0.34414f * 4096.0f + 0.5f));
-                __m128i cb_const1 = _mm_set1_epi16((short)(1.77200f * 4096.0f + 0.5f));
-                __m128i y_bias = _mm_set1_epi8((char)(unsigned char)128);
-                __m128i xw = _mm_set1_epi16(255); // alpha channel
-
-                for (; i + 7 < count; i += 8) {
-                    // load
-                    __m128i y_bytes = _mm_loadl_epi64((__m128i*) (y + i));
-                    __m128i cr_bytes = _mm_loadl_epi64((__m128i*) (pcr + i));
-                    __m128i cb_bytes = _mm_loadl_epi64((__m128i*) (pcb + i));
-                    __m128i cr_biased = _mm_xor_si128(cr_bytes, signflip); // -128
-                    __m128i cb_biased = _mm_xor_si128(cb_bytes, signflip); // -128
-
-                    // unpack to short (and left-shift cr, cb by 8)
-                    __m128i yw = _mm_unpacklo_epi8(y_bias, y_bytes);
-                    __m128i crw = _mm_unpacklo_epi8(_mm_setzero_si128(), cr_biased);
-                    __m128i cbw = _mm_unpacklo_epi8(_mm_setzero_si128(), cb_biased);
-
-                    // color transform
-                    __m128i yws = _mm_srli_epi16(yw, 4);
-                    __m128i cr0 = _mm_mulhi_epi16(cr_const0, crw);
-                    __m128i cb0 = _mm_mulhi_epi16(cb_const0, cbw);
-                    __m128i cb1 = _mm_mulhi_epi16(cbw, cb_const1);
-                    __m128i cr1 = _mm_mulhi_epi16(crw, cr_const1);
-                    __m128i rws = _mm_add_epi16(cr0, yws);
-                    __m128i gwt = _mm_add_epi16(cb0, yws);
-                    __m128i bws = _mm_add_epi16(yws, cb1);
-                    __m128i gws = _mm_add_epi16(gwt, cr1);
-
-                    // descale
-                    __m128i rw = _mm_srai_epi16(rws, 4);
-                    __m128i bw = _mm_srai_epi16(bws, 4);
-                    __m128i gw = _mm_srai_epi16(gws, 4);
-
-                    // back to byte, set up for transpose
-                    __m128i brb = _mm_packus_epi16(rw, bw);
-                    __m128i gxb = _mm_packus_epi16(gw, xw);
-
-                    // transpose to interleave channels
-                    __m128i t0 = _mm_unpacklo_epi8(brb, gxb);
-                    __m128i t1 = _mm_unpackhi_epi8(brb, gxb);
-                    __m128i o0 = _mm_unpacklo_epi16(t0, t1);
-                    __m128i o1 = _mm_unpackhi_epi16(t0, t1);
-
-                    // store
-                    _mm_storeu_si128((__m128i*) (out + 0), o0);
-                    _mm_storeu_si128((__m128i*) (out + 16), o1);
-                    out += 32;
-                }
-            }
-#endif
-
-#ifdef JPEG_NEON
-            // in this version, step=3 support would be easy to add. but is there demand?
-            if (step == 4) {
-                // this is a fairly straightforward implementation and not super-optimized.
-                uint8x8_t signflip = vdup_n_u8(0x80);
-                int16x8_t cr_const0 = vdupq_n_s16((short)(1.40200f * 4096.0f + 0.5f));
-                int16x8_t cr_const1 = vdupq_n_s16(-(short)(0.71414f * 4096.0f + 0.5f));
-                int16x8_t cb_const0 = vdupq_n_s16(-(short)(0.34414f * 4096.0f + 0.5f));
-                int16x8_t cb_const1 = vdupq_n_s16((short)(1.77200f * 4096.0f + 0.5f));
-
-                for (; i + 7 < count; i += 8) {
-                    // load
-                    uint8x8_t y_bytes = vld1_u8(y + i);
-                    uint8x8_t cr_bytes = vld1_u8(pcr + i);
-                    uint8x8_t cb_bytes = vld1_u8(pcb + i);
-                    int8x8_t cr_biased = vreinterpret_s8_u8(vsub_u8(cr_bytes, signflip));
-                    int8x8_t cb_biased = vreinterpret_s8_u8(vsub_u8(cb_bytes, signflip));
-
-                    // expand to s16
-                    int16x8_t yws = vreinterpretq_s16_u16(vshll_n_u8(y_bytes, 4));
-                    int16x8_t crw = vshll_n_s8(cr_biased, 7);
-                    int16x8_t cbw = vshll_n_s8(cb_biased, 7);
-
-                    // color transform
-                    int16x8_t cr0 = vqdmulhq_s16(crw, cr_const0);
-                    int16x8_t cb0 = vqdmulhq_s16(cbw, cb_const0);
-                    int16x8_t cr1 = vqdmulhq_s16(crw, cr_const1);
-                    int16x8_t cb1 = vqdmulhq_s16(cbw, cb_const1);
-                    int16x8_t rws = vaddq_s16(yws, cr0);
-                    int16x8_t gws = vaddq_s16(vaddq_s16(yws, cb0), cr1);
-                    int16x8_t bws = vaddq_s16(yws, cb1);
-
-                    // undo scaling, round, convert to byte
-                    uint8x8x4_t o;
-                    o.val[0] = vqrshrun_n_s16(rws, 4);
-                    o.val[1] = vqrshrun_n_s16(gws, 4);
-                    o.val[2] = vqrshrun_n_s16(bws, 4);
-                    o.val[3] = vdup_n_u8(255);
-
-                    // store, interleaving r/g/b/a
-                    vst4_u8(out, o);
-                    out += 8 * 4;
-                }
-            }
-#endif
-
-            for (; i < count; ++i) {
-                int y_fixed = (y[i] << 20) + (1 << 19); // rounding
-                int r, g, b;
-                int cr = pcr[i] - 128;
-                int cb = pcb[i] - 128;
-                r = y_fixed + cr * jpeg__float2fixed(1.40200f);
-                g = y_fixed + cr * -jpeg__float2fixed(0.71414f) + ((cb * -jpeg__float2fixed(0.34414f)) & 0xffff0000);
-                b = y_fixed + cb * jpeg__float2fixed(1.77200f);
-                r >>= 20;
-                g >>= 20;
-                b >>= 20;
-                if ((unsigned)r > 255) { if (r < 0) r = 0; else r = 255; }
-                if ((unsigned)g > 255) { if (g < 0) g = 0; else g = 255; }
-                if ((unsigned)b > 255) { if (b < 0) b = 0; else b = 255; }
-                out[0] = (jpeg_uc)r;
-                out[1] = (jpeg_uc)g;
-                out[2] = (jpeg_uc)b;
-                out[3] = 255;
-                out += step;
-            }
-        }
-#endif
-
-        // set up the kernels
-        static void jpeg__setup_jpeg(jpeg__jpeg* j)
-        {
-            j->idct_block_kernel = jpeg__idct_block;
-            j->YCbCr_to_RGB_kernel = jpeg__YCbCr_to_RGB_row;
-            j->resample_row_hv_2_kernel = jpeg__resample_row_hv_2;
-
-#ifdef JPEG_SSE2
-            if (jpeg__sse2_available()) {
-                j->idct_block_kernel = jpeg__idct_simd;
-                j->YCbCr_to_RGB_kernel = jpeg__YCbCr_to_RGB_simd;
-                j->resample_row_hv_2_kernel = jpeg__resample_row_hv_2_simd;
-            }
-#endif
-
-#ifdef JPEG_NEON
-            j->idct_block_kernel = jpeg__idct_simd;
-            j->YCbCr_to_RGB_kernel = jpeg__YCbCr_to_RGB_simd;
-            j->resample_row_hv_2_kernel = jpeg__resample_row_hv_2_simd;
-#endif
-        }
-
         // clean up the temporary component buffers
         static void jpeg__cleanup_jpeg(jpeg__jpeg* j)
         {
@@ -2164,184 +1849,243 @@ namespace Simd
             return (jpeg_uc)((t + (t >> 8)) >> 8);
         }
 
-        static jpeg_uc* load_jpeg_image(jpeg__jpeg* z, int* out_x, int* out_y, int* comp, int req_comp)
+        static void jpeg__convert_row(const jpeg_uc* src, size_t width, size_t size, jpeg_uc* dst,
+            void (*to_any)(const jpeg_uc*, size_t, size_t, size_t, jpeg_uc*, size_t),
+            void (*to_bgra)(const jpeg_uc*, size_t, size_t, size_t, jpeg_uc*, size_t, jpeg_uc))
         {
-            int n, decode_n, is_rgb;
-            z->s->img_n = 0; // make jpeg__cleanup_jpeg safe
-
-            // validate req_comp
-            if (req_comp < 0 || req_comp > 4) return jpeg__errpuc("bad req_comp", "Internal error");
-
-            // load a jpeg image from whichever source, but leave in YCbCr format
-            if (!jpeg__decode_jpeg_image(z)) { jpeg__cleanup_jpeg(z); return NULL; }
+            if (to_bgra)
+                to_bgra(src, width, 1, 0, dst, 0, 0xFF);
+            else if (to_any)
+                to_any(src, width, 1, 0, dst, 0);
+            else
+                memcpy(dst, src, width * size);
+        }
 
-            // determine actual number of components to generate
-            n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
+        // resample and color-convert decoded components directly into output image
+        static int jpeg__output_image(jpeg__jpeg* z, jpeg_uc* dst, size_t stride, size_t size, int gray)
+        {
+            int k, decode_n, is_rgb, is_ycbcr;
+            unsigned int i, j;
+            jpeg_uc* rgb = NULL;
+            jpeg_uc* coutput[4] = { NULL, NULL, NULL, NULL };
+            jpeg__resample res_comp[4];
+            size_t width = z->out_x;
 
             is_rgb = z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+            is_ycbcr = z->s->img_n == 3 ? !is_rgb : z->s->img_n == 4 && z->app14_color_transform != 0 && z->app14_color_transform != 2;
 
-            if (z->s->img_n == 3 && n < 3 && !is_rgb)
+            // gray output of YCbCr sources (including 4-component YCbCr + K) is the Y component itself
+            if (gray && is_ycbcr)
                 decode_n = 1;
             else
                 decode_n = z->s->img_n;
 
-            // resample and color-convert
-            {
-                int k;
-                unsigned int i, j;
-                jpeg_uc* output;
-                jpeg_uc* coutput[4] = { NULL, NULL, NULL, NULL };
+            for (k = 0; k < decode_n; ++k) {
+                jpeg__resample* r = &res_comp[k];
+
+                // allocate line buffer big enough for upsampling off the edges
+                // with upsample factor of 4
+                z->img_comp[k].linebuf = (jpeg_uc*)jpeg__scratch_mad3(z, k, 3, z->out_x + 3, 1, 1, 0);
+                if (!z->img_comp[k].linebuf) return jpeg__err("outofmem", "Out of memory");
+
+                r->hs = z->img_h_max / z->img_comp[k].h;
+                r->vs = z->img_v_max / z->img_comp[k].v;
+                r->ystep = r->vs >> 1;
+                r->w_lores = (z->out_x + r->hs - 1) / r->hs;
+                r->ypos = 0;
+                r->line0 = r->line1 = z->img_comp[k].data;
+
+                if (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
+                else if (r->hs == 1 && r->vs == 2) r->resample = z->resample_row_v_2_kernel;
+                else if (r->hs == 2 && r->vs == 1) r->resample = z->resample_row_h_2_kernel;
+                else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
+                else                               r->resample = jpeg__resample_row_generic;
+            }
 
-                jpeg__resample res_comp[4];
+            // RGB, CMYK and YCCK sources are converted through intermediate RGB row
+            if (decode_n > 1 && !is_ycbcr) {
+                rgb = (jpeg_uc*)jpeg__malloc(width * 3);
+                if (!rgb) return jpeg__err("outofmem", "Out of memory");
+            }
 
+            for (j = 0; j < (unsigned int)z->out_y; ++j) {
+                jpeg_uc* out = dst + stride * j;
                 for (k = 0; k < decode_n; ++k) {
                     jpeg__resample* r = &res_comp[k];
-
-                    // allocate line buffer big enough for upsampling off the edges
-                    // with upsample factor of 4
-                    z->img_comp[k].linebuf = (jpeg_uc*)jpeg__malloc(z->s->img_x + 3);
-                    if (!z->img_comp[k].linebuf) { jpeg__cleanup_jpeg(z); return jpeg__errpuc("outofmem", "Out of memory"); }
-
-                    r->hs = z->img_h_max / z->img_comp[k].h;
-                    r->vs = z->img_v_max / z->img_comp[k].v;
-                    r->ystep = r->vs >> 1;
-                    r->w_lores = (z->s->img_x + r->hs - 1) / r->hs;
-                    r->ypos = 0;
-                    r->line0 = r->line1 = z->img_comp[k].data;
-
-                    if (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
-                    else if (r->hs == 1 && r->vs == 2) r->resample = jpeg__resample_row_v_2;
-                    else if (r->hs == 2 && r->vs == 1) r->resample = jpeg__resample_row_h_2;
-                    else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
-                    else                               r->resample = jpeg__resample_row_generic;
+                    int y_bot = r->ystep >= (r->vs >> 1);
+                    coutput[k] = r->resample(z->img_comp[k].linebuf,
+                        y_bot ? r->line1 : r->line0,
+                        y_bot ? r->line0 : r->line1,
+                        r->w_lores, r->hs);
+                    if (++r->ystep >= r->vs) {
+                        r->ystep = 0;
+                        r->line0 = r->line1;
+                        if (++r->ypos < (z->img_comp[k].y + z->scale - 1) / z->scale)
+                            r->line1 += z->img_comp[k].w2;
+                    }
                 }
-
-                // can't error after this so, this is safe
-                output = (jpeg_uc*)jpeg__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
-                if (!output) { jpeg__cleanup_jpeg(z); return jpeg__errpuc("outofmem", "Out of memory"); }
-
-                // now go ahead and resample
-                for (j = 0; j < z->s->img_y; ++j) {
-                    jpeg_uc* out = output + n * z->s->img_x * j;
-                    for (k = 0; k < decode_n; ++k) {
-                        jpeg__resample* r = &res_comp[k];
-                        int y_bot = r->ystep >= (r->vs >> 1);
-                        coutput[k] = r->resample(z->img_comp[k].linebuf,
-                            y_bot ? r->line1 : r->line0,
-                            y_bot ? r->line0 : r->line1,
-                            r->w_lores, r->hs);
-                        if (++r->ystep >= r->vs) {
-                            r->ystep = 0;
-                            r->line0 = r->line1;
-                            if (++r->ypos < z->img_comp[k].y)
-                                r->line1 += z->img_comp[k].w2;
+                if (decode_n == 1)
+                    jpeg__convert_row(coutput[0], width, size, out, z->gray_to_any_kernel, z->gray_to_bgra_kernel);
+                else if (is_ycbcr)
+                    z->yuv_to_any_kernel(coutput[0], coutput[1], coutput[2], width, out);
+                else {
+                    jpeg_uc* o = rgb;
+                    if (is_rgb) {
+                        for (i = 0; i < width; ++i, o += 3) {
+                            o[0] = coutput[0][i];
+                            o[1] = coutput[1][i];
+                            o[2] = coutput[2][i];
                         }
                     }
-                    if (n >= 3) {
-                        jpeg_uc* y = coutput[0];
-                        if (z->s->img_n == 3) {
-                            if (is_rgb) {
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    out[0] = y[i];
-                                    out[1] = coutput[1][i];
-                                    out[2] = coutput[2][i];
-                                    out[3] = 255;
-                                    out += n;
-                                }
-                            }
-                            else {
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                            }
+                    else if (z->app14_color_transform == 0) { // CMYK
+                        for (i = 0; i < width; ++i, o += 3) {
+                            jpeg_uc m = coutput[3][i];
+                            o[0] = jpeg__blinn_8x8(coutput[0][i], m);
+                            o[1] = jpeg__blinn_8x8(coutput[1][i], m);
+                            o[2] = jpeg__blinn_8x8(coutput[2][i], m);
                         }
-                        else if (z->s->img_n == 4) {
-                            if (z->app14_color_transform == 0) { // CMYK
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    jpeg_uc m = coutput[3][i];
-                                    out[0] = jpeg__blinn_8x8(coutput[0][i], m);
-                                    out[1] = jpeg__blinn_8x8(coutput[1][i], m);
-                                    out[2] = jpeg__blinn_8x8(coutput[2][i], m);
-                                    out[3] = 255;
-                                    out += n;
-                                }
-                            }
-                            else if (z->app14_color_transform == 2) { // YCCK
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    jpeg_uc m = coutput[3][i];
-                                    out[0] = jpeg__blinn_8x8(255 - out[0], m);
-                                    out[1] = jpeg__blinn_8x8(255 - out[1], m);
-                                    out[2] = jpeg__blinn_8x8(255 - out[2], m);
-                                    out += n;
-                                }
-                            }
-                            else { // YCbCr + alpha?  Ignore the fourth channel for now
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                            }
-                        }
-                        else
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                out[0] = out[1] = out[2] = y[i];
-                                out[3] = 255; // not used if n==3
-                                out += n;
-                            }
                     }
-                    else {
-                        if (is_rgb) {
-                            if (n == 1)
-                                for (i = 0; i < z->s->img_x; ++i)
-                                    *out++ = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                            else {
-                                for (i = 0; i < z->s->img_x; ++i, out += 2) {
-                                    out[0] = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                                    out[1] = 255;
-                                }
-                            }
-                        }
-                        else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                jpeg_uc m = coutput[3][i];
-                                jpeg_uc r = jpeg__blinn_8x8(coutput[0][i], m);
-                                jpeg_uc g = jpeg__blinn_8x8(coutput[1][i], m);
-                                jpeg_uc b = jpeg__blinn_8x8(coutput[2][i], m);
-                                out[0] = jpeg__compute_y(r, g, b);
-                                out[1] = 255;
-                                out += n;
-                            }
-                        }
-                        else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                out[0] = jpeg__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
-                                out[1] = 255;
-                                out += n;
-                            }
-                        }
-                        else {
-                            jpeg_uc* y = coutput[0];
-                            if (n == 1)
-                                for (i = 0; i < z->s->img_x; ++i) out[i] = y[i];
-                            else
-                                for (i = 0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+                    else { // YCCK
+                        for (i = 0; i < width; ++i, o += 3) {
+                            jpeg_uc m = coutput[3][i];
+                            o[0] = jpeg__blinn_8x8(255 - YuvToRed<Trect871>(coutput[0][i], coutput[2][i]), m);
+                            o[1] = jpeg__blinn_8x8(255 - YuvToGreen<Trect871>(coutput[0][i], coutput[1][i], coutput[2][i]), m);
+                            o[2] = jpeg__blinn_8x8(255 - YuvToBlue<Trect871>(coutput[0][i], coutput[1][i]), m);
                         }
                     }
+                    jpeg__convert_row(rgb, width, size, out, z->rgb_to_any_kernel, z->rgb_to_bgra_kernel);
                 }
-                jpeg__cleanup_jpeg(z);
-                *out_x = z->s->img_x;
-                *out_y = z->s->img_y;
-                if (comp) *comp = z->s->img_n >= 3 ? 3 : 1; // report original components, not output
-                return output;
             }
+            if (rgb)
+                JPEG_FREE(rgb);
+            return 1;
         }
 
-        static void* jpeg__jpeg_load(jpeg__context* s, int* x, int* y, int* comp, int req_comp, jpeg__result_info* ri)
+        // component planes hold gray or YCbCr data which can be copied without color conversion
+        static int jpeg__is_yuv(jpeg__jpeg* z)
         {
-            unsigned char* result;
-            jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
-            JPEG_NOTUSED(ri);
-            j->s = s;
-            jpeg__setup_jpeg(j);
-            result = load_jpeg_image(j, x, y, comp, req_comp);
-            JPEG_FREE(j);
-            return result;
+            if (z->s->img_n == 1)
+                return 1;
+            return z->s->img_n == 3 && !(z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+        }
+
+        // copy (or replicate for subsampled luma) the first component plane into output Y plane
+        static void jpeg__output_luma(jpeg__jpeg* z, jpeg_uc* dst, size_t stride)
+        {
+            const jpeg_uc* data = z->img_comp[0].data;
+            int w2 = z->img_comp[0].w2;
+            int hs = z->img_h_max / z->img_comp[0].h;
+            int vs = z->img_v_max / z->img_comp[0].v;
+            for (int y = 0; y < z->out_y; ++y, dst += stride)
+            {
+                const jpeg_uc* src = data + (y / vs) * w2;
+                if (hs == 1)
+                    memcpy(dst, src, z->out_x);
+                else
+                {
+                    for (int x = 0; x < z->out_x; ++x)
+                        dst[x] = src[x / hs];
+                }
+            }
+        }
+
+        // resample chroma component plane to 4:2:0 grid (step 2 is used for interleaved NV12 output)
+        static void jpeg__output_chroma(jpeg__jpeg* z, int k, jpeg_uc* dst, size_t stride, int step)
+        {
+            const jpeg_uc* data = z->img_comp[k].data;
+            int w2 = z->img_comp[k].w2;
+            int hs = z->img_h_max / z->img_comp[k].h;
+            int vs = z->img_v_max / z->img_comp[k].v;
+            int cw = (z->out_x + hs - 1) / hs, ch = (z->out_y + vs - 1) / vs;
+            int w = (z->out_x + 1) / 2, h = (z->out_y + 1) / 2;
+            for (int y = 0; y < h; ++y, dst += stride)
+            {
+                const jpeg_uc* src0 = data + Min(y * 2 / vs, ch - 1) * w2;
+                const jpeg_uc* src1 = vs == 1 ? data + Min(y * 2 + 1, ch - 1) * w2 : src0;
+                if (hs == 2 && vs == 2 && step == 1)
+                    memcpy(dst, src0, w);
+                else if (hs == 2 && vs == 2)
+                {
+                    for (int x = 0; x < w; ++x)
+                        dst[x * 2] = src0[x];
+                }
+                else if (hs == 1)
+                {
+                    for (int x = 0; x < w; ++x)
+                    {
+                        int x0 = x * 2, x1 = Min(x * 2 + 1, cw - 1);
+                        dst[x * step] = (src0[x0] + src0[x1] + src1[x0] + src1[x1] + 2) >> 2;
+                    }
+                }
+                else
+                {
+                    for (int x = 0; x < w; ++x)
+                    {
+                        int xs = x * 2 / hs;
+                        dst[x * step] = (src0[xs] + src1[xs] + 1) >> 1;
+                    }
+                }
+            }
+        }
+
+        // copy decoded gray or YCbCr components directly into Y, U, V (or Y, UV if v is NULL) planes
+        static void jpeg__output_planes(jpeg__jpeg* z, jpeg_uc* y, size_t yStride, jpeg_uc* u, size_t uStride, jpeg_uc* v, size_t vStride)
+        {
+            int w = (z->out_x + 1) / 2, h = (z->out_y + 1) / 2;
+            jpeg__output_luma(z, y, yStride);
+            if (z->s->img_n == 1)
+            {
+                for (int row = 0; row < h; ++row)
+                {
+                    memset(u + row * uStride, 128, v ? w : w * 2);
+                    if (v)
+                        memset(v + row * vStride, 128, w);
+                }
+            }
+            else if (v)
+            {
+                jpeg__output_chroma(z, 1, u, uStride, 1);
+                jpeg__output_chroma(z, 2, v, vStride, 1);
+            }
+            else
+            {
+                jpeg__output_chroma(z, 1, u + 0, uStride, 2);
+                jpeg__output_chroma(z, 2, u + 1, uStride, 2);
+            }
+        }
+
+        // fallback for RGB, CMYK and YCCK sources: converts intermediate BGR image to Y, U, V (or Y, UV if v is NULL) planes
+        static void jpeg__bgr_to_planes(const jpeg_uc* bgr, size_t bgrStride, size_t width, size_t height, 
+            jpeg_uc* y, size_t yStride, jpeg_uc* u, size_t uStride, jpeg_uc* v, size_t vStride)
+        {
+            size_t step = v ? 1 : 2;
+            if (v == NULL)
+                v = u + 1, vStride = uStride;
+            for (size_t row = 0; row < height; row += 2)
+            {
+                const jpeg_uc* bgr0 = bgr + row * bgrStride;
+                const jpeg_uc* bgr1 = row + 1 < height ? bgr0 + bgrStride : bgr0;
+                jpeg_uc* y0 = y + row * yStride;
+                jpeg_uc* y1 = row + 1 < height ? y0 + yStride : y0;
+                jpeg_uc* pu = u + row / 2 * uStride;
+                jpeg_uc* pv = v + row / 2 * vStride;
+                for (size_t col = 0; col < width; col += 2, pu += step, pv += step)
+                {
+                    size_t c0 = col * 3, c1 = col + 1 < width ? c0 + 3 : c0;
+                    y0[col] = BgrToY<Trect871>(bgr0[c0 + 0], bgr0[c0 + 1], bgr0[c0 + 2]);
+                    y1[col] = BgrToY<Trect871>(bgr1[c0 + 0], bgr1[c0 + 1], bgr1[c0 + 2]);
+                    if (col + 1 < width)
+                    {
+                        y0[col + 1] = BgrToY<Trect871>(bgr0[c1 + 0], bgr0[c1 + 1], bgr0[c1 + 2]);
+                        y1[col + 1] = BgrToY<Trect871>(bgr1[c1 + 0], bgr1[c1 + 1], bgr1[c1 + 2]);
+                    }
+                    int b = (bgr0[c0 + 0] + bgr0[c1 + 0] + bgr1[c0 + 0] + bgr1[c1 + 0] + 2) >> 2;
+                    int g = (bgr0[c0 + 1] + bgr0[c1 + 1] + bgr1[c0 + 1] + bgr1[c1 + 1] + 2) >> 2;
+                    int r = (bgr0[c0 + 2] + bgr0[c1 + 2] + bgr1[c0 + 2] + bgr1[c1 + 2] + 2) >> 2;
+                    *pu = BgrToU<Trect871>(b, g, r);
+                    *pv = BgrToV<Trect871>(b, g, r);
+                }
+            }
         }
 
         static int jpeg__jpeg_test(jpeg__context* s)
@@ -2349,7 +2093,6 @@ namespace Simd
             int r;
             jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
             j->s = s;
-            jpeg__setup_jpeg(j);
             r = jpeg__decode_jpeg_header(j, JPEG__SCAN_type);
             jpeg__rewind(s);
             JPEG_FREE(j);
@@ -2398,6 +2141,56 @@ namespace Simd
             return stream->Pos() == stream->Size() ? 1 : 0;
         }
 
+        static void jpeg__init_context(jpeg__context* s, InputMemoryStream* stream)
+        {
+            s->io.eof = jpeg__stdio_eof;
+            s->io.read = jpeg__stdio_read;
+            s->io.skip = jpeg__stdio_skip;
+            s->io_user_data = stream;
+            s->buflen = sizeof(s->buffer_start);
+            s->read_from_callbacks = 1;
+            s->callback_already_read = 0;
+            s->img_buffer = s->img_buffer_original = s->buffer_start;
+            jpeg__refill_buffer(s);
+            s->img_buffer_original_end = s->img_buffer_end;
+            s->img_n = 0;
+        }
+
+        //---------------------------------------------------------------------
+
+        template<class T> void JpegYuvToBgr(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* bgr)
+        {
+            for (size_t i = 0; i < width; ++i, bgr += 3)
+                YuvToBgr<T>(y[i], u[i], v[i], bgr);
+        }
+
+        template<class T> void JpegYuvToBgra(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* bgra)
+        {
+            for (size_t i = 0; i < width; ++i, bgra += 4)
+                YuvToBgra<T>(y[i], u[i], v[i], 0xFF, bgra);
+        }
+
+        template<class T> void JpegYuvToRgb(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* rgb)
+        {
+            for (size_t i = 0; i < width; ++i, rgb += 3)
+            {
+                rgb[0] = YuvToRed<T>(y[i], v[i]);
+                rgb[1] = YuvToGreen<T>(y[i], u[i], v[i]);
+                rgb[2] = YuvToBlue<T>(y[i], u[i]);
+            }
+        }
+
+        template<class T> void JpegYuvToRgba(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* rgba)
+        {
+            for (size_t i = 0; i < width; ++i, rgba += 4)
+            {
+                rgba[0] = YuvToRed<T>(y[i], v[i]);
+                rgba[1] = YuvToGreen<T>(y[i], u[i], v[i]);
+                rgba[2] = YuvToBlue<T>(y[i], u[i]);
+                rgba[3] = 0xFF;
+            }
+        }
+
         //---------------------------------------------------------------------
 
         ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
@@ -2405,52 +2198,157 @@ namespace Simd
         {
             if (_param.format == SimdPixelFormatNone)
                 _param.format = SimdPixelFormatRgb24;
+            if (_param.planes > 1)
+                _param.format = SimdPixelFormatBgr24;
+            _idctBlocks = jpeg__idct_blocks;
+            _upsampleV2 = jpeg__resample_row_v_2;
+            _upsampleH2 = jpeg__resample_row_h_2;
+#if defined(JPEG_NEON)
+            _upsampleHv2 = jpeg__resample_row_hv_2_simd;
+#else
+            _upsampleHv2 = jpeg__resample_row_hv_2;
+#endif
         }
 
         bool ImageJpegLoader::FromStream()
         {
-            int x, y, comp;
             jpeg__context s;
-            s.io.eof = jpeg__stdio_eof;
-            s.io.read = jpeg__stdio_read;
-            s.io.skip = jpeg__stdio_skip;
-            s.io_user_data = &_stream;
-            s.buflen = sizeof(s.buffer_start);
-            s.read_from_callbacks = 1;
-            s.callback_already_read = 0;
-            s.img_buffer = s.img_buffer_original = s.buffer_start;
-            jpeg__refill_buffer(&s);
-            s.img_buffer_original_end = s.img_buffer_end;
-            jpeg__result_info ri;
-            uint8_t * data = (uint8_t*)jpeg__jpeg_load(&s, &x, &y, &comp, 3, &ri);
-            if (data)
+            jpeg__init_context(&s, &_stream);
+            bool result = false;
+            _context.Resize(sizeof(jpeg__jpeg));
+            jpeg__jpeg* j = (jpeg__jpeg*)_context.data;
+            j->s = &s;
+            j->scratch = _scratch;
+            j->scale = (int)_param.scale;
+            j->block_size = 8 / j->scale;
+            switch (j->scale)
             {
-                size_t stride = 3 * x;
-                _image.Recreate(x, y, (Image::Format)_param.format);
-                switch (_param.format)
+            case 2: j->idct_blocks_kernel = jpeg__idct_blocks_4x4; break;
+            case 4: j->idct_blocks_kernel = jpeg__idct_blocks_2x2; break;
+            case 8: j->idct_blocks_kernel = jpeg__idct_blocks_1x1; break;
+            default: j->idct_blocks_kernel = _idctBlocks;
+            }
+            if (jpeg__decode_jpeg_image(j))
+            {
+                _width = j->out_x;
+                _height = j->out_y;
+                if (_param.planes > 1)
                 {
-                case SimdPixelFormatGray8:
-                    Base::RgbToGray(data, x, y, stride, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatBgr24:
-                    Base::BgrToRgb(data, x, y, stride, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatBgra32:
-                    Base::RgbToBgra(data, x, y, stride, _image.data, _image.stride, 0xFF);
-                    break;
-                case SimdPixelFormatRgb24:
-                    Base::Copy(data, stride, x, y, 3, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatRgba32:
-                    Base::BgrToBgra(data, x, y, stride, _image.data, _image.stride, 0xFF);
-                    break;
-                default: 
-                    break;
+                    _image.Recreate(_param.planes == 2 ? (_width + 1) / 2 * 2 : _width, _height + (_height + 1) / 2 * (_param.planes - 1), Image::Gray8);
+                    result = true;
+                }
+                else
+                    result = InitImage(_width, _height);
+            }
+            if (result)
+            {
+                SetConverters();
+                j->resample_row_v_2_kernel = _upsampleV2;
+                j->resample_row_h_2_kernel = _upsampleH2;
+                j->resample_row_hv_2_kernel = _upsampleHv2;
+                j->yuv_to_any_kernel = _yuvToAny;
+                j->gray_to_any_kernel = _grayToAny;
+                j->gray_to_bgra_kernel = _grayToBgra;
+                j->rgb_to_any_kernel = _rgbToAny;
+                j->rgb_to_bgra_kernel = _rgbToBgra;
+                if (_param.planes > 1)
+                {
+                    uint8_t* y, * u, * v;
+                    size_t yStride, uStride, vStride;
+                    GetPlanes(&y, &yStride, &u, &uStride, &v, &vStride);
+                    if (jpeg__is_yuv(j))
+                        jpeg__output_planes(j, y, yStride, u, uStride, v, vStride);
+                    else
+                    {
+                        Image bgr(_width, _height, Image::Bgr24);
+                        result = jpeg__output_image(j, bgr.data, bgr.stride, bgr.PixelSize(), 0) != 0;
+                        if (result)
+                            jpeg__bgr_to_planes(bgr.data, bgr.stride, _width, _height, y, yStride, u, uStride, v, vStride);
+                    }
                 }
-                JPEG_FREE(data);
-                return true;
+                else
+                    result = jpeg__output_image(j, _image.data, _image.stride, _image.PixelSize(), _param.format == SimdPixelFormatGray8) != 0;
+            }
+            jpeg__cleanup_jpeg(j);
+            return result;
+        }
+
+        bool ImageJpegLoader::Probe(size_t* width, size_t* height)
+        {
+            jpeg__context s;
+            _stream.Seek(0);
+            jpeg__init_context(&s, &_stream);
+            _context.Resize(sizeof(jpeg__jpeg));
+            jpeg__jpeg* j = (jpeg__jpeg*)_context.data;
+            j->s = &s;
+            int x, y;
+            if (!jpeg__jpeg_info_raw(j, &x, &y, NULL))
+                return false;
+            *width = (x + _param.scale - 1) / _param.scale;
+            *height = (y + _param.scale - 1) / _param.scale;
+            return true;
+        }
+
+        void ImageJpegLoader::GetPlanes(uint8_t** y, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride)
+        {
+            *y = _image.data;
+            *yStride = _image.stride;
+            *u = _image.data + _height * _image.stride;
+            *uStride = _image.stride;
+            if (_param.planes == 3)
+            {
+                *v = *u + (_height + 1) / 2 * _image.stride;
+                *vStride = _image.stride;
+            }
+            else
+            {
+                *v = NULL;
+                *vStride = 0;
+            }
+        }
+
+        uint8_t* ImageJpegLoader::ReleasePlanes(size_t* width, size_t* height, uint8_t** y, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride)
+        {
+            GetPlanes(y, yStride, u, uStride, v, vStride);
+            *width = _width;
+            *height = _height;
+            return _image.Release();
+        }
+
+        void ImageJpegLoader::SetConverters()
+        {
+            _yuvToAny = NULL;
+            _grayToAny = NULL;
+            _grayToBgra = NULL;
+            _rgbToAny = NULL;
+            _rgbToBgra = NULL;
+            switch (_param.format)
+            {
+            case SimdPixelFormatGray8:
+                _rgbToAny = Base::RgbToGray;
+                break;
+            case SimdPixelFormatBgr24:
+                _yuvToAny = JpegYuvToBgr<Trect871>;
+                _grayToAny = Base::GrayToBgr;
+                _rgbToAny = Base::BgrToRgb;
+                break;
+            case SimdPixelFormatBgra32:
+                _yuvToAny = JpegYuvToBgra<Trect871>;
+                _grayToBgra = Base::GrayToBgra;
+                _rgbToBgra = Base::RgbToBgra;
+                break;
+            case SimdPixelFormatRgb24:
+                _yuvToAny = JpegYuvToRgb<Trect871>;
+                _grayToAny = Base::GrayToBgr;
+                break;
+            case SimdPixelFormatRgba32:
+                _yuvToAny = JpegYuvToRgba<Trect871>;
+                _grayToBgra = Base::GrayToBgra;
+                _rgbToBgra = Base::BgrToBgra;
+                break;
+            default:
+                break;
             }
-            return false;
         }
     }
 }
@@ -40,13 +40,23 @@ namespace Simd
 
         namespace Zlib
         {
-            const size_t ZFAST_BITS = 9;
+            const size_t ZFAST_BITS = 11;
             const size_t ZFAST_SIZE = 1 << ZFAST_BITS;
             const size_t ZFAST_MASK = ZFAST_SIZE - 1;
 
+            static SIMD_INLINE int BitRev16(int n)
+            {
+                n = ((n & 0xAAAA) >> 1) | ((n & 0x5555) << 1);
+                n = ((n & 0xCCCC) >> 2) | ((n & 0x3333) << 2);
+                n = ((n & 0xF0F0) >> 4) | ((n & 0x0F0F) << 4);
+                n = ((n & 0xFF00) >> 8) | ((n & 0x00FF) << 8);
+                return n;
+            }
+
             struct Zhuffman
             {
                 uint16_t fast[ZFAST_SIZE];
+                uint32_t multi[ZFAST_SIZE];
                 uint16_t firstCode[16];
                 int maxCode[17];
                 uint16_t firstSymbol[16];
@@ -91,7 +101,7 @@ namespace Simd
                             value[c] = (uint16_t)i;
                             if (s <= (int)ZFAST_BITS)
                             {
-                                int j = ZlibBitRev(nextCode[s], s);
+                                int j = BitRev16(nextCode[s]) >> (16 - s);
                                 while (j < (1 << ZFAST_BITS))
                                 {
                                     fast[j] = fastv;
@@ -103,16 +113,22 @@ namespace Simd
                     }
                     return 1;
                 }
-            };
 
-            static SIMD_INLINE int BitRev16(int n)
-            {
-                n = ((n & 0xAAAA) >> 1) | ((n & 0x5555) << 1);
-                n = ((n & 0xCCCC) >> 2) | ((n & 0x3333) << 2);
-                n = ((n & 0xF0F0) >> 4) | ((n & 0x0F0F) << 4);
-                n = ((n & 0xFF00) >> 8) | ((n & 0x00FF) << 8);
-                return n;
-            }
+                void BuildMulti()
+                {
+                    for (size_t i = 0; i < ZFAST_SIZE; ++i)
+                    {
+                        int b = fast[i], s = b >> 9, v = b & 511;
+                        multi[i] = b ? (v | (s << 20)) : 0;
+                        if (b && v < 256)
+                        {
+                            int b2 = fast[i >> s], s2 = b2 >> 9, v2 = b2 & 511;
+                            if (b2 && v2 < 256 && s + s2 <= (int)ZFAST_BITS)
+                                multi[i] = v | (v2 << 9) | ((s + s2) << 20) | (1 << 24);
+                        }
+                    }
+                }
+            };
 
             static SIMD_INLINE int ZhuffmanDecode(InputMemoryStream& is, const Zhuffman& z)
             {
@@ -147,30 +163,76 @@ namespace Simd
                 }
             }
 
+            static SIMD_INLINE void Reserve(OutputMemoryStream& os, uint8_t*& beg, uint8_t*& dst, uint8_t*& end, size_t size)
+            {
+                os.Seek(dst - beg);
+                os.Reserve(os.Pos() + size);
+                beg = os.Data();
+                dst = os.Current();
+                end = beg + os.Capacity();
+            }
+
+            static SIMD_INLINE void CopyMatch(uint8_t* dst, int dist, int len)
+            {
+                const uint8_t* src = dst - dist;
+                if (dist >= 16)
+                {
+                    for (int i = 0; i < len; i += 16)
+                        memcpy(dst + i, src + i, 16);
+                }
+                else if (dist >= 8)
+                {
+                    for (int i = 0; i < len; i += 8)
+                        memcpy(dst + i, src + i, 8);
+                }
+                else if (dist == 1)
+                    memset(dst, src[0], len);
+                else
+                {
+                    for (int i = 0; i < len; ++i)
+                        dst[i] = src[i];
+                }
+            }
+
             static int ParseHuffmanBlock(InputMemoryStream& is, const Zhuffman& zLength, const Zhuffman& zDistance, OutputMemoryStream& os)
             {
                 static const int zlengthBase[31] = { 3,4,5,6,7,8,9,10,11,13, 15,17,19,23,27,31,35,43,51,59, 67,83,99,115,131,163,195,227,258,0,0 };
                 static const int zlengthExtra[31] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0,0,0 };
                 static const int zdistBase[32] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193, 257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577,0,0 };
                 static const int zdistExtra[32] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+                const ptrdiff_t SLACK = 258 + 16;
 
                 SIMD_PERF_FUNC();
 
                 uint8_t* beg = os.Data(), * dst = os.Current(), * end = beg + os.Capacity();
                 for (;;)
                 {
-                    int z = ZhuffmanDecode(is, zLength);
+                    if (end - dst < SLACK)
+                        Reserve(os, beg, dst, end, SLACK);
+                    int z;
+                    if (is.BitCount() < 16)
+                        is.FillBits();
+                    uint32_t multi = is.BitCount() >= ZFAST_BITS ? zLength.multi[is.BitBuffer() & ZFAST_MASK] : 0;
+                    if (multi)
+                    {
+                        int s = (multi >> 20) & 15;
+                        is.BitBuffer() >>= s;
+                        is.BitCount() -= s;
+                        if (multi & (1 << 24))
+                        {
+                            dst[0] = (uint8_t)multi;
+                            dst[1] = (uint8_t)(multi >> 9);
+                            dst += 2;
+                            continue;
+                        }
+                        z = multi & 511;
+                    }
+                    else
+                        z = ZhuffmanDecode(is, zLength);
                     if (z < 256)
                     {
                         if (z < 0)
                             return PngError("bad huffman code", "Corrupt PNG");
-                        if (dst >= end)
-                        {
-                            os.Reserve(end - beg + 1);
-                            beg = os.Data();
-                            dst = os.Current();
-                            end = beg + os.Capacity();
-                        }
                         *dst++ = (uint8_t)z;
                     }
                     else
@@ -193,41 +255,8 @@ namespace Simd
                             dist += (int)is.ReadBits(zdistExtra[z]);
                         if (dst - beg < dist)
                             return PngError("bad dist", "Corrupt PNG");
-                        if (dst + len > end)
-                        {
-                            os.Reserve(dst - beg + len);
-                            beg = os.Data();
-                            dst = os.Current();
-                            end = beg + os.Capacity();
-                        }
-                        if (dist == 1)
-                        {
-                            uint8_t val = dst[-dist];
-                            if (len < 16)
-                            {
-                                while (len--)
-                                    *dst++ = val;
-                            }
-                            else
-                            {
-                                memset(dst, val, len);
-                                dst += len;
-                            }
-                        }
-                        else
-                        {
-                            uint8_t* src = dst - dist;
-                            if (dist < len || len < 16)
-                            {
-                                while(len--)
-                                    *dst++ = *src++;
-                            }
-                            else
-                            {
-                                memcpy(dst, src, len);
-                                dst += len;
-                            }                        
-                        }
+                        CopyMatch(dst, dist, len);
+                        dst += len;
                     }
                 }
             }
@@ -365,6 +394,7 @@ namespace Simd
                             if (!ComputeHuffmanCodes(is, zLength, zDistance))
                                 return false;
                         }
+                        zLength.BuildMulti();
                         if (!ParseHuffmanBlock(is, zLength, zDistance, os))
                             return false;
                     }
@@ -375,12 +405,52 @@ namespace Simd
 
 #define PNG__BYTECAST(x)  ((uint8_t) ((x) & 255))  // truncate int to byte without warnings
 
+        void PngDecodeLineSub(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst)
+        {
+            size_t i = 0;
+            for (; i < bpp; ++i)
+                dst[i] = src[i];
+            for (; i < size; ++i)
+                dst[i] = src[i] + dst[i - bpp];
+        }
+
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = src[i] + prev[i];
+        }
+
+        void PngDecodeLineAvg(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst)
+        {
+            size_t i = 0;
+            for (; i < bpp; ++i)
+                dst[i] = src[i] + (prev[i] >> 1);
+            for (; i < size; ++i)
+                dst[i] = src[i] + ((prev[i] + dst[i - bpp]) >> 1);
+        }
+
+        void PngDecodeLinePaeth(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst)
+        {
+            size_t i = 0;
+            for (; i < bpp; ++i)
+                dst[i] = src[i] + prev[i];
+            for (; i < size; ++i)
+                dst[i] = src[i] + Paeth(dst[i - bpp], prev[i], prev[i - bpp]);
+        }
+
+        //---------------------------------------------------------------------
+
+        typedef void (*DecodeLinePtr)(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        typedef void (*Reorder16bitPtr)(const uint8_t* src, size_t size, uint8_t* dst);
+
         struct Png
         {
             uint32_t width, height;
             int channels, img_out_n;
             uint8_t depth;
             Array8u buf0, buf1;
+            DecodeLinePtr decodeLine[5];
+            Reorder16bitPtr reorder16bit;
 
             SIMD_INLINE int Swap()
             {
@@ -453,6 +523,12 @@ namespace Simd
                     width = img_width_bytes;
                 }
                 prior = cur - stride; // bugfix: need to compute this after 'cur +=' computation above
+                if (depth >= 8 && img_n == out_n && (j > 0 || filter == PNG__F_sub) && filter != PNG__F_none)
+                {
+                    a.decodeLine[filter](raw, prior, x * filter_bytes, filter_bytes, cur);
+                    raw += x * filter_bytes;
+                    continue;
+                }
                 if (j == 0) 
                     filter = FirstRowFilter[filter];
 
@@ -620,10 +696,11 @@ namespace Simd
             }
             else if (depth == 16) 
             {
-                uint8_t* cur = a.buf0.data;
-                uint16_t* cur16 = (uint16_t*)cur;
-                for (i = 0; i < x * y * out_n; ++i, cur16++, cur += 2)
-                    *cur16 = (cur[0] << 8) | cur[1];
+                size_t size = size_t(x) * y * out_n * 2;
+                if (size >= SIMD_ALIGN)
+                    a.reorder16bit(a.buf0.data, size, a.buf0.data);
+                else
+                    Base::Reorder16bit(a.buf0.data, size, a.buf0.data);
             }
             return 1;
         }
@@ -826,14 +903,30 @@ namespace Simd
             , _toBgra8(NULL)
             , _toAny16(NULL)
             , _toBgra16(NULL)
+            , _reorder16(NULL)
         {
             if (_param.format == SimdPixelFormatNone)
                 _param.format = SimdPixelFormatRgba32;
+            _decodeLine[0] = NULL;
+            _decodeLine[1] = PngDecodeLineSub;
+            _decodeLine[2] = PngDecodeLineUp;
+            _decodeLine[3] = PngDecodeLineAvg;
+            _decodeLine[4] = PngDecodeLinePaeth;
         }
 
         void ImagePngLoader::SetConverters()
         {
             _bgrToBgra = Base::BgrToBgra;
+            _rgbToBgr = Base::BgrToRgb;
+            _reorder16 = Base::Reorder16bit;
+            switch (_param.format)
+            {
+            case SimdPixelFormatGray8: _rgbaToAny = Base::RgbaToGray; break;
+            case SimdPixelFormatBgr24: _rgbaToAny = Base::BgraToRgb; break;
+            case SimdPixelFormatBgra32: _rgbaToAny = Base::BgraToRgba; break;
+            case SimdPixelFormatRgb24: _rgbaToAny = Base::BgraToBgr; break;
+            default: _rgbaToAny = NULL;
+            }
         }
 
 #ifdef SIMD_CPP_2011_ENABLE
@@ -855,21 +948,27 @@ namespace Simd
             p.height = _height;
             p.channels = _channels;
             p.depth = _depth;
+            for (size_t i = 0; i < 5; ++i)
+                p.decodeLine[i] = _decodeLine[i];
+            p.reorder16bit = _reorder16;
 
             InputMemoryStream zSrc = MergedDataStream();
-            OutputMemoryStream zDst(AlignHi(size_t(_width) * _depth, 8) * _height * _channels + _height);
-            if(!Zlib::Decode(zSrc, zDst, !_iPhone))
+            _zDst.Clear();
+            _zDst.Reserve(AlignHi(size_t(_width) * _depth, 8) * _height * _channels + _height);
+            if(!Zlib::Decode(zSrc, _zDst, !_iPhone))
                 return false;
 
             int req_comp = 4;
-            if (Image::ChannelCount((Image::Format)_param.format) == _channels && _depth != 16)
+            if (_param.format == SimdPixelFormatInt16)
+                req_comp = 1;
+            else if (Image::ChannelCount((Image::Format)_param.format) == _channels && _depth != 16)
                 req_comp = _channels;
 
             if ((req_comp == p.channels + 1 && req_comp != 3 && !_paletteChannels) || _hasTrans)
                 p.img_out_n = p.channels + 1;
             else
                 p.img_out_n = p.channels;
-            if (!CreatePngImage(p, zDst.Data(), (int)zDst.Size(), p.img_out_n, p.depth, _color, _interlace))
+            if (!CreatePngImage(p, _zDst.Data(), (int)_zDst.Size(), p.img_out_n, p.depth, _color, _interlace))
                 return 0;
             if (_hasTrans) 
             {
@@ -904,7 +1003,20 @@ namespace Simd
                 if (res == 0)
                     return false;
             }
-            if (p.depth == 16)
+            if (_param.format == SimdPixelFormatInt16)
+            {
+                if (p.depth != 16)
+                {
+                    size_t size = p.width * p.height;
+                    p.buf1.Resize(size * 2);
+                    const uint8_t* src = p.buf0.data;
+                    uint16_t* dst = (uint16_t*)p.buf1.data;
+                    for (size_t i = 0; i < size; ++i)
+                        dst[i] = src[i] * 257;
+                    p.buf0.Swap(p.buf1);
+                }
+            }
+            else if (p.depth == 16)
             {
                 size_t size = p.width * p.height * req_comp;
                 p.buf1.Resize(size);
@@ -916,32 +1028,34 @@ namespace Simd
             }
             if (p.buf0.data)
             {
-                size_t stride = req_comp * p.width;
-                _image.Recreate(p.width, p.height, (Image::Format)_param.format);
+                size_t stride = req_comp * p.width * (_param.format == SimdPixelFormatInt16 ? 2 : 1);
+                if (!InitImage(p.width, p.height))
+                    return false;
                 switch (_param.format)
                 {
                 case SimdPixelFormatGray8:
                     if(req_comp != 4)
                         Base::Copy(p.buf0.data, stride, p.width, p.height, _image.PixelSize(), _image.data, _image.stride);
                     else
-                        Base::RgbaToGray(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
+                        _rgbaToAny(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
                     break;
                 case SimdPixelFormatBgr24:
                     if (req_comp != 4)
-                        Base::BgrToRgb(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
+                        _rgbToBgr(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
                     else
-                        Base::BgraToRgb(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
+                        _rgbaToAny(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
                     break;
                 case SimdPixelFormatBgra32:
-                    Base::BgraToRgba(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
+                    _rgbaToAny(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
                     break;
                 case SimdPixelFormatRgb24:
                     if (req_comp != 4)
                         Base::Copy(p.buf0.data, stride, p.width, p.height, _image.PixelSize(), _image.data, _image.stride);
                     else
-                        Base::BgraToBgr(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
+                        _rgbaToAny(p.buf0.data, p.width, p.height, stride, _image.data, _image.stride);
                     break;
                 case SimdPixelFormatRgba32:
+                case SimdPixelFormatInt16:
                     Base::Copy(p.buf0.data, stride, p.width, p.height, _image.PixelSize(), _image.data, _image.stride);
                     break;
                 default: 
@@ -952,9 +1066,24 @@ namespace Simd
             return false;
         }
 
+        bool ImagePngLoader::Probe(size_t* width, size_t* height)
+        {
+            _stream.Seek(0);
+            Chunk chunk;
+            uint32_t w, h;
+            if (!(CheckHeader() && ReadChunk(chunk) && chunk.type == ChunkType('I', 'H', 'D', 'R') && chunk.size == 13))
+                return false;
+            if (!(_stream.ReadBe32u(w) && _stream.ReadBe32u(h) && w > 0 && h > 0))
+                return false;
+            *width = w;
+            *height = h;
+            return true;
+        }
+
         bool ImagePngLoader::ParseFile()
         {
             _first = true, _iPhone = false, _hasTrans = false;
+            _idats.clear();
             if (!CheckHeader())
                 return false;
             for (bool run = true; run;)
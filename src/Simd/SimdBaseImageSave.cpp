@@ -64,11 +64,12 @@ namespace Simd
         ImagePxmSaver::ImagePxmSaver(const ImageSaverParam& param)
             : ImageSaver(param)
             , _convert(NULL)
+            , _reorder(NULL)
         {
             _block = _param.height;
             if (_param.file == SimdImageFilePgmTxt || _param.file == SimdImageFilePgmBin)
             {
-                _size = _param.width * 1;
+                _size = _param.width * (_param.format == SimdPixelFormatInt16 ? 2 : 1);
                 if (_param.format != SimdPixelFormatGray8)
                 {
                     _block = Simd::RestrictRange<size_t>(Base::AlgCacheL1() / _size, 1, _param.height);
@@ -91,7 +92,8 @@ namespace Simd
         void ImagePxmSaver::WriteHeader(size_t version)
         {
             std::stringstream header;
-            header << "P" << version << "\n" << _param.width << " " << _param.height << "\n255\n";
+            header << "P" << version << "\n" << _param.width << " " << _param.height << "\n";
+            header << (_param.format == SimdPixelFormatInt16 ? 65535 : 255) << "\n";
             _stream.Write(header.str().c_str(), header.str().size());
         }
 
@@ -174,6 +176,7 @@ namespace Simd
             case SimdPixelFormatBgra32: _convert = Base::BgraToGray; break;
             case SimdPixelFormatRgb24: _convert = Base::RgbToGray; break;
             case SimdPixelFormatRgba32: _convert = Base::RgbaToGray; break;
+            case SimdPixelFormatInt16: _reorder = Base::Reorder16bit; break;
             default: break;
             }
         }
@@ -187,7 +190,13 @@ namespace Simd
             {
                 size_t block = Simd::Min(row + _block, _param.height) - row;
                 const uint8_t* gray = src;
-                if (_param.format != SimdPixelFormatGray8)
+                if (_param.format == SimdPixelFormatInt16)
+                {
+                    for (size_t b = 0; b < block; ++b)
+                        _reorder(src + b * stride, _size, _buffer.data + b * _size);
+                    gray = _buffer.data;
+                }
+                else if (_param.format != SimdPixelFormatGray8)
                 {
                     _convert(src, _param.width, block, stride, _buffer.data, grayStride);
                     gray = _buffer.data;
@@ -303,6 +312,29 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImagePfmSaver::ImagePfmSaver(const ImageSaverParam& param)
+            : ImageSaver(param)
+        {
+        }
+
+        bool ImagePfmSaver::ToStream(const uint8_t* src, size_t stride)
+        {
+            size_t size = _param.width * 4;
+            std::stringstream header;
+#if defined(SIMD_BIG_ENDIAN)
+            header << "Pf\n" << _param.width << " " << _param.height << "\n1.0\n";
+#else
+            header << "Pf\n" << _param.width << " " << _param.height << "\n-1.0\n";
+#endif
+            _stream.Reserve(header.str().size() + _param.height * size);
+            _stream.Write(header.str().c_str(), header.str().size());
+            for (size_t row = 0; row < _param.height; ++row)
+                _stream.Write(src + (_param.height - 1 - row) * stride, size);
+            return true;
+        }
+
+        //---------------------------------------------------------------------
+
         ImageSaver* CreateImageSaver(const ImageSaverParam& param)
         {
             switch (param.file)
@@ -313,6 +345,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinSaver(param);
             case SimdImageFilePng:    return new ImagePngSaver(param);
             case SimdImageFileJpeg:   return new ImageJpegSaver(param);
+            case SimdImageFilePfm:    return new ImagePfmSaver(param);
             default:
                 return NULL;
             }
@@ -25,6 +25,9 @@
 #include "Simd/SimdImageSave.h"
 #include "Simd/SimdImageSaveJpeg.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
+
+#include <vector>
 
 namespace Simd
 {
@@ -365,6 +368,41 @@ namespace Simd
             bitBuf.Clear();
         }
 
+        template<class Writer> void JpegWriteRows(OutputMemoryStream& stream, int height, int block, size_t threads, const Writer & writer)
+        {
+            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
+            int rows = DivHi(height, block);
+            if (threads > 1)
+            {
+                std::vector<OutputMemoryStream> bands(threads);
+                Parallel(0, rows, [&](size_t thread, size_t begin, size_t end)
+                {
+                    OutputMemoryStream& band = thread ? bands[thread] : stream;
+                    for (int row = (int)begin; row < (int)end; ++row)
+                    {
+                        int dc[3] = { 0, 0, 0 };
+                        writer(band, thread, row * block, Simd::Min(block, height - row * block), dc);
+                        Base::WriteBits(band, FILL_BITS);
+                        band.BitCount() = 0;
+                        band.BitBuffer() = 0;
+                        if (row + 1 < rows)
+                        {
+                            band.Write8u(0xFF);
+                            band.Write8u(0xD0 | (row & 7));
+                        }
+                    }
+                }, threads);
+                for (size_t thread = 1; thread < threads; ++thread)
+                    stream.Write(bands[thread].Data(), bands[thread].Size());
+            }
+            else
+            {
+                int dc[3] = { 0, 0, 0 };
+                for (int row = 0; row < rows; ++row)
+                    writer(stream, 0, row * block, Simd::Min(block, height - row * block), dc);
+            }
+        }
+
         //---------------------------------------------------------------------
 
         ImageJpegSaver::ImageJpegSaver(const ImageSaverParam& param)
@@ -374,6 +412,7 @@ namespace Simd
             , _writeBlock(NULL)
             , _writeNv12Block(NULL)
             , _writeYuv420pBlock(NULL)
+            , _threads(1)
         {
         }
 
@@ -438,8 +477,11 @@ namespace Simd
             }
             _block = _subSample ? 16 : 8;
             _width = (int)AlignHi(_param.width, _block);
+            _threads = Simd::Min<size_t>(Base::GetThreadNumber(), DivHi(_param.height, _block));
+            if (_width / _block > 0xFFFF)
+                _threads = 1;
             if (_param.format != SimdPixelFormatGray8 && _param.yuvType == SimdYuvUnknown)
-                _buffer.Resize(_width * _block * 3);
+                _buffer.Resize(_width * _block * 3 * _threads);
         }
 
         void ImageJpegSaver::WriteHeader()
@@ -488,6 +530,12 @@ namespace Simd
             _stream.Write8u(0x11); // HTUACinfo
             _stream.Write(AC_CHR_COD + 1, sizeof(AC_CHR_COD) - 1);
             _stream.Write(AC_CHR_VAL, sizeof(AC_CHR_VAL));
+            if (_threads > 1)
+            {
+                int interval = _width / _block;
+                const uint8_t dri[] = { 0xFF, 0xDD, 0, 4, uint8_t(interval >> 8), uint8_t(interval) };
+                _stream.Write(dri, sizeof(dri));
+            }
             _stream.Write(head2, sizeof(head2));
         }
 
@@ -495,34 +543,34 @@ namespace Simd
         {
             Init();
             WriteHeader();
-            uint8_t* r = _buffer.data, * g = r + _width * _block,* b = g + _width * _block;
-            int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            JpegWriteRows(_stream, (int)_param.height, _block, _threads, [&](OutputMemoryStream& stream, size_t thread, int row, int block, int dc[3])
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
+                const uint8_t* s = src + row * stride;
+                if (_param.format == SimdPixelFormatGray8)
+                {
+                    _writeBlock(stream, (int)_param.width, block, s, s, s, (int)stride, _fY, _fUv, dc);
+                    return;
+                }
+                uint8_t* r = _buffer.data + thread * _width * _block * 3, * g = r + _width * _block, * b = g + _width * _block;
                 switch (_param.format)
                 {
                 case SimdPixelFormatBgr24:
-                    _deintBgr(src, stride, _param.width, block, b, _width, g, _width, r, _width);
+                    _deintBgr(s, stride, _param.width, block, b, _width, g, _width, r, _width);
                     break;
                 case SimdPixelFormatBgra32:
-                    _deintBgra(src, stride, _param.width, block, b, _width, g, _width, r, _width, NULL, 0);
+                    _deintBgra(s, stride, _param.width, block, b, _width, g, _width, r, _width, NULL, 0);
                     break;
                 case SimdPixelFormatRgb24:
-                    _deintBgr(src, stride, _param.width, block, r, _width, g, _width, b, _width);
+                    _deintBgr(s, stride, _param.width, block, r, _width, g, _width, b, _width);
                     break;
                 case SimdPixelFormatRgba32:
-                    _deintBgra(src, stride, _param.width, block, r, _width, g, _width, b, _width, NULL, 0);
+                    _deintBgra(s, stride, _param.width, block, r, _width, g, _width, b, _width, NULL, 0);
                     break;
-                default: 
+                default:
                     break;
                 }
-                if(_param.format == SimdPixelFormatGray8)
-                    _writeBlock(_stream, (int)_param.width, block, src, src, src, (int)stride, _fY, _fUv, dc);
-                else
-                    _writeBlock(_stream, (int)_param.width, block, r, g, b, _width, _fY, _fUv, dc);
-                src += block * stride;
-            }
+                _writeBlock(stream, (int)_param.width, block, r, g, b, _width, _fY, _fUv, dc);
+            });
             static const uint16_t FILL_BITS[] = { 0x7F, 7 };
             Base::WriteBits(_stream, FILL_BITS);
             _stream.Write8u(0xFF);
@@ -534,14 +582,10 @@ namespace Simd
         {
             Init();
             WriteHeader();
-            int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            JpegWriteRows(_stream, (int)_param.height, _block, _threads, [&](OutputMemoryStream& stream, size_t thread, int row, int block, int dc[3])
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
-                _writeNv12Block(_stream, (int)_param.width, block, y, (int)yStride, uv, (int)uvStride, _fY, _fUv, dc);
-                y += block * yStride;
-                uv += (block / 2) * uvStride;
-            }
+                _writeNv12Block(stream, (int)_param.width, block, y + row * yStride, (int)yStride, uv + row / 2 * uvStride, (int)uvStride, _fY, _fUv, dc);
+            });
             static const uint16_t FILL_BITS[] = { 0x7F, 7 };
             Base::WriteBits(_stream, FILL_BITS);
             _stream.Write8u(0xFF);
@@ -553,15 +597,11 @@ namespace Simd
         {
             Init();
             WriteHeader();
-            int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            JpegWriteRows(_stream, (int)_param.height, _block, _threads, [&](OutputMemoryStream& stream, size_t thread, int row, int block, int dc[3])
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
-                _writeYuv420pBlock(_stream, (int)_param.width, block, y, (int)yStride, u, (int)uStride, v, (int)vStride, _fY, _fUv, dc);
-                y += block * yStride;
-                u += (block / 2) * uStride;
-                v += (block / 2) * vStride;
-            }
+                _writeYuv420pBlock(stream, (int)_param.width, block, y + row * yStride, (int)yStride, 
+                    u + row / 2 * uStride, (int)uStride, v + row / 2 * vStride, (int)vStride, _fY, _fUv, dc);
+            });
             static const uint16_t FILL_BITS[] = { 0x7F, 7 };
             Base::WriteBits(_stream, FILL_BITS);
             _stream.Write8u(0xFF);
@@ -26,6 +26,9 @@
 #include "Simd/SimdImageSavePng.h"
 #include "Simd/SimdBase.h"
 #include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
+
+#include <vector>
 
 namespace Simd
 {
@@ -83,9 +86,7 @@ namespace Simd
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(0, 1);
             stream.WriteBits(1, 2);
 
             int i = 0, j;
@@ -155,8 +156,57 @@ namespace Simd
             for (; i < size; ++i)
                 ZlibHuffB(data[i], stream);
             ZlibHuff(256, stream);
-            stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+        }
+
+        void ZlibCompressRle(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        {
+            stream.WriteBits(0, 1);
+            stream.WriteBits(1, 2);
+            int i = 0;
+            if (size > 0)
+                ZlibHuffB(data[i++], stream);
+            while (i < size)
+            {
+                int length = ZlibCount(data + i - 1, data + i, size - i);
+                if (length >= 3)
+                {
+                    ZlibMatch(length, 1, stream);
+                    i += length;
+                }
+                else
+                    ZlibHuffB(data[i++], stream);
+            }
+            ZlibHuff(256, stream);
+        }
+
+        void ZlibCompressGreedy(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        {
+            const int ZHASH = 16384;
+            Array32i hashTable(ZHASH);
+            memset(hashTable.data, -1, hashTable.RawSize());
+
+            stream.WriteBits(0, 1);
+            stream.WriteBits(1, 2);
+
+            int i = 0;
+            while (i < size - 3)
+            {
+                int* hItem = hashTable.data + (ZlibHash(data + i) & (ZHASH - 1));
+                int prev = *hItem, length = 0;
+                *hItem = i;
+                if (prev >= 0 && prev > i - 32768)
+                    length = ZlibCount(data + prev, data + i, size - i);
+                if (length >= 3)
+                {
+                    ZlibMatch(length, i - prev, stream);
+                    i += length;
+                }
+                else
+                    ZlibHuffB(data[i++], stream);
+            }
+            for (; i < size; ++i)
+                ZlibHuffB(data[i], stream);
+            ZlibHuff(256, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -269,9 +319,18 @@ namespace Simd
         ImagePngSaver::ImagePngSaver(const ImageSaverParam& param)
             : ImageSaver(param)
             , _channels(0)
+            , _depth(8)
             , _size(0)
             , _convert(NULL)
+            , _reorder(NULL)
         {
+            int quality = _param.quality ? _param.quality : 100;
+            if (quality < 25)
+                _level = COMPRESSION_RLE;
+            else if (quality < 50)
+                _level = COMPRESSION_GREEDY;
+            else
+                _level = Simd::Min(5 + (quality - 50) * (COMPRESSION - 5) / 50, COMPRESSION);
             switch (_param.format)
             {
             case SimdPixelFormatGray8:
@@ -289,10 +348,14 @@ namespace Simd
             case SimdPixelFormatRgba32:
                 _channels = 4;
                 break;
+            case SimdPixelFormatInt16:
+                _channels = 1;
+                _depth = 16;
+                break;
             default: 
                 break;
             }
-            _size = _param.width * _channels;
+            _size = _param.width * _channels * _depth / 8;
             if (_param.format == SimdPixelFormatBgr24)
             {
                 _convert = Base::BgrToRgb;
@@ -303,8 +366,14 @@ namespace Simd
                 _convert = Base::BgraToRgba;
                 _buff.Resize(_param.height * _size);
             }
+            else if (_param.format == SimdPixelFormatInt16)
+            {
+                _reorder = Base::Reorder16bit;
+                _buff.Resize(_param.height * _size);
+            }
             _filt.Resize((_size + 1) * _param.height);
-            _line.Resize(_size * FILTERS);
+            _threads = Simd::Min(Base::GetThreadNumber(), DivHi(_filt.size, STRIP_MIN));
+            _line.Resize(_size * FILTERS * _threads);
             _encode[0] = Base::EncodeLine0;
             _encode[1] = Base::EncodeLine1;
             _encode[2] = Base::EncodeLine2;
@@ -312,7 +381,26 @@ namespace Simd
             _encode[4] = Base::EncodeLine4;
             _encode[5] = Base::EncodeLine5;
             _encode[6] = Base::EncodeLine6;
-            _compress = Base::ZlibCompress;
+            _compress = _level == COMPRESSION_RLE ? Base::ZlibCompressRle : (_level == COMPRESSION_GREEDY ? Base::ZlibCompressGreedy : Base::ZlibCompress);
+            _adler32 = Base::ZlibAdler32;
+        }
+
+        void ImagePngSaver::EncodeRow(const uint8_t* src, size_t stride, size_t row, int8_t* line)
+        {
+            int bestFilter = 0, bestSum = INT_MAX;
+            for (int filter = 0; filter < FILTERS; filter++)
+            {
+                static const int TYPES[] = { 0, 1, 0, 5, 6, 0, 1, 2, 3, 4 };
+                int type = TYPES[filter + (row ? 1 : 0) * FILTERS];
+                int sum = _encode[type](src + stride * row, stride, _channels * _depth / 8, _size, line + _size * filter);
+                if (sum < bestSum)
+                {
+                    bestSum = sum;
+                    bestFilter = filter;
+                }
+            }
+            _filt[row * (_size + 1)] = (uint8_t)bestFilter;
+            memcpy(_filt.data + row * (_size + 1) + 1, line + _size * bestFilter, _size);
         }
 
         bool ImagePngSaver::ToStream(const uint8_t* src, size_t stride)
@@ -323,25 +411,50 @@ namespace Simd
                 src = _buff.data;
                 stride = _size;
             }
-            for (size_t row = 0; row < _param.height; ++row)
+            else if (_reorder)
             {
-                int bestFilter = 0, bestSum = INT_MAX;
-                for (int filter = 0; filter < FILTERS; filter++)
+                for (size_t row = 0; row < _param.height; ++row)
+                    _reorder(src + row * stride, _size, _buff.data + row * _size);
+                src = _buff.data;
+                stride = _size;
+            }
+            OutputMemoryStream zlib(Simd::Min(_param.width * _param.height, Base::AlgCacheL1()));
+            zlib.Write(uint8_t(0x78));
+            zlib.Write(uint8_t(0x5e));
+            std::vector<OutputMemoryStream> strips(_threads);
+            std::vector<uint32_t> adlers(_threads, 1);
+            std::vector<size_t> sizes(_threads, 0);
+            Parallel(0, _param.height, [&](size_t thread, size_t begin, size_t end)
+            {
+                OutputMemoryStream& strip = thread ? strips[thread] : zlib;
+                for (size_t row = begin; row < end; ++row)
+                    EncodeRow(src, stride, row, _line.data + _size * FILTERS * thread);
+                uint8_t* data = _filt.data + begin * (_size + 1);
+                int size = int((end - begin) * (_size + 1));
+                _compress(data, size, _level, strip);
+                if (end < _param.height)
                 {
-                    static const int TYPES[] = { 0, 1, 0, 5, 6, 0, 1, 2, 3, 4 };
-                    int type = TYPES[filter + (row ? 1 : 0) * FILTERS];
-                    int sum = _encode[type](src + stride * row, stride, _channels, _size, _line.data + _size * filter);
-                    if (sum < bestSum)
-                    {
-                        bestSum = sum;
-                        bestFilter = filter;
-                    }
+                    strip.WriteBits(0, 3);
+                    strip.FlushBits();
+                    strip.WriteBe32u(0x0000FFFF);
+                }
+                else
+                {
+                    strip.WriteBits(1, 1);
+                    strip.WriteBits(1, 2);
+                    ZlibHuff(256, strip);
+                    strip.FlushBits();
                 }
-                _filt[row * (_size + 1)] = (uint8_t)bestFilter;
-                memcpy(_filt.data + row * (_size + 1) + 1, _line.data + _size * bestFilter, _size);
+                adlers[thread] = _adler32(data, size);
+                sizes[thread] = size;
+            }, _threads, DivHi(STRIP_MIN, _size + 1));
+            uint32_t adler = adlers[0];
+            for (size_t thread = 1; thread < _threads; ++thread)
+            {
+                zlib.Write(strips[thread].Data(), strips[thread].Size());
+                adler = ZlibAdler32Combine(adler, adlers[thread], sizes[thread]);
             }
-            OutputMemoryStream zlib(Simd::Min(_param.width * _param.height, Base::AlgCacheL1()));
-            _compress(_filt.data, (int)_filt.size, COMPRESSION, zlib);
+            zlib.WriteBe32u(adler);
             WriteToStream(zlib.Data(), zlib.Size());
             return true;
         }
@@ -361,7 +474,7 @@ namespace Simd
             _stream.Write("IHDR", 4);
             _stream.WriteBe32u((uint32_t)_param.width);
             _stream.WriteBe32u((uint32_t)_param.height);
-            _stream.Write8u(8);
+            _stream.Write8u((uint8_t)_depth);
             _stream.Write8u(CTYPE[_channels]);
             _stream.Write8u(0);
             _stream.Write8u(0);
@@ -23,11 +23,38 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdResizer.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
     namespace Base
     {
+        ResizerParallel::ResizerParallel(const ResParam& param, const std::vector<Resizer*>& bands)
+            : Resizer(param)
+            , _bands(bands)
+        {
+            for (size_t i = 0, n = _bands.size(); i < n; ++i)
+                _bands[i]->SetBand(_param.dstH * i / n, _param.dstH * (i + 1) / n);
+        }
+
+        ResizerParallel::~ResizerParallel()
+        {
+            for (size_t i = 0; i < _bands.size(); ++i)
+                delete _bands[i];
+        }
+
+        void ResizerParallel::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Parallel(0, _bands.size(), [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    _bands[i]->Run(src, srcStride, dst, dstStride);
+            }, _bands.size());
+        }
+
+        //---------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
         {
             ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(void*));
@@ -41,13 +68,31 @@ namespace Simd
                 return new ResizerFloatBilinear(param);
             else if (param.IsByteBicubic())
                 return new ResizerByteBicubic(param);
+            else if (param.IsByteLanczos3())
+                return new ResizerByteLanczos3(param);
             else if (param.IsByteArea2x2())
                 return new ResizerByteArea2x2(param);
             else if (param.IsByteArea1x1())
                 return new ResizerByteArea1x1(param);
+            else if (param.IsShortBicubic() || param.IsFloatBicubic() || param.IsShortArea() || param.IsFloatArea())
+                return new ResizerFloatFilter(param);
             else
                 return NULL;
         }
+
+        //---------------------------------------------------------------------------------------------
+
+        void * ResizerParallelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method, ResizerInitPtr init)
+        {
+            size_t size = dstX * dstY * channels, threads = Simd::Min(Simd::Min(GetThreadNumber(), dstY), DivHi(size, SIMD_RESIZER_BAND_MIN_SIZE));
+            Resizer* resizer = (Resizer*)init(srcX, srcY, dstX, dstY, channels, type, method);
+            if (resizer == NULL || threads < 2)
+                return resizer;
+            std::vector<Resizer*> bands(1, resizer);
+            while (bands.size() < threads)
+                bands.push_back((Resizer*)init(srcX, srcY, dstX, dstY, channels, type, method));
+            return new ResizerParallel(ResParam(srcX, srcY, dstX, dstY, channels, type, method, sizeof(void*)), bands);
+        }
     }
 }
 
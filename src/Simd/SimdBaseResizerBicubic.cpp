@@ -29,6 +29,67 @@ namespace Simd
 {
     namespace Base
     {
+        SIMD_INLINE float Sinc(float x)
+        {
+            if (x == 0.0f)
+                return 1.0f;
+            x *= float(M_PI);
+            return ::sin(x) / x;
+        }
+
+        SIMD_INLINE float FilterWeight(SimdResizeMethodType method, float x)
+        {
+            x = ::fabs(x);
+            switch (method)
+            {
+            case SimdResizeMethodMitchell:
+                if (x < 1.0f)
+                    return (7.0f * x * x * x - 12.0f * x * x + 16.0f / 3.0f) / 6.0f;
+                if (x < 2.0f)
+                    return (-7.0f / 3.0f * x * x * x + 12.0f * x * x - 20.0f * x + 32.0f / 3.0f) / 6.0f;
+                return 0.0f;
+            case SimdResizeMethodLanczos2:
+                return x < 2.0f ? Sinc(x) * Sinc(x / 2.0f) : 0.0f;
+            case SimdResizeMethodLanczos3:
+                return x < 3.0f ? Sinc(x) * Sinc(x / 3.0f) : 0.0f;
+            default:
+                assert(0);
+                return 0.0f;
+            }
+        }
+
+        void EstimateFilterAlpha(SimdResizeMethodType method, float d, size_t taps, int32_t* alpha)
+        {
+            if (method == SimdResizeMethodBicubic)
+            {
+                assert(taps == 4);
+                alpha[0] = Round(BICUBIC_RANGE * (2.0f - d) * (1.0f - d) * d / 6.0f);
+                alpha[1] = Round(BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * (1.0f - d) / 2.0f);
+                alpha[2] = Round(BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * d / 2.0f);
+                alpha[3] = Round(BICUBIC_RANGE * (1.0f + d) * (1.0f - d) * d / 6.0f);
+                return;
+            }
+            assert(taps <= 6);
+            float weight[6], sum = 0.0f;
+            size_t max = 0;
+            for (size_t k = 0; k < taps; ++k)
+            {
+                weight[k] = FilterWeight(method, d + float(taps / 2 - 1) - float(k));
+                sum += weight[k];
+                if (::fabs(weight[k]) > ::fabs(weight[max]))
+                    max = k;
+            }
+            int32_t total = 0;
+            for (size_t k = 0; k < taps; ++k)
+            {
+                alpha[k] = -Round(BICUBIC_RANGE * weight[k] / sum);
+                total += alpha[k];
+            }
+            alpha[max] = Max(alpha[max] - BICUBIC_RANGE - total, -BICUBIC_RANGE);
+        }
+
+        //---------------------------------------------------------------------------------------------
+
         ResizerByteBicubic::ResizerByteBicubic(const ResParam & param)
             : Resizer(param)
         {
@@ -55,10 +116,7 @@ namespace Simd
                     d = 1.0f;
                 }
                 index[i] = idx * (int)N;
-                alpha[i * 4 + 0] = Round(BICUBIC_RANGE * (2.0f - d) * (1.0f - d) * d / 6.0f);
-                alpha[i * 4 + 1] = Round(BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * (1.0f - d) / 2.0f);
-                alpha[i * 4 + 2] = Round(BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * d / 2.0f);
-                alpha[i * 4 + 3] = Round(BICUBIC_RANGE * (1.0f + d) * (1.0f - d) * d / 6.0f);
+                EstimateFilterAlpha(_param.method, d, 4, alpha.data + i * 4);
             }
         } 
 
@@ -99,7 +157,8 @@ namespace Simd
 
         template<int N> void ResizerByteBicubic::RunS(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -145,8 +204,9 @@ namespace Simd
 
         template<int N> void ResizerByteBicubic::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
-            int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            int32_t prev = _iy[_yBeg] - 1;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 int32_t sy = _iy[dy], next = prev;
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
@@ -82,7 +82,8 @@ namespace Simd
             }
             int32_t * pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 int32_t fy = _ay[dy];
                 int32_t sy = _iy[dy];
@@ -181,7 +182,8 @@ namespace Simd
             size_t rs = _param.dstW * N;
             float* pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -214,7 +216,8 @@ namespace Simd
         template<size_t N> void ResizerShortBilinear::RunS(const uint16_t* src, size_t srcStride, uint16_t* dst, size_t dstStride)
         {
             size_t rs = _param.dstW * N;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -353,7 +356,8 @@ namespace Simd
             size_t rs = _param.dstW * cn;
             float * pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
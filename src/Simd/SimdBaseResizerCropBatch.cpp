@@ -0,0 +1,251 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdCopyPixel.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        ResizerCropBatch::ResizerCropBatch(const ResParam& param)
+            : _param(param)
+            , _threads(GetThreadNumber())
+        {
+        }
+
+        void ResizerCropBatch::Run(const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rects, size_t count, uint8_t* dst)
+        {
+            size_t dstSize = _param.dstW * _param.dstH * _param.PixelSize();
+            Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    Crop(thread, src, srcStride, srcW, srcH, rects + 4 * i, dst + i * dstSize);
+            }, _threads);
+        }
+
+        //---------------------------------------------------------------------------------------------
+
+        ResizerNearestCropBatch::ResizerNearestCropBatch(const ResParam& param)
+            : ResizerCropBatch(param)
+            , _pixelSize(param.PixelSize())
+        {
+            _ix.Resize(_param.dstW * _threads);
+            _iy.Resize(_param.dstH * _threads);
+        }
+
+        void ResizerNearestCropBatch::EstimateIndex(float beg, float end, size_t srcSize, size_t dstSize, size_t step, int32_t* indices)
+        {
+            float scale = (end - beg) / dstSize, shift = _param.method == SimdResizeMethodNearestPytorch ? 0.0f : 0.5f;
+            for (size_t i = 0; i < dstSize; ++i)
+            {
+                int index = RestrictRange((int)::floor(beg + (i + shift) * scale), 0, (int)srcSize - 1);
+                indices[i] = (int32_t)(index * step);
+            }
+        }
+
+        template<size_t N> void ResizerNearestCropBatch::Crop(const uint8_t* src, size_t srcStride, const int32_t* ix, const int32_t* iy, uint8_t* dst)
+        {
+            for (size_t dy = 0; dy < _param.dstH; dy++)
+            {
+                const uint8_t* srcRow = src + iy[dy] * srcStride;
+                for (size_t dx = 0; dx < _param.dstW; dx++, dst += N)
+                    CopyPixel<N>(srcRow + ix[dx], dst);
+            }
+        }
+
+        void ResizerNearestCropBatch::Crop(size_t thread, const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, uint8_t* dst)
+        {
+            int32_t* ix = _ix.data + thread * _param.dstW;
+            int32_t* iy = _iy.data + thread * _param.dstH;
+            EstimateIndex(rect[0], rect[2], srcW, _param.dstW, _pixelSize, ix);
+            EstimateIndex(rect[1], rect[3], srcH, _param.dstH, 1, iy);
+            switch (_pixelSize)
+            {
+            case 1: Crop<1>(src, srcStride, ix, iy, dst); break;
+            case 2: Crop<2>(src, srcStride, ix, iy, dst); break;
+            case 3: Crop<3>(src, srcStride, ix, iy, dst); break;
+            case 4: Crop<4>(src, srcStride, ix, iy, dst); break;
+            case 6: Crop<6>(src, srcStride, ix, iy, dst); break;
+            case 8: Crop<8>(src, srcStride, ix, iy, dst); break;
+            case 12: Crop<12>(src, srcStride, ix, iy, dst); break;
+            default:
+                for (size_t dy = 0; dy < _param.dstH; dy++)
+                {
+                    const uint8_t* srcRow = src + iy[dy] * srcStride;
+                    for (size_t dx = 0; dx < _param.dstW; dx++, dst += _pixelSize)
+                        memcpy(dst, srcRow + ix[dx], _pixelSize);
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void CropBilinearAlpha(float alpha, int32_t& dst)
+        {
+            dst = (int32_t)(alpha * FRACTION_RANGE + 0.5f);
+        }
+
+        SIMD_INLINE void CropBilinearAlpha(float alpha, float& dst)
+        {
+            dst = alpha;
+        }
+
+        SIMD_INLINE int32_t CropBilinearRow(int32_t s0, int32_t s1, int32_t alpha)
+        {
+            return (s0 << LINEAR_SHIFT) + (s1 - s0) * alpha;
+        }
+
+        SIMD_INLINE float CropBilinearRow(float s0, float s1, float alpha)
+        {
+            return s0 + (s1 - s0) * alpha;
+        }
+
+        SIMD_INLINE void CropBilinearCol(int32_t r0, int32_t r1, int32_t alpha, uint8_t& dst)
+        {
+            dst = ((r0 << LINEAR_SHIFT) + (r1 - r0) * alpha + BILINEAR_ROUND_TERM) >> BILINEAR_SHIFT;
+        }
+
+        SIMD_INLINE void CropBilinearCol(float r0, float r1, float alpha, uint16_t& dst)
+        {
+            dst = Round(r0 + (r1 - r0) * alpha);
+        }
+
+        SIMD_INLINE void CropBilinearCol(float r0, float r1, float alpha, float& dst)
+        {
+            dst = r0 + (r1 - r0) * alpha;
+        }
+
+        ResizerBilinearCropBatch::ResizerBilinearCropBatch(const ResParam& param)
+            : ResizerCropBatch(param)
+        {
+            size_t rs = _param.dstW * _param.channels;
+            _threadSize = (rs * 5 + _param.dstH * 3) * sizeof(int32_t);
+            _buffer.Resize(_threadSize * _threads);
+        }
+
+        template<class A> void ResizerBilinearCropBatch::EstimateIndexAlpha(float beg, float end, size_t srcSize, size_t dstSize, size_t channels, int32_t* index0, int32_t* index1, A* alphas)
+        {
+            float scale = (end - beg) / dstSize;
+            for (size_t i = 0; i < dstSize; ++i)
+            {
+                float pos = beg + (i + 0.5f) * scale - 0.5f;
+                ptrdiff_t i0, i1;
+                float alpha;
+                if (pos <= 0.0f)
+                {
+                    i0 = i1 = 0;
+                    alpha = 0.0f;
+                }
+                else if (pos >= float(srcSize - 1))
+                {
+                    i0 = i1 = srcSize - 1;
+                    alpha = 0.0f;
+                }
+                else
+                {
+                    i0 = (ptrdiff_t)::floor(pos);
+                    i1 = i0 + 1;
+                    alpha = pos - i0;
+                }
+                for (size_t c = 0; c < channels; c++)
+                {
+                    size_t offset = i * channels + c;
+                    index0[offset] = (int32_t)(channels * i0 + c);
+                    index1[offset] = (int32_t)(channels * i1 + c);
+                    CropBilinearAlpha(alpha, alphas[offset]);
+                }
+            }
+        }
+
+        template<class T, class A> void ResizerBilinearCropBatch::Crop(size_t thread, const T* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, T* dst)
+        {
+            size_t cn = _param.channels, rs = _param.dstW * cn, dh = _param.dstH;
+            int32_t* ix0 = (int32_t*)(_buffer.data + thread * _threadSize), * ix1 = ix0 + rs;
+            int32_t* iy0 = ix1 + rs, * iy1 = iy0 + dh;
+            A* ax = (A*)(iy1 + dh), * ay = ax + rs;
+            A* pbx[2] = { ay + dh, ay + dh + rs };
+            EstimateIndexAlpha(rect[0], rect[2], srcW, _param.dstW, cn, ix0, ix1, ax);
+            EstimateIndexAlpha(rect[1], rect[3], srcH, dh, 1, iy0, iy1, ay);
+            int32_t rows[2] = { -1, -1 };
+            for (size_t dy = 0; dy < dh; dy++, dst += rs)
+            {
+                int32_t sy[2] = { iy0[dy], iy1[dy] };
+                if (rows[0] != sy[0] && rows[1] == sy[0])
+                {
+                    Swap(pbx[0], pbx[1]);
+                    Swap(rows[0], rows[1]);
+                }
+                for (size_t k = 0; k < 2; k++)
+                {
+                    if (rows[k] == sy[k])
+                        continue;
+                    A* pb = pbx[k];
+                    const T* ps = src + sy[k] * srcStride;
+                    for (size_t dx = 0; dx < rs; dx++)
+                        pb[dx] = CropBilinearRow(A(ps[ix0[dx]]), A(ps[ix1[dx]]), ax[dx]);
+                    rows[k] = sy[k];
+                }
+                A fy = ay[dy];
+                for (size_t dx = 0; dx < rs; dx++)
+                    CropBilinearCol(pbx[0][dx], pbx[1][dx], fy, dst[dx]);
+            }
+        }
+
+        void ResizerBilinearCropBatch::Crop(size_t thread, const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, uint8_t* dst)
+        {
+            switch (_param.type)
+            {
+            case SimdResizeChannelByte:
+                Crop<uint8_t, int32_t>(thread, src, srcStride, srcW, srcH, rect, dst);
+                break;
+            case SimdResizeChannelShort:
+                Crop<uint16_t, float>(thread, (uint16_t*)src, srcStride / sizeof(uint16_t), srcW, srcH, rect, (uint16_t*)dst);
+                break;
+            case SimdResizeChannelFloat:
+                Crop<float, float>(thread, (float*)src, srcStride / sizeof(float), srcW, srcH, rect, (float*)dst);
+                break;
+            default:
+                assert(0);
+            }
+        }
+
+        //---------------------------------------------------------------------------------------------
+
+        void * ResizerCropBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
+        {
+            ResParam param(0, 0, dstX, dstY, channels, type, method, sizeof(void*));
+            if (dstX == 0 || dstY == 0 || channels == 0)
+                return NULL;
+            if (method == SimdResizeMethodNearest || method == SimdResizeMethodNearestPytorch)
+                return new ResizerNearestCropBatch(param);
+            else if (method == SimdResizeMethodBilinear)
+                return new ResizerBilinearCropBatch(param);
+            else
+                return NULL;
+        }
+    }
+}
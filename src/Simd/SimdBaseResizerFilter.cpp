@@ -0,0 +1,149 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdResizer.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        ResizerFloatFilter::ResizerFloatFilter(const ResParam& param)
+            : Resizer(param)
+        {
+            if (_param.method == SimdResizeMethodBicubic)
+            {
+                _kx = Simd::Min(_param.srcW, size_t(4));
+                _ky = Simd::Min(_param.srcH, size_t(4));
+            }
+            else
+            {
+                _kx = Simd::Min(_param.srcW, (size_t)::ceil(float(_param.srcW) / float(_param.dstW)) + 1);
+                _ky = Simd::Min(_param.srcH, (size_t)::ceil(float(_param.srcH) / float(_param.dstH)) + 1);
+            }
+            _sx = AlignHi(_kx, 4);
+            EstimateIndexAlpha(_param.srcH, _param.dstH, 1, _ky, _ky, _iy, _ay);
+            EstimateIndexAlpha(_param.srcW, _param.dstW, _param.channels, _kx, _sx, _ix, _ax);
+            _by.Resize(_param.srcW * _param.channels + SIMD_ALIGN, true);
+            _bx.Resize(_param.dstW * _param.channels + SIMD_ALIGN, true);
+        }
+
+        void ResizerFloatFilter::EstimateIndexAlpha(size_t sizeS, size_t sizeD, size_t N, size_t taps, size_t stride, Array32i& index, Array32f& alpha)
+        {
+            index.Resize(sizeD);
+            alpha.Resize(sizeD * stride, true);
+            float scale = float(sizeS) / float(sizeD);
+            int last = int(sizeS - taps);
+            for (size_t i = 0; i < sizeD; ++i)
+            {
+                float* a = alpha.data + i * stride;
+                int beg;
+                if (_param.method == SimdResizeMethodBicubic)
+                {
+                    float pos = (float)((i + 0.5f) * scale - 0.5f);
+                    int idx = (int)::floor(pos);
+                    float d = pos - idx;
+                    if (idx < 0)
+                    {
+                        idx = 0;
+                        d = 0.0f;
+                    }
+                    if (idx > (int)sizeS - 2)
+                    {
+                        idx = (int)sizeS - 2;
+                        d = 1.0f;
+                    }
+                    float w[4];
+                    w[0] = -(2.0f - d) * (1.0f - d) * d / 6.0f;
+                    w[1] = (2.0f - d) * (1.0f + d) * (1.0f - d) / 2.0f;
+                    w[2] = (2.0f - d) * (1.0f + d) * d / 2.0f;
+                    w[3] = -(1.0f + d) * (1.0f - d) * d / 6.0f;
+                    beg = RestrictRange(idx - 1, 0, last);
+                    for (int k = 0; k < 4; ++k)
+                        a[RestrictRange(idx - 1 + k, 0, (int)sizeS - 1) - beg] += w[k];
+                }
+                else
+                {
+                    float lo = float(i) * scale, hi = lo + scale;
+                    beg = Min((int)::floor(lo), last);
+                    for (size_t k = 0; k < taps; ++k)
+                    {
+                        float s = float(beg + k);
+                        a[k] = Simd::Max(Simd::Min(hi, s + 1.0f) - Simd::Max(lo, s), 0.0f) / scale;
+                    }
+                }
+                index[i] = beg * (int)N;
+            }
+        }
+
+        SIMD_INLINE void FilterStore(float src, float& dst)
+        {
+            dst = src;
+        }
+
+        SIMD_INLINE void FilterStore(float src, uint16_t& dst)
+        {
+            dst = (uint16_t)RestrictRange(Round(src), 0, 0xFFFF);
+        }
+
+        template<class T> void ResizerFloatFilter::RunB(const T* src, size_t srcStride, T* dst, size_t dstStride)
+        {
+            size_t N = _param.channels, sw = _param.srcW * N;
+            float* by = _by.data;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                const T* ps = src + _iy[dy] * srcStride;
+                const float* ay = _ay.data + dy * _ky;
+                for (size_t i = 0; i < sw; ++i)
+                    by[i] = ay[0] * ps[i];
+                for (size_t k = 1; k < _ky; ++k)
+                {
+                    ps += srcStride;
+                    for (size_t i = 0; i < sw; ++i)
+                        by[i] += ay[k] * ps[i];
+                }
+                const float* ax = _ax.data;
+                for (size_t dx = 0; dx < _param.dstW; dx++, ax += _sx)
+                {
+                    const float* pb = by + _ix[dx];
+                    for (size_t c = 0; c < N; ++c)
+                    {
+                        float sum = 0.0f;
+                        for (size_t k = 0; k < _kx; ++k)
+                            sum += ax[k] * pb[k * N + c];
+                        FilterStore(sum, dst[dx * N + c]);
+                    }
+                }
+            }
+        }
+
+        void ResizerFloatFilter::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            if (_param.type == SimdResizeChannelFloat)
+                RunB((const float*)src, srcStride / sizeof(float), (float*)dst, dstStride / sizeof(float));
+            else
+                RunB((const uint16_t*)src, srcStride / sizeof(uint16_t), (uint16_t*)dst, dstStride / sizeof(uint16_t));
+        }
+    }
+}
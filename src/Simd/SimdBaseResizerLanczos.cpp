@@ -0,0 +1,135 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdResizerCommon.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        ResizerByteLanczos3::ResizerByteLanczos3(const ResParam& param)
+            : Resizer(param)
+        {
+        }
+
+        void ResizerByteLanczos3::EstimateIndexAlpha(size_t sizeS, size_t sizeD, size_t N, Array32i& index, Array32i& alpha)
+        {
+            index.Resize(sizeD);
+            alpha.Resize(sizeD * 6);
+            float scale = float(sizeS) / float(sizeD);
+            for (size_t i = 0; i < sizeD; ++i)
+            {
+                float pos = (float)((i + 0.5f) * scale - 0.5f);
+                int idx = (int)::floor(pos);
+                float d = pos - idx;
+                if (idx < 0)
+                {
+                    idx = 0;
+                    d = 0.0f;
+                }
+                if (idx > (int)sizeS - 2)
+                {
+                    idx = (int)sizeS - 2;
+                    d = 1.0f;
+                }
+                index[i] = idx * (int)N;
+                EstimateFilterAlpha(_param.method, d, 6, alpha.data + i * 6);
+            }
+        }
+
+        void ResizerByteLanczos3::Init()
+        {
+            if (_iy.data)
+                return;
+            EstimateIndexAlpha(_param.srcH, _param.dstH, 1, _iy, _ay);
+            EstimateIndexAlpha(_param.srcW, _param.dstW, _param.channels, _ix, _ax);
+            for (int i = 0; i < 8; ++i)
+                _bx[i].Resize(_param.dstW * _param.channels);
+            int32_t N = (int32_t)_param.channels, last = (int32_t)(_param.srcW - 1) * N;
+            for (_xn = 0; _xn < _param.dstW && _ix[_xn] < 2 * N; _xn++);
+            for (_xt = _param.dstW; _xt > _xn && _ix[_xt - 1] + 3 * N > last; _xt--);
+        }
+
+        template<int N> SIMD_INLINE void PixelLanczos3SumX(const uint8_t* src, const int32_t* ax, int32_t* dst)
+        {
+            for (size_t c = 0; c < N; ++c, src++)
+                dst[c] = ax[0] * src[0 * N] + ax[1] * src[1 * N] + ax[2] * src[2 * N] + ax[3] * src[3 * N] + ax[4] * src[4 * N] + ax[5] * src[5 * N];
+        }
+
+        template<int N> SIMD_INLINE void RowLanczos3SumX(const uint8_t* src, size_t nose, size_t body, size_t tail, int32_t last, const int32_t* ix, const int32_t* ax, int32_t* dst)
+        {
+            size_t dx = 0;
+            for (; dx < nose; dx++, ax += 6, dst += N)
+                PixelLanczos3SumX<N>(src, ix[dx], last, ax, dst);
+            for (; dx < body; dx++, ax += 6, dst += N)
+                PixelLanczos3SumX<N>(src + ix[dx] - 2 * N, ax, dst);
+            for (; dx < tail; dx++, ax += 6, dst += N)
+                PixelLanczos3SumX<N>(src, ix[dx], last, ax, dst);
+        }
+
+        SIMD_INLINE void Lanczos3RowInt(const int32_t* const* src, size_t n, const int32_t* ay, uint8_t* dst)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                int32_t sum = ay[0] * src[0][i] + ay[1] * src[1][i] + ay[2] * src[2][i] + ay[3] * src[3][i] + ay[4] * src[4][i] + ay[5] * src[5][i];
+                dst[i] = RestrictRange((sum + BICUBIC_ROUND) >> BICUBIC_SHIFT, 0, 255);
+            }
+        }
+
+        template<int N> void ResizerByteLanczos3::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            int32_t prev = -2, last = (int32_t)(_param.srcW - 1) * N;
+            const int32_t* pb[6];
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                int32_t sy = _iy[dy];
+                for (int32_t curr = Max(sy - 2, prev); curr < sy + 4; ++curr)
+                {
+                    const uint8_t* ps = src + RestrictRange(curr, 0, (int)_param.srcH - 1) * srcStride;
+                    RowLanczos3SumX<N>(ps, _xn, _xt, _param.dstW, last, _ix.data, _ax.data, _bx[(curr + 2) & 7].data);
+                }
+                prev = sy + 4;
+                for (int k = 0; k < 6; ++k)
+                    pb[k] = _bx[(sy + k) & 7].data;
+                Lanczos3RowInt(pb, _param.dstW * N, _ay.data + dy * 6, dst);
+            }
+        }
+
+        void ResizerByteLanczos3::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Init();
+            switch (_param.channels)
+            {
+            case 1: RunB<1>(src, srcStride, dst, dstStride); return;
+            case 2: RunB<2>(src, srcStride, dst, dstStride); return;
+            case 3: RunB<3>(src, srcStride, dst, dstStride); return;
+            case 4: RunB<4>(src, srcStride, dst, dstStride); return;
+            default:
+                assert(0);
+            }
+        }
+    }
+}
@@ -80,7 +80,8 @@ namespace Simd
 
         void ResizerNearest::Resize(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t* srcRow = src + _iy[dy] * srcStride;
                 for (size_t dx = 0, offset = 0; dx < _param.dstW; dx++, offset += _pixelSize)
@@ -91,7 +92,8 @@ namespace Simd
 
         template<size_t N> void ResizerNearest::Resize(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t * srcRow = src + _iy[dy] * srcStride;
                 for (size_t dx = 0, offset = 0; dx < _param.dstW; dx++, offset += N)
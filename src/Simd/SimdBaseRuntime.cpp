@@ -0,0 +1,191 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdRuntime.h"
+#include "Simd/SimdCpu.h"
+
+#include <map>
+#include <fstream>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__GNUC__) && (defined(SIMD_X86_ENABLE) || defined(SIMD_X64_ENABLE))
+#include <cpuid.h>
+#endif
+
+namespace Simd
+{
+    namespace Base
+    {
+        static String CpuModel()
+        {
+            String model;
+#if defined(SIMD_X86_ENABLE) || defined(SIMD_X64_ENABLE)
+            unsigned int registers[12] = { 0 };
+#if defined(_MSC_VER)
+            for (int i = 0; i < 3; ++i)
+                __cpuid((int*)registers + i * 4, 0x80000002 + i);
+#elif defined(__GNUC__)
+            if (__get_cpuid_max(0x80000000, NULL) >= 0x80000004)
+            {
+                for (unsigned int i = 0; i < 3; ++i)
+                    __cpuid(0x80000002 + i, registers[i * 4 + 0], registers[i * 4 + 1], registers[i * 4 + 2], registers[i * 4 + 3]);
+            }
+#endif
+            model.assign((char*)registers, strnlen((char*)registers, sizeof(registers)));
+#endif
+            size_t beg = model.find_first_not_of(' '), end = model.find_last_not_of(' ');
+            return beg == String::npos ? String("Unknown") : model.substr(beg, end - beg + 1);
+        }
+
+        static String CpuSignature()
+        {
+            std::stringstream ss;
+            ss << CpuModel() << " [" << Cpu::SOCKET_NUMBER << "x" << Cpu::CORE_NUMBER << "x" << Cpu::THREAD_NUMBER;
+            ss << ", " << Cpu::L1_CACHE_SIZE / 1024 << "-" << Cpu::L2_CACHE_SIZE / 1024 << "-" << Cpu::L3_CACHE_SIZE / 1024 << "]";
+            return ss.str();
+        }
+
+        class RuntimeDatabase
+        {
+        public:
+            static RuntimeDatabase & Global()
+            {
+                static RuntimeDatabase database;
+                return database;
+            }
+
+            bool Empty() const
+            {
+                return _size.load(std::memory_order_relaxed) == 0;
+            }
+
+            bool Find(const String & key, String & name)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                Map::const_iterator it = _map.find(_signature + '\t' + key);
+                if (it == _map.end())
+                    return false;
+                name = it->second;
+                return true;
+            }
+
+            void Update(const String & key, const String & name)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _map[_signature + '\t' + key] = name;
+                _size.store(_map.size(), std::memory_order_relaxed);
+            }
+
+            String Export()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                std::stringstream ss;
+                for (Map::const_iterator it = _map.begin(); it != _map.end(); ++it)
+                    ss << it->first << '\t' << it->second << '\n';
+                return ss.str();
+            }
+
+            bool Import(const String & data)
+            {
+                Map map;
+                std::stringstream ss(data);
+                String line;
+                while (std::getline(ss, line))
+                {
+                    if (line.empty())
+                        continue;
+                    size_t pos = line.rfind('\t');
+                    if (pos == String::npos || pos == 0 || line.find('\t') == pos)
+                        return false;
+                    map[line.substr(0, pos)] = line.substr(pos + 1);
+                }
+                std::lock_guard<std::mutex> lock(_mutex);
+                map.insert(_map.begin(), _map.end());
+                _map.swap(map);
+                _size.store(_map.size(), std::memory_order_relaxed);
+                return true;
+            }
+
+        private:
+            typedef std::map<String, String> Map;
+
+            RuntimeDatabase()
+                : _signature(CpuSignature())
+                , _size(0)
+            {
+            }
+
+            std::mutex _mutex;
+            String _signature;
+            Map _map;
+            std::atomic<size_t> _size;
+        };
+
+        //---------------------------------------------------------------------
+
+        bool RuntimeDatabaseFind(const String & key, String & name)
+        {
+            return RuntimeDatabase::Global().Find(key, name);
+        }
+
+        void RuntimeDatabaseUpdate(const String & key, const String & name)
+        {
+            RuntimeDatabase::Global().Update(key, name);
+        }
+
+        bool RuntimeDatabaseEmpty()
+        {
+            return RuntimeDatabase::Global().Empty();
+        }
+
+        String RuntimeDatabaseExport()
+        {
+            return RuntimeDatabase::Global().Export();
+        }
+
+        bool RuntimeDatabaseImport(const String & data)
+        {
+            return RuntimeDatabase::Global().Import(data);
+        }
+
+        bool RuntimeDatabaseSave(const char * path)
+        {
+            std::ofstream ofs(path, std::ios::binary);
+            if (!ofs.is_open())
+                return false;
+            ofs << RuntimeDatabaseExport();
+            return (bool)ofs;
+        }
+
+        bool RuntimeDatabaseLoad(const char * path)
+        {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs.is_open())
+                return false;
+            std::stringstream ss;
+            ss << ifs.rdbuf();
+            return RuntimeDatabaseImport(ss.str());
+        }
+    }
+}
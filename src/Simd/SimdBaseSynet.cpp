@@ -27,6 +27,9 @@
 #include "Simd/SimdAlignment.h"
 #include "Simd/SimdExp.h"
 
+#include <vector>
+#include <algorithm>
+
 namespace Simd
 {
 #if defined(SIMD_SYNET_ENABLE)
@@ -190,6 +193,45 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        size_t SynetArenaPlan(const size_t* sizes, const size_t* begins, const size_t* ends, size_t count, size_t align, size_t* offsets)
+        {
+            align = Simd::Max<size_t>(align, 1);
+            std::vector<size_t> order(count);
+            for (size_t i = 0; i < count; ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+            typedef std::pair<size_t, size_t> Range;
+            std::vector<Range> busy;
+            size_t total = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t curr = order[i], size = AlignHiAny(sizes[curr], align);
+                busy.clear();
+                for (size_t j = 0; j < i; ++j)
+                {
+                    size_t prev = order[j];
+                    if (begins[prev] <= ends[curr] && begins[curr] <= ends[prev])
+                        busy.push_back(Range(offsets[prev], offsets[prev] + AlignHiAny(sizes[prev], align)));
+                }
+                std::sort(busy.begin(), busy.end());
+                size_t offset = 0, best = SIZE_MAX, gap = SIZE_MAX;
+                for (size_t j = 0; j < busy.size(); ++j)
+                {
+                    if (busy[j].first >= offset + size && busy[j].first - offset < gap)
+                    {
+                        best = offset;
+                        gap = busy[j].first - offset;
+                    }
+                    offset = Simd::Max(offset, busy[j].second);
+                }
+                offsets[curr] = best == SIZE_MAX ? offset : best;
+                total = Simd::Max(total, offsets[curr] + size);
+            }
+            return total;
+        }
+
+        //---------------------------------------------------------------------
+
         template <SimdSynetEltwiseOperationType type> void SynetEltwiseLayerForward(float const * const * src, size_t count, size_t size, float * dst)
         {
             size_t aligned = Simd::AlignLo(size, 4);
@@ -946,7 +946,7 @@ namespace Simd
             for (size_t b = 0; b < _batch; b += _merge)
             {
                 for (size_t m = 0; m < _merge; ++m)
-                    _setInput(src + m * _sizeS, p.srcC, p.srcH, p.srcW, p.padY, p.padX, p.padH, p.padW, bufS + m * _strideS, _strideS * _merge, p.trans);
+                    ForwardInput(src + m * _sizeS, 0, _tileH, bufS + m * _strideS, _strideS * _merge);
                 for (size_t i = 0; i < _count; ++i)
                 {
                     if (_nhwcWeight.data)
@@ -960,10 +960,7 @@ namespace Simd
                         _gemm.Run(GemmArgs(_M * _merge, _N, _K, &_1, bufS + i * _strideS * _merge, _K, _winogradWeight.data + i * _strideW, _N, &_0, bufD + i * _strideD * _merge, _N));
                 }
                 for (size_t m = 0; m < _merge; ++m)
-                {
-                    _setOutput(bufD + m * _strideD, _strideD * _merge, dst + m * _sizeD, p.dstC, p.dstH, p.dstW, p.trans);
-                    _biasAndActivation(_bias, p.dstC, p.dstH * p.dstW, p.activation, _params, p.trans, dst + m * _sizeD);
-                }
+                    ForwardOutput(bufD + m * _strideD, _strideD * _merge, 0, _tileH, dst + m * _sizeD);
                 src += _sizeS * _merge;
                 dst += _sizeD * _merge;
             }
@@ -976,14 +973,9 @@ namespace Simd
             {
                 for (size_t s = 0; s < _split; ++s)
                 {
-                    size_t padY = s ? 0 : p.padY;
-                    size_t padH = s == _split - 1 ? p.padH : 0;
-                    size_t srcY = s * _tileHs * _blockY + padY - p.padY;
-                    size_t srcH = Simd::Min(_tileHs * _blockY + p.kernelY - 1 - padY - padH, p.srcH - srcY);
-                    size_t M = _tileW * Simd::Min(_tileHs, _tileH - s * _tileHs);
-                    size_t dstY = s * _tileHs * _blockY;
-                    size_t dstH = Simd::Min(_tileHs * _blockY, p.dstH - dstY);
-                    _setInput(src + srcY * p.srcC * p.srcW, p.srcC, srcH, p.srcW, padY, p.padX, padH, p.padW, bufS, _strideS, p.trans);
+                    size_t tileBeg = s * _tileHs, tileEnd = Simd::Min(tileBeg + _tileHs, _tileH);
+                    size_t M = _tileW * (tileEnd - tileBeg);
+                    ForwardInput(src, tileBeg, tileEnd, bufS, _strideS);
                     for (size_t i = 0; i < _count; ++i)
                     {
                         if (_nhwcWeight.data)
@@ -996,14 +988,41 @@ namespace Simd
                         else
                             _gemm.Run(GemmArgs(M, _N, _K, &_1, bufS + i * _strideS, _K, _winogradWeight.data + i * _strideW, _N, &_0, bufD + i * _strideD, _N));
                     }
-                    _setOutput(bufD, _strideD, dst + dstY * p.dstC * p.dstW, p.dstC, dstH, p.dstW, p.trans);
-                    _biasAndActivation(_bias, p.dstC, dstH * p.dstW, p.activation, _params, p.trans, dst + dstY * p.dstC * p.dstW);
+                    ForwardOutput(bufD, _strideD, tileBeg, tileEnd, dst);
                 }
                 src += _sizeS;
                 dst += _sizeD;
             }
         }
 
+        void SynetConvolution32fWinograd::ForwardInput(const float* src, size_t tileBeg, size_t tileEnd, float* dst, size_t dstStride)
+        {
+            const ConvParam32f& p = _param;
+            size_t tiles = tileEnd - tileBeg;
+            Simd::Parallel(tileBeg, tileEnd, [&](size_t thread, size_t beg, size_t end)
+            {
+                size_t padY = beg ? 0 : p.padY;
+                size_t padH = end == _tileH ? p.padH : 0;
+                size_t srcY = beg * _blockY + padY - p.padY;
+                size_t srcH = Simd::Min((end - beg) * _blockY + p.kernelY - 1 - padY - padH, p.srcH - srcY);
+                _setInput(src + srcY * p.srcC * p.srcW, p.srcC, srcH, p.srcW, padY, p.padX, padH, p.padW, dst + (beg - tileBeg) * _tileW * p.srcC, dstStride, p.trans);
+            }, ThreadNumber(tiles));
+        }
+
+        void SynetConvolution32fWinograd::ForwardOutput(const float* src, size_t srcStride, size_t tileBeg, size_t tileEnd, float* dst)
+        {
+            const ConvParam32f& p = _param;
+            size_t tiles = tileEnd - tileBeg;
+            Simd::Parallel(tileBeg, tileEnd, [&](size_t thread, size_t beg, size_t end)
+            {
+                size_t dstY = beg * _blockY;
+                size_t dstH = Simd::Min((end - beg) * _blockY, p.dstH - dstY);
+                float* out = dst + dstY * p.dstC * p.dstW;
+                _setOutput(src + (beg - tileBeg) * _tileW * p.dstC, srcStride, out, p.dstC, dstH, p.dstW, p.trans);
+                _biasAndActivation(_bias, p.dstC, dstH * p.dstW, p.activation, _params, p.trans, out);
+            }, ThreadNumber(tiles));
+        }
+
         //---------------------------------------------------------------------
 
         SynetConvolution32fDirectNchw::SynetConvolution32fDirectNchw(const ConvParam32f & p)
@@ -1033,6 +1052,8 @@ namespace Simd
             const ConvParam32f & p = _param;
             if(_pad)
                 buf = Buffer(buf);
+            size_t threads = ThreadNumber(_dstC);
+            bool prelu = p.activation == ::SimdConvolutionActivationPrelu;
             for (size_t b = 0; b < p.batch; ++b)
             {
                 const float * weight = _weight;
@@ -1041,12 +1062,13 @@ namespace Simd
                 for (size_t g = 0; g < p.group; ++g)
                 {
                     if (_pad)
-                    {
                         Pad(src, buf);
-                        _convolutionBiasActivation(buf, _srcC, _srcH, _srcW, weight, bias, params, dst, _dstC, p.dstH, p.dstW);
-                    }
-                    else
-                        _convolutionBiasActivation(src, _srcC, _srcH, _srcW, weight, bias, params, dst, _dstC, p.dstH, p.dstW);
+                    const float* input = _pad ? buf : src;
+                    Simd::Parallel(0, _dstC, [&](size_t thread, size_t dcBeg, size_t dcEnd)
+                    {
+                        _convolutionBiasActivation(input, _srcC, _srcH, _srcW, weight + dcBeg * _grW / _dstC, bias ? bias + dcBeg : NULL, 
+                            prelu ? params + dcBeg : params, dst + dcBeg * p.dstH * p.dstW, dcEnd - dcBeg, p.dstH, p.dstW);
+                    }, threads);
                     weight += _grW;
                     if (bias)
                         bias += _dstC;
@@ -1260,9 +1282,14 @@ namespace Simd
 
         void SynetConvolution32fDirectNhwc::Forward(const float * src, float * buf, float * dst)
         {
+            const ConvParam32f& p = _param;
+            size_t threads = ThreadNumber(p.dstH);
             for (size_t b = 0; b < _batch; ++b)
             {
-                _convolutionBiasActivation(src, _param, _weight, _bias, _params, dst);
+                ParallelRowBands(p, threads, [&](const ConvParam32f& band, size_t srcY, size_t dstY)
+                {
+                    _convolutionBiasActivation(src + srcY * p.srcW * p.srcC, band, _weight, _bias, _params, dst + dstY * p.dstW * p.dstC);
+                });
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -1363,20 +1390,24 @@ namespace Simd
        
         void SynetConvolution32fDepthwiseDotProduct::Forward(const float * src, float * buf, float * dst)
         {
+            bool prelu = _param.activation == ::SimdConvolutionActivationPrelu;
             for (size_t b = 0; b < _batch; ++b)
             {
-                if (_bias)
-                {
-                    for (size_t i = 0; i < _count; ++i)
-                        dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size) + _bias[i];
-                }
-                else
+                Simd::Parallel(0, _count, [&](size_t thread, size_t begin, size_t end)
                 {
-                    for (size_t i = 0; i < _count; ++i)
-                        dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size);
-                }
-                if (_param.activation)
-                    ConvolutionBiasAndActivation(NULL, _count, 1, _param.activation, _params, ::SimdFalse, dst);                
+                    if (_bias)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size) + _bias[i];
+                    }
+                    else
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size);
+                    }
+                    if (_param.activation)
+                        ConvolutionBiasAndActivation(NULL, end - begin, 1, _param.activation, prelu ? _params + begin : _params, ::SimdFalse, dst + begin);
+                }, ThreadNumber(_count));
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -1496,17 +1527,35 @@ namespace Simd
         void SynetConvolution32fNhwcDirect::Forward(const float * src, float * buf, float * dst)
         {
             const ConvParam32f & p = _param;
+            size_t threads = ThreadNumber(p.dstH);
             for (size_t b = 0; b < p.batch; ++b)
             {
-                if(_old.enable)
-                    _old.convolution(src, _param, _old.alg, _weight, _bias, _params, dst);
+                if (_old.enable)
+                {
+                    ParallelRowBands(p, threads, [&](const ConvParam32f& band, size_t srcY, size_t dstY)
+                    {
+                        _old.convolution(src + srcY * p.srcW * p.srcC, band, _old.alg, _weight, _bias, _params, dst + dstY * p.dstW * p.dstC);
+                    });
+                }
                 else
-                _run.Run(RunArgs(src, _param, _weight, _bias, _params, dst));
+                    _run.Run(RunArgs(src, _param, _weight, _bias, _params, dst, threads));
                 src += _sizeS;
                 dst += _sizeD;
             }
         }
 
+        void SynetConvolution32fNhwcDirect::ForwardRows(const float* src, size_t dstBeg, size_t dstEnd, float* dst)
+        {
+            const ConvParam32f& p = _param;
+            size_t srcBeg;
+            ConvParam32f band = RowBand(p, dstBeg, dstEnd, srcBeg);
+            src += srcBeg * p.srcW * p.srcC;
+            if (_old.enable)
+                _old.convolution(src, band, _old.alg, _weight, _bias, _params, dst);
+            else
+                _run.Run(RunArgs(src, band, _weight, _bias, _params, dst, 1));
+        }
+
         void SynetConvolution32fNhwcDirect::Forward(const float* src, const ConvParam32f& p, const AlgParam& a, const float* weight, const float* bias, const float* params, float* dst)
         {
             for (size_t dc = 0; dc < p.dstC; dc += a.macroD)
@@ -1674,6 +1723,173 @@ namespace Simd
             else
                 return new SynetConvolution32fGemmNN(param);
         }
+
+        //---------------------------------------------------------------------
+
+        static ConvParam32f BatchParam(size_t batch, const SynetConvolution32f * single)
+        {
+            ConvParam32f param = single->Param();
+            param.batch = batch;
+            return param;
+        }
+
+        SynetConvolution32fBatch::SynetConvolution32fBatch(size_t batch, SynetConvolution32f * single)
+            : SynetConvolution32f(BatchParam(batch, single))
+            , _single(single)
+        {
+            const ConvParam32f& p = _param;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * p.dstH * p.dstW;
+            _stride = AlignHi(_single->ExternalBufferSize(), SIMD_ALIGN);
+        }
+
+        SynetConvolution32fBatch::~SynetConvolution32fBatch()
+        {
+            delete _single;
+        }
+
+        size_t SynetConvolution32fBatch::ExternalBufferSize() const
+        {
+            return _stride * Simd::Min(_param.batch, _threadNumber);
+        }
+
+        size_t SynetConvolution32fBatch::InternalBufferSize() const
+        {
+            return _buffer.size + _single->InternalBufferSize();
+        }
+
+        void SynetConvolution32fBatch::SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params)
+        {
+            _single->SetParams(weight, internal, bias, params);
+        }
+
+        void SynetConvolution32fBatch::Forward(const float* src, float* buf, float* dst)
+        {
+            Forward(src, buf, dst, _param.batch);
+        }
+
+        void SynetConvolution32fBatch::Forward(const float* src, float* buf, float* dst, size_t batch)
+        {
+            assert(batch <= _param.batch);
+            buf = Buffer(buf);
+            size_t threads = batch * 2 > _threadNumber ? Simd::Min(batch, _threadNumber) : 1;
+            Simd::Parallel(0, batch, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t b = begin; b < end; ++b)
+                    _single->Forward(src + b * _sizeS, buf + thread * _stride, dst + b * _sizeD);
+            }, threads);
+        }
+
+        void * SynetConvolution32fBatchInit(size_t batch, void * single)
+        {
+            if (single == NULL || batch == 0)
+            {
+                delete (SynetConvolution32f*)single;
+                return NULL;
+            }
+            return new SynetConvolution32fBatch(batch, (SynetConvolution32f*)single);
+        }
+
+        //---------------------------------------------------------------------
+
+        static ConvParam32f EpilogueParam(size_t batch, const SynetConvolution32f* single)
+        {
+            ConvParam32f param = single->Param();
+            param.batch = batch;
+            return param;
+        }
+
+        SynetConvolution32fEpilogue::SynetConvolution32fEpilogue(size_t batch, const SimdConvolutionParameters& conv, const SimdConvolutionEpilogue& epilogue, SynetConvolution32f* single, const SynetConvolutionEpilogue::Funcs& funcs)
+            : SynetConvolution32f(EpilogueParam(batch, single))
+            , _single(single)
+            , _epilogue(epilogue, conv, funcs)
+        {
+            const ConvParam32f& p = _param;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * _epilogue.DstH() * _epilogue.DstW();
+            _rows = _single->RowsForwardable();
+            if (_rows)
+            {
+                size_t dstH = _epilogue.DstH(), minH = Simd::Max<size_t>(Simd::Max(p.padY, p.padH), 1);
+                _chunks = Simd::Max(DivHi(dstH, _epilogue.ChunkRows()), _threadNumber);
+                _chunks = Simd::Max<size_t>(Simd::Min(_chunks, dstH / minH), 1);
+                _threads = Simd::Min(_chunks, _threadNumber);
+                _stride = AlignHi(_epilogue.SrcSize(DivHi(dstH, _chunks)), SIMD_ALIGN);
+            }
+            else
+            {
+                _chunks = 1;
+                _threads = 1;
+                _stride = AlignHi(_single->ExternalBufferSize(), SIMD_ALIGN);
+            }
+        }
+
+        SynetConvolution32fEpilogue::~SynetConvolution32fEpilogue()
+        {
+            delete _single;
+        }
+
+        size_t SynetConvolution32fEpilogue::ExternalBufferSize() const
+        {
+            const ConvParam32f& p = _param;
+            return _stride * _threads + (_rows ? 0 : p.dstC * p.dstH * p.dstW);
+        }
+
+        size_t SynetConvolution32fEpilogue::InternalBufferSize() const
+        {
+            return _buffer.size + _single->InternalBufferSize();
+        }
+
+        void SynetConvolution32fEpilogue::SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params)
+        {
+            _single->SetParams(weight, internal, bias, params);
+            _epilogue.SetParams(params);
+        }
+
+        void SynetConvolution32fEpilogue::Forward(const float* src, float* buf, float* dst)
+        {
+            const ConvParam32f& p = _param;
+            size_t dstH = _epilogue.DstH(), dstW = _epilogue.DstW();
+            buf = Buffer(buf);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                if (_rows)
+                {
+                    Simd::Parallel(0, _chunks, [&](size_t thread, size_t begin, size_t end)
+                    {
+                        float* tmp = buf + thread * _stride;
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            size_t dstBeg = i * dstH / _chunks, dstEnd = (i + 1) * dstH / _chunks, srcBeg, srcEnd;
+                            _epilogue.SrcRows(dstBeg, dstEnd, srcBeg, srcEnd);
+                            _single->ForwardRows(src, srcBeg, srcEnd, tmp);
+                            _epilogue.Run(tmp, dstBeg, dstEnd, dst + dstBeg * dstW * p.dstC);
+                        }
+                    }, _threads);
+                }
+                else
+                {
+                    float* tmp = buf + _stride;
+                    _single->Forward(src, buf, tmp);
+                    _epilogue.Run(tmp, 0, dstH, dst);
+                }
+                src += _sizeS;
+                dst += _sizeD;
+            }
+        }
+
+        void * SynetConvolution32fEpilogueInit(size_t batch, const SimdConvolutionParameters * param, const SimdConvolutionEpilogue * epilogue, void * single, const SynetConvolutionEpilogue::Funcs & funcs)
+        {
+            SynetConvolution32f* conv = (SynetConvolution32f*)single;
+            if (conv && batch == 1 && epilogue->type == SimdConvolutionEpilogueIdentity)
+                return conv;
+            if (conv == NULL || batch == 0 || conv->Param().dstF != SimdTensorFormatNhwc || !SynetConvolutionEpilogue(*epilogue, *param, funcs).Valid())
+            {
+                delete conv;
+                return NULL;
+            }
+            return new SynetConvolution32fEpilogue(batch, *param, *epilogue, conv, funcs);
+        }
     }
 #endif
 }
@@ -74,6 +74,7 @@ namespace Simd
         _sizeS = p.srcC * p.srcH * p.srcW;
         _sizeD = p.dstC * p.dstH * p.dstW;
         _merge = 1;
+        _threadNumber = Base::GetThreadNumber();
         _src8u = p.srcT == SimdTensorData8u;
         _dst8u = p.dstT == SimdTensorData8u;
         _weight.Resize(p.kernelY * p.kernelX * p.srcC / p.group * p.dstC);
@@ -254,6 +255,12 @@ namespace Simd
         }
     }
 
+    void SynetConvolution8i::ConvertSrc(const float* src, uint8_t* dst) const
+    {
+        const ConvParam8i& p = _param;
+        _convertSrc(src, 1, p.srcC, p.srcH, p.srcW, p.srcF, _srcCvt.scale.data, _srcCvt.shift.data, dst, p.compatibility);
+    }
+
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
     Base::PerformanceMeasurer * SynetConvolution8i::Perf(const char* func)
     {
@@ -550,6 +557,22 @@ namespace Simd
         }
 
         void SynetConvolution8iNhwcDirect::Forward8u(const uint8_t* src, const ConvParam8i& p, int32_t* buf, uint8_t* dst)
+        {
+            Simd::Parallel(0, p.dstH, [&](size_t thread, size_t begin, size_t end)
+            {
+                Forward8u(src, p, begin, end, buf, dst);
+            }, ThreadNumber(p.dstH));
+        }
+
+        void SynetConvolution8iNhwcDirect::ForwardRows(const uint8_t* src, size_t dstBeg, size_t dstEnd, float* dst)
+        {
+            const ConvParam8i& p = _param;
+            size_t srcBeg;
+            ConvParam8i band = RowBand(p, dstBeg, dstEnd, srcBeg);
+            Forward8u(src + srcBeg * p.srcW * p.srcC, band, 0, band.dstH, (int32_t*)dst, (uint8_t*)dst);
+        }
+
+        void SynetConvolution8iNhwcDirect::Forward8u(const uint8_t* src, const ConvParam8i& p, size_t dstBeg, size_t dstEnd, int32_t* buf, uint8_t* dst)
         {
             const int8_t* weight = _weight.data;
             const float* norm = _norm.data;
@@ -563,9 +586,9 @@ namespace Simd
                 for (size_t sc = 0; sc < p.srcC; sc += _alg.macroC)
                 {
                     size_t macroC = Simd::Min(p.srcC, sc + _alg.macroC) - sc;
-                    for (size_t yBeg = 0; yBeg < p.dstH;)
+                    for (size_t yBeg = dstBeg; yBeg < dstEnd;)
                     {
-                        size_t yEnd = Simd::Min(yBeg + _alg.macroH, p.dstH);
+                        size_t yEnd = Simd::Min(yBeg + _alg.macroH, dstEnd);
                         if (sc + macroC == p.srcC)
                         {
                             int first = macroC == p.srcC ? 1 : 0;
@@ -627,9 +650,14 @@ namespace Simd
             const float* params = _params.data;
             const float* scale = _dstCvt.scale.data;
             const float* shift = _dstCvt.shift.data;
+            const ConvParam8i& p = _param;
+            size_t threads = ThreadNumber(p.dstH);
             for (size_t m = 0; m < _merge; ++m)
             {
-                _convolution(src, _param, _alg, weight, norm, bias, params, scale, shift, dst);
+                ParallelRowBands(p, threads, [&](const ConvParam8i& band, size_t srcY, size_t dstY)
+                {
+                    _convolution(src + srcY * p.srcW * p.srcC, band, _alg, weight, norm, bias, params, scale, shift, dst + dstY * p.dstW * p.dstC * _alg.size);
+                });
                 src += _sizeS;
                 dst += _sizeD * _alg.size;
             }
@@ -653,6 +681,128 @@ namespace Simd
             else
                 return new SynetConvolution8iGemmNN(param);
         }
+
+        //---------------------------------------------------------------------
+
+        static ConvParam8i EpilogueParam(size_t batch, const SynetConvolution8i* single)
+        {
+            ConvParam8i param = single->Param();
+            param.batch = batch;
+            return param;
+        }
+
+        SynetConvolution8iEpilogue::SynetConvolution8iEpilogue(size_t batch, const SimdConvolutionParameters& conv, const SimdConvolutionEpilogue& epilogue, SynetConvolution8i* single, const SynetConvolutionEpilogue::Funcs& funcs)
+            : SynetConvolution8i(EpilogueParam(batch, single))
+            , _single(single)
+            , _epilogue(epilogue, conv, funcs)
+        {
+            const ConvParam8i& p = _param;
+            _weight.Resize(0);
+            _norm.Resize(0);
+            _bias.Resize(0);
+            _sizeD = p.dstC * _epilogue.DstH() * _epilogue.DstW();
+            _rows = _single->RowsForwardable();
+            if (_rows)
+            {
+                size_t dstH = _epilogue.DstH(), minH = Simd::Max<size_t>(Simd::Max(p.padY, p.padH), 1);
+                _chunks = Simd::Max(DivHi(dstH, _epilogue.ChunkRows()), _threadNumber);
+                _chunks = Simd::Max<size_t>(Simd::Min(_chunks, dstH / minH), 1);
+                _threads = Simd::Min(_chunks, _threadNumber);
+                _stride = AlignHi(_epilogue.SrcSize(DivHi(dstH, _chunks)) * sizeof(float), SIMD_ALIGN);
+            }
+            else
+            {
+                _chunks = 1;
+                _threads = 1;
+                _stride = AlignHi(p.dstC * p.dstH * p.dstW * sizeof(float), SIMD_ALIGN);
+            }
+        }
+
+        SynetConvolution8iEpilogue::~SynetConvolution8iEpilogue()
+        {
+            delete _single;
+        }
+
+        size_t SynetConvolution8iEpilogue::ExternalBufferSize() const
+        {
+            if (_rows)
+                return SIMD_ALIGN + (_src8u ? 0 : AlignHi(_sizeS, SIMD_ALIGN)) + _stride * _threads;
+            else
+                return _stride + _single->ExternalBufferSize();
+        }
+
+        size_t SynetConvolution8iEpilogue::InternalBufferSize() const
+        {
+            return _buffer.size + _single->InternalBufferSize();
+        }
+
+        void SynetConvolution8iEpilogue::SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
+        {
+            _single->SetParams(weight, bias, params, stats);
+            _epilogue.SetParams(params);
+        }
+
+        void SynetConvolution8iEpilogue::Forward(const uint8_t* src, uint8_t* buf, uint8_t* dst)
+        {
+            if (buf == NULL)
+            {
+                _buffer.Resize(ExternalBufferSize());
+                buf = _buffer.data;
+            }
+            const ConvParam8i& p = _param;
+            float* dst32f = (float*)dst;
+            uint8_t* src8u = _src8u || !_rows ? NULL : Allocate<uint8_t>(buf, _sizeS);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                if (_rows)
+                {
+                    if (!_src8u)
+                        _single->ConvertSrc((float*)src, src8u);
+                    Forward8u(_src8u ? src : src8u, buf, (uint8_t*)dst32f);
+                }
+                else
+                {
+                    float* tmp = (float*)buf;
+                    _single->Forward(src, buf + _stride, (uint8_t*)tmp);
+                    _epilogue.Run(tmp, 0, _epilogue.DstH(), dst32f);
+                }
+                src += _sizeS * (_src8u ? sizeof(uint8_t) : sizeof(float));
+                dst32f += _sizeD;
+            }
+        }
+
+        void SynetConvolution8iEpilogue::Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst)
+        {
+            assert(_rows);
+            const ConvParam8i& p = _param;
+            size_t dstH = _epilogue.DstH(), dstW = _epilogue.DstW();
+            float* dst32f = (float*)dst;
+            Simd::Parallel(0, _chunks, [&](size_t thread, size_t begin, size_t end)
+            {
+                float* tmp = (float*)(buf + thread * _stride);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    size_t dstBeg = i * dstH / _chunks, dstEnd = (i + 1) * dstH / _chunks, srcBeg, srcEnd;
+                    _epilogue.SrcRows(dstBeg, dstEnd, srcBeg, srcEnd);
+                    _single->ForwardRows(src, srcBeg, srcEnd, tmp);
+                    _epilogue.Run(tmp, dstBeg, dstEnd, dst32f + dstBeg * dstW * p.dstC);
+                }
+            }, _threads);
+        }
+
+        void* SynetConvolution8iEpilogueInit(size_t batch, const SimdConvolutionParameters* param, const SimdConvolutionEpilogue* epilogue, void* single, const SynetConvolutionEpilogue::Funcs& funcs)
+        {
+            SynetConvolution8i* conv = (SynetConvolution8i*)single;
+            if (conv && batch == 1 && epilogue->type == SimdConvolutionEpilogueIdentity)
+                return conv;
+            if (conv == NULL || batch == 0 || conv->Param().dstF != SimdTensorFormatNhwc || conv->Param().dstT != SimdTensorData32f ||
+                !SynetConvolutionEpilogue(*epilogue, *param, funcs).Valid())
+            {
+                delete conv;
+                return NULL;
+            }
+            return new SynetConvolution8iEpilogue(batch, *param, *epilogue, conv, funcs);
+        }
     }
 #endif
 }
@@ -0,0 +1,398 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetDeconvolution8i.h"
+#include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    SynetDeconvolution8i::SynetDeconvolution8i(const DeconvParam8i& p)
+        : _param(p)
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        , _perf(NULL)
+#endif
+    {
+        _sizeS = p.srcC * p.srcH * p.srcW;
+        _sizeD = p.dstC * p.dstH * p.dstW;
+        _src8u = p.srcT == SimdTensorData8u;
+        _dst8u = p.dstT == SimdTensorData8u;
+        _bias.Resize(p.dstC, true);
+        _params.Resize(p.activation == SimdConvolutionActivationPrelu ? p.dstC : 2, true);
+        _convertSrc = Base::SynetConvert32fTo8u;
+        _convertDst = Base::SynetConvert32fTo8u;
+        _biasAndActivation = Base::ConvolutionBiasAndActivation;
+    }
+
+    size_t SynetDeconvolution8i::ExternalBufferSize() const
+    {
+        size_t size = SIMD_ALIGN;
+        if (_dst8u)
+            size += AlignHi(_sizeD * sizeof(float), SIMD_ALIGN);
+        return size;
+    }
+
+    size_t SynetDeconvolution8i::InternalBufferSize() const
+    {
+        return _buffer.size * sizeof(uint8_t) + _srcCvt.Size() + _dstCvt.Size() + (_bias.size + _params.size) * sizeof(float);
+    }
+
+    void SynetDeconvolution8i::SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
+    {
+        const DeconvParam8i& p = _param;
+        _srcCvt.Init(stats[0], stats[1], p.srcC, p.compatibility);
+        _dstCvt.Init(stats[2], stats[3], p.dstC, p.compatibility);
+        if (bias)
+            memcpy(_bias.data, bias, p.dstC * sizeof(float));
+        size_t count = 0;
+        switch (p.activation)
+        {
+        case SimdConvolutionActivationIdentity:
+        case SimdConvolutionActivationRelu:
+            break;
+        case SimdConvolutionActivationRestrictRange:
+        case SimdConvolutionActivationHswish:
+        case SimdConvolutionActivationHardSigmoid:
+            count = 2;
+            break;
+        case SimdConvolutionActivationPrelu:
+            count = p.dstC;
+            break;
+        default:
+            count = 1;
+        }
+        if (params && count)
+            memcpy(_params.data, params, count * sizeof(float));
+    }
+
+    void SynetDeconvolution8i::Forward(const uint8_t* src, uint8_t* buf, uint8_t* dst)
+    {
+        if (buf == NULL)
+        {
+            _buffer.Resize(ExternalBufferSize());
+            buf = _buffer.data;
+        }
+        const DeconvParam8i& p = _param;
+        float* dst32f = _dst8u ? Allocate<float>(buf, _sizeD) : NULL;
+        for (size_t b = 0; b < p.batch; ++b)
+        {
+            float* sum = _dst8u ? dst32f : (float*)dst + b * _sizeD;
+            Forward8u(src + b * _sizeS * (_src8u ? sizeof(uint8_t) : sizeof(float)), buf, sum);
+            _biasAndActivation(_bias.data, p.dstC, p.dstH * p.dstW, p.activation, _params.data, SimdTrue, sum);
+            if (_dst8u)
+                _convertDst(sum, 1, p.dstC, p.dstH, p.dstW, p.dstF, _dstCvt.scale.data, _dstCvt.shift.data, dst + b * _sizeD, p.compatibility);
+        }
+    }
+
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+    Base::PerformanceMeasurer * SynetDeconvolution8i::Perf(const char* func)
+    {
+        if (_perf == NULL)
+            _perf = Simd::Base::PerformanceMeasurerStorage::s_storage.Get(func, Param().Info() + " " + Desc(), Param().Flop());
+        return _perf;
+    }
+#endif
+
+    //-------------------------------------------------------------------------
+
+    namespace Base
+    {
+        static void RowToImgCopy(const float* src, const DeconvParam8i& p, float* dst)
+        {
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx)
+                {
+                    size_t dy = sy * p.strideY;
+                    for (size_t ky = 0; ky < p.kernelY; ky++, dy += 1)
+                    {
+                        size_t dx = sx * p.strideX;
+                        for (size_t kx = 0; kx < p.kernelX; kx++, dx += 1)
+                        {
+                            memcpy(dst + (dy * p.dstW + dx) * p.dstC, src, p.dstC * sizeof(float));
+                            src += p.dstC;
+                        }
+                    }
+                }
+            }
+        }
+
+        static void RowToImgSum(const float* src, const DeconvParam8i& p, float* dst)
+        {
+            memset(dst, 0, p.dstH * p.dstW * p.dstC * sizeof(float));
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx)
+                {
+                    size_t dy = sy * p.strideY - p.padY;
+                    for (size_t ky = 0; ky < p.kernelY; ky++, dy += p.dilationY)
+                    {
+                        if (dy < p.dstH)
+                        {
+                            size_t dx = sx * p.strideX - p.padX;
+                            for (size_t kx = 0; kx < p.kernelX; kx++, dx += p.dilationX)
+                            {
+                                if (dx < p.dstW)
+                                {
+                                    float* d = dst + (dy * p.dstW + dx) * p.dstC;
+                                    for (size_t dc = 0; dc < p.dstC; ++dc)
+                                        d[dc] += src[dc];
+                                }
+                                src += p.dstC;
+                            }
+                        }
+                        else
+                            src += p.kernelX * p.dstC;
+                    }
+                }
+            }
+        }
+
+        SynetDeconvolution8iGemm::SynetDeconvolution8iGemm(const DeconvParam8i& p, ConvolutionInitPtr init)
+            : SynetDeconvolution8i(p)
+        {
+            assert(p.group == 1);
+            SimdConvolutionParameters conv = p;
+            conv.dstC = p.kernelY * p.kernelX * p.dstC;
+            conv.dstH = p.srcH;
+            conv.dstW = p.srcW;
+            conv.dstT = SimdTensorData32f;
+            conv.kernelY = 1;
+            conv.kernelX = 1;
+            conv.dilationY = 1;
+            conv.dilationX = 1;
+            conv.strideY = 1;
+            conv.strideX = 1;
+            conv.padY = 0;
+            conv.padX = 0;
+            conv.padH = 0;
+            conv.padW = 0;
+            conv.activation = SimdConvolutionActivationIdentity;
+            _convolution = (SynetConvolution8i*)init(1, &conv, p.compatibility);
+            assert(_convolution);
+            _stats.Resize(conv.dstC, true);
+            _sizeB = p.srcH * p.srcW * conv.dstC;
+            _rowToImg = p.IsTiled() ? RowToImgCopy : RowToImgSum;
+        }
+
+        SynetDeconvolution8iGemm::~SynetDeconvolution8iGemm()
+        {
+            delete _convolution;
+        }
+
+        String SynetDeconvolution8iGemm::Desc() const
+        {
+            return Ext() + "::Gemm(" + _convolution->Desc() + ")";
+        }
+
+        size_t SynetDeconvolution8iGemm::ExternalBufferSize() const
+        {
+            return SynetDeconvolution8i::ExternalBufferSize() + AlignHi(_sizeB * sizeof(float), SIMD_ALIGN) + _convolution->ExternalBufferSize();
+        }
+
+        size_t SynetDeconvolution8iGemm::InternalBufferSize() const
+        {
+            return SynetDeconvolution8i::InternalBufferSize() + _stats.size * sizeof(float) + _convolution->InternalBufferSize();
+        }
+
+        void SynetDeconvolution8iGemm::SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
+        {
+            SynetDeconvolution8i::SetParams(weight, bias, params, stats);
+            const float* inner[4] = { stats[0], stats[1], _stats.data, _stats.data };
+            _convolution->SetParams(weight, NULL, NULL, inner);
+        }
+
+        bool SynetDeconvolution8iGemm::Preferable(const DeconvParam8i& p)
+        {
+            return p.group == 1;
+        }
+
+        void SynetDeconvolution8iGemm::Forward8u(const uint8_t* src, uint8_t* buf, float* dst)
+        {
+            float* col = Allocate<float>(buf, _sizeB);
+            _convolution->Forward(src, buf, (uint8_t*)col);
+            _rowToImg(col, _param, dst);
+        }
+
+        //---------------------------------------------------------------------
+
+        static void DeconvolutionNhwcGroup(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst)
+        {
+            size_t G = p.group, C = p.srcC / G, D = p.dstC / G, K = p.kernelY * p.kernelX;
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx, src += p.srcC)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                        if (dy >= p.dstH)
+                            continue;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                        {
+                            size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                            if (dx >= p.dstW)
+                                continue;
+                            int32_t* d = dst + (dy * p.dstW + dx) * p.dstC;
+                            const int8_t* w = weight + (ky * p.kernelX + kx) * D;
+                            for (size_t g = 0; g < G; ++g, d += D)
+                            {
+                                for (size_t c = 0, gc = g * C; c < C; ++c, ++gc)
+                                {
+                                    int s = int(src[gc]) - int(zero[gc]);
+                                    const int8_t* wc = w + gc * K * D;
+                                    for (size_t i = 0; i < D; ++i)
+                                        d[i] += s * wc[i];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        static void DeconvolutionNhwcDepthwise(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst)
+        {
+            size_t C = p.srcC;
+            for (size_t sy = 0; sy < p.srcH; ++sy)
+            {
+                for (size_t sx = 0; sx < p.srcW; ++sx, src += C)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                        if (dy >= p.dstH)
+                            continue;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                        {
+                            size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                            if (dx >= p.dstW)
+                                continue;
+                            int32_t* d = dst + (dy * p.dstW + dx) * C;
+                            const int8_t* w = weight + (ky * p.kernelX + kx) * C;
+                            for (size_t c = 0; c < C; ++c)
+                                d[c] += (int(src[c]) - int(zero[c])) * w[c];
+                        }
+                    }
+                }
+            }
+        }
+
+        SynetDeconvolution8iNhwcDirect::SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p)
+            : SynetDeconvolution8i(p)
+        {
+            _weight.Resize(p.kernelY * p.kernelX * p.srcC * p.dstC / p.group);
+            _norm.Resize(p.dstC);
+            _convertSrc = Base::SynetConvert32fTo8u;
+            _deconvolution = p.IsDepthwise() ? DeconvolutionNhwcDepthwise : DeconvolutionNhwcGroup;
+        }
+
+        String SynetDeconvolution8iNhwcDirect::Desc() const
+        {
+            return Ext() + "::NhwcDirect" + (_param.IsDepthwise() ? "-dw" : "-" + ToStr(_param.group));
+        }
+
+        size_t SynetDeconvolution8iNhwcDirect::ExternalBufferSize() const
+        {
+            size_t size = SynetDeconvolution8i::ExternalBufferSize();
+            if (!_src8u)
+                size += AlignHi(_sizeS * sizeof(uint8_t), SIMD_ALIGN);
+            return size;
+        }
+
+        size_t SynetDeconvolution8iNhwcDirect::InternalBufferSize() const
+        {
+            return SynetDeconvolution8i::InternalBufferSize() + _weight.size * sizeof(int8_t) + _norm.size * sizeof(float);
+        }
+
+        void SynetDeconvolution8iNhwcDirect::SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
+        {
+            SynetDeconvolution8i::SetParams(weight, bias, params, stats);
+            const DeconvParam8i& p = _param;
+            size_t G = p.group, C = p.srcC / G, D = p.dstC / G, K = p.kernelY * p.kernelX;
+            bool dw = p.IsDepthwise();
+            for (size_t g = 0; g < G; ++g)
+            {
+                for (size_t d = 0; d < D; ++d)
+                {
+                    float maxW = 0.0f;
+                    for (size_t c = 0, gc = g * C; c < C; ++c, ++gc)
+                        for (size_t k = 0; k < K; ++k)
+                            maxW = Simd::Max(maxW, Simd::Abs(weight[(gc * K + k) * D + d] / _srcCvt.scale[gc]));
+                    float scale = maxW > 0.0f ? _srcCvt.iMax / maxW : 1.0f;
+                    for (size_t c = 0, gc = g * C; c < C; ++c, ++gc)
+                    {
+                        for (size_t k = 0; k < K; ++k)
+                        {
+                            size_t i = (gc * K + k) * D + d;
+                            int8_t w = SynetConvert32fTo8i(weight[i] / _srcCvt.scale[gc], scale, 0.0f, _srcCvt.iMin, _srcCvt.iMax);
+                            _weight[dw ? k * p.srcC + gc : i] = w;
+                        }
+                    }
+                    _norm[g * D + d] = 1.0f / scale;
+                }
+            }
+        }
+
+        bool SynetDeconvolution8iNhwcDirect::Preferable(const DeconvParam8i& p)
+        {
+            return p.group > 1;
+        }
+
+        void SynetDeconvolution8iNhwcDirect::Forward8u(const uint8_t* src, uint8_t* buf, float* dst)
+        {
+            const DeconvParam8i& p = _param;
+            if (!_src8u)
+            {
+                uint8_t* src8u = Allocate<uint8_t>(buf, _sizeS);
+                _convertSrc((float*)src, 1, p.srcC, p.srcH, p.srcW, p.srcF, _srcCvt.scale.data, _srcCvt.shift.data, src8u, p.compatibility);
+                src = src8u;
+            }
+            int32_t* sum = (int32_t*)dst;
+            memset(sum, 0, _sizeD * sizeof(int32_t));
+            _deconvolution(src, p, _srcCvt.zero.data, _weight.data, sum);
+            for (size_t i = 0, n = p.dstH * p.dstW; i < n; ++i)
+            {
+                for (size_t c = 0; c < p.dstC; ++c)
+                    dst[c] = float(sum[c]) * _norm[c];
+                sum += p.dstC;
+                dst += p.dstC;
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
+        {
+            DeconvParam8i param(batch, conv, compatibility);
+            if (!param.Valid())
+                return NULL;
+            if (SynetDeconvolution8iNhwcDirect::Preferable(param))
+                return new SynetDeconvolution8iNhwcDirect(param);
+            return new SynetDeconvolution8iGemm(param);
+        }
+    }
+#endif
+}
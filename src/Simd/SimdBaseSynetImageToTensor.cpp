@@ -0,0 +1,377 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2020 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetImageToTensor.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdConversion.h"
+#include "Simd/SimdYuvToBgr.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        bool ImageToTensorParam::Valid() const
+        {
+            if (srcW == 0 || srcH == 0 || dstW == 0 || dstH == 0)
+                return false;
+            if (channels != 1 && channels != 3)
+                return false;
+            if (dstType != SimdTensorData32f && dstType != SimdTensorData8u)
+                return false;
+            if (dstFormat != SimdTensorFormatNchw && dstFormat != SimdTensorFormatNhwc && dstFormat != SimdTensorFormatNchw4c && 
+                dstFormat != SimdTensorFormatNchw8c && dstFormat != SimdTensorFormatNchw16c)
+                return false;
+            if (IsYuv())
+            {
+                if (yuvType != SimdYuvBt601 && yuvType != SimdYuvBt709 && yuvType != SimdYuvBt2020 && yuvType != SimdYuvTrect871)
+                    return false;
+                if (srcFormat != SimdPixelFormatGray8 && srcFormat != SimdPixelFormatUv16)
+                    return false;
+                return srcW % 2 == 0 && srcH % 2 == 0;
+            }
+            return srcFormat == SimdPixelFormatGray8 || srcFormat == SimdPixelFormatBgr24 || srcFormat == SimdPixelFormatBgra32 ||
+                srcFormat == SimdPixelFormatRgb24 || srcFormat == SimdPixelFormatRgba32;
+        }
+
+        size_t ImageToTensorParam::Planes() const
+        {
+            if (IsYuv())
+                return srcFormat == SimdPixelFormatUv16 ? 2 : 3;
+            return 1;
+        }
+
+        size_t ImageToTensorParam::PlaneChannels(size_t plane) const
+        {
+            if (IsYuv())
+                return plane && srcFormat == SimdPixelFormatUv16 ? 2 : 1;
+            switch (srcFormat)
+            {
+            case SimdPixelFormatGray8: return 1;
+            case SimdPixelFormatBgr24: return 3;
+            case SimdPixelFormatBgra32: return 4;
+            case SimdPixelFormatRgb24: return 3;
+            case SimdPixelFormatRgba32: return 4;
+            default:
+                return 0;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        template<SimdPixelFormatType format> SIMD_INLINE void PixelToBgr(const uint8_t* src, uint8_t* bgr);
+
+        template<> SIMD_INLINE void PixelToBgr<SimdPixelFormatGray8>(const uint8_t* src, uint8_t* bgr)
+        {
+            bgr[0] = src[0];
+            bgr[1] = src[0];
+            bgr[2] = src[0];
+        }
+
+        template<> SIMD_INLINE void PixelToBgr<SimdPixelFormatBgr24>(const uint8_t* src, uint8_t* bgr)
+        {
+            bgr[0] = src[0];
+            bgr[1] = src[1];
+            bgr[2] = src[2];
+        }
+
+        template<> SIMD_INLINE void PixelToBgr<SimdPixelFormatRgb24>(const uint8_t* src, uint8_t* bgr)
+        {
+            bgr[0] = src[2];
+            bgr[1] = src[1];
+            bgr[2] = src[0];
+        }
+
+        template<SimdPixelFormatType format> SIMD_INLINE int PixelToGray(const uint8_t* src)
+        {
+            uint8_t bgr[3];
+            PixelToBgr<format>(src, bgr);
+            return BgrToGray(bgr[0], bgr[1], bgr[2]);
+        }
+
+        template<> SIMD_INLINE int PixelToGray<SimdPixelFormatGray8>(const uint8_t* src)
+        {
+            return src[0];
+        }
+
+        template<SimdPixelFormatType format, size_t step> void ToPixelsPackedBgr(const uint8_t* const* src, size_t width, uint8_t* dst)
+        {
+            const uint8_t* ps = src[0];
+            for (size_t x = 0; x < width; ++x, ps += step, dst += 3)
+                PixelToBgr<format>(ps, dst);
+        }
+
+        template<SimdPixelFormatType format, size_t step> void ToPixelsPackedGray(const uint8_t* const* src, size_t width, uint8_t* dst)
+        {
+            const uint8_t* ps = src[0];
+            for (size_t x = 0; x < width; ++x, ps += step)
+                dst[x] = PixelToGray<format>(ps);
+        }
+
+        template<class T, bool nv12> void ToPixelsYuvBgr(const uint8_t* const* src, size_t width, uint8_t* dst)
+        {
+            const uint8_t* y = src[0], * u = src[1], * v = nv12 ? src[1] + 1 : src[2];
+            const size_t uvStep = nv12 ? 2 : 1;
+            for (size_t x = 0, uv = 0; x < width; ++x, uv += uvStep, dst += 3)
+                YuvToBgr<T>(y[x], u[uv], v[uv], dst);
+        }
+
+        template<class T, bool nv12> void ToPixelsYuvGray(const uint8_t* const* src, size_t width, uint8_t* dst)
+        {
+            const uint8_t* y = src[0], * u = src[1], * v = nv12 ? src[1] + 1 : src[2];
+            const size_t uvStep = nv12 ? 2 : 1;
+            uint8_t bgr[3];
+            for (size_t x = 0, uv = 0; x < width; ++x, uv += uvStep)
+            {
+                YuvToBgr<T>(y[x], u[uv], v[uv], bgr);
+                dst[x] = BgrToGray(bgr[0], bgr[1], bgr[2]);
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        template<class T> SIMD_INLINE T ToTensorValue(int value, float scale, float shift);
+
+        template<> SIMD_INLINE float ToTensorValue<float>(int value, float scale, float shift)
+        {
+            return SynetConvert8uTo32f(value, scale, shift);
+        }
+
+        template<> SIMD_INLINE uint8_t ToTensorValue<uint8_t>(int value, float scale, float shift)
+        {
+            return (uint8_t)value;
+        }
+
+        template<class T> void ToTensorNhwc(const uint8_t* src, size_t width, size_t height, size_t channels, size_t align, size_t y, const float* scale, const float* shift, uint8_t* dst)
+        {
+            T* pd = (T*)dst + y * width * channels;
+            for (size_t x = 0; x < width; ++x)
+                for (size_t c = 0; c < channels; ++c)
+                    *pd++ = ToTensorValue<T>(*src++, scale[c], shift[c]);
+        }
+
+        template<class T> void ToTensorNchw(const uint8_t* src, size_t width, size_t height, size_t channels, size_t align, size_t y, const float* scale, const float* shift, uint8_t* dst)
+        {
+            size_t spatial = width * height, channelsA = AlignHi(channels, align);
+            T* pd = (T*)dst + y * width * align;
+            for (size_t c = 0; c < channelsA; ++c)
+            {
+                T* pc = pd + (c / align) * spatial * align + c % align;
+                if (c < channels)
+                {
+                    for (size_t x = 0; x < width; ++x, pc += align)
+                        *pc = ToTensorValue<T>(src[x * channels + c], scale[c], shift[c]);
+                }
+                else
+                {
+                    for (size_t x = 0; x < width; ++x, pc += align)
+                        *pc = 0;
+                }
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetImageToTensor::SynetImageToTensor(const ImageToTensorParam& param, const float* mean, const float* std, ResizerInitPtr resizerInit, SynetSetInputPtr setInput)
+            : _param(param)
+            , _toPixels(NULL)
+            , _toTensor(NULL)
+            , _setInput(NULL)
+        {
+            const ImageToTensorParam& p = _param;
+            _planes = p.Planes();
+            _align = SynetTensorAlignment(p.dstFormat);
+            _scale.Resize(p.channels);
+            _shift.Resize(p.channels);
+            for (size_t c = 0; c < p.channels; ++c)
+            {
+                float m = mean ? mean[c] : 0.0f, s = std ? std[c] : 1.0f;
+                _scale[c] = 1.0f / (255.0f * s);
+                _shift[c] = -m / s;
+            }
+            size_t rowSize = p.dstW * AlignHi(p.channels, _align) * (p.dstType == SimdTensorData32f ? 4 : 1);
+            for (size_t i = 0; i < _planes; ++i)
+            {
+                _stride[i] = p.dstW * p.PlaneChannels(i);
+                _buffer[i].Resize(_stride[i] * p.dstH);
+                rowSize += _stride[i];
+            }
+            _band = Simd::RestrictRange<size_t>(AlgCacheL2() / 2 / rowSize, 1, p.dstH);
+            _threads = Simd::Min(GetThreadNumber(), DivHi(p.dstH, _band));
+            _pixels.Resize(p.dstW * p.channels * _threads);
+            if (!p.IsYuv() && p.srcFormat != SimdPixelFormatRgba32 && p.dstType == SimdTensorData32f &&
+                (p.dstFormat == SimdTensorFormatNchw || p.dstFormat == SimdTensorFormatNhwc))
+            {
+                _setInput = setInput;
+                _lower.Resize(p.channels);
+                _upper.Resize(p.channels);
+                for (size_t c = 0; c < p.channels; ++c)
+                {
+                    _lower[c] = _shift[c];
+                    _upper[c] = _shift[c] + 255.0f * _scale[c];
+                }
+                if (p.dstFormat == SimdTensorFormatNchw && p.channels > 1)
+                    _tensor.Resize(p.dstW * p.channels * _band * _threads);
+            }
+            for (size_t t = 0; t < _threads; ++t)
+            {
+                for (size_t i = 0; i < _planes; ++i)
+                {
+                    size_t srcW = i ? p.srcW / 2 : p.srcW, srcH = i ? p.srcH / 2 : p.srcH;
+                    _resizers.push_back((Resizer*)resizerInit(srcW, srcH, p.dstW, p.dstH, p.PlaneChannels(i), SimdResizeChannelByte, p.method));
+                }
+            }
+            SetConverters();
+        }
+
+        SynetImageToTensor::~SynetImageToTensor()
+        {
+            for (size_t i = 0; i < _resizers.size(); ++i)
+                if (_resizers[i])
+                    delete _resizers[i];
+        }
+
+        bool SynetImageToTensor::Valid() const
+        {
+            for (size_t i = 0; i < _resizers.size(); ++i)
+                if (_resizers[i] == NULL)
+                    return false;
+            return _toPixels && _toTensor;
+        }
+
+        void SynetImageToTensor::Forward(const uint8_t* const* src, const size_t* stride, uint8_t* dst)
+        {
+            const ImageToTensorParam& p = _param;
+            Parallel(0, p.dstH, [&](size_t thread, size_t begin, size_t end)
+            {
+                Resizer** resizers = _resizers.data() + thread * _planes;
+                uint8_t* pixels = _pixels.data + thread * p.dstW * p.channels;
+                for (size_t yBeg = begin; yBeg < end; yBeg += _band)
+                {
+                    size_t yEnd = Simd::Min(yBeg + _band, end);
+                    for (size_t i = 0; i < _planes; ++i)
+                    {
+                        resizers[i]->SetBand(yBeg, yEnd);
+                        resizers[i]->Run(src[i], stride[i], _buffer[i].data, _stride[i]);
+                    }
+                    if (_setInput)
+                    {
+                        SetInput(thread, yBeg, yEnd, dst);
+                        continue;
+                    }
+                    for (size_t y = yBeg; y < yEnd; ++y)
+                    {
+                        const uint8_t* rows[3];
+                        for (size_t i = 0; i < _planes; ++i)
+                            rows[i] = _buffer[i].data + y * _stride[i];
+                        _toPixels(rows, p.dstW, pixels);
+                        _toTensor(pixels, p.dstW, p.dstH, p.channels, _align, y, _scale.data, _shift.data, dst);
+                    }
+                }
+            }, _threads, _band);
+        }
+
+        void SynetImageToTensor::SetInput(size_t thread, size_t yBeg, size_t yEnd, uint8_t* dst)
+        {
+            const ImageToTensorParam& p = _param;
+            const uint8_t* src = _buffer[0].data + yBeg * _stride[0];
+            size_t height = yEnd - yBeg, size = p.dstW * height;
+            if (_tensor.data)
+            {
+                float* tensor = _tensor.data + thread * p.dstW * p.channels * _band;
+                _setInput(src, p.dstW, height, _stride[0], p.srcFormat, _lower.data, _upper.data, tensor, p.channels, SimdTensorFormatNchw);
+                for (size_t c = 0; c < p.channels; ++c)
+                    memcpy((float*)dst + (c * p.dstH + yBeg) * p.dstW, tensor + c * size, size * sizeof(float));
+            }
+            else
+                _setInput(src, p.dstW, height, _stride[0], p.srcFormat, _lower.data, _upper.data, (float*)dst + yBeg * p.dstW * p.channels, p.channels, p.dstFormat);
+        }
+
+        template<class T> SIMD_INLINE void SetToPixelsYuv(bool nv12, bool gray, SynetImageToTensor::ToPixelsPtr & toPixels)
+        {
+            if (nv12)
+                toPixels = gray ? ToPixelsYuvGray<T, true> : ToPixelsYuvBgr<T, true>;
+            else
+                toPixels = gray ? ToPixelsYuvGray<T, false> : ToPixelsYuvBgr<T, false>;
+        }
+
+        void SynetImageToTensor::SetConverters()
+        {
+            const ImageToTensorParam& p = _param;
+            bool gray = p.channels == 1;
+            if (p.IsYuv())
+            {
+                bool nv12 = p.srcFormat == SimdPixelFormatUv16;
+                switch (p.yuvType)
+                {
+                case SimdYuvBt601: SetToPixelsYuv<Bt601>(nv12, gray, _toPixels); break;
+                case SimdYuvBt709: SetToPixelsYuv<Bt709>(nv12, gray, _toPixels); break;
+                case SimdYuvBt2020: SetToPixelsYuv<Bt2020>(nv12, gray, _toPixels); break;
+                case SimdYuvTrect871: SetToPixelsYuv<Trect871>(nv12, gray, _toPixels); break;
+                default:
+                    break;
+                }
+            }
+            else
+            {
+                switch (p.srcFormat)
+                {
+                case SimdPixelFormatGray8: _toPixels = gray ? ToPixelsPackedGray<SimdPixelFormatGray8, 1> : ToPixelsPackedBgr<SimdPixelFormatGray8, 1>; break;
+                case SimdPixelFormatBgr24: _toPixels = gray ? ToPixelsPackedGray<SimdPixelFormatBgr24, 3> : ToPixelsPackedBgr<SimdPixelFormatBgr24, 3>; break;
+                case SimdPixelFormatBgra32: _toPixels = gray ? ToPixelsPackedGray<SimdPixelFormatBgr24, 4> : ToPixelsPackedBgr<SimdPixelFormatBgr24, 4>; break;
+                case SimdPixelFormatRgb24: _toPixels = gray ? ToPixelsPackedGray<SimdPixelFormatRgb24, 3> : ToPixelsPackedBgr<SimdPixelFormatRgb24, 3>; break;
+                case SimdPixelFormatRgba32: _toPixels = gray ? ToPixelsPackedGray<SimdPixelFormatRgb24, 4> : ToPixelsPackedBgr<SimdPixelFormatRgb24, 4>; break;
+                default:
+                    break;
+                }
+            }
+            if (p.dstType == SimdTensorData32f)
+                _toTensor = p.dstFormat == SimdTensorFormatNhwc ? ToTensorNhwc<float> : ToTensorNchw<float>;
+            else
+                _toTensor = p.dstFormat == SimdTensorFormatNhwc ? ToTensorNhwc<uint8_t> : ToTensorNchw<uint8_t>;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetImageToTensorInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method,
+            const float* mean, const float* std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType, ResizerInitPtr resizerInit, SynetSetInputPtr setInput)
+        {
+            if (dstFormat == SimdTensorFormatNchwXc)
+                dstFormat = SynetSpecifyTensorFormat(dstFormat);
+            ImageToTensorParam param(srcW, srcH, srcFormat, yuvType, dstW, dstH, method, channels, dstFormat, dstType);
+            if (!param.Valid())
+                return NULL;
+            SynetImageToTensor* context = new SynetImageToTensor(param, mean, std, resizerInit, setInput);
+            if (!context->Valid())
+            {
+                delete context;
+                return NULL;
+            }
+            return context;
+        }
+    }
+#endif
+}
@@ -145,7 +145,7 @@ namespace Simd
 
         size_t SynetMergedConvolution32f::ExternalBufferSize() const
         {
-            return _sizeB[0] + _sizeB[1];
+            return (AlignHi(_sizeB[0], SIMD_ALIGN) + AlignHi(_sizeB[1], SIMD_ALIGN)) * _threads;
         }
 
         size_t SynetMergedConvolution32f::InternalBufferSize() const
@@ -301,6 +301,7 @@ namespace Simd
             _dw[0] = p.conv[0].kernelY*p.conv[0].kernelX*p.conv[0].srcC;
             _dw[1] = p.conv[1].kernelY*p.conv[1].kernelX;
             _dw[2] = AlignHiAny(p.conv[2].dstC, 2 * _miC);
+            SetThreads(p.conv[1].dstH);
         }
 
         void SynetMergedConvolution32fCdc::ReorderFirstWeight(const float * src, float * dst) const
@@ -373,32 +374,37 @@ namespace Simd
                 return;
             }
             const MergConvParam32f & p = _param;
-            float * buf0 = Buffer(buf);
-            float * buf1 = buf0 + _sizeB[0];
+            size_t step0 = AlignHi(_sizeB[0], SIMD_ALIGN), step1 = AlignHi(_sizeB[1], SIMD_ALIGN);
+            float * bufs = Buffer(buf);
             for (size_t b = 0; b < p.conv[0].batch; ++b)
             {
-                for (size_t c = 0, C = p.conv[1].dstC; c < C; c += _maC)
+                Simd::Parallel(0, p.conv[1].dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + _maC) - c;
-                    for (size_t yBeg1 = 0, yBeg0 = 0; yBeg1 < p.conv[1].dstH;)
+                    float* buf0 = bufs + thread * (step0 + step1);
+                    float* buf1 = buf0 + step0;
+                    for (size_t c = 0, C = p.conv[1].dstC; c < C; c += _maC)
                     {
-                        size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], p.conv[1].dstH);
-                        size_t yEnd0 = Simd::Min(Simd::Max(yBeg0 + _yStep[0], (_yStep[1] - 1)*p.conv[1].strideY + p.conv[1].kernelY - p.conv[1].padY), p.conv[0].dstH);
-                        _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
-                        _convolution[1](buf0, p.conv[1], maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], buf1, 1);
-                        if (p.add && c == 0)
+                        size_t maC = Simd::Min(C, c + _maC) - c;
+                        for (size_t yBeg1 = yBeg, yBeg0 = SrcRowBeg(p.conv[1], yBeg1); yBeg1 < yEnd;)
                         {
-                            size_t offset = yBeg1 * p.conv[2].dstW * p.conv[2].dstC, size = (yEnd1 - yBeg1)*p.conv[2].dstW * p.conv[2].dstC;
-                            memcpy(dst + offset, src + offset, sizeof(float)*size);
+                            size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], yEnd);
+                            size_t yEnd0 = SrcRowEnd(p.conv[1], yEnd1);
+                            _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
+                            _convolution[1](buf0, p.conv[1], maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], buf1, 1);
+                            if (p.add && c == 0)
+                            {
+                                size_t offset = yBeg1 * p.conv[2].dstW * p.conv[2].dstC, size = (yEnd1 - yBeg1) * p.conv[2].dstW * p.conv[2].dstC;
+                                memcpy(dst + offset, src + offset, sizeof(float) * size);
+                            }
+                            if (c + maC == C)
+                                _convolution[2](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (maC != C || p.add) ? 0 : 1);
+                            else
+                                _convolution[3](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (c != 0 || p.add) ? 0 : 1);
+                            yBeg1 = yEnd1;
+                            yBeg0 = yEnd0;
                         }
-                        if(c + maC == C)
-                            _convolution[2](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (maC != C || p.add) ? 0 : 1);
-                        else
-                            _convolution[3](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (c != 0 || p.add) ? 0 : 1);
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -449,6 +455,7 @@ namespace Simd
             _dp[1] = p.conv[1].activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             _dw[0] = p.conv[0].kernelY * p.conv[0].kernelX * p.conv[0].srcC;
             _dw[1] = p.conv[1].kernelY * p.conv[1].kernelX;
+            SetThreads(p.conv[1].dstH);
         }
 
         void SynetMergedConvolution32fCd::ReorderFirstWeight(const float* src, float* dst) const
@@ -497,22 +504,27 @@ namespace Simd
                 return;
             }
             const MergConvParam32f& p = _param;
-            float* buf0 = Buffer(buf);
+            size_t step0 = AlignHi(_sizeB[0], SIMD_ALIGN);
+            float* bufs = Buffer(buf);
             for (size_t b = 0; b < p.conv[0].batch; ++b)
             {
-                for (size_t c = 0, C = p.conv[1].dstC; c < C; c += _maC)
+                Simd::Parallel(0, p.conv[1].dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + _maC) - c;
-                    for (size_t yBeg1 = 0, yBeg0 = 0; yBeg1 < p.conv[1].dstH;)
+                    float* buf0 = bufs + thread * step0;
+                    for (size_t c = 0, C = p.conv[1].dstC; c < C; c += _maC)
                     {
-                        size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], p.conv[1].dstH);
-                        size_t yEnd0 = Simd::Min(Simd::Max(yBeg0 + _yStep[0], (_yStep[1] - 1) * p.conv[1].strideY + p.conv[1].kernelY - p.conv[1].padY), p.conv[0].dstH);
-                        _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
-                        _convolution[1](buf0, p.conv[1], maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], dst + c, 1);
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
+                        size_t maC = Simd::Min(C, c + _maC) - c;
+                        for (size_t yBeg1 = yBeg, yBeg0 = SrcRowBeg(p.conv[1], yBeg1); yBeg1 < yEnd;)
+                        {
+                            size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], yEnd);
+                            size_t yEnd0 = SrcRowEnd(p.conv[1], yEnd1);
+                            _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
+                            _convolution[1](buf0, p.conv[1], maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], dst + c, 1);
+                            yBeg1 = yEnd1;
+                            yBeg0 = yEnd0;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -562,6 +574,7 @@ namespace Simd
             _dp[0] = p.conv[0].activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             _dw[0] = p.conv[0].kernelY * p.conv[0].kernelX;
             _dw[1] = AlignHiAny(p.conv[1].dstC, 2 * _miC);
+            SetThreads(p.conv[0].dstH);
         }
 
         void SynetMergedConvolution32fDc::ReorderFirstWeight(const float* src, float* dst) const
@@ -615,23 +628,28 @@ namespace Simd
                 return;
             }
             const MergConvParam32f& p = _param;
-            float* buf0 = Buffer(buf);
+            size_t step0 = AlignHi(_sizeB[0], SIMD_ALIGN);
+            float* bufs = Buffer(buf);
             for (size_t b = 0; b < p.conv[0].batch; ++b)
             {
-                for (size_t c = 0, C = p.conv[0].dstC; c < C; c += _maC)
+                Simd::Parallel(0, p.conv[0].dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + _maC) - c;
-                    for (size_t yBeg0 = 0; yBeg0 < p.conv[0].dstH;)
+                    float* buf0 = bufs + thread * step0;
+                    for (size_t c = 0, C = p.conv[0].dstC; c < C; c += _maC)
                     {
-                        size_t yEnd0 = Simd::Min(yBeg0 + _yStep[0], p.conv[0].dstH);
-                        _convolution[0](src + c, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
-                        if (c + maC == C)
-                            _convolution[1](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, maC == C ? 1 : 0);
-                        else
-                            _convolution[2](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, c == 0 ? 1 : 0);
-                        yBeg0 = yEnd0;
+                        size_t maC = Simd::Min(C, c + _maC) - c;
+                        for (size_t yBeg0 = yBeg; yBeg0 < yEnd;)
+                        {
+                            size_t yEnd0 = Simd::Min(yBeg0 + _yStep[0], yEnd);
+                            _convolution[0](src + c, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
+                            if (c + maC == C)
+                                _convolution[1](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, maC == C ? 1 : 0);
+                            else
+                                _convolution[2](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, c == 0 ? 1 : 0);
+                            yBeg0 = yEnd0;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
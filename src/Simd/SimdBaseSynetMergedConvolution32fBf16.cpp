@@ -207,11 +207,16 @@ namespace Simd
         size_t SynetMergedConvolution32fBf16::ExternalBufferSize() const
         {
             if (_alg.miC)
-                return _sizeB[1] + (_sizeB[0] + _sizeB[2]) / 2 + (SIMD_ALIGN * 2 / 4);
+                return DivHi(ThreadBufferSize() * _threads, 4);
             else
                 return _sizeB[1] + _sizeB[0];
         }
 
+        size_t SynetMergedConvolution32fBf16::ThreadBufferSize() const
+        {
+            return AlignHi(_sizeB[0] * 2, SIMD_ALIGN) + AlignHi(_sizeB[1] * 4, SIMD_ALIGN) + AlignHi(_sizeB[2] * 2, SIMD_ALIGN) + SIMD_ALIGN * 2;
+        }
+
         size_t SynetMergedConvolution32fBf16::InternalBufferSize() const
         {
             size_t size = _buffer.size + _weightD.size;
@@ -455,44 +460,50 @@ namespace Simd
             const ConvParam32f& c2 = p.conv[2];
             const AlgParam& a = _alg;
 
-            uint8_t* buffer = (uint8_t*)Buffer(buf);
-            uint16_t* buf0 = Allocate<uint16_t>(buffer, _sizeB[0]);
-            SetGap(buffer);
-            float* buf1 = Allocate<float>(buffer, _sizeB[1]);
-            uint16_t* buf2 = Allocate<uint16_t>(buffer, _sizeB[2]);
-            SetGap(buffer);
+            uint8_t* bufs = (uint8_t*)Buffer(buf);
+            size_t step = ThreadBufferSize();
 
             for (size_t b = 0; b < c0.batch; ++b)
             {
-                for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
+                Simd::Parallel(0, c1.dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + a.maC) - c;
-                    for (size_t yBeg2 = 0, yBeg1 = 0, yBeg0 = 0; yBeg2 < c1.dstH;)
+                    uint8_t* buffer = bufs + thread * step;
+                    uint16_t* buf0 = Allocate<uint16_t>(buffer, _sizeB[0]);
+                    SetGap(buffer);
+                    float* buf1 = Allocate<float>(buffer, _sizeB[1]);
+                    uint16_t* buf2 = Allocate<uint16_t>(buffer, _sizeB[2]);
+                    SetGap(buffer);
+                    for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
                     {
-                        size_t yEnd2 = Simd::RestrictRange(yBeg2 + a.yStep[2], a.yStart[2], c1.dstH);
-                        size_t yEnd1 = Simd::RestrictRange(yBeg1 + a.yStep[1], a.yStart[1], c1.srcH);
-                        size_t yEnd0 = Simd::RestrictRange(yBeg0 + a.yStep[0], a.yStart[0], c0.srcH);
-                        _convert(src, c0, yBeg0, yEnd0, buf0, a.bufH[0]);
-                        _input(buf0, c0, a, maC, yBeg1, yEnd1, _weightI.data + c * a.dw[0], 
-                            _bias[0].data + c, _params[0].data + c * a.dp[0], buf1);
-                        _depthwise(buf1, c1, a, maC, yBeg2, yEnd2, _weightD.data + c * a.dw[1], 
-                            _bias[1].data + c, _params[1].data + c * a.dp[1], buf2);
-                        if (p.add && c == 0)
+                        size_t maC = Simd::Min(C, c + a.maC) - c;
+                        size_t yBeg2 = yBeg, yBeg1 = SrcRowBeg(c1, yBeg2), yBeg0 = SrcRowBeg(c0, yBeg1);
+                        while (yBeg2 < yEnd)
                         {
-                            size_t offset = yBeg1 * p.conv[2].dstW * p.conv[2].dstC, size = (yEnd1 - yBeg1) * p.conv[2].dstW * p.conv[2].dstC;
-                            memcpy(dst + offset, src + offset, sizeof(float) * size);
+                            size_t yEnd2 = Simd::Min(yBeg2 + a.yStep[2], yEnd);
+                            size_t yEnd1 = SrcRowEnd(c1, yEnd2);
+                            size_t yEnd0 = SrcRowEnd(c0, yEnd1);
+                            _convert(src, c0, yBeg0, yEnd0, buf0, a.bufH[0]);
+                            _input(buf0, c0, a, maC, yBeg1, yEnd1, _weightI.data + c * a.dw[0],
+                                _bias[0].data + c, _params[0].data + c * a.dp[0], buf1);
+                            _depthwise(buf1, c1, a, maC, yBeg2, yEnd2, _weightD.data + c * a.dw[1],
+                                _bias[1].data + c, _params[1].data + c * a.dp[1], buf2);
+                            if (p.add && c == 0)
+                            {
+                                size_t offset = yBeg2 * c2.dstW * c2.dstC, size = (yEnd2 - yBeg2) * c2.dstW * c2.dstC;
+                                memcpy(dst + offset, src + offset, sizeof(float) * size);
+                            }
+                            if (c + maC == C)
+                                _output[0](buf2, c2, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[2],
+                                    _bias[2].data, _params[2].data, dst, (maC != C || p.add) ? 0 : 1);
+                            else
+                                _output[1](buf2, c2, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[2],
+                                    _bias[2].data, _params[2].data, dst, (c != 0 || p.add) ? 0 : 1);
+                            yBeg2 = yEnd2;
+                            yBeg1 = yEnd1;
+                            yBeg0 = yEnd0;
                         }
-                        if (c + maC == C)
-                            _output[0](buf2, c2, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[2], 
-                                _bias[2].data, _params[2].data, dst, (maC != C || p.add) ? 0 : 1);
-                        else
-                            _output[1](buf2, c2, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[2], 
-                                _bias[2].data, _params[2].data, dst, (c != 0 || p.add) ? 0 : 1);
-                        yBeg2 = yEnd2;
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -533,7 +544,7 @@ namespace Simd
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
                 a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0]));
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] + c1.kernelY - c1.strideY - 1) * c0.strideY + c0.kernelY, a.yStart[0]));
 
                 _sizeB[0] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[1] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -549,6 +560,7 @@ namespace Simd
             
             ((ConvParam32f&)c1).dstT = SimdTensorData16b;
             ((ConvParam32f&)c2).srcT = SimdTensorData16b;
+            SetThreads(c1.dstH);
         }
 
         //-----------------------------------------------------------------------------------------
@@ -565,31 +577,37 @@ namespace Simd
             const ConvParam32f& c1 = p.conv[1];
             const AlgParam& a = _alg;
 
-            uint8_t* buffer = (uint8_t*)Buffer(buf);
-            uint16_t* buf0 = Allocate<uint16_t>(buffer, _sizeB[0]);
-            SetGap(buffer);
-            float* buf1 = Allocate<float>(buffer, _sizeB[1]);
+            uint8_t* bufs = (uint8_t*)Buffer(buf);
+            size_t step = ThreadBufferSize();
 
             for (size_t b = 0; b < c0.batch; ++b)
             {
-                for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
+                Simd::Parallel(0, c1.dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + a.maC) - c;
-                    for (size_t yBeg2 = 0, yBeg1 = 0, yBeg0 = 0; yBeg2 < c1.dstH;)
+                    uint8_t* buffer = bufs + thread * step;
+                    uint16_t* buf0 = Allocate<uint16_t>(buffer, _sizeB[0]);
+                    SetGap(buffer);
+                    float* buf1 = Allocate<float>(buffer, _sizeB[1]);
+                    for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
                     {
-                        size_t yEnd2 = Simd::RestrictRange(yBeg2 + a.yStep[2], a.yStart[2], c1.dstH);
-                        size_t yEnd1 = Simd::RestrictRange(yBeg1 + a.yStep[1], a.yStart[1], c1.srcH);
-                        size_t yEnd0 = Simd::RestrictRange(yBeg0 + a.yStep[0], a.yStart[0], c0.srcH);
-                        _convert(src, c0, yBeg0, yEnd0, buf0, a.bufH[0]);
-                        _input(buf0, c0, a, maC, yBeg1, yEnd1, _weightI.data + c * a.dw[0],
-                            _bias[0].data + c, _params[0].data + c * a.dp[0], buf1);
-                        _depthwise(buf1, c1, a, maC, yBeg2, yEnd2, _weightD.data + c * a.dw[1],
-                            _bias[1].data + c, _params[1].data + c * a.dp[1], (uint16_t*)dst);
-                        yBeg2 = yEnd2;
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
+                        size_t maC = Simd::Min(C, c + a.maC) - c;
+                        size_t yBeg2 = yBeg, yBeg1 = SrcRowBeg(c1, yBeg2), yBeg0 = SrcRowBeg(c0, yBeg1);
+                        while (yBeg2 < yEnd)
+                        {
+                            size_t yEnd2 = Simd::Min(yBeg2 + a.yStep[2], yEnd);
+                            size_t yEnd1 = SrcRowEnd(c1, yEnd2);
+                            size_t yEnd0 = SrcRowEnd(c0, yEnd1);
+                            _convert(src, c0, yBeg0, yEnd0, buf0, a.bufH[0]);
+                            _input(buf0, c0, a, maC, yBeg1, yEnd1, _weightI.data + c * a.dw[0],
+                                _bias[0].data + c, _params[0].data + c * a.dp[0], buf1);
+                            _depthwise(buf1, c1, a, maC, yBeg2, yEnd2, _weightD.data + c * a.dw[1],
+                                _bias[1].data + c, _params[1].data + c * a.dp[1], (uint16_t*)dst);
+                            yBeg2 = yEnd2;
+                            yBeg1 = yEnd1;
+                            yBeg0 = yEnd0;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -628,7 +646,7 @@ namespace Simd
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
                 a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0]));
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] + c1.kernelY - c1.strideY - 1) * c0.strideY + c0.kernelY, a.yStart[0]));
 
                 _sizeB[0] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[1] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -642,6 +660,7 @@ namespace Simd
             a.dw[2] = 0;
             a.bufH[2] = 0;
             _sizeB[2] = 0;
+            SetThreads(c1.dstH);
         }
 
         //-----------------------------------------------------------------------------------------
@@ -658,31 +677,34 @@ namespace Simd
             const ConvParam32f& c1 = p.conv[1];
             const AlgParam& a = _alg;
 
-            uint8_t* buffer = (uint8_t*)Buffer(buf);
-            uint16_t* buf2 = Allocate<uint16_t>(buffer, _sizeB[2]);
-            SetGap(buffer);
+            uint8_t* bufs = (uint8_t*)Buffer(buf);
+            size_t step = ThreadBufferSize();
 
             for (size_t b = 0; b < c0.batch; ++b)
             {
-                for (size_t c = 0, C = c0.dstC; c < C; c += a.maC)
+                Simd::Parallel(0, c0.dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + a.maC) - c;
-                    for (size_t yBeg2 = 0, yBeg1 = 0, yBeg0 = 0; yBeg2 < c1.dstH;)
+                    uint8_t* buffer = bufs + thread * step;
+                    uint16_t* buf2 = Allocate<uint16_t>(buffer, _sizeB[2]);
+                    SetGap(buffer);
+                    for (size_t c = 0, C = c0.dstC; c < C; c += a.maC)
                     {
-                        size_t yEnd2 = Simd::RestrictRange(yBeg2 + a.yStep[2], a.yStart[2], c0.dstH);
-                        size_t yEnd1 = Simd::RestrictRange(yBeg1 + a.yStep[1], a.yStart[1], c0.srcH);
-                        _depthwise(src + c, c0, a, maC, yBeg2, yEnd2, _weightD.data + c * a.dw[0], _bias[0].data + c,
-                            _params[0].data + c * a.dp[0], buf2);
-                        if (c + maC == C)
-                            _output[0](buf2, c1, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[1],
-                                _bias[1].data, _params[1].data, dst, maC != C ? 0 : 1);
-                        else
-                            _output[1](buf2, c1, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[1],
-                                _bias[1].data, _params[1].data, dst, c != 0 ? 0 : 1);
-                        yBeg2 = yEnd2;
-                        yBeg1 = yEnd1;
+                        size_t maC = Simd::Min(C, c + a.maC) - c;
+                        for (size_t yBeg2 = yBeg; yBeg2 < yEnd;)
+                        {
+                            size_t yEnd2 = Simd::Min(yBeg2 + a.yStep[2], yEnd);
+                            _depthwise(src + c, c0, a, maC, yBeg2, yEnd2, _weightD.data + c * a.dw[0], _bias[0].data + c,
+                                _params[0].data + c * a.dp[0], buf2);
+                            if (c + maC == C)
+                                _output[0](buf2, c1, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[1],
+                                    _bias[1].data, _params[1].data, dst, maC != C ? 0 : 1);
+                            else
+                                _output[1](buf2, c1, a, maC, yBeg2, yEnd2, _weightO.data + c * a.dw[1],
+                                    _bias[1].data, _params[1].data, dst, c != 0 ? 0 : 1);
+                            yBeg2 = yEnd2;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -735,6 +757,7 @@ namespace Simd
 
             ((ConvParam32f&)c0).dstT = SimdTensorData16b;
             ((ConvParam32f&)c1).srcT = SimdTensorData16b;
+            SetThreads(c0.dstH);
         }
     }
 #endif
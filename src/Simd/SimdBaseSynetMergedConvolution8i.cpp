@@ -65,6 +65,7 @@ namespace Simd
 #endif        
         {
             _alg.miC = 0;
+            _threads = 1;
             const ConvParam8i& beg = p.conv[0];
             const ConvParam8i& end = p.conv[p.count - 1];
             _sizeS = beg.srcH * beg.srcW * beg.srcC;
@@ -124,7 +125,8 @@ namespace Simd
 
         size_t SynetMergedConvolution8i::ExternalBufferSize() const
         {
-            return (_sizeB[0] + _sizeB[1] + _sizeB[4]) * 4 + _sizeB[2] + _sizeB[3] + SIMD_ALIGN;
+            return (AlignHi(_sizeB[0], SIMD_ALIGN) * _threads + _sizeB[1] + _sizeB[4]) * 4 + 
+                (AlignHi(_sizeB[2], SIMD_ALIGN) + AlignHi(_sizeB[3], SIMD_ALIGN)) * _threads + SIMD_ALIGN;
         }
 
         size_t SynetMergedConvolution8i::InternalBufferSize() const
@@ -303,6 +305,12 @@ namespace Simd
             }
         }
 
+        void SynetMergedConvolution8i::SetThreads(size_t dstH)
+        {
+            int64_t limit = Simd::Max<int64_t>(_param.Flop() / _param.conv[0].batch / SYNET_INT8_THREAD_FLOP_MIN, 1);
+            _threads = Simd::Min<size_t>(Simd::Min<size_t>(Base::GetThreadNumber(), dstH), size_t(limit));
+        }
+
         void SynetMergedConvolution8i::Quantize(const float* weight, const float* bias, size_t i, size_t q)
         {
             const ConvParam8i& conv = _param.conv[i];
@@ -486,6 +494,18 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        SIMD_INLINE size_t SrcRowBeg(const ConvParam8i& p, size_t dstRow)
+        {
+            return Simd::Max<ptrdiff_t>(ptrdiff_t(dstRow * p.strideY) - ptrdiff_t(p.padY), 0);
+        }
+
+        SIMD_INLINE size_t SrcRowEnd(const ConvParam8i& p, size_t dstRow)
+        {
+            return Simd::Min((dstRow - 1) * p.strideY + p.kernelY - p.padY, p.srcH);
+        }
+
+        //---------------------------------------------------------------------
+
         SynetMergedConvolution8iCdc::SynetMergedConvolution8iCdc(const MergConvParam8i& p)
             : SynetMergedConvolution8i(p)
         {
@@ -500,38 +520,46 @@ namespace Simd
             const AlgParam& a = _alg;
 
             buf = GetBuffer(buf);
-            float* buf0 = Allocate<float>(buf, _sizeB[0]);
-            uint8_t* buf2 = Allocate<uint8_t>(buf, _sizeB[2]);
-            uint8_t* buf3 = Allocate<uint8_t>(buf, _sizeB[3]);
+            size_t step0 = AlignHi(_sizeB[0], SIMD_ALIGN), step2 = AlignHi(_sizeB[2], SIMD_ALIGN), step3 = AlignHi(_sizeB[3], SIMD_ALIGN);
+            float* bufs0 = Allocate<float>(buf, step0 * _threads);
+            uint8_t* bufs2 = Allocate<uint8_t>(buf, step2 * _threads);
+            uint8_t* bufs3 = Allocate<uint8_t>(buf, step3 * _threads);
             int32_t* buf4 = Allocate<int32_t>(buf, _sizeB[4]);
 
             for (size_t b = 0; b < c0.batch; ++b)
             {
-                for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
+                Simd::Parallel(0, c1.dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + a.maC) - c;
-                    for (size_t yBeg2 = 0, yBeg1 = 0, yBeg0 = 0; yBeg2 < c1.dstH;)
+                    float* buf0 = bufs0 + thread * step0;
+                    uint8_t* buf2 = bufs2 + thread * step2;
+                    uint8_t* buf3 = bufs3 + thread * step3;
+                    for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
                     {
-                        size_t yEnd2 = Simd::RestrictRange(yBeg2 + a.yStep[2], a.yStart[2], c1.dstH);
-                        size_t yEnd1 = Simd::RestrictRange(yBeg1 + a.yStep[1], a.yStart[1], c1.srcH);
-                        size_t yEnd0 = Simd::RestrictRange(yBeg0 + a.yStep[0], a.yStart[0], c0.srcH);
-                        if (!_s8u)
-                            _cvt32fTo8u((float*)src, yBeg0, yEnd0, c0.srcW, c0.srcC, _cvt[0].scale.data, _cvt[0].shift.data, buf2, a.bufH[0], c0.compatibility);
-                        _input(_s8u ? src : buf2, c0, a, maC, yBeg1, yEnd1, _weight8i[0].data + c * a.dw[0], _norm[0].data + c, 
-                            _bias[0].data + c, _params[0].data + c * a.dp[0], buf0);
-                        _depthwise(buf0, c1, a, maC, yBeg2, yEnd2, _weight32f.data + c * a.dw[1], _bias[1].data + c, 
-                            _params[1].data + c * a.dp[1], _cvt[1].scale.data + c, _cvt[1].shift.data + c, buf3);
-                        if (c + maC == C)
-                            _output[0](buf3, c2, a, maC, yBeg2, yEnd2, _weight8i[1].data + c * a.dw[2], _norm[1].data, _bias[2].data, 
-                                _params[2].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, maC == C ? 1 : 0);
-                        else
-                            _output[1](buf3, c2, a, maC, yBeg2, yEnd2, _weight8i[1].data + c * a.dw[2], _norm[1].data, _bias[2].data,
-                                _params[2].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, c == 0 ? 1 : 0);
-                        yBeg2 = yEnd2;
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
+                        size_t maC = Simd::Min(C, c + a.maC) - c;
+                        size_t yBeg2 = yBeg, yBeg1 = SrcRowBeg(c1, yBeg2), yBeg0 = SrcRowBeg(c0, yBeg1);
+                        while (yBeg2 < yEnd)
+                        {
+                            size_t yEnd2 = Simd::Min(yBeg2 + a.yStep[2], yEnd);
+                            size_t yEnd1 = SrcRowEnd(c1, yEnd2);
+                            size_t yEnd0 = SrcRowEnd(c0, yEnd1);
+                            if (!_s8u)
+                                _cvt32fTo8u((float*)src, yBeg0, yEnd0, c0.srcW, c0.srcC, _cvt[0].scale.data, _cvt[0].shift.data, buf2, a.bufH[0], c0.compatibility);
+                            _input(_s8u ? src : buf2, c0, a, maC, yBeg1, yEnd1, _weight8i[0].data + c * a.dw[0], _norm[0].data + c,
+                                _bias[0].data + c, _params[0].data + c * a.dp[0], buf0);
+                            _depthwise(buf0, c1, a, maC, yBeg2, yEnd2, _weight32f.data + c * a.dw[1], _bias[1].data + c,
+                                _params[1].data + c * a.dp[1], _cvt[1].scale.data + c, _cvt[1].shift.data + c, buf3);
+                            if (c + maC == C)
+                                _output[0](buf3, c2, a, maC, yBeg2, yEnd2, _weight8i[1].data + c * a.dw[2], _norm[1].data, _bias[2].data,
+                                    _params[2].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, maC == C ? 1 : 0);
+                            else
+                                _output[1](buf3, c2, a, maC, yBeg2, yEnd2, _weight8i[1].data + c * a.dw[2], _norm[1].data, _bias[2].data,
+                                    _params[2].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, c == 0 ? 1 : 0);
+                            yBeg2 = yEnd2;
+                            yBeg1 = yEnd1;
+                            yBeg0 = yEnd0;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS * (_s8u ? 1 : 4);
                 dst += _sizeD * (_d8u ? 1 : 4);
             }
@@ -571,7 +599,7 @@ namespace Simd
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
                 a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0])) * (_s8u ? 0 : 1);
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] + c1.kernelY - c1.strideY - 1) * c0.strideY + c0.kernelY, a.yStart[0])) * (_s8u ? 0 : 1);
 
                 _sizeB[2] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[0] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -581,6 +609,7 @@ namespace Simd
             }
             _sizeB[1] = 0;
             _sizeB[4] = count > 1 ? _sizeD : 0;
+            SetThreads(c1.dstH);
             a.dp[0] = c0.activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             a.dp[1] = c1.activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             a.dw[0] = c0.kernelY * c0.kernelX * c0.srcC;
@@ -604,30 +633,37 @@ namespace Simd
             const AlgParam& a = _alg;
 
             buf = GetBuffer(buf);
-            float* buf0 = Allocate<float>(buf, _sizeB[0]);
-            uint8_t* buf2 = Allocate<uint8_t>(buf, _sizeB[2]);
+            size_t step0 = AlignHi(_sizeB[0], SIMD_ALIGN), step2 = AlignHi(_sizeB[2], SIMD_ALIGN);
+            float* bufs0 = Allocate<float>(buf, step0 * _threads);
+            uint8_t* bufs2 = Allocate<uint8_t>(buf, step2 * _threads);
 
             for (size_t b = 0; b < c0.batch; ++b)
             {
-                for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
+                Simd::Parallel(0, c1.dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + a.maC) - c;
-                    for (size_t yBeg2 = 0, yBeg1 = 0, yBeg0 = 0; yBeg2 < c1.dstH;)
+                    float* buf0 = bufs0 + thread * step0;
+                    uint8_t* buf2 = bufs2 + thread * step2;
+                    for (size_t c = 0, C = c1.dstC; c < C; c += a.maC)
                     {
-                        size_t yEnd2 = Simd::RestrictRange(yBeg2 + a.yStep[2], a.yStart[2], c1.dstH);
-                        size_t yEnd1 = Simd::RestrictRange(yBeg1 + a.yStep[1], a.yStart[1], c1.srcH);
-                        size_t yEnd0 = Simd::RestrictRange(yBeg0 + a.yStep[0], a.yStart[0], c0.srcH);
-                        if (!_s8u)
-                            _cvt32fTo8u((float*)src, yBeg0, yEnd0, c0.srcW, c0.srcC, _cvt[0].scale.data, _cvt[0].shift.data, buf2, a.bufH[0], c0.compatibility);
-                        _input(_s8u ? src : buf2, c0, a, maC, yBeg1, yEnd1, _weight8i[0].data + c * a.dw[0], _norm[0].data + c,
-                            _bias[0].data + c, _params[0].data + c * a.dp[0], buf0);
-                        _depthwise(buf0, c1, a, maC, yBeg2, yEnd2, _weight32f.data + c * a.dw[1], _bias[1].data + c,
-                            _params[1].data + c * a.dp[1], _cvt[2].scale.data + c, _cvt[2].shift.data + c, dst + c);
-                        yBeg2 = yEnd2;
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
+                        size_t maC = Simd::Min(C, c + a.maC) - c;
+                        size_t yBeg2 = yBeg, yBeg1 = SrcRowBeg(c1, yBeg2), yBeg0 = SrcRowBeg(c0, yBeg1);
+                        while (yBeg2 < yEnd)
+                        {
+                            size_t yEnd2 = Simd::Min(yBeg2 + a.yStep[2], yEnd);
+                            size_t yEnd1 = SrcRowEnd(c1, yEnd2);
+                            size_t yEnd0 = SrcRowEnd(c0, yEnd1);
+                            if (!_s8u)
+                                _cvt32fTo8u((float*)src, yBeg0, yEnd0, c0.srcW, c0.srcC, _cvt[0].scale.data, _cvt[0].shift.data, buf2, a.bufH[0], c0.compatibility);
+                            _input(_s8u ? src : buf2, c0, a, maC, yBeg1, yEnd1, _weight8i[0].data + c * a.dw[0], _norm[0].data + c,
+                                _bias[0].data + c, _params[0].data + c * a.dp[0], buf0);
+                            _depthwise(buf0, c1, a, maC, yBeg2, yEnd2, _weight32f.data + c * a.dw[1], _bias[1].data + c,
+                                _params[1].data + c * a.dp[1], _cvt[2].scale.data + c, _cvt[2].shift.data + c, dst + c);
+                            yBeg2 = yEnd2;
+                            yBeg1 = yEnd1;
+                            yBeg0 = yEnd0;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS * (_s8u ? 1 : 4);
                 dst += _sizeD * (_d8u ? 1 : 4);
             }
@@ -666,7 +702,7 @@ namespace Simd
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
                 a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0])) * (_s8u ? 0 : 1);
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] + c1.kernelY - c1.strideY - 1) * c0.strideY + c0.kernelY, a.yStart[0])) * (_s8u ? 0 : 1);
 
                 _sizeB[2] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[0] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -677,6 +713,7 @@ namespace Simd
             _sizeB[1] = 0;
             _sizeB[3] = 0;
             _sizeB[4] = 0;
+            SetThreads(c1.dstH);
             a.dp[0] = c0.activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             a.dp[1] = c1.activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             a.dw[0] = c0.kernelY * c0.kernelX * c0.srcC;
@@ -699,34 +736,41 @@ namespace Simd
             const AlgParam& a = _alg;
 
             buf = GetBuffer(buf);
-            float* buf0 = Allocate<float>(buf, _sizeB[0]);
-            uint8_t* buf2 = Allocate<uint8_t>(buf, _sizeB[2]);
+            size_t step0 = AlignHi(_sizeB[0], SIMD_ALIGN), step2 = AlignHi(_sizeB[2], SIMD_ALIGN);
+            float* bufs0 = Allocate<float>(buf, step0 * _threads);
+            uint8_t* bufs2 = Allocate<uint8_t>(buf, step2 * _threads);
             int32_t* buf4 = Allocate<int32_t>(buf, _sizeB[4]);
 
             for (size_t b = 0; b < c0.batch; ++b)
             {
-                for (size_t c = 0, C = c0.dstC; c < C; c += a.maC)
+                Simd::Parallel(0, c0.dstH, [&](size_t thread, size_t yBeg, size_t yEnd)
                 {
-                    size_t maC = Simd::Min(C, c + a.maC) - c;
-                    for (size_t yBeg2 = 0, yBeg1 = 0, yBeg0 = 0; yBeg2 < c0.dstH;)
+                    float* buf0 = bufs0 + thread * step0;
+                    uint8_t* buf2 = bufs2 + thread * step2;
+                    for (size_t c = 0, C = c0.dstC; c < C; c += a.maC)
                     {
-                        size_t yEnd2 = Simd::RestrictRange(yBeg2 + a.yStep[2], a.yStart[2], c0.dstH);
-                        size_t yEnd1 = Simd::RestrictRange(yBeg1 + a.yStep[1], a.yStart[1], c0.srcH);
-                        if (_s8u)
-                            _cvt8uTo32f(src + c, maC, yBeg1, yEnd1, c0.srcW, c0.srcC, _cvt[0].iScale.data + c, 
-                                _cvt[0].iShift.data + c, buf0, a.bufH[1], c0.compatibility);
-                        _depthwise(_s8u ? buf0 : (float*)src + c, c0, a, maC, yBeg2, yEnd2, _weight32f.data + c * a.dw[0], _bias[0].data + c,
-                            _params[0].data + c * a.dp[0], _cvt[1].scale.data + c, _cvt[1].shift.data + c, buf2);
-                        if (c + maC == C)
-                            _output[0](buf2, c1, a, maC, yBeg2, yEnd2, _weight8i[0].data + c * a.dw[1], _norm[0].data, _bias[1].data,
-                                _params[1].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, maC == C ? 1 : 0);
-                        else
-                            _output[1](buf2, c1, a, maC, yBeg2, yEnd2, _weight8i[0].data + c * a.dw[1], _norm[0].data, _bias[1].data,
-                                _params[1].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, c == 0 ? 1 : 0);
-                        yBeg2 = yEnd2;
-                        yBeg1 = yEnd1;
+                        size_t maC = Simd::Min(C, c + a.maC) - c;
+                        size_t yBeg2 = yBeg, yBeg1 = SrcRowBeg(c0, yBeg2);
+                        while (yBeg2 < yEnd)
+                        {
+                            size_t yEnd2 = Simd::Min(yBeg2 + a.yStep[2], yEnd);
+                            size_t yEnd1 = SrcRowEnd(c0, yEnd2);
+                            if (_s8u)
+                                _cvt8uTo32f(src + c, maC, yBeg1, yEnd1, c0.srcW, c0.srcC, _cvt[0].iScale.data + c,
+                                    _cvt[0].iShift.data + c, buf0, a.bufH[1], c0.compatibility);
+                            _depthwise(_s8u ? buf0 : (float*)src + c, c0, a, maC, yBeg2, yEnd2, _weight32f.data + c * a.dw[0], _bias[0].data + c,
+                                _params[0].data + c * a.dp[0], _cvt[1].scale.data + c, _cvt[1].shift.data + c, buf2);
+                            if (c + maC == C)
+                                _output[0](buf2, c1, a, maC, yBeg2, yEnd2, _weight8i[0].data + c * a.dw[1], _norm[0].data, _bias[1].data,
+                                    _params[1].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, maC == C ? 1 : 0);
+                            else
+                                _output[1](buf2, c1, a, maC, yBeg2, yEnd2, _weight8i[0].data + c * a.dw[1], _norm[0].data, _bias[1].data,
+                                    _params[1].data, _cvt[2].scale.data, _cvt[2].shift.data, buf4, dst, c == 0 ? 1 : 0);
+                            yBeg2 = yEnd2;
+                            yBeg1 = yEnd1;
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS * (_s8u ? 1 : 4);
                 dst += _sizeD * (_d8u ? 1 : 4);
             }
@@ -772,6 +816,7 @@ namespace Simd
             _sizeB[1] = 0;
             _sizeB[3] = 0;
             _sizeB[4] = count > 1 ? _sizeD : 0;
+            SetThreads(c0.dstH);
             a.dp[0] = c0.activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             a.dp[1] = c1.activation == ::SimdConvolutionActivationPrelu ? 1 : 0;
             a.dw[0] = c0.kernelY * c0.kernelX;
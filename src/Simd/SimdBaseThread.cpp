@@ -21,15 +21,179 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 * SOFTWARE.
 */
+#include "Simd/SimdMemory.h"
 #include "Simd/SimdMath.h"
 #include "Simd/SimdBase.h"
 
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <memory>
 
 namespace Simd
 {
     namespace Base
     {
+        class ThreadPool
+        {
+        public:
+            ThreadPool()
+                : _size(0)
+            {
+                _workers.resize(Simd::Max<size_t>(std::thread::hardware_concurrency(), 1));
+            }
+
+            void SetSize(size_t size)
+            {
+                if (s_inside)
+                    return;
+                Grow(size);
+            }
+
+            void Run(size_t begin, size_t end, SimdParallelTaskPtr task, void * context, size_t threadNumber, size_t blockAlign)
+            {
+                size_t blockSize = DivHi(end - begin, threadNumber);
+                blockSize = DivHi(blockSize, blockAlign) * blockAlign;
+                size_t blockNumber = DivHi(end - begin, blockSize);
+                if (blockNumber <= 1 || s_inside)
+                {
+                    task(context, 0, begin, end);
+                    return;
+                }
+                Grow(blockNumber - 1);
+                s_inside = true;
+                std::atomic<size_t> pending(0);
+                size_t block = 1, size = _size.load(std::memory_order_acquire);
+                for (size_t w = 0; w < size && block < blockNumber; ++w)
+                {
+                    Worker & worker = *_workers[w];
+                    int idle = Idle;
+                    if (!worker.state.compare_exchange_strong(idle, Claimed))
+                        continue;
+                    worker.task = task;
+                    worker.context = context;
+                    worker.pending = &pending;
+                    worker.index = block;
+                    worker.begin = begin + block * blockSize;
+                    worker.end = Simd::Min(worker.begin + blockSize, end);
+                    pending.fetch_add(1);
+                    Wake(worker, Busy);
+                    block++;
+                }
+                task(context, 0, begin, begin + blockSize);
+                for (; block < blockNumber; ++block)
+                    task(context, block, begin + block * blockSize, Simd::Min(begin + (block + 1) * blockSize, end));
+                while (pending.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                s_inside = false;
+            }
+
+        private:
+            static const size_t SPIN_COUNT = 1 << 14;
+
+            enum State
+            {
+                Idle,
+                Claimed,
+                Busy,
+            };
+
+            struct Worker
+            {
+                std::thread thread;
+                std::atomic<int> state;
+                std::atomic<bool> parked;
+                std::mutex mutex;
+                std::condition_variable wake;
+                SimdParallelTaskPtr task;
+                void * context;
+                std::atomic<size_t> * pending;
+                size_t index, begin, end;
+
+                Worker()
+                    : state(Idle)
+                    , parked(false)
+                    , task(NULL)
+                    , context(NULL)
+                    , pending(NULL)
+                    , index(0)
+                    , begin(0)
+                    , end(0)
+                {
+                }
+            };
+            typedef std::unique_ptr<Worker> WorkerPtr;
+            typedef std::vector<WorkerPtr> WorkerPtrs;
+
+            std::mutex _mutex;
+            WorkerPtrs _workers;
+            std::atomic<size_t> _size;
+
+            static thread_local bool s_inside;
+
+            void Grow(size_t size)
+            {
+                size = Simd::Min(size, _workers.size());
+                if (_size.load(std::memory_order_acquire) >= size)
+                    return;
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (size_t w = _size.load(); w < size; ++w)
+                {
+                    _workers[w].reset(new Worker());
+                    Worker * worker = _workers[w].get();
+                    worker->thread = std::thread([worker] { Loop(*worker); });
+                    worker->thread.detach();
+                    _size.store(w + 1, std::memory_order_release);
+                }
+            }
+
+            static void Wake(Worker & worker, State state)
+            {
+                worker.state.store(state);
+                if (worker.parked.load())
+                {
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    worker.wake.notify_one();
+                }
+            }
+
+            static void Loop(Worker & worker)
+            {
+                s_inside = true;
+                for (;;)
+                {
+                    int state = worker.state.load(std::memory_order_acquire);
+                    for (size_t i = 0; state != Busy && i < SPIN_COUNT; ++i)
+                        state = worker.state.load(std::memory_order_acquire);
+                    if (state != Busy)
+                    {
+                        std::unique_lock<std::mutex> lock(worker.mutex);
+                        worker.parked.store(true);
+                        worker.wake.wait(lock, [&worker] { return worker.state.load() == Busy; });
+                        worker.parked.store(false);
+                    }
+                    std::atomic<size_t> * pending = worker.pending;
+                    worker.task(worker.context, worker.index, worker.begin, worker.end);
+                    worker.state.store(Idle, std::memory_order_release);
+                    pending->fetch_sub(1, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local bool ThreadPool::s_inside = false;
+
+        static ThreadPool & GetThreadPool()
+        {
+            // The pool is never destroyed: its workers are detached and stay parked until the process exits.
+            // Joining them in a static destructor may hang when the library is unloaded (other threads are already terminated).
+            static ThreadPool * pool = new ThreadPool();
+            return *pool;
+        }
+
+        //---------------------------------------------------------------------
+
         size_t g_threadNumber = 1;
 
         size_t GetThreadNumber()
@@ -40,6 +204,18 @@ namespace Simd
         void SetThreadNumber(size_t threadNumber)
         {
             g_threadNumber = Simd::RestrictRange<size_t>(threadNumber, 1, std::thread::hardware_concurrency());
+            GetThreadPool().SetSize(g_threadNumber - 1);
+        }
+
+        void ParallelFor(size_t begin, size_t end, SimdParallelTaskPtr task, void * context, size_t threadNumber, size_t blockAlign)
+        {
+            if (begin >= end)
+                return;
+            threadNumber = Simd::Min<size_t>(threadNumber, std::thread::hardware_concurrency());
+            if (threadNumber <= 1)
+                task(context, 0, begin, end);
+            else
+                GetThreadPool().Run(begin, end, task, context, threadNumber, Simd::Max<size_t>(blockAlign, 1));
         }
     }
 }
@@ -46,6 +46,9 @@ namespace Simd
         size_t size;
         SimdImageFileType file;
         SimdPixelFormatType format;
+        size_t scale;
+        size_t planes;
+        SimdYuvType yuvType;
 
         ImageLoaderParam(const uint8_t* d, size_t s, SimdPixelFormatType f);
 
@@ -56,10 +59,25 @@ namespace Simd
     {
     protected:
         typedef Simd::View<Simd::Allocator> Image;
+        typedef void (*ReorderPtr)(const uint8_t* src, size_t size, uint8_t* dst);
 
         ImageLoaderParam _param;
         InputMemoryStream _stream;
-        Image _image;
+        Image _image, _target;
+
+        SIMD_INLINE bool InitImage(size_t width, size_t height)
+        {
+            if (_target.data)
+            {
+                if (_target.width != width || _target.height != height)
+                    return false;
+                _image.Clear();
+                _image = _target;
+            }
+            else
+                _image.Recreate(width, height, (Image::Format)_param.format);
+            return true;
+        }
         
     public:
         ImageLoader(const ImageLoaderParam& param)
@@ -74,6 +92,25 @@ namespace Simd
 
         virtual bool FromStream() = 0;
 
+        virtual bool Probe(size_t* width, size_t* height) = 0;
+
+        SIMD_INLINE SimdPixelFormatType Format() const
+        {
+            return _param.format;
+        }
+
+        SIMD_INLINE void SetData(const uint8_t* data, size_t size)
+        {
+            _param.data = data;
+            _param.size = size;
+            _stream.Init(data, size);
+        }
+
+        SIMD_INLINE void SetTarget(uint8_t* dst, size_t stride, size_t width, size_t height)
+        {
+            _target = Image(width, height, stride, (Image::Format)_param.format, dst);
+        }
+
         SIMD_INLINE uint8_t* Release(size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
         {
             *stride = _image.stride;
@@ -84,6 +121,37 @@ namespace Simd
         }
     };
 
+    typedef ImageLoader* (*CreateImageLoaderPtr)(const ImageLoaderParam& param);
+
+    uint8_t* ImageLoadFromMemory(const CreateImageLoaderPtr create, ImageLoaderParam& param, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
+
+    uint8_t* ImageLoadPlanesFromMemory(const CreateImageLoaderPtr create, ImageLoaderParam& param, size_t* width, size_t* height, 
+        uint8_t** y, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride);
+
+    //-------------------------------------------------------------------------
+
+    class ImageDecoder : public Deletable
+    {
+    public:
+        ImageDecoder(const CreateImageLoaderPtr create, SimdPixelFormatType format);
+        virtual ~ImageDecoder();
+
+        bool Probe(const uint8_t* data, size_t size, size_t* width, size_t* height, SimdPixelFormatType* format);
+        bool Decode(const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height);
+        size_t DecodeBatch(size_t count, const uint8_t* const* data, const size_t* size, uint8_t* const* dst, 
+            const size_t* stride, const size_t* width, const size_t* height, SimdBool* status);
+
+    private:
+        typedef Simd::View<Simd::Allocator> Image;
+
+        CreateImageLoaderPtr _create;
+        SimdPixelFormatType _format;
+        ImageLoader* _loaders[SimdImageFilePfm + 1];
+        std::vector<ImageDecoder*> _workers;
+
+        ImageLoader* Loader(const uint8_t* data, size_t size);
+    };
+
     namespace Base
     {
         class ImagePxmLoader : public ImageLoader
@@ -91,14 +159,19 @@ namespace Simd
         public:
             ImagePxmLoader(const ImageLoaderParam& param);
 
+            virtual bool Probe(size_t* width, size_t* height);
+
         protected:
             typedef void (*ToAnyPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             typedef void (*ToBgraPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* bgra, size_t bgraStride, uint8_t alpha);
             ToAnyPtr _toAny;
             ToBgraPtr _toBgra;
-            Array8u _buffer;
+            ReorderPtr _reorder;
+            Array8u _buffer, _line;
             size_t _block, _size;
+            uint32_t _max;
 
+            bool ReadSize(uint32_t& width, uint32_t& height);
             bool ReadHeader(size_t version);
             virtual void SetConverters() = 0;
         };
@@ -154,6 +227,8 @@ namespace Simd
 
             virtual bool FromStream();
 
+            virtual bool Probe(size_t* width, size_t* height);
+
         protected:
             typedef void (*ToAny8Ptr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             typedef void (*ToBgra8Ptr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* bgra, size_t bgraStride, uint8_t alpha);
@@ -163,14 +238,21 @@ namespace Simd
             ToBgra8Ptr _toBgra8, _bgrToBgra;
             ToAny16Ptr _toAny16;
             ToBgra16Ptr _toBgra16;
+            ToAny8Ptr _rgbaToAny, _rgbToBgr;
+            ReorderPtr _reorder16;
+
+            typedef void (*DecodeLinePtr)(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+            DecodeLinePtr _decodeLine[5];
+
+            uint32_t _width, _height, _channels;
 
             virtual void SetConverters();
         private:
             bool _first, _hasTrans, _iPhone;
-            uint32_t _width, _height, _channels;
             uint16_t _tc16[3];
             uint8_t _depth, _color, _interlace, _paletteChannels, _tc[3];
             Array8u _palette, _idat;
+            OutputMemoryStream _zDst;
 
             struct Chunk
             {
@@ -197,10 +279,58 @@ namespace Simd
             ImageJpegLoader(const ImageLoaderParam& param);
 
             virtual bool FromStream();
+
+            virtual bool Probe(size_t* width, size_t* height);
+
+            uint8_t* ReleasePlanes(size_t* width, size_t* height, uint8_t** y, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride);
+
+        protected:
+            typedef void (*IdctBlocksPtr)(const int16_t* src, int count, uint8_t* dst, int stride);
+            typedef uint8_t* (*UpsampleRowPtr)(uint8_t* dst, uint8_t* src0, uint8_t* src1, int width, int hs);
+            typedef void (*YuvToAnyPtr)(const uint8_t* y, const uint8_t* u, const uint8_t* v, size_t width, uint8_t* dst);
+            typedef void (*ToAnyPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
+            typedef void (*ToBgraPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* bgra, size_t bgraStride, uint8_t alpha);
+            IdctBlocksPtr _idctBlocks;
+            UpsampleRowPtr _upsampleH2, _upsampleV2, _upsampleHv2;
+            YuvToAnyPtr _yuvToAny;
+            ToAnyPtr _grayToAny, _rgbToAny;
+            ToBgraPtr _grayToBgra, _rgbToBgra;
+            size_t _width, _height;
+            Array8u _context, _scratch[16];
+
+            virtual void SetConverters();
+
+            void GetPlanes(uint8_t** y, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride);
+        };
+
+        class ImagePfmLoader : public ImageLoader
+        {
+        public:
+            ImagePfmLoader(const ImageLoaderParam& param);
+
+            virtual bool FromStream();
+
+            virtual bool Probe(size_t* width, size_t* height);
+
+        protected:
+            ReorderPtr _reorder;
+            bool _bigEndian;
+
+            bool ReadHeader(uint32_t& width, uint32_t& height);
+            virtual void SetConverters();
         };
 
         //---------------------------------------------------------------------
 
+        void PngDecodeLineSub(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        void PngDecodeLineAvg(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        void PngDecodeLinePaeth(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+
+        //---------------------------------------------------------------------
+
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 
@@ -248,11 +378,39 @@ namespace Simd
         public:
             ImagePngLoader(const ImageLoaderParam& param);
 
-            virtual bool FromStream();
+        protected:
+            virtual void SetConverters();
+        };
+
+        class ImageJpegLoader : public Base::ImageJpegLoader
+        {
+        public:
+            ImageJpegLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
+        class ImagePfmLoader : public Base::ImagePfmLoader
+        {
+        public:
+            ImagePfmLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
         };
 
         //---------------------------------------------------------------------
 
+        void PngDecodeLineSub(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        void PngDecodeLineAvg(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+        void PngDecodeLinePaeth(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+
+        //---------------------------------------------------------------------
+
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_SSE41_ENABLE
@@ -296,8 +454,41 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePngLoader : public Sse41::ImagePngLoader
+        {
+        public:
+            ImagePngLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
+        class ImageJpegLoader : public Sse41::ImageJpegLoader
+        {
+        public:
+            ImageJpegLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
+        class ImagePfmLoader : public Sse41::ImagePfmLoader
+        {
+        public:
+            ImagePfmLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
         //---------------------------------------------------------------------
 
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+
+        //---------------------------------------------------------------------
+
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_AVX2_ENABLE
@@ -341,8 +532,41 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePngLoader : public Avx2::ImagePngLoader
+        {
+        public:
+            ImagePngLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
+        class ImageJpegLoader : public Avx2::ImageJpegLoader
+        {
+        public:
+            ImageJpegLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
+        class ImagePfmLoader : public Avx2::ImagePfmLoader
+        {
+        public:
+            ImagePfmLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
         //---------------------------------------------------------------------
 
+        void PngDecodeLineUp(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+
+        //---------------------------------------------------------------------
+
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_AVX512BW_ENABLE
@@ -386,8 +610,19 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePfmLoader : public Base::ImagePfmLoader
+        {
+        public:
+            ImagePfmLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverters();
+        };
+
         //---------------------------------------------------------------------
 
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_NEON_ENABLE
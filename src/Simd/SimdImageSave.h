@@ -68,8 +68,10 @@ namespace Simd
         {
             if (file == SimdImageFileUndefined)
             {
-                if (format == SimdPixelFormatGray8)
+                if (format == SimdPixelFormatGray8 || format == SimdPixelFormatInt16)
                     file = SimdImageFilePgmBin;
+                else if (format == SimdPixelFormatFloat)
+                    file = SimdImageFilePfm;
                 else
                     file = SimdImageFilePpmBin;
             } 
@@ -77,7 +79,18 @@ namespace Simd
                 return false;
             if (yuvType == SimdYuvUnknown)
             {
-                if (format < SimdPixelFormatGray8 || format > SimdPixelFormatRgba32)
+                if (file == SimdImageFilePfm)
+                {
+                    if (format != SimdPixelFormatFloat)
+                        return false;
+                }
+                else if (format == SimdPixelFormatInt16)
+                {
+                    if (file != SimdImageFilePgmBin && file != SimdImageFilePng)
+                        return false;
+                }
+                else if (format != SimdPixelFormatGray8 && format != SimdPixelFormatBgr24 && format != SimdPixelFormatBgra32 && 
+                    format != SimdPixelFormatRgb24 && format != SimdPixelFormatRgba32)
                     return false;
             }
             else
@@ -87,7 +100,7 @@ namespace Simd
                 if (width % 2 != 0 || height % 2 != 0)
                     return false;
             }
-            if (file <= SimdImageFileUndefined || file > SimdImageFileJpeg)
+            if (file <= SimdImageFileUndefined || file > SimdImageFilePfm)
                 return false;
             return true;
         }
@@ -96,6 +109,8 @@ namespace Simd
     class ImageSaver
     {
     protected:
+        typedef void (*ReorderPtr)(const uint8_t* src, size_t size, uint8_t* dst);
+
         ImageSaverParam _param;
         OutputMemoryStream _stream;
     public:
@@ -126,6 +141,7 @@ namespace Simd
         protected:
             typedef void (*ConvertPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             ConvertPtr _convert;
+            ReorderPtr _reorder;
             Array8u _buffer;
             size_t _block, _size;
 
@@ -172,18 +188,27 @@ namespace Simd
             virtual bool ToStream(const uint8_t* src, size_t stride);
         protected:
             static const int COMPRESSION = 8;
+            static const int COMPRESSION_RLE = 1;
+            static const int COMPRESSION_GREEDY = 2;
             static const int FILTERS = 5;
             static const int TYPES = 7;
+            static const size_t STRIP_MIN = 128 * 1024;
             typedef void (*ConvertPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             typedef uint32_t (*EncodePtr)(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst);
             typedef void (*CompressPtr)(uint8_t* data, int size, int quality, OutputMemoryStream& stream);
+            typedef uint32_t (*Adler32Ptr)(uint8_t* data, int size);
             ConvertPtr _convert;
+            ReorderPtr _reorder;
             EncodePtr _encode[TYPES];
             CompressPtr _compress;
-            size_t _channels, _size;
+            Adler32Ptr _adler32;
+            size_t _channels, _depth, _size, _threads;
+            int _level;
             Array8u _filt, _buff;
             Array8i _line;
 
+            void EncodeRow(const uint8_t* src, size_t stride, size_t row, int8_t* line);
+
             void WriteToStream(const uint8_t* zlib, size_t zlen);
         };
 
@@ -217,6 +242,7 @@ namespace Simd
             WriteYuv420pBlockPtr _writeYuv420pBlock;
             bool _subSample;
             int _quality, _block, _width;
+            size_t _threads;
             float _fY[64], _fUv[64];
             uint8_t _uY[64], _uUv[64];
 
@@ -226,6 +252,14 @@ namespace Simd
             void WriteHeader();
         };
 
+        class ImagePfmSaver : public ImageSaver
+        {
+        public:
+            ImagePfmSaver(const ImageSaverParam& param);
+
+            virtual bool ToStream(const uint8_t* src, size_t stride);
+        };
+
         //---------------------------------------------------------------------
 
         uint8_t* ImageSaveToMemory(const uint8_t* src, size_t stride, size_t width, size_t height, SimdPixelFormatType format, SimdImageFileType file, int quality, size_t* size);
@@ -117,6 +117,39 @@ namespace Simd
                 ZlibHuff2(bits, stream);
         }
 
+        SIMD_INLINE void ZlibMatch(int length, int distance, OutputMemoryStream& stream)
+        {
+            assert(distance <= 32767 && length <= 258);
+            int j = 0;
+            for (; length > ZlibLenC[j + 1] - 1; ++j);
+            ZlibHuff(j + 257, stream);
+            if (ZlibLenEb[j])
+                stream.WriteBits(length - ZlibLenC[j], ZlibLenEb[j]);
+            for (j = 0; distance > ZlibDistC[j + 1] - 1; ++j);
+            stream.WriteBits(ZlibBitRev(j, 5), 5);
+            if (ZlibDistEb[j])
+                stream.WriteBits(distance - ZlibDistC[j], ZlibDistEb[j]);
+        }
+
+        SIMD_INLINE uint32_t ZlibAdler32Combine(uint32_t adler1, uint32_t adler2, size_t size2)
+        {
+            const uint32_t BASE = 65521;
+            uint32_t rem = uint32_t(size2 % BASE);
+            uint32_t sum1 = adler1 & 0xFFFF;
+            uint32_t sum2 = (rem * sum1) % BASE;
+            sum1 += (adler2 & 0xFFFF) + BASE - 1;
+            sum2 += (adler1 >> 16) + (adler2 >> 16) + BASE - rem;
+            if (sum1 >= BASE)
+                sum1 -= BASE;
+            if (sum1 >= BASE)
+                sum1 -= BASE;
+            if (sum2 >= BASE * 2)
+                sum2 -= BASE * 2;
+            if (sum2 >= BASE)
+                sum2 -= BASE;
+            return sum1 | (sum2 << 16);
+        }
+
         SIMD_INLINE int ZlibCount(const uint8_t* a, const uint8_t* b, int limit)
         {
             limit = Min(limit, 258);
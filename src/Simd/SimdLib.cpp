@@ -68,13 +68,16 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 #include "Simd/SimdImageSave.h"
 #include "Simd/SimdRecursiveBilateralFilter.h"
 #include "Simd/SimdResizer.h"
+#include "Simd/SimdRuntime.h"
 #include "Simd/SimdSynetConvolution8i.h"
 #include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdSynetDeconvolution32f.h"
+#include "Simd/SimdSynetDeconvolution8i.h"
 #include "Simd/SimdSynetInnerProduct32f.h"
 #include "Simd/SimdSynetMergedConvolution32f.h"
 #include "Simd/SimdSynetMergedConvolution8i.h"
 #include "Simd/SimdSynetScale8i.h"
+#include "Simd/SimdSynetImageToTensor.h"
 
 #include "Simd/SimdBase.h"
 #include "Simd/SimdSse41.h"
@@ -178,9 +181,18 @@ SIMD_API size_t SimdAlignment()
     return Simd::ALIGNMENT;
 }
 
+SIMD_API void * SimdAddRef(void * context)
+{
+    if (context)
+        ((Deletable*)context)->AddRef();
+    return context;
+}
+
 SIMD_API void SimdRelease(void * context)
 {
-    delete (Deletable*)context;
+    Deletable * deletable = (Deletable*)context;
+    if (deletable && deletable->Release())
+        delete deletable;
 }
 
 SIMD_API size_t SimdGetThreadNumber()
@@ -193,6 +205,11 @@ SIMD_API void SimdSetThreadNumber(size_t threadNumber)
     Base::SetThreadNumber(threadNumber);
 }
 
+SIMD_API void SimdParallelFor(size_t begin, size_t end, SimdParallelTaskPtr task, void * context, size_t threadNumber, size_t blockAlign)
+{
+    Base::ParallelFor(begin, end, task, context, threadNumber, blockAlign);
+}
+
 SIMD_API SimdBool SimdGetFastMode()
 {
 #ifdef SIMD_SSE41_ENABLE
@@ -220,6 +237,29 @@ SIMD_API void SimdSetFastMode(SimdBool value)
 #endif
 }
 
+SIMD_API SimdBool SimdRuntimeDatabaseLoad(const char * path)
+{
+    return Base::RuntimeDatabaseLoad(path) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdRuntimeDatabaseSave(const char * path)
+{
+    return Base::RuntimeDatabaseSave(path) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API size_t SimdRuntimeDatabaseExport(char * data, size_t size)
+{
+    String database = Base::RuntimeDatabaseExport();
+    if (data && size > database.size())
+        memcpy(data, database.c_str(), database.size() + 1);
+    return database.size() + 1;
+}
+
+SIMD_API SimdBool SimdRuntimeDatabaseImport(const char * data)
+{
+    return data && Base::RuntimeDatabaseImport(data) ? SimdTrue : SimdFalse;
+}
+
 SIMD_API void SimdEmpty()
 {
 #ifdef SIMD_SSE41_ENABLE
@@ -3230,6 +3270,70 @@ SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t
     return ImageLoadFromFile(imageLoadFromMemory, path, stride, width, height, format);
 }
 
+SIMD_API uint8_t* SimdImageLoadFromMemoryScaled(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format, size_t scale)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    Simd::ImageLoaderParam param(data, size, *format);
+    param.scale = scale;
+    return Simd::ImageLoadFromMemory(createImageLoader, param, stride, width, height, format);
+}
+
+SIMD_API uint8_t* SimdYuv420pLoadFromJpegMemory(const uint8_t* data, size_t size, SimdYuvType yuvType, size_t* width, size_t* height,
+    size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    Simd::ImageLoaderParam param(data, size, SimdPixelFormatBgr24);
+    param.planes = 3;
+    param.yuvType = yuvType;
+    uint8_t* y;
+    return Simd::ImageLoadPlanesFromMemory(createImageLoader, param, width, height, &y, yStride, u, uStride, v, vStride);
+}
+
+SIMD_API uint8_t* SimdNv12LoadFromJpegMemory(const uint8_t* data, size_t size, SimdYuvType yuvType, size_t* width, size_t* height,
+    size_t* yStride, uint8_t** uv, size_t* uvStride)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    Simd::ImageLoaderParam param(data, size, SimdPixelFormatBgr24);
+    param.planes = 2;
+    param.yuvType = yuvType;
+    uint8_t* y, * v;
+    size_t vStride;
+    return Simd::ImageLoadPlanesFromMemory(createImageLoader, param, width, height, &y, yStride, uv, uvStride, &v, &vStride);
+}
+
+SIMD_API void* SimdImageDecoderInit(SimdPixelFormatType format)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    return new Simd::ImageDecoder(createImageLoader, format);
+}
+
+SIMD_API SimdBool SimdImageDecoderProbe(void* context, const uint8_t* data, size_t size, size_t* width, size_t* height, SimdPixelFormatType* format)
+{
+    SIMD_EMPTY();
+    return ((Simd::ImageDecoder*)context)->Probe(data, size, width, height, format) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdImageDecoderDecode(void* context, const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height)
+{
+    SIMD_EMPTY();
+    return ((Simd::ImageDecoder*)context)->Decode(data, size, dst, stride, width, height) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API size_t SimdImageDecoderDecodeBatch(void* context, size_t count, const uint8_t* const* data, const size_t* size, uint8_t* const* dst,
+    const size_t* stride, const size_t* width, const size_t* height, SimdBool* status)
+{
+    SIMD_EMPTY();
+    return ((Simd::ImageDecoder*)context)->DecodeBatch(count, data, size, dst, stride, width, height, status);
+}
+
 SIMD_API void SimdInt16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride)
 {
     SIMD_EMPTY();
@@ -4683,7 +4787,7 @@ SIMD_API void * SimdResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t ds
     typedef void*(*SimdResizerInitPtr) (size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
     const static SimdResizerInitPtr simdResizerInit = SIMD_FUNC5(ResizerInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
 
-    return simdResizerInit(srcX, srcY, dstX, dstY, channels, type, method);
+    return Base::ResizerParallelInit(srcX, srcY, dstX, dstY, channels, type, method, simdResizerInit);
 }
 
 SIMD_API void SimdResizerRun(const void * resizer, const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride)
@@ -4692,6 +4796,18 @@ SIMD_API void SimdResizerRun(const void * resizer, const uint8_t * src, size_t s
     ((Resizer*)resizer)->Run(src, srcStride, dst, dstStride);
 }
 
+SIMD_API void * SimdResizerCropBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
+{
+    SIMD_EMPTY();
+    return Base::ResizerCropBatchInit(dstX, dstY, channels, type, method);
+}
+
+SIMD_API void SimdResizerCropBatchRun(const void * resizer, const uint8_t * src, size_t srcX, size_t srcY, size_t srcStride, const float * rects, size_t count, uint8_t * dst)
+{
+    SIMD_EMPTY();
+    ((Base::ResizerCropBatch*)resizer)->Run(src, srcStride, srcX, srcY, rects, count, dst);
+}
+
 SIMD_API void SimdRgbToBgra(const uint8_t* rgb, size_t width, size_t height, size_t rgbStride, uint8_t* bgra, size_t bgraStride, uint8_t alpha)
 {
     SIMD_EMPTY();
@@ -5734,6 +5850,16 @@ SIMD_API void SimdSynetAdd8i(const uint8_t* aData, const float* aScale, const fl
 #endif
 }
 
+SIMD_API size_t SimdSynetArenaPlan(const size_t* sizes, const size_t* begins, const size_t* ends, size_t count, size_t align, size_t* offsets)
+{
+#if defined(SIMD_SYNET_ENABLE)
+    return Base::SynetArenaPlan(sizes, begins, ends, count, align, offsets);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API void SimdSynetConvert32fTo8u(const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -5807,13 +5933,18 @@ SIMD_API const char* SimdSynetConvolution32fInfo(const void* context)
 #endif
 }
 
-SIMD_API void SimdSynetConvolution32fSetParams(void * context, const float * weight, SimdBool * internal, const float * bias, const float * params)
+SIMD_API SimdBool SimdSynetConvolution32fSetParams(void * context, const float * weight, SimdBool * internal, const float * bias, const float * params)
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    ((SynetConvolution32f*)context)->SetParams(weight, internal, bias, params);
+    SynetConvolution32f* layer = (SynetConvolution32f*)context;
+    if (layer->Shared())
+        return SimdFalse;
+    layer->SetParams(weight, internal, bias, params);
+    return SimdTrue;
 #else
     assert(0);
+    return SimdFalse;
 #endif
 }
 
@@ -5829,6 +5960,52 @@ SIMD_API void SimdSynetConvolution32fForward(void * context, const float * src,
 #endif
 }
 
+SIMD_API void * SimdSynetConvolution32fBatchInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return Base::SynetConvolution32fBatchInit(batch, SimdSynetConvolution32fInit(1, conv, compatibility));
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API void SimdSynetConvolution32fBatchForward(void * context, const float * src, float * buf, float * dst, size_t batch)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    Base::SynetConvolution32fBatch * c = (Base::SynetConvolution32fBatch*)context;
+    SIMD_PERF_EXT(c);
+    c->Forward(src, buf, dst, batch);
+#else
+    assert(0);
+#endif
+}
+
+#if defined(SIMD_SYNET_ENABLE)
+static const SynetConvolutionEpilogue::Funcs & SynetConvolutionEpilogueFuncs()
+{
+    static SynetConvolutionEpilogue::Funcs funcs = { SIMD_FUNC4(ConvolutionBiasAndActivation, SIMD_AVX512BW_FUNC, SIMD_AVX_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC),
+        SimdSynetPoolingAverage, SimdSynetPoolingMax32f, SimdSynetEltwiseLayerForward };
+    return funcs;
+}
+#endif
+
+SIMD_API void * SimdSynetConvolution32fInitEpilogue(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    SimdConvolutionParameters single = *conv;
+    if (epilogue->type == SimdConvolutionEpilogueAdd)
+        single.activation = SimdConvolutionActivationIdentity;
+    return Base::SynetConvolution32fEpilogueInit(batch, conv, epilogue, SimdSynetConvolution32fInit(1, &single, compatibility), SynetConvolutionEpilogueFuncs());
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API void* SimdSynetConvolution8iInit(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -5843,6 +6020,20 @@ SIMD_API void* SimdSynetConvolution8iInit(size_t batch, const SimdConvolutionPar
 #endif
 }
 
+SIMD_API void * SimdSynetConvolution8iInitEpilogue(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    SimdConvolutionParameters single = *conv;
+    if (epilogue->type == SimdConvolutionEpilogueAdd)
+        single.activation = SimdConvolutionActivationIdentity;
+    return Base::SynetConvolution8iEpilogueInit(batch, conv, epilogue, SimdSynetConvolution8iInit(1, &single, compatibility), SynetConvolutionEpilogueFuncs());
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API size_t SimdSynetConvolution8iExternalBufferSize(const void* context)
 {
     SIMD_EMPTY();
@@ -5876,13 +6067,18 @@ SIMD_API const char* SimdSynetConvolution8iInfo(const void* context)
 #endif
 }
 
-SIMD_API void SimdSynetConvolution8iSetParams(void* context, const float* weight, const float* bias, const float* params, const float* const* stats)
+SIMD_API SimdBool SimdSynetConvolution8iSetParams(void* context, const float* weight, const float* bias, const float* params, const float* const* stats)
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    ((SynetConvolution8i*)context)->SetParams(weight, bias, params, stats);
+    SynetConvolution8i* layer = (SynetConvolution8i*)context;
+    if (layer->Shared())
+        return SimdFalse;
+    layer->SetParams(weight, bias, params, stats);
+    return SimdTrue;
 #else
     assert(0);
+    return SimdFalse;
 #endif
 }
 
@@ -5967,6 +6163,75 @@ SIMD_API void SimdSynetDeconvolution32fForward(void * context, const float * src
 #endif
 }
 
+SIMD_API void * SimdSynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void* (*SimdSynetDeconvolution8iInitPtr) (size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+    const static SimdSynetDeconvolution8iInitPtr simdSynetDeconvolution8iInit = SIMD_FUNC4(SynetDeconvolution8iInit, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+
+    return simdSynetDeconvolution8iInit(batch, conv, compatibility);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API size_t SimdSynetDeconvolution8iExternalBufferSize(const void * context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetDeconvolution8i*)context)->ExternalBufferSize();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API size_t SimdSynetDeconvolution8iInternalBufferSize(const void * context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetDeconvolution8i*)context)->InternalBufferSize();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API const char* SimdSynetDeconvolution8iInfo(const void* context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetDeconvolution8i*)context)->Info();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API void SimdSynetDeconvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const* stats)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    ((SynetDeconvolution8i*)context)->SetParams(weight, bias, params, stats);
+#else
+    assert(0);
+#endif
+}
+
+SIMD_API void SimdSynetDeconvolution8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    SynetDeconvolution8i * d = (SynetDeconvolution8i*)context;
+    SIMD_PERF_EXT(d);
+    d->Forward(src, buf, dst);
+#else
+    assert(0);
+#endif
+}
+
 SIMD_API void SimdSynetEltwiseLayerForward(float const * const * src, const float * weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float * dst)
 {
     SIMD_EMPTY();
@@ -6135,13 +6400,18 @@ SIMD_API size_t SimdSynetInnerProduct32fInternalBufferSize(const void* context)
 #endif
 }
 
-SIMD_API void SimdSynetInnerProduct32fSetParams(void* context, const float* weight, SimdBool* internal, const float* bias, const float* params)
+SIMD_API SimdBool SimdSynetInnerProduct32fSetParams(void* context, const float* weight, SimdBool* internal, const float* bias, const float* params)
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    ((SynetInnerProduct32f*)context)->SetParams(weight, internal, bias, params);
+    SynetInnerProduct32f* layer = (SynetInnerProduct32f*)context;
+    if (layer->Shared())
+        return SimdFalse;
+    layer->SetParams(weight, internal, bias, params);
+    return SimdTrue;
 #else
     assert(0);
+    return SimdFalse;
 #endif
 }
 
@@ -6243,13 +6513,18 @@ SIMD_API const char* SimdSynetMergedConvolution32fInfo(const void* context)
 #endif
 }
 
-SIMD_API void SimdSynetMergedConvolution32fSetParams(void * context, const float * const * weight, SimdBool * internal, const float * const * bias, const float * const * params)
+SIMD_API SimdBool SimdSynetMergedConvolution32fSetParams(void * context, const float * const * weight, SimdBool * internal, const float * const * bias, const float * const * params)
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    ((SynetMergedConvolution32f*)context)->SetParams(weight, internal, bias, params);
+    SynetMergedConvolution32f* layer = (SynetMergedConvolution32f*)context;
+    if (layer->Shared())
+        return SimdFalse;
+    layer->SetParams(weight, internal, bias, params);
+    return SimdTrue;
 #else
     assert(0);
+    return SimdFalse;
 #endif
 }
 
@@ -6312,13 +6587,18 @@ SIMD_API const char* SimdSynetMergedConvolution8iInfo(const void* context)
 #endif
 }
 
-SIMD_API void SimdSynetMergedConvolution8iSetParams(void* context, const float* const* weight, SimdBool* internal, const float* const* bias, const float* const* params, const float* const* stats)
+SIMD_API SimdBool SimdSynetMergedConvolution8iSetParams(void* context, const float* const* weight, SimdBool* internal, const float* const* bias, const float* const* params, const float* const* stats)
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    ((SynetMergedConvolution8i*)context)->SetParams(weight, internal, bias, params, stats);
+    SynetMergedConvolution8i* layer = (SynetMergedConvolution8i*)context;
+    if (layer->Shared())
+        return SimdFalse;
+    layer->SetParams(weight, internal, bias, params, stats);
+    return SimdTrue;
 #else
     assert(0);
+    return SimdFalse;
 #endif
 }
 
@@ -6548,6 +6828,53 @@ SIMD_API void SimdSynetSetInput(const uint8_t * src, size_t width, size_t height
 #endif
 }
 
+SIMD_API void* SimdSynetImageToTensorInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method,
+    const float* mean, const float* std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    const static Base::ResizerInitPtr resizerInit = SIMD_FUNC5(ResizerInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    Base::SynetSetInputPtr setInput;
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable && dstW >= Avx512bw::A)
+        setInput = Avx512bw::SynetSetInput;
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && dstW >= Avx2::A)
+        setInput = Avx2::SynetSetInput;
+    else
+#endif
+#ifdef SIMD_SSE41_ENABLE
+    if (Sse41::Enable && dstW >= Sse41::A)
+        setInput = Sse41::SynetSetInput;
+    else
+#endif
+#ifdef SIMD_NEON_ENABLE
+    if (Neon::Enable && dstW >= Neon::A)
+        setInput = Neon::SynetSetInput;
+    else
+#endif
+        setInput = Base::SynetSetInput;
+
+    return Base::SynetImageToTensorInit(srcW, srcH, srcFormat, yuvType, dstW, dstH, method, mean, std, channels, dstFormat, dstType, resizerInit, setInput);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API void SimdSynetImageToTensorForward(void* context, const uint8_t* const* src, const size_t* stride, uint8_t* dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    ((Base::SynetImageToTensor*)context)->Forward(src, stride, dst);
+#else
+    assert(0);
+#endif
+}
+
 SIMD_API void SimdSynetShuffleLayerForward(const float* src0, const float* src1, size_t channels0, size_t channels1, size_t spatial, float* dst0, float* dst1, SimdTensorFormatType format, int type)
 {
     SIMD_EMPTY();
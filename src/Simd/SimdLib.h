@@ -123,7 +123,7 @@ typedef enum
 
 /*! @ingroup synet
     Describes type of activation function. 
-    It is used in ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, ::SimdSynetDeconvolution32fInit, 
+    It is used in ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, ::SimdSynetDeconvolution32fInit, ::SimdSynetDeconvolution8iInit, 
     ::SimdSynetInnerProduct32fInit, ::SimdSynetMergedConvolution32fInit and ::SimdSynetMergedConvolution8iInit.
 */
 typedef enum
@@ -265,6 +265,8 @@ typedef enum
     SimdImageFilePng,
     /*! A JPEG (Joint Photographic Experts Group) image file format. */
     SimdImageFileJpeg,
+    /*! A PFM (Portable Float Map) gray (Pf) image file format. It stores images in ::SimdPixelFormatFloat pixel format. */
+    SimdImageFilePfm,
 } SimdImageFileType;
 
 /*! @ingroup c_types
@@ -409,12 +411,18 @@ typedef enum
     SimdResizeMethodArea,
     /*! Area method for previously reduced in 2 times image. */
     SimdResizeMethodAreaFast,
+    /*! Mitchell-Netravali cubic filter (B = C = 1/3). It is supported only for ::SimdResizeChannelByte. */
+    SimdResizeMethodMitchell,
+    /*! Lanczos filter with 2 lobes. It is supported only for ::SimdResizeChannelByte. */
+    SimdResizeMethodLanczos2,
+    /*! Lanczos filter with 3 lobes. It is supported only for ::SimdResizeChannelByte. */
+    SimdResizeMethodLanczos3,
 } SimdResizeMethodType;
 
 /*! @ingroup synet
     Describes Synet calculation compatibility flags. This type used in functions ::SimdSynetAdd8i, ::SimdSynetScaleLayerForward, 
     ::SimdSynetConvert32fTo8u, ::SimdSynetConvert8uTo32f, ::SimdSynetInnerProduct8i, ::SimdSynetScale8iInit,
-    ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, ::SimdSynetMergedConvolution32fInit, ::SimdSynetMergedConvolution8iInit.
+    ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, ::SimdSynetDeconvolution8iInit, ::SimdSynetMergedConvolution32fInit, ::SimdSynetMergedConvolution8iInit.
 */
 typedef enum
 {
@@ -527,9 +535,14 @@ typedef enum
     SimdYuvTrect871, /*!< Corresponds to T-REC-T.871 standard. Uses Kr=0.299, Kb=0.114. Y, U and V use full range [0..255]. */
 } SimdYuvType;
 
+/*! @ingroup thread
+    Describes a pointer to task function used in ::SimdParallelFor. The function processes the range [begin, end) in the thread with given index.
+*/
+typedef void(*SimdParallelTaskPtr)(void * context, size_t thread, size_t begin, size_t end);
+
 /*! @ingroup synet
     Describes convolution (deconvolution) parameters. It is used in ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, 
-    ::SimdSynetDeconvolution32fInit, ::SimdSynetMergedConvolution32fInit and ::SimdSynetMergedConvolution8iInit.
+    ::SimdSynetDeconvolution32fInit, ::SimdSynetDeconvolution8iInit, ::SimdSynetMergedConvolution32fInit and ::SimdSynetMergedConvolution8iInit.
 */
 typedef struct SimdConvolutionParameters
 {
@@ -623,6 +636,61 @@ typedef struct SimdConvolutionParameters
     SimdConvolutionActivationType activation;
 } SimdConvolutionParameters;
 
+/*! @ingroup synet
+    Describes type of operation fused to the output of convolution. 
+    It is used in ::SimdSynetConvolution32fInitEpilogue and ::SimdSynetConvolution8iInitEpilogue.
+*/
+typedef enum
+{
+    /*!
+        Epilogue is absent.
+    */
+    SimdConvolutionEpilogueIdentity = 0,
+    /*!
+        Element-wise addition of residual tensor (ResNet shortcut). 
+        The residual tensor is passed in output tensor and the activation function is applied after the addition:
+        \verbatim
+        dst[i] = Activation(Convolution(src)[i] + dst[i]);
+        \endverbatim
+    */
+    SimdConvolutionEpilogueAdd,
+    /*!
+        Max pooling of activated output of convolution. Output tensor has shape [dstH', dstW', dstC] where:
+        \verbatim
+        dstH' = (dstH + 2*pad - kernel)/stride + 1;
+        dstW' = (dstW + 2*pad - kernel)/stride + 1;
+        \endverbatim
+    */
+    SimdConvolutionEpiloguePoolingMax,
+    /*!
+        Average pooling (padding is excluded) of activated output of convolution. Output tensor has the same shape as for ::SimdConvolutionEpiloguePoolingMax.
+    */
+    SimdConvolutionEpiloguePoolingAverage,
+} SimdConvolutionEpilogueType;
+
+/*! @ingroup synet
+    Describes operation fused to the output of convolution. It is used in ::SimdSynetConvolution32fInitEpilogue and ::SimdSynetConvolution8iInitEpilogue.
+*/
+typedef struct SimdConvolutionEpilogue
+{
+    /*!
+        A type of fused operation.
+    */
+    SimdConvolutionEpilogueType type;
+    /*!
+        A pooling kernel size (the same for both axes). It is used only for pooling epilogues.
+    */
+    size_t kernel;
+    /*!
+        A pooling stride (the same for both axes). It is used only for pooling epilogues.
+    */
+    size_t stride;
+    /*!
+        A pooling padding (the same for all sides). It is used only for pooling epilogues.
+    */
+    size_t pad;
+} SimdConvolutionEpilogue;
+
 #if defined(WIN32) && !defined(SIMD_STATIC)
 #  ifdef SIMD_EXPORTS
 #    define SIMD_API __declspec(dllexport)
@@ -759,11 +827,30 @@ extern "C"
         \short Releases context created with using of Simd Library API.
 
         \note This function releases a context created by functions ::SimdDetectionLoadA and ::SimdDetectionInit.
+            If the context was shared with using of function ::SimdAddRef then it is deleted only after the last reference is released.
 
         \param [in] context - a context to be released.
     */    
     SIMD_API void SimdRelease(void * context);
 
+    /*! @ingroup memory
+
+        \fn void * SimdAddRef(void * context);
+
+        \short Adds a reference to context created with using of Simd Library API.
+
+        It allows to share one context (and its internal buffers, for example reordered weights of Synet layers) between several owners.
+        Each call of this function must be paired with a call of function ::SimdRelease.
+        Forward functions of contexts of ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, ::SimdSynetMergedConvolution32fInit,
+        ::SimdSynetMergedConvolution8iInit and ::SimdSynetInnerProduct32fInit can be called concurrently from different threads 
+        if each thread passes its own external temporary buffer. Set parameters of the context before sharing:
+        parameters of a shared context are immutable: the corresponding SetParams functions return ::SimdFalse and do not change the context while it has more than one reference.
+
+        \param [in] context - a context to be shared.
+        \return the same pointer to the context.
+    */
+    SIMD_API void * SimdAddRef(void * context);
+
     /*! @ingroup thread
 
         \fn size_t SimdGetThreadNumber();
@@ -784,6 +871,28 @@ extern "C"
     */
     SIMD_API void SimdSetThreadNumber(size_t threadNumber);
 
+    /*! @ingroup thread
+
+        \fn void SimdParallelFor(size_t begin, size_t end, SimdParallelTaskPtr task, void * context, size_t threadNumber, size_t blockAlign);
+
+        \short Executes a task in parallel with using of internal thread pool of Simd Library.
+
+        The range [begin, end) is divided into no more than threadNumber blocks (size of the block is aligned to blockAlign).
+        The first block is processed by the calling thread, other blocks are processed by persistent worker threads of the thread pool.
+        The thread pool is shared by all algorithms of the library. Its size is set by function ::SimdSetThreadNumber and it grows on demand
+        (up to the number of hardware threads). The function can be called from several threads simultaneously: blocks which can't get
+        an idle worker (all of them are busy with tasks of other callers) are executed in the calling thread.
+        The function returns after processing of all blocks. Nested calls (from inside of a task) are executed in the calling thread.
+
+        \param [in] begin - a begin of the range.
+        \param [in] end - an end of the range.
+        \param [in] task - a pointer to task function (see ::SimdParallelTaskPtr). Thread index passed to the task is less than threadNumber.
+        \param [in] context - a pointer to user context which is passed to the task.
+        \param [in] threadNumber - a maximal number of threads used to execute the task.
+        \param [in] blockAlign - an alignment of block size. It must be greater than 0.
+    */
+    SIMD_API void SimdParallelFor(size_t begin, size_t end, SimdParallelTaskPtr task, void * context, size_t threadNumber, size_t blockAlign);
+
     /*! @ingroup cpu_flags
 
         \fn void SimdEmpty();
@@ -812,6 +921,59 @@ extern "C"
     */
     SIMD_API void SimdSetFastMode(SimdBool value);
 
+    /*! @ingroup runtime
+
+        \fn SimdBool SimdRuntimeDatabaseLoad(const char * path);
+
+        \short Loads database of runtime tuning from file.
+
+        Some algorithms (for example ::SimdSynetConvolution32fForward) measure several implementations at the first calls and then use the fastest one.
+        The result of this selection is stored in the database, where it is keyed by CPU signature, function name, its parameters and thread number (see ::SimdSetThreadNumber).
+        If the database contains a record for the current CPU then the measurement is skipped.
+        Loaded records are merged with existing records of the database. The function must be called before the first use of the tuned algorithms.
+
+        \param [in] path - a path to database file.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdRuntimeDatabaseLoad(const char * path);
+
+    /*! @ingroup runtime
+
+        \fn SimdBool SimdRuntimeDatabaseSave(const char * path);
+
+        \short Saves database of runtime tuning to file.
+
+        \param [in] path - a path to database file.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdRuntimeDatabaseSave(const char * path);
+
+    /*! @ingroup runtime
+
+        \fn size_t SimdRuntimeDatabaseExport(char * data, size_t size);
+
+        \short Exports database of runtime tuning to text buffer.
+
+        \param [out] data - a pointer to output buffer. Can be NULL.
+        \param [in] size - a size of output buffer. The database is exported only if the buffer is large enough.
+        \return required size of the buffer (including terminating zero).
+    */
+    SIMD_API size_t SimdRuntimeDatabaseExport(char * data, size_t size);
+
+    /*! @ingroup runtime
+
+        \fn SimdBool SimdRuntimeDatabaseImport(const char * data);
+
+        \short Imports database of runtime tuning from text buffer (exported by function ::SimdRuntimeDatabaseExport).
+
+        Imported records are merged with existing records of the database.
+        If the buffer contains an invalid record the database is left unchanged.
+
+        \param [in] data - a pointer to zero terminated text buffer.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdRuntimeDatabaseImport(const char * data);
+
     /*! @ingroup hash
 
         \fn uint32_t SimdCrc32(const void * src, size_t size);
@@ -3861,8 +4023,11 @@ extern "C"
         \param [in] height - a height of input image.
         \param [in] format - a pixel format of input image. 
             Supported pixel formats: ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
+            Also ::SimdPixelFormatInt16 (unsigned 16-bit gray, PGM binary and PNG files) and ::SimdPixelFormatFloat (PFM files) are supported.
         \param [in] file - a format of output image file. To auto choise format of output file set this parameter to ::SimdImageFileUndefined.
         \param [in] quality - a parameter of compression quality (if file format supports it).
+            For PNG format it selects a compression level: quality less than 25 means RLE only (the fastest), 
+            quality in range [25, 50) means a greedy hash matcher, greater values (or 0) give a better and slower compression.
         \param [out] size - a pointer to the size of output image file in bytes.
         \return a pointer to memory buffer with output image file. 
             It has to be deleted after use by function ::SimdFree. On error it returns NULL.
@@ -3881,8 +4046,11 @@ extern "C"
         \param [in] height - a height of input image.
         \param [in] format - a pixel format of input image. 
             Supported pixel formats: ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
+            Also ::SimdPixelFormatInt16 (unsigned 16-bit gray, PGM binary and PNG files) and ::SimdPixelFormatFloat (PFM files) are supported.
         \param [in] file - a format of output image file. To auto choise format of output file set this parameter to ::SimdImageFileUndefined.
         \param [in] quality - a parameter of compression quality (if file format supports it).
+            For PNG format it selects a compression level: quality less than 25 means RLE only (the fastest), 
+            quality in range [25, 50) means a greedy hash matcher, greater values (or 0) give a better and slower compression.
         \param [in] path - a path to output image file.
         \return result of the operation.
     */
@@ -3944,6 +4112,7 @@ extern "C"
         \param [out] height - a pointer to height of output image.
         \param [in, out] format - a pointer to pixel format of output image. 
             Here you can set desired pixel format (it can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32).
+            Also ::SimdPixelFormatInt16 (unsigned 16-bit gray, PGM binary and PNG files) and ::SimdPixelFormatFloat (PFM files) are supported.
             Or set ::SimdPixelFormatNone and use pixel format of input image file.
         \return a pointer to pixels data of output image. 
             It has to be deleted after use by function ::SimdFree. On error it returns NULL.
@@ -3956,18 +4125,171 @@ extern "C"
 
         \short Loads an image from file.
 
+        \note Regular files of 1 MB or more are memory mapped and decoded directly from the mapping (without intermediate copy). 
+            Smaller files or files which can't be mapped are read into temporary buffer.
+            The mapped file must not be truncated by other process during loading: access to the lost pages raises SIGBUS on POSIX systems 
+            (or an access violation on Windows).
+
         \param [in] path - a path to input image file.
         \param [out] stride - a pointer to row size of output image in bytes.
         \param [out] width - a pointer to width of output image.
         \param [out] height - a pointer to height of output image.
         \param [in, out] format - a pointer to pixel format of output image.
             Here you can set desired pixel format (it can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32).
+            Also ::SimdPixelFormatInt16 (unsigned 16-bit gray, PGM binary and PNG files) and ::SimdPixelFormatFloat (PFM files) are supported.
             Or set ::SimdPixelFormatNone and use pixel format of input image file.
         \return a pointer to pixels data of output image.
             It has to be deleted after use by function ::SimdFree. On error it returns NULL.
     */
     SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
 
+    /*! @ingroup image_io
+
+        \fn uint8_t* SimdImageLoadFromMemoryScaled(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format, size_t scale);
+
+        \short Loads an image from memory buffer with reduced size.
+
+        JPEG images are decoded with reduced size IDCT (4x4, 2x2 or DC only), so the most part of IDCT, upsampling and color conversion work is skipped. 
+        Output image has size ((width + scale - 1) / scale, (height + scale - 1) / scale).
+        Images of other formats are loaded in original size (use output width and height to check it).
+
+        \param [in] data - a pointer to memory buffer with input image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [out] stride - a pointer to row size of output image in bytes.
+        \param [out] width - a pointer to width of output image.
+        \param [out] height - a pointer to height of output image.
+        \param [in, out] format - a pointer to pixel format of output image. 
+            Here you can set desired pixel format (it can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32).
+            Also ::SimdPixelFormatInt16 (unsigned 16-bit gray, PGM binary and PNG files) and ::SimdPixelFormatFloat (PFM files) are supported.
+            Or set ::SimdPixelFormatNone and use pixel format of input image file.
+        \param [in] scale - a downscale factor. It can be 1, 2, 4 or 8.
+        \return a pointer to pixels data of output image. 
+            It has to be deleted after use by function ::SimdFree. On error it returns NULL.
+    */
+    SIMD_API uint8_t* SimdImageLoadFromMemoryScaled(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format, size_t scale);
+
+    /*! @ingroup image_io
+
+        \fn uint8_t* SimdYuv420pLoadFromJpegMemory(const uint8_t* data, size_t size, SimdYuvType yuvType, size_t* width, size_t* height, size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride);
+
+        \short Loads JPEG image from memory buffer to YUV420P planes.
+
+        Decoded Y, Cb and Cr components are copied to output planes without conversion to RGB (chroma planes are resampled if the image has other than 4:2:0 subsampling).
+        Gray images get neutral chroma planes. RGB, CMYK and YCCK images are converted to YUV.
+        Y plane has size (width, height), U and V planes have size ((width + 1) / 2, (height + 1) / 2). All planes are placed in the single memory buffer.
+
+        \param [in] data - a pointer to memory buffer with input JPEG image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [in] yuvType - a type of output YUV image (see descriprion of ::SimdYuvType). Now only ::SimdYuvTrect871 (T-REC-T.871 format) is supported.
+        \param [out] width - a pointer to width of output image.
+        \param [out] height - a pointer to height of output image.
+        \param [out] yStride - a pointer to row size of output Y plane.
+        \param [out] u - a pointer to pointer to output U plane.
+        \param [out] uStride - a pointer to row size of output U plane.
+        \param [out] v - a pointer to pointer to output V plane.
+        \param [out] vStride - a pointer to row size of output V plane.
+        \return a pointer to output Y plane (it is also a start of memory buffer with all planes).
+            It has to be deleted after use by function ::SimdFree. On error it returns NULL.
+    */
+    SIMD_API uint8_t* SimdYuv420pLoadFromJpegMemory(const uint8_t* data, size_t size, SimdYuvType yuvType, size_t* width, size_t* height,
+        size_t* yStride, uint8_t** u, size_t* uStride, uint8_t** v, size_t* vStride);
+
+    /*! @ingroup image_io
+
+        \fn uint8_t* SimdNv12LoadFromJpegMemory(const uint8_t* data, size_t size, SimdYuvType yuvType, size_t* width, size_t* height, size_t* yStride, uint8_t** uv, size_t* uvStride);
+
+        \short Loads JPEG image from memory buffer to NV12 planes.
+
+        It works like ::SimdYuv420pLoadFromJpegMemory but stores U and V components interleaved in the single UV plane.
+        Y plane has size (width, height), UV plane has size ((width + 1) / 2, (height + 1) / 2) in 16-bit pixels. All planes are placed in the single memory buffer.
+
+        \param [in] data - a pointer to memory buffer with input JPEG image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [in] yuvType - a type of output YUV image (see descriprion of ::SimdYuvType). Now only ::SimdYuvTrect871 (T-REC-T.871 format) is supported.
+        \param [out] width - a pointer to width of output image.
+        \param [out] height - a pointer to height of output image.
+        \param [out] yStride - a pointer to row size of output Y plane.
+        \param [out] uv - a pointer to pointer to output UV plane.
+        \param [out] uvStride - a pointer to row size of output UV plane.
+        \return a pointer to output Y plane (it is also a start of memory buffer with all planes).
+            It has to be deleted after use by function ::SimdFree. On error it returns NULL.
+    */
+    SIMD_API uint8_t* SimdNv12LoadFromJpegMemory(const uint8_t* data, size_t size, SimdYuvType yuvType, size_t* width, size_t* height,
+        size_t* yStride, uint8_t** uv, size_t* uvStride);
+
+    /*! @ingroup image_io
+
+        \fn void* SimdImageDecoderInit(SimdPixelFormatType format);
+
+        \short Creates reusable image decoder.
+
+        Decoder keeps image loaders (with their Huffman tables, component planes and other scratch buffers) between calls, 
+        so decoding of image stream does not allocate memory for every image. 
+        Use function ::SimdImageDecoderProbe to get size of next image and ::SimdImageDecoderDecode to decode it into external buffer.
+
+        \param [in] format - a pixel format of output images (it can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32).
+            Or set ::SimdPixelFormatNone and use pixel format of input image file (see ::SimdImageDecoderProbe).
+        \return a pointer to image decoder context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer can be used in functions ::SimdImageDecoderProbe, ::SimdImageDecoderDecode and ::SimdImageDecoderDecodeBatch. Context is not thread safe. 
+    */
+    SIMD_API void* SimdImageDecoderInit(SimdPixelFormatType format);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageDecoderProbe(void* context, const uint8_t* data, size_t size, size_t* width, size_t* height, SimdPixelFormatType* format);
+
+        \short Reads header of image file and returns size and pixel format of output image without image decoding.
+
+        \param [in] context - a pointer to image decoder context. It must be created by function ::SimdImageDecoderInit and released by function ::SimdRelease.
+        \param [in] data - a pointer to memory buffer with input image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [out] width - a pointer to width of output image.
+        \param [out] height - a pointer to height of output image.
+        \param [out] format - a pointer to pixel format of output image.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdImageDecoderProbe(void* context, const uint8_t* data, size_t size, size_t* width, size_t* height, SimdPixelFormatType* format);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageDecoderDecode(void* context, const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height);
+
+        \short Decodes image file into external output buffer.
+
+        \param [in] context - a pointer to image decoder context. It must be created by function ::SimdImageDecoderInit and released by function ::SimdRelease.
+        \param [in] data - a pointer to memory buffer with input image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [out] dst - a pointer to pixels data of output image.
+        \param [in] stride - a row size of output image in bytes.
+        \param [in] width - a width of output image. It must be equal to width returned by ::SimdImageDecoderProbe.
+        \param [in] height - a height of output image. It must be equal to height returned by ::SimdImageDecoderProbe.
+        \return result of the operation. It returns ::SimdFalse if size of output image is not equal to size of decoded image.
+    */
+    SIMD_API SimdBool SimdImageDecoderDecode(void* context, const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height);
+
+    /*! @ingroup image_io
+
+        \fn size_t SimdImageDecoderDecodeBatch(void* context, size_t count, const uint8_t* const* data, const size_t* size, uint8_t* const* dst, const size_t* stride, const size_t* width, const size_t* height, SimdBool* status);
+
+        \short Decodes a batch of image files into external output buffers.
+
+        Images are distributed between threads of internal thread pool (see ::SimdSetThreadNumber) dynamically, one image at a time. 
+        Every thread uses its own decoder which is kept in the context and reused in next calls. 
+
+        \param [in] context - a pointer to image decoder context. It must be created by function ::SimdImageDecoderInit and released by function ::SimdRelease.
+        \param [in] count - a number of images in the batch.
+        \param [in] data - an array of pointers to memory buffers with input image files. Its size is equal to count.
+        \param [in] size - an array of sizes of input image files in bytes. Its size is equal to count.
+        \param [out] dst - an array of pointers to pixels data of output images. Its size is equal to count.
+        \param [in] stride - an array of row sizes of output images in bytes. Its size is equal to count.
+        \param [in] width - an array of widths of output images (see ::SimdImageDecoderProbe). Its size is equal to count.
+        \param [in] height - an array of heights of output images (see ::SimdImageDecoderProbe). Its size is equal to count.
+        \param [out] status - an array of results of decoding of every image. Its size is equal to count. Can be NULL.
+        \return a number of successfully decoded images.
+    */
+    SIMD_API size_t SimdImageDecoderDecodeBatch(void* context, size_t count, const uint8_t* const* data, const size_t* size, uint8_t* const* dst, 
+        const size_t* stride, const size_t* width, const size_t* height, SimdBool* status);
+
     /*! @ingroup other_conversion
 
         \fn void SimdInt16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride);
@@ -5407,6 +5729,10 @@ extern "C"
 
         \short Creates resize context.
 
+        \note Resizing supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+            The number of threads is fixed at context creation: destination image is divided into horizontal bands
+            which are processed in parallel by ::SimdResizerRun (every band has its own buffers).
+
         An using example (resize of RGBA64 image):
         \verbatim
         void * resizer = SimdResizerInit(srcX, srcY, dstX, dstY, 4, SimdResizeChannelShort, SimdResizeMethodBilinear);
@@ -5444,6 +5770,53 @@ extern "C"
     */
     SIMD_API void SimdResizerRun(const void * resizer, const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup resizing
+
+        \fn void * SimdResizerCropBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        \short Creates resize context for batched crop and resize of image regions (ROI align).
+
+        All regions are resized to the common output size. The context keeps its buffers between calls, so it can be reused
+        for different source images and different sets of regions.
+
+        \note Batched crop and resize supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+            The number of threads is fixed at context creation: regions are distributed between threads.
+
+        \param [in] dstX - a width of the output images.
+        \param [in] dstY - a height of the output images.
+        \param [in] channels - a channel number of input and output images.
+        \param [in] type - a type of input and output image channel.
+        \param [in] method - a method used in order to resize image regions. There are supported ::SimdResizeMethodNearest,
+            ::SimdResizeMethodNearestPytorch and ::SimdResizeMethodBilinear.
+        \return a pointer to resize context. On error it returns NULL.
+                This pointer is used in functions ::SimdResizerCropBatchRun.
+                It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdResizerCropBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+    /*! @ingroup resizing
+
+        \fn void SimdResizerCropBatchRun(const void * resizer, const uint8_t * src, size_t srcX, size_t srcY, size_t srcStride, const float * rects, size_t count, uint8_t * dst);
+
+        \short Crops regions of the image and resizes them to the output size.
+
+        Regions are given in coordinates of pixel edges: region (0, 0, srcX, srcY) covers whole input image
+        (for this region the result is equal to the result of ::SimdResizerRun). The coordinates can be fractional.
+        Samples outside of input image are replicated from its border.
+
+        \param [in] resizer - a resize context. It must be created by function ::SimdResizerCropBatchInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to pixels data of the input image.
+        \param [in] srcX - a width of the input image.
+        \param [in] srcY - a height of the input image.
+        \param [in] srcStride - a row size (in bytes) of the input image.
+        \param [in] rects - a pointer to the array with regions. Every region is described by 4 values: left, top, right and bottom.
+            The size of the array must be equal to 4*count.
+        \param [in] count - a number of regions.
+        \param [out] dst - a pointer to the output batch of images. Images are placed continuously one after another,
+            so its size is count*dstY*dstX*channels (in channels).
+    */
+    SIMD_API void SimdResizerCropBatchRun(const void * resizer, const uint8_t * src, size_t srcX, size_t srcY, size_t srcStride, const float * rects, size_t count, uint8_t * dst);
+
     /*! @ingroup rgb_conversion
 
         \fn void SimdRgbToBgra(const uint8_t * rgb, size_t width, size_t height, size_t rgbStride, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
@@ -6374,6 +6747,31 @@ extern "C"
     SIMD_API void SimdSynetAdd8i(const uint8_t * aData, const float * aScale, const float* aShift, const uint8_t* bData, const float* bScale, const float* bShift,
         uint8_t* cData, const float* cScale, const float* cShift, size_t batch, size_t channels, size_t spatial, SimdTensorFormatType format, SimdSynetCompatibilityType compatibility);
 
+    /*! @ingroup synet
+
+        \fn size_t SimdSynetArenaPlan(const size_t * sizes, const size_t * begins, const size_t * ends, size_t count, size_t align, size_t * offsets);
+
+        \short Plans placement of several buffers in one memory arena.
+
+        Each buffer is used during the range [begins[i], ends[i]] of steps of network execution (for example, external buffer of a layer
+        is used only at the step of its forward propagation, and its output tensor is used from this step to the step of its last consumer).
+        Buffers with intersecting lifetimes are placed into non-overlapping parts of the arena, other buffers may reuse the same memory.
+        Buffers are placed in order of decreasing size, each one into the smallest free gap which fits it (or after the last busy range).
+        After that a pointer (arena + offsets[i]) can be passed to forward functions of Synet contexts
+        (for example ::SimdSynetConvolution32fForward) as an external temporary buffer instead of NULL.
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] sizes - a pointer to array with sizes (in bytes) of buffers (for example ::SimdSynetConvolution32fExternalBufferSize * sizeof(float)).
+        \param [in] begins - a pointer to array with the first execution steps of buffers.
+        \param [in] ends - a pointer to array with the last execution steps of buffers.
+        \param [in] count - a number of buffers.
+        \param [in] align - an alignment of buffer offsets (for example ::SimdAlignment).
+        \param [out] offsets - a pointer to array with offsets of buffers in the arena.
+        \return required size (in bytes) of the arena.
+    */
+    SIMD_API size_t SimdSynetArenaPlan(const size_t * sizes, const size_t * begins, const size_t * ends, size_t count, size_t align, size_t * offsets);
+
     /*! @ingroup synet_conversion
 
         \fn void SimdSynetConvert32fTo8u(const float * src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float * shift, uint8_t * dst, SimdSynetCompatibilityType compatibility);
@@ -6466,7 +6864,7 @@ extern "C"
 
     /*! @ingroup synet_convolution_fp32
 
-        \fn void SimdSynetConvolution32fSetParams(void * context, const float * weight, SimdBool * internal, const float * bias, const float * params);
+        \fn SimdBool SimdSynetConvolution32fSetParams(void * context, const float * weight, SimdBool * internal, const float * bias, const float * params);
 
         \short Sets weights, biases and parameters of activation function required for FP32 convolution algorithm.
 
@@ -6475,8 +6873,9 @@ extern "C"
         \param [out] internal - a flag signalized that weight is stored in the internal buffer. Can be NULL.
         \param [in] bias - a pointer to bias. Can be NULL.
         \param [in] params - a pointer to parameters of activation functions (see ::SimdConvolutionActivationType). Can be NULL.
+        \return ::SimdTrue if the parameters are set or ::SimdFalse if the context is shared (see ::SimdAddRef) and its parameters are immutable.
     */
-    SIMD_API void SimdSynetConvolution32fSetParams(void * context, const float * weight, SimdBool * internal, const float * bias, const float * params);
+    SIMD_API SimdBool SimdSynetConvolution32fSetParams(void * context, const float * weight, SimdBool * internal, const float * bias, const float * params);
 
     /*! @ingroup synet_convolution_fp32
 
@@ -6491,6 +6890,57 @@ extern "C"
     */
     SIMD_API void SimdSynetConvolution32fForward(void * context, const float * src, float * buf, float * dst);
 
+    /*! @ingroup synet_convolution_fp32
+
+        \fn void * SimdSynetConvolution32fBatchInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes FP32 convolution algorithm for batched execution of independent requests.
+
+        Weights are reordered only once and are shared by all requests of the batch. Independent requests (images) of the batch are processed in parallel.
+
+        \param [in] batch - a maximal batch size.
+        \param [in] conv - a pointer to convolution parameters.
+        \param [in] compatibility - a flags of calculation compatibility.
+        \return a pointer to FP32 convolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetConvolution32fExternalBufferSize, ::SimdSynetConvolution32fInternalBufferSize,
+            ::SimdSynetConvolution32fInfo, ::SimdSynetConvolution32fSetParams, ::SimdSynetConvolution32fForward and ::SimdSynetConvolution32fBatchForward.
+    */
+    SIMD_API void * SimdSynetConvolution32fBatchInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+
+    /*! @ingroup synet_convolution_fp32
+
+        \fn void SimdSynetConvolution32fBatchForward(void * context, const float * src, float * buf, float * dst, size_t batch);
+
+        \short Performs forward propagation of FP32 convolution algorithm for given number of requests.
+
+        \param [in] context - a pointer to FP32 convolution context. It must be created by function ::SimdSynetConvolution32fBatchInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to input tensor.
+        \param [out] buf - a pointer to external temporary buffer. The size of the external temporary buffer is determined by function ::SimdSynetConvolution32fExternalBufferSize. Can be NULL (it causes usage of internal buffer).
+        \param [out] dst - a pointer to output tensor.
+        \param [in] batch - a number of requests in the batch. It must not exceed the maximal batch size passed to ::SimdSynetConvolution32fBatchInit.
+    */
+    SIMD_API void SimdSynetConvolution32fBatchForward(void * context, const float * src, float * buf, float * dst, size_t batch);
+
+    /*! @ingroup synet_convolution_fp32
+
+        \fn void * SimdSynetConvolution32fInitEpilogue(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes FP32 convolution algorithm with fused epilogue (pooling or element-wise addition).
+
+        The epilogue is applied to the rows of convolution output while they are still in cache. 
+        For ::SimdConvolutionEpilogueAdd the output tensor must contain residual tensor before call of ::SimdSynetConvolution32fForward.
+        Only ::SimdTensorFormatNhwc format is supported.
+
+        \param [in] batch - a batch size.
+        \param [in] conv - a pointer to convolution parameters.
+        \param [in] epilogue - a pointer to parameters of fused epilogue.
+        \param [in] compatibility - a flags of calculation compatibility.
+        \return a pointer to FP32 convolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetConvolution32fExternalBufferSize, ::SimdSynetConvolution32fInternalBufferSize,
+            ::SimdSynetConvolution32fInfo, ::SimdSynetConvolution32fSetParams and ::SimdSynetConvolution32fForward.
+    */
+    SIMD_API void * SimdSynetConvolution32fInitEpilogue(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, SimdSynetCompatibilityType compatibility);
+
     /*! @ingroup synet_convolution_int8
 
         \fn void * SimdSynetConvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
@@ -6541,7 +6991,7 @@ extern "C"
 
     /*! @ingroup synet_convolution_int8
 
-        \fn void SimdSynetConvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const * stats);
+        \fn SimdBool SimdSynetConvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const * stats);
 
         \short Sets weights, biases, parameters of activation function, input/output tensor statistics required for INT8 convolution algorithm.
 
@@ -6550,8 +7000,9 @@ extern "C"
         \param [in] bias - a pointer to original (32-bit float point) bias. Can be NULL.
         \param [in] params - a pointer to original (32-bit float point) parameters of activation functions (see ::SimdConvolutionActivationType). Can be NULL.
         \param [in] stats - a pointer to pointers with statistics of input(min - stats[0], max - stats[1]) and output(min - stats[2], max - stats[3]) tensors.
+        \return ::SimdTrue if the parameters are set or ::SimdFalse if the context is shared (see ::SimdAddRef) and its parameters are immutable.
     */
-    SIMD_API void SimdSynetConvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const* stats);
+    SIMD_API SimdBool SimdSynetConvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const* stats);
 
     /*! @ingroup synet_convolution_int8
 
@@ -6566,6 +7017,26 @@ extern "C"
     */
     SIMD_API void SimdSynetConvolution8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst);
 
+    /*! @ingroup synet_convolution_int8
+
+        \fn void * SimdSynetConvolution8iInitEpilogue(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes INT8 convolution algorithm with fused epilogue (pooling or element-wise addition).
+
+        The epilogue is applied to the rows of convolution output while they are still in cache. 
+        For ::SimdConvolutionEpilogueAdd the output tensor must contain residual tensor before call of ::SimdSynetConvolution8iForward.
+        Only ::SimdTensorFormatNhwc format and ::SimdTensorData32f output are supported.
+
+        \param [in] batch - a batch size.
+        \param [in] conv - a pointer to convolution parameters.
+        \param [in] epilogue - a pointer to parameters of fused epilogue.
+        \param [in] compatibility - a flags of calculation compatibility.
+        \return a pointer to INT8 convolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetConvolution8iExternalBufferSize, ::SimdSynetConvolution8iInternalBufferSize,
+            ::SimdSynetConvolution8iInfo, ::SimdSynetConvolution8iSetParams and ::SimdSynetConvolution8iForward.
+    */
+    SIMD_API void * SimdSynetConvolution8iInitEpilogue(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, SimdSynetCompatibilityType compatibility);
+
     /*! @ingroup synet_deconvolution_fp32
 
         \fn void * SimdSynetDeconvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
@@ -6641,6 +7112,84 @@ extern "C"
     */
     SIMD_API void SimdSynetDeconvolution32fForward(void * context, const float * src, float * buf, float * dst);
 
+    /*! @ingroup synet_deconvolution_int8
+
+        \fn void * SimdSynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes INT8 deconvolution algorithm.
+
+        Only ::SimdTensorFormatNhwc format is supported. Grouped and depthwise deconvolutions are supported.
+        Deconvolution weights have shape [srcC, kernelY, kernelX, dstC / group].
+
+        \param [in] batch - a batch size.
+        \param [in] conv - a pointer to deconvolution parameters.
+        \param [in] compatibility - a flags of calculation compatibility.
+        \return a pointer to INT8 deconvolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetDeconvolution8iExternalBufferSize, ::SimdSynetDeconvolution8iInternalBufferSize, 
+            ::SimdSynetDeconvolution8iInfo, ::SimdSynetDeconvolution8iSetParams and ::SimdSynetDeconvolution8iForward.
+    */
+    SIMD_API void * SimdSynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+
+    /*! @ingroup synet_deconvolution_int8
+
+        \fn size_t SimdSynetDeconvolution8iExternalBufferSize(const void * context);
+
+        \short Gets size in bytes of external temporary buffer required for INT8 deconvolution algorithm.
+
+        \param [in] context - a pointer to INT8 deconvolution context. It must be created by function ::SimdSynetDeconvolution8iInit and released by function ::SimdRelease.
+        \return size of external temporary buffer required for INT8 deconvolution algorithm.
+    */
+    SIMD_API size_t SimdSynetDeconvolution8iExternalBufferSize(const void * context);
+
+    /*! @ingroup synet_deconvolution_int8
+
+        \fn size_t SimdSynetDeconvolution8iInternalBufferSize(const void * context);
+
+        \short Gets size of internal buffer used inside INT8 deconvolution algorithm.
+
+        \param [in] context - a pointer to INT8 deconvolution context. It must be created by function ::SimdSynetDeconvolution8iInit and released by function ::SimdRelease.
+        \return size of internal buffer used inside INT8 deconvolution algorithm.
+    */
+    SIMD_API size_t SimdSynetDeconvolution8iInternalBufferSize(const void * context);
+
+    /*! @ingroup synet_deconvolution_int8
+
+        \fn const char* SimdSynetDeconvolution8iInfo(const void* context);
+
+        \short Gets description of internal implementation of INT8 deconvolution algorithm.
+
+        \param [in] context - a pointer to INT8 deconvolution context. It must be created by function ::SimdSynetDeconvolution8iInit and released by function ::SimdRelease.
+        \return string with description of internal implementation of INT8 deconvolution algorithm.
+    */
+    SIMD_API const char* SimdSynetDeconvolution8iInfo(const void* context);
+
+    /*! @ingroup synet_deconvolution_int8
+
+        \fn void SimdSynetDeconvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const * stats);
+
+        \short Sets weights, biases, parameters of activation function, input/output tensor statistics required for INT8 deconvolution algorithm.
+
+        \param [in, out] context - a pointer to INT8 deconvolution context. It must be created by function ::SimdSynetDeconvolution8iInit and released by function ::SimdRelease.
+        \param [in] weight - a pointer to original (32-bit float point) deconvolution weights.
+        \param [in] bias - a pointer to original (32-bit float point) bias. Can be NULL.
+        \param [in] params - a pointer to original (32-bit float point) parameters of activation functions (see ::SimdConvolutionActivationType). Can be NULL.
+        \param [in] stats - a pointer to pointers with statistics of input(min - stats[0], max - stats[1]) and output(min - stats[2], max - stats[3]) tensors.
+    */
+    SIMD_API void SimdSynetDeconvolution8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const* stats);
+
+    /*! @ingroup synet_deconvolution_int8
+
+        \fn void SimdSynetDeconvolution8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+        \short Performs forward propagation of INT8 deconvolution algorithm.
+
+        \param [in] context - a pointer to INT8 deconvolution context. It must be created by function ::SimdSynetDeconvolution8iInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to input tensor.
+        \param [out] buf - a pointer to external temporary buffer. The size of the external temporary buffer is determined by function ::SimdSynetDeconvolution8iExternalBufferSize. Can be NULL (it causes usage of internal buffer).
+        \param [out] dst - a pointer to output tensor.
+    */
+    SIMD_API void SimdSynetDeconvolution8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
     /*! @ingroup synet
 
         \fn void SimdSynetEltwiseLayerForward(float const * const * src, const float * weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float * dst);
@@ -7009,7 +7558,7 @@ extern "C"
 
     /*! @ingroup synet_inner_product
 
-        \fn void SimdSynetInnerProduct32fSetParams(void* context, const float* weight, SimdBool* internal, const float* bias, const float* params);
+        \fn SimdBool SimdSynetInnerProduct32fSetParams(void* context, const float* weight, SimdBool* internal, const float* bias, const float* params);
 
         \short Sets weights, beases and parameters of activation function required for FP32 inner product algorithm.
 
@@ -7018,8 +7567,9 @@ extern "C"
         \param [out] internal - a flag signalized that weight is stored in the internal buffer. Can be NULL.
         \param [in] bias - a pointer to bias. Can be NULL.
         \param [in] params - a pointer to parameters of activation functions (see ::SimdConvolutionActivationType). Can be NULL.
+        \return ::SimdTrue if the parameters are set or ::SimdFalse if the context is shared (see ::SimdAddRef) and its parameters are immutable.
     */
-    SIMD_API void SimdSynetInnerProduct32fSetParams(void* context, const float* weight, SimdBool* internal, const float* bias, const float* params);
+    SIMD_API SimdBool SimdSynetInnerProduct32fSetParams(void* context, const float* weight, SimdBool* internal, const float* bias, const float* params);
 
     /*! @ingroup synet_inner_product
 
@@ -7177,7 +7727,7 @@ extern "C"
 
     /*! @ingroup synet_merged_convolution_fp32
 
-        \fn void SimdSynetMergedConvolution32fSetParams(void * context, const float * const * weight, SimdBool * internal, const float * const * bias, const float * const * params);
+        \fn SimdBool SimdSynetMergedConvolution32fSetParams(void * context, const float * const * weight, SimdBool * internal, const float * const * bias, const float * const * params);
 
         \short Sets weights, beases and parameters of activation function required for FP32 merged convolution algorithm.
 
@@ -7186,8 +7736,9 @@ extern "C"
         \param [out] internal - a ponter to the array of flags signalized that weights are stored in the internal buffer. The array size is determined by number of merged convolutions. Can be NULL.
         \param [in] bias - a pointer to the array with pointers to bias. The array size is determined by number of merged convolutions. Can be NULL.
         \param [in] params - a pointer to the array with pointers to parameters of the activation functions (see ::SimdConvolutionActivationType). The array size is determined by number of merged convolutions. Can be NULL.
+        \return ::SimdTrue if the parameters are set or ::SimdFalse if the context is shared (see ::SimdAddRef) and its parameters are immutable.
     */
-    SIMD_API void SimdSynetMergedConvolution32fSetParams(void * context, const float * const * weight, SimdBool * internal, const float * const * bias, const float * const * params);
+    SIMD_API SimdBool SimdSynetMergedConvolution32fSetParams(void * context, const float * const * weight, SimdBool * internal, const float * const * bias, const float * const * params);
 
     /*! @ingroup synet_merged_convolution_fp32
 
@@ -7253,7 +7804,7 @@ extern "C"
 
     /*! @ingroup synet_merged_convolution_int8
 
-        \fn void SimdSynetMergedConvolution8iSetParams(void* context, const float* const* weight, SimdBool* internal, const float* const* bias, const float* const* params, const float* const* stats);
+        \fn SimdBool SimdSynetMergedConvolution8iSetParams(void* context, const float* const* weight, SimdBool* internal, const float* const* bias, const float* const* params, const float* const* stats);
 
         \short Sets weights, beases and parameters of activation function required for INT8 merged convolution algorithm.
 
@@ -7263,8 +7814,9 @@ extern "C"
         \param [in] bias - a pointer to the array with pointers to bias. The array size is determined by number of merged convolutions. Can be NULL.
         \param [in] params - a pointer to the array with pointers to parameters of the activation functions (see ::SimdConvolutionActivationType). The array size is determined by number of merged convolutions. Can be NULL.
         \param [in] stats - a pointer to pointers with statistics of input(min - stats[0], max - stats[1]), interim(min - stats[2], max - stats[3]) and output(min - stats[4], max - stats[5]) tensors.
+        \return ::SimdTrue if the parameters are set or ::SimdFalse if the context is shared (see ::SimdAddRef) and its parameters are immutable.
     */
-    SIMD_API void SimdSynetMergedConvolution8iSetParams(void* context, const float* const* weight, SimdBool* internal, const float* const* bias, const float* const* params, const float* const* stats);
+    SIMD_API SimdBool SimdSynetMergedConvolution8iSetParams(void* context, const float* const* weight, SimdBool* internal, const float* const* bias, const float* const* params, const float* const* stats);
 
     /*! @ingroup synet_merged_convolution_int8
 
@@ -7606,6 +8158,63 @@ extern "C"
     SIMD_API void SimdSynetSetInput(const uint8_t * src, size_t width, size_t height, size_t stride, SimdPixelFormatType srcFormat, 
         const float * lower, const float * upper, float * dst, size_t channels, SimdTensorFormatType dstFormat);
 
+    /*! @ingroup synet_conversion
+
+        \fn void * SimdSynetImageToTensorInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method, const float * mean, const float * std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType);
+
+        \short Creates context of image to tensor conversion (it converts image to the input of neural network of <a href="http://github.com/ermig1979/Synet">Synet Framework</a>).
+
+        The conversion fuses image resizing, color conversion and normalization in one pass over bands of output rows.
+        Algorithm's details (example for NCHW output tensor with 32-bit float data type):
+        \verbatim
+        pixels = ColorConvert(Resize(src, dstW, dstH, method)); // to BGR or gray
+        for(c = 0; c < channels; ++c)
+            for(y = 0; y < dstH; ++y)
+                for(x = 0; x < dstW; ++x)
+                    dst[(c*dstH + y)*dstW + x] = (pixels[y][x][c]/255 - mean[c]) / std[c];
+        \endverbatim
+
+        \note Image to tensor conversion supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+            The number of threads is fixed at context creation.
+
+        \param [in] srcW - a width of input image.
+        \param [in] srcH - a height of input image.
+        \param [in] srcFormat - a pixel format of input image. If yuvType is ::SimdYuvUnknown there are supported following packed pixel formats:
+            ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
+            Otherwise it describes format of chroma planes: ::SimdPixelFormatGray8 for YUV420P image (separate U and V planes)
+            and ::SimdPixelFormatUv16 for NV12 image (interleaved UV plane).
+        \param [in] yuvType - a type of input YUV image (see descriprion of ::SimdYuvType). It is ::SimdYuvUnknown for packed (not YUV) input images.
+            The width and the height of YUV image must be even.
+        \param [in] dstW - a width of output image tensor.
+        \param [in] dstH - a height of output image tensor.
+        \param [in] method - a method used in order to resize image.
+        \param [in] mean - a pointer to the array with mean values of channels of output tensor (in B, G, R order for 3 channels). Can be NULL (all mean values are equal to 0).
+        \param [in] std - a pointer to the array with standard deviations of channels of output tensor (in B, G, R order for 3 channels). Can be NULL (all standard deviations are equal to 1).
+        \param [in] channels - a number of channels in the output image tensor. It can be 1 (gray) or 3 (BGR).
+        \param [in] dstFormat - a format of output image tensor. There are supported following tensor formats: ::SimdTensorFormatNchw, ::SimdTensorFormatNhwc,
+            ::SimdTensorFormatNchw4c, ::SimdTensorFormatNchw8c, ::SimdTensorFormatNchw16c, ::SimdTensorFormatNchwXc. Additional channels of 5D-tensor formats are filled by zeros.
+        \param [in] dstType - a data type of output image tensor. It can be ::SimdTensorData32f or ::SimdTensorData8u.
+            Normalization (mean and std) is not applied to ::SimdTensorData8u output: it contains resized pixel values which are quantized by INT8 layers of neural network.
+        \return a pointer to image to tensor conversion context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in function ::SimdSynetImageToTensorForward.
+    */
+    SIMD_API void * SimdSynetImageToTensorInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method,
+        const float * mean, const float * std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType);
+
+    /*! @ingroup synet_conversion
+
+        \fn void SimdSynetImageToTensorForward(void * context, const uint8_t * const * src, const size_t * stride, uint8_t * dst);
+
+        \short Converts image to the input tensor of neural network.
+
+        \param [in, out] context - a pointer to image to tensor conversion context. It must be created by function ::SimdSynetImageToTensorInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to the array with pointers to planes of input image: 1 plane for packed formats,
+            2 planes (Y and UV) for NV12 image and 3 planes (Y, U and V) for YUV420P image.
+        \param [in] stride - a pointer to the array with row sizes (in bytes) of planes of input image.
+        \param [out] dst - a pointer to the output image tensor (32-bit float or 8-bit unsigned integer data).
+    */
+    SIMD_API void SimdSynetImageToTensorForward(void * context, const uint8_t * const * src, const size_t * stride, uint8_t * dst);
+
     /*! @ingroup synet
 
         \fn void SimdSynetShuffleLayerForward(const float * src0, const float * src1, size_t channels0, size_t channels1, size_t spatial, float * dst0, float * dst1, SimdTensorFormatType format, int type);
@@ -32,6 +32,7 @@
 #include <iostream>
 #endif
 #include <memory>
+#include <atomic>
 
 namespace Simd
 {
@@ -177,7 +178,28 @@ namespace Simd
 
     struct Deletable
     {
+        Deletable() : _references(1) {}
+        Deletable(const Deletable &) : _references(1) {}
+        Deletable & operator = (const Deletable &) { return *this; }
         virtual ~Deletable() {}
+
+        SIMD_INLINE void AddRef()
+        {
+            _references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        SIMD_INLINE bool Release()
+        {
+            return _references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        SIMD_INLINE bool Shared() const
+        {
+            return _references.load(std::memory_order_acquire) > 1;
+        }
+
+    private:
+        std::atomic<size_t> _references;
     };
 
     //---------------------------------------------------------------------------------------------
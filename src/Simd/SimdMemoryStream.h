@@ -262,6 +262,15 @@ namespace Simd
         SIMD_INLINE void FillBits()
         {
             static const size_t canReadByte = (sizeof(_bitBuffer) - 1) * 8;
+#if (defined(SIMD_X64_ENABLE) || defined(SIMD_ARM64_ENABLE)) && !defined(SIMD_BIG_ENDIAN)
+            if (_pos + 8 <= _size)
+            {
+                _bitBuffer |= *(uint64_t*)(_data + _pos) << _bitCount;
+                _pos += (63 - _bitCount) >> 3;
+                _bitCount |= 56;
+                return;
+            }
+#endif
             while (_bitCount <= canReadByte && _pos < _size)
             {
                 _bitBuffer |= (size_t)_data[_pos++] << _bitCount;
@@ -353,6 +362,14 @@ namespace Simd
             Reserve(_pos);
         }
 
+        SIMD_INLINE void Clear()
+        {
+            _pos = 0;
+            _size = 0;
+            _bitBuffer = 0;
+            _bitCount = 0;
+        }
+
         SIMD_INLINE size_t Pos() const
         {
             return _pos;
@@ -70,6 +70,7 @@ namespace Simd
                 case SimdPixelFormatBgra32: _toBgra = Neon::GrayToBgra; break;
                 case SimdPixelFormatRgb24: _toAny = Neon::GrayToBgr; break;
                 case SimdPixelFormatRgba32: _toBgra = Neon::GrayToBgra; break;
+                case SimdPixelFormatInt16: _reorder = Neon::Reorder16bit; break;
                 }
             }
         }
@@ -120,6 +121,20 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImagePfmLoader::ImagePfmLoader(const ImageLoaderParam& param)
+            : Base::ImagePfmLoader(param)
+        {
+        }
+
+        void ImagePfmLoader::SetConverters()
+        {
+            Base::ImagePfmLoader::SetConverters();
+            if (_image.width >= A)
+                _reorder = Neon::Reorder32bit;
+        }
+
+        //---------------------------------------------------------------------
+
         ImageLoader* CreateImageLoader(const ImageLoaderParam& param)
         {
             switch (param.file)
@@ -130,6 +145,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinLoader(param);
             case SimdImageFilePng: return new Base::ImagePngLoader(param);
             case SimdImageFileJpeg: return new Base::ImageJpegLoader(param);
+            case SimdImageFilePfm: return new ImagePfmLoader(param);
             default:
                 return NULL;
             }
@@ -60,6 +60,7 @@ namespace Simd
                 case SimdPixelFormatBgra32: _convert = Neon::BgraToGray; break;
                 case SimdPixelFormatRgb24: _convert = Neon::RgbToGray; break;
                 case SimdPixelFormatRgba32: _convert = Neon::RgbaToGray; break;
+                case SimdPixelFormatInt16: _reorder = Neon::Reorder16bit; break;
                 }
             }
         }
@@ -110,6 +111,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinSaver(param);
             case SimdImageFilePng: return new ImagePngSaver(param);
             case SimdImageFileJpeg: return new ImageJpegSaver(param);
+            case SimdImageFilePfm: return new Base::ImagePfmSaver(param);
             default:
                 return NULL;
             }
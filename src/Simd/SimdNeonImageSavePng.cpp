@@ -80,9 +80,7 @@ namespace Simd
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(0, 1);
             stream.WriteBits(1, 2);
 
             int i = 0, j;
@@ -152,8 +150,6 @@ namespace Simd
             for (; i < size; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
-            stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -395,6 +391,8 @@ namespace Simd
                 _convert = Neon::BgrToRgb;
             else if (_param.format == SimdPixelFormatBgra32)
                 _convert = Neon::BgraToRgba;
+            else if (_param.format == SimdPixelFormatInt16 && _size >= A)
+                _reorder = Neon::Reorder16bit;
             _encode[0] = Neon::EncodeLine0;
             _encode[1] = Neon::EncodeLine1;
             _encode[2] = Neon::EncodeLine2;
@@ -402,7 +400,9 @@ namespace Simd
             _encode[4] = Neon::EncodeLine4;
             _encode[5] = Neon::EncodeLine5;
             _encode[6] = Neon::EncodeLine6;
-            _compress = Neon::ZlibCompress;
+            if (_level > COMPRESSION_GREEDY)
+                _compress = Neon::ZlibCompress;
+            _adler32 = Neon::ZlibAdler32;
         }
     }
 #endif// SIMD_NEON_ENABLE
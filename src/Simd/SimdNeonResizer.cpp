@@ -213,7 +213,8 @@ namespace Simd
             const int32_t * ix = _ix.data;
             size_t dstW = _param.dstW;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = vdupq_n_u16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = vdupq_n_u16(int16_t(_ay[yDst]));
@@ -293,7 +294,8 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const Idx * ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = vdupq_n_u16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = vdupq_n_u16(int16_t(_ay[yDst]));
@@ -449,7 +451,9 @@ namespace Simd
             size_t dstW = _param.dstW, rowSize = _param.srcW*N, rowRest = dstStride - dstW * N;
             const int32_t * iy = _iy.data, *ix = _ix.data, *ay = _ay.data, *ax = _ax.data;
             int32_t ay0 = ay[0], ax0 = ax[0];
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += rowRest)
+            src += iy[_yBeg] * srcStride;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += rowRest)
             {
                 int32_t * buf = _by.data;
                 size_t yn = iy[dy + 1] - iy[dy];
@@ -525,7 +529,8 @@ namespace Simd
             size_t rs4 = AlignLo(rs, 4);
             size_t rs8 = AlignLo(rs, 8);
             float32x4_t _1 = vdupq_n_f32(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -624,7 +629,8 @@ namespace Simd
             size_t rs4 = AlignLo(rs, 4);
             size_t rs8 = AlignLo(rs, 8);
             float32x4_t _1 = vdupq_n_f32(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -764,7 +770,8 @@ namespace Simd
             float * pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
             size_t rsa = AlignLo(rs, F);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -637,20 +637,24 @@ namespace Simd
 
         void SynetConvolution32fDepthwiseDotProduct::Forward(const float * src, float * buf, float * dst)
         {
+            bool prelu = _param.activation == ::SimdConvolutionActivationPrelu;
             for (size_t b = 0; b < _batch; ++b)
             {
-                if (_bias)
+                Simd::Parallel(0, _count, [&](size_t thread, size_t begin, size_t end)
                 {
-                    for (size_t i = 0; i < _count; ++i)
-                        dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size) + _bias[i];
-                }
-                else
-                {
-                    for (size_t i = 0; i < _count; ++i)
-                        dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size);
-                }
-                if (_param.activation)
-                    ConvolutionBiasAndActivation(NULL, _count, 1, _param.activation, _params, ::SimdFalse, dst);
+                    if (_bias)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size) + _bias[i];
+                    }
+                    else
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            dst[i] = DotProduct(src + i * _size, _weight + i * _size, _size);
+                    }
+                    if (_param.activation)
+                        ConvolutionBiasAndActivation(NULL, end - begin, 1, _param.activation, prelu ? _params + begin : _params, ::SimdFalse, dst + begin);
+                }, ThreadNumber(_count));
                 src += _sizeS;
                 dst += _sizeD;
             }
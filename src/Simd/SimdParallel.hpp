@@ -24,41 +24,27 @@
 #ifndef __SimdParallel_hpp__
 #define __SimdParallel_hpp__
 
+#include "Simd/SimdLib.h"
+
 #include <vector>
 #include <thread>
-#ifndef SIMD_FUTURE_DISABLE
-#include <future>
-#endif
 
 namespace Simd
 {
+    template<class Function> void ParallelTask(void * context, size_t thread, size_t begin, size_t end)
+    {
+        (*(const Function*)context)(thread, begin, end);
+    }
+
     template<class Function> inline void Parallel(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign = 1)
     {
 #ifdef SIMD_FUTURE_DISABLE
         function(0, begin, end);
 #else
-        threadNumber = std::min<size_t>(threadNumber, std::thread::hardware_concurrency());
         if (threadNumber <= 1 || size_t(blockAlign*1.5) >= (end - begin))
             function(0, begin, end);
         else
-        {
-            std::vector<std::future<void>> futures;
-
-            size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
-            blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
-            size_t blockBegin = begin;
-            size_t blockEnd = blockBegin + blockSize;
-
-            for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
-            {
-                futures.push_back(std::move(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); })));
-                blockBegin += blockSize;
-                blockEnd = std::min(blockBegin + blockSize, end);
-            }
-
-            for (size_t i = 0; i < futures.size(); ++i)
-                futures[i].wait();
-        }
+            ::SimdParallelFor(begin, end, ParallelTask<Function>, (void*)&function, threadNumber, blockAlign);
 #endif
     }
 }
@@ -27,8 +27,12 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdMath.h"
 
+#include <vector>
+
 #define SIMD_RESIZER_BICUBIC_BITS 7 // 7, 11
 
+#define SIMD_RESIZER_BAND_MIN_SIZE 0x10000 // minimal size (in destination channels) of the band processed by one thread
+
 namespace Simd
 {
     struct ResParam
@@ -57,7 +61,7 @@ namespace Simd
         bool IsByteBilinear() const
         {
             return type == SimdResizeChannelByte && (method == SimdResizeMethodBilinear || 
-                (method == SimdResizeMethodBicubic && (srcW == 2 || srcH == 2)));
+                (IsFilter() && (srcW == 2 || srcH == 2)));
         }
 
         bool IsShortBilinear() const
@@ -71,9 +75,20 @@ namespace Simd
                 (method == SimdResizeMethodBilinear || method == SimdResizeMethodBilinearCaffe || method == SimdResizeMethodBilinearPytorch);
         }
 
+        bool IsFilter() const
+        {
+            return method == SimdResizeMethodBicubic || method == SimdResizeMethodMitchell || 
+                method == SimdResizeMethodLanczos2 || method == SimdResizeMethodLanczos3;
+        }
+
         bool IsByteBicubic() const
         {
-            return type == SimdResizeChannelByte && method == SimdResizeMethodBicubic;
+            return type == SimdResizeChannelByte && IsFilter() && method != SimdResizeMethodLanczos3;
+        }
+
+        bool IsByteLanczos3() const
+        {
+            return type == SimdResizeChannelByte && method == SimdResizeMethodLanczos3;
         }
 
         bool IsByteArea1x1() const
@@ -88,6 +103,26 @@ namespace Simd
                 DivHi(srcW, 2) >= dstW && DivHi(srcH, 2) >= dstH;
         }
 
+        bool IsShortBicubic() const
+        {
+            return type == SimdResizeChannelShort && method == SimdResizeMethodBicubic;
+        }
+
+        bool IsFloatBicubic() const
+        {
+            return type == SimdResizeChannelFloat && method == SimdResizeMethodBicubic;
+        }
+
+        bool IsShortArea() const
+        {
+            return type == SimdResizeChannelShort && (method == SimdResizeMethodArea || method == SimdResizeMethodAreaFast);
+        }
+
+        bool IsFloatArea() const
+        {
+            return type == SimdResizeChannelFloat && (method == SimdResizeMethodArea || method == SimdResizeMethodAreaFast);
+        }
+
         size_t ChannelSize() const
         {
             static const size_t sizes[3] = { 1, 2, 4 };
@@ -107,13 +142,22 @@ namespace Simd
     public:
         Resizer(const ResParam & param)
             : _param(param)
+            , _yBeg(0)
+            , _yEnd(param.dstH)
         {
         }
 
         virtual void Run(const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride) = 0;
 
+        void SetBand(size_t yBeg, size_t yEnd)
+        {
+            _yBeg = yBeg;
+            _yEnd = yEnd;
+        }
+
     protected:
         ResParam _param;
+        size_t _yBeg, _yEnd;
     };
 
     //---------------------------------------------------------------------------------------------
@@ -196,6 +240,8 @@ namespace Simd
         const int32_t BICUBIC_SHIFT = SIMD_RESIZER_BICUBIC_BITS * 2;
         const int32_t BICUBIC_ROUND = 1 << (BICUBIC_SHIFT - 1);
 
+        void EstimateFilterAlpha(SimdResizeMethodType method, float d, size_t taps, int32_t* alpha);
+
         class ResizerByteBicubic : public Resizer
         {
         protected:
@@ -216,6 +262,25 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerByteLanczos3 : public Resizer
+        {
+        protected:
+            Array32i _ix, _iy, _ax, _ay, _bx[8];
+            size_t _xn, _xt;
+
+            void EstimateIndexAlpha(size_t sizeS, size_t sizeD, size_t N, Array32i& index, Array32i& alpha);
+
+            void Init();
+
+            template<int N> void RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        public:
+            ResizerByteLanczos3(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         const int32_t AREA_SHIFT = 22;
         const int32_t AREA_RANGE = 1 << 11;
         const int32_t AREA_ROUND = 1 << 21;
@@ -256,7 +321,95 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerFloatFilter : public Resizer
+        {
+        protected:
+            size_t _kx, _ky, _sx;
+            Array32i _ix, _iy;
+            Array32f _ax, _ay, _bx, _by;
+
+            void EstimateIndexAlpha(size_t sizeS, size_t sizeD, size_t N, size_t taps, size_t stride, Array32i& index, Array32f& alpha);
+
+            template<class T> void RunB(const T* src, size_t srcStride, T* dst, size_t dstStride);
+        public:
+            ResizerFloatFilter(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
+        class ResizerParallel : public Resizer
+        {
+        public:
+            ResizerParallel(const ResParam& param, const std::vector<Resizer*> & bands);
+            virtual ~ResizerParallel();
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+
+        protected:
+            std::vector<Resizer*> _bands;
+        };
+
+        //---------------------------------------------------------------------------------------------
+
+        class ResizerCropBatch : Deletable
+        {
+        public:
+            ResizerCropBatch(const ResParam& param);
+
+            void Run(const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rects, size_t count, uint8_t* dst);
+
+        protected:
+            virtual void Crop(size_t thread, const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, uint8_t* dst) = 0;
+
+            ResParam _param;
+            size_t _threads;
+        };
+
+        //---------------------------------------------------------------------------------------------
+
+        class ResizerNearestCropBatch : public ResizerCropBatch
+        {
+        protected:
+            size_t _pixelSize;
+            Array32i _ix, _iy;
+
+            void EstimateIndex(float beg, float end, size_t srcSize, size_t dstSize, size_t step, int32_t* indices);
+
+            template<size_t N> void Crop(const uint8_t* src, size_t srcStride, const int32_t* ix, const int32_t* iy, uint8_t* dst);
+
+            virtual void Crop(size_t thread, const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, uint8_t* dst);
+        public:
+            ResizerNearestCropBatch(const ResParam& param);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
+        class ResizerBilinearCropBatch : public ResizerCropBatch
+        {
+        protected:
+            size_t _threadSize;
+            Array8u _buffer;
+
+            template<class A> void EstimateIndexAlpha(float beg, float end, size_t srcSize, size_t dstSize, size_t channels, int32_t* index0, int32_t* index1, A* alphas);
+
+            template<class T, class A> void Crop(size_t thread, const T* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, T* dst);
+
+            virtual void Crop(size_t thread, const uint8_t* src, size_t srcStride, size_t srcW, size_t srcH, const float* rect, uint8_t* dst);
+        public:
+            ResizerBilinearCropBatch(const ResParam& param);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        typedef void* (*ResizerInitPtr)(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        void * ResizerParallelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method, ResizerInitPtr init);
+
+        void * ResizerCropBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -344,6 +497,24 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerByteLanczos3 : public Base::ResizerByteLanczos3
+        {
+        protected:
+            Array16i _ax;
+
+            void Init();
+
+            void RowSumX(const uint8_t* src, int32_t* dst);
+
+            void RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        public:
+            ResizerByteLanczos3(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         class ResizerByteArea1x1 : public Base::ResizerByteArea1x1
         {
         protected:
@@ -368,6 +539,20 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerFloatFilter : public Base::ResizerFloatFilter
+        {
+        protected:
+            void RowX(float* dst);
+
+            template<class T> void RunB(const T* src, size_t srcStride, T* dst, size_t dstStride);
+        public:
+            ResizerFloatFilter(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
     }
 #endif //SIMD_SSE41_ENABLE
@@ -459,6 +644,18 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerByteLanczos3 : public Sse41::ResizerByteLanczos3
+        {
+        protected:
+            void RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        public:
+            ResizerByteLanczos3(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         class ResizerByteArea1x1 : public Sse41::ResizerByteArea1x1
         {
         protected:
@@ -483,6 +680,18 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerFloatFilter : public Sse41::ResizerFloatFilter
+        {
+        protected:
+            template<class T> void RunB(const T* src, size_t srcStride, T* dst, size_t dstStride);
+        public:
+            ResizerFloatFilter(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
     }
 #endif //SIMD_AVX2_ENABLE 
@@ -559,6 +768,18 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerByteLanczos3 : public Avx2::ResizerByteLanczos3
+        {
+        protected:
+            void RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        public:
+            ResizerByteLanczos3(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         class ResizerByteArea1x1 : public Avx2::ResizerByteArea1x1
         {
         protected:
@@ -583,6 +804,18 @@ namespace Simd
 
         //---------------------------------------------------------------------------------------------
 
+        class ResizerFloatFilter : public Avx2::ResizerFloatFilter
+        {
+        protected:
+            template<class T> void RunB(const T* src, size_t srcStride, T* dst, size_t dstStride);
+        public:
+            ResizerFloatFilter(const ResParam& param);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //---------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
     }
 #endif //SIMD_AVX512BW_ENABLE 
@@ -56,6 +56,20 @@ namespace Simd
                 dst[c] = CubicSumX<N, F, L>(src + c, ax);
         }
 
+        template<int N, class A> SIMD_INLINE void PixelLanczos3SumX(const uint8_t* src, int32_t ix, int32_t last, const A* ax, int32_t* dst)
+        {
+            int32_t offs[6];
+            for (int k = 0; k < 6; ++k)
+                offs[k] = RestrictRange(ix + (k - 2) * N, 0, last);
+            for (int c = 0; c < N; ++c)
+            {
+                int32_t sum = 0;
+                for (int k = 0; k < 6; ++k)
+                    sum += ax[k] * src[offs[k] + c];
+                dst[c] = sum;
+            }
+        }
+
         //---------------------------------------------------------------------------------------------
 
         template<size_t N> SIMD_INLINE void ResizerByteAreaSet(const int32_t* src, int32_t value, int32_t* dst)
@@ -31,8 +31,10 @@
 #include <limits>
 #include <algorithm>
 #include <string>
-#ifdef SIMD_RUNTIME_STATISTIC
+#include <atomic>
+#include <mutex>
 #include <sstream>
+#ifdef SIMD_RUNTIME_STATISTIC
 #include <iostream>
 #include <iomanip>
 #endif
@@ -41,6 +43,23 @@ namespace Simd
 {
     typedef ::std::string String;
 
+    namespace Base
+    {
+        bool RuntimeDatabaseFind(const String & key, String & name);
+
+        void RuntimeDatabaseUpdate(const String & key, const String & name);
+
+        bool RuntimeDatabaseEmpty();
+
+        String RuntimeDatabaseExport();
+
+        bool RuntimeDatabaseImport(const String & data);
+
+        bool RuntimeDatabaseSave(const char * path);
+
+        bool RuntimeDatabaseLoad(const char * path);
+    }
+
     template <class Func, class Args> struct Runtime
     {
         SIMD_INLINE Runtime()
@@ -70,6 +89,7 @@ namespace Simd
         {
             _candidates.clear();
             _candidates.push_back(Candidate(func));
+            _key.clear();
             _best = &_candidates[0].func;
         }
 
@@ -77,6 +97,7 @@ namespace Simd
         {
             assert(funcs.size() >= 1);
             _candidates.clear();
+            _key.clear();
             for (size_t i = 0; i < funcs.size(); ++i)
                 _candidates.push_back(Candidate(funcs[i]));
             _best = funcs.size() == 1 ? &_candidates[0].func : NULL;
@@ -84,8 +105,9 @@ namespace Simd
 
         SIMD_INLINE void Run(const Args & args)
         {
-            if (_best)
-                _best->Run(args);
+            Func * best = _best.load(std::memory_order_acquire);
+            if (best)
+                best->Run(args);
             else
                 Test(args);
         }
@@ -100,6 +122,12 @@ namespace Simd
             return _candidates[index].func;
         }
 
+        SIMD_INLINE const Func & Selected() const
+        {
+            Func * best = _best.load(std::memory_order_acquire);
+            return best ? *best : _candidates[0].func;
+        }
+
     private:
         static const size_t TEST_COUNT = 3 + 2;
 
@@ -138,12 +166,44 @@ namespace Simd
         };
         typedef std::vector<Candidate> Candidates;
 
-        Func * _best;
+        std::atomic<Func*> _best;
+        std::mutex _mutex;
         Candidates _candidates;
-        String _info;
+        String _info, _key;
+
+        SIMD_INLINE Func * Load(const Args & args)
+        {
+            std::stringstream key;
+            key << _candidates[0].func.Info(args) << " threads=" << Base::GetThreadNumber();
+            for (size_t i = 0; i < _candidates.size(); ++i)
+                key << (i ? "," : " : ") << _candidates[i].func.Name();
+            _key = key.str();
+            String name;
+            if (!Base::RuntimeDatabaseEmpty() && Base::RuntimeDatabaseFind(_key, name))
+            {
+                for (size_t i = 0; i < _candidates.size(); ++i)
+                {
+                    if (_candidates[i].func.Name() == name)
+                    {
+                        _best.store(&_candidates[i].func, std::memory_order_release);
+                        return &_candidates[i].func;
+                    }
+                }
+            }
+            return NULL;
+        }
 
         SIMD_INLINE void Test(const Args & args)
         {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Func * best = _best.load(std::memory_order_relaxed);
+            if (best == NULL && _key.empty())
+                best = Load(args);
+            if (best)
+            {
+                best->Run(args);
+                return;
+            }
             assert(_candidates.size());
             Candidate * current = Current();
             if (current)
@@ -158,8 +218,10 @@ namespace Simd
             }
             else
             {
-                _best = &Best()->func;
-                _best->Run(args);
+                best = &Best()->func;
+                Base::RuntimeDatabaseUpdate(_key, best->Name());
+                _best.store(best, std::memory_order_release);
+                best->Run(args);
             }
         }
 
@@ -222,14 +284,12 @@ namespace Simd
             _func(args.M, args.N, args.K, args.alpha, args.A, args.lda, args.B, args.ldb, args.beta, args.C, args.ldc);
         }
 
-#ifdef SIMD_RUNTIME_STATISTIC
         SIMD_INLINE String Info(const GemmArgs & args) const
         {
             std::stringstream ss;
             ss << "Gemm [" << args.M << ", " << args.N << ", " << args.K << "]";
             return ss.str();
         }
-#endif
 
     private:
         Func _func;
@@ -280,14 +340,12 @@ namespace Simd
             _run(args.M, args.N, args.K, args.A, args.pB, args.C, _type, _type != GemmKernelAny);
         }
 
-#ifdef SIMD_RUNTIME_STATISTIC
         SIMD_INLINE String Info(const GemmCbArgs & args) const
         {
             std::stringstream ss;
             ss << "GemmCb [" << args.M << ", " << args.N << ", " << args.K << "]";
             return ss.str();
         }
-#endif 
         
         SIMD_INLINE GemmKernelType Type() const { return _type; }
 
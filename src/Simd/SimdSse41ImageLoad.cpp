@@ -72,6 +72,7 @@ namespace Simd
                 case SimdPixelFormatBgra32: _toBgra = Sse41::GrayToBgra; break;
                 case SimdPixelFormatRgb24: _toAny = Sse41::GrayToBgr; break;
                 case SimdPixelFormatRgba32: _toBgra = Sse41::GrayToBgra; break;
+                case SimdPixelFormatInt16: _reorder = Sse41::Reorder16bit; break;
                 default: break;
                 }
             }
@@ -125,6 +126,20 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImagePfmLoader::ImagePfmLoader(const ImageLoaderParam& param)
+            : Base::ImagePfmLoader(param)
+        {
+        }
+
+        void ImagePfmLoader::SetConverters()
+        {
+            Base::ImagePfmLoader::SetConverters();
+            if (_image.width >= A)
+                _reorder = Sse41::Reorder32bit;
+        }
+
+        //---------------------------------------------------------------------
+
         ImageLoader* CreateImageLoader(const ImageLoaderParam& param)
         {
             switch (param.file)
@@ -134,7 +149,8 @@ namespace Simd
             case SimdImageFilePpmTxt: return new ImagePpmTxtLoader(param);
             case SimdImageFilePpmBin: return new ImagePpmBinLoader(param);
             case SimdImageFilePng: return new ImagePngLoader(param);
-            case SimdImageFileJpeg: return new Base::ImageJpegLoader(param);
+            case SimdImageFileJpeg: return new ImageJpegLoader(param);
+            case SimdImageFilePfm: return new ImagePfmLoader(param);
             default:
                 return NULL;
             }
@@ -62,6 +62,7 @@ namespace Simd
                 case SimdPixelFormatBgra32: _convert = Sse41::BgraToGray; break;
                 case SimdPixelFormatRgb24: _convert = Sse41::RgbToGray; break;
                 case SimdPixelFormatRgba32: _convert = Sse41::RgbaToGray; break;
+                case SimdPixelFormatInt16: _reorder = Sse41::Reorder16bit; break;
                 default: break;
                 }
             }
@@ -115,6 +116,7 @@ namespace Simd
             case SimdImageFilePpmBin: return new ImagePpmBinSaver(param);
             case SimdImageFilePng: return new ImagePngSaver(param);
             case SimdImageFileJpeg: return new ImageJpegSaver(param);
+            case SimdImageFilePfm: return new Base::ImagePfmSaver(param);
             default:
                 return NULL;
             }
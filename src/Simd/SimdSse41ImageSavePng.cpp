@@ -73,9 +73,7 @@ namespace Simd
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(0, 1);
             stream.WriteBits(1, 2);
 
             int i = 0, j;
@@ -145,8 +143,6 @@ namespace Simd
             for (; i < size; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
-            stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -357,6 +353,8 @@ namespace Simd
                 _convert = Sse41::BgrToRgb;
             else if (_param.format == SimdPixelFormatBgra32)
                 _convert = Sse41::BgraToRgba;
+            else if (_param.format == SimdPixelFormatInt16 && _size >= A)
+                _reorder = Sse41::Reorder16bit;
             _encode[0] = Sse41::EncodeLine0;
             _encode[1] = Sse41::EncodeLine1;
             _encode[2] = Sse41::EncodeLine2;
@@ -364,7 +362,9 @@ namespace Simd
             _encode[4] = Sse41::EncodeLine4;
             _encode[5] = Sse41::EncodeLine5;
             _encode[6] = Sse41::EncodeLine6;
-            _compress = Sse41::ZlibCompress;
+            if (_level > COMPRESSION_GREEDY)
+                _compress = Sse41::ZlibCompress;
+            _adler32 = Sse41::ZlibAdler32;
         }
     }
 #endif// SIMD_SSE41_ENABLE
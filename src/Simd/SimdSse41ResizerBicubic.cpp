@@ -45,7 +45,7 @@ namespace Simd
             float scale = float(sizeS) / float(sizeD);
             size_t i = 0, sizeDF = AlignLo(sizeD, F);
             int32_t* ay = _ay.data;
-            if (sizeDF)
+            if (sizeDF && _param.method == SimdResizeMethodBicubic)
             {
                 __m128i _i = _mm_setr_epi32(0, 1, 2, 3);
                 __m128 _scale = _mm_set1_ps(scale);
@@ -105,10 +105,7 @@ namespace Simd
                     d = 1.0f;
                 }
                 _iy[i] = idx;
-                ay[0] = Round(Base::BICUBIC_RANGE * (2.0f - d) * (1.0f - d) * d / 6.0f);
-                ay[1] = Round(Base::BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * (1.0f - d) / 2.0f);
-                ay[2] = Round(Base::BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * d / 2.0f);
-                ay[3] = Round(Base::BICUBIC_RANGE * (1.0f + d) * (1.0f - d) * d / 6.0f);
+                Base::EstimateFilterAlpha(_param.method, d, 4, ay);
             }
         }
 
@@ -120,7 +117,7 @@ namespace Simd
             float scale = float(sizeS) / float(sizeD);
             size_t i = 0, sizeDF = AlignLo(sizeD, F);
             int8_t* ax = _ax.data;
-            if (sizeDF)
+            if (sizeDF && _param.method == SimdResizeMethodBicubic)
             {
                 static const __m128i _SHUFFLE = SIMD_MM_SETR_EPI8(0x0, 0x4, 0x8, 0xC, 0x1, 0x5, 0x9, 0xD, 0x2, 0x6, 0xA, 0xE, 0x3, 0x7, 0xB, 0xF);
                 __m128i _i = _mm_setr_epi32(0, 1, 2, 3);
@@ -175,10 +172,10 @@ namespace Simd
                     d = 1.0f;
                 }
                 _ix[i] = idx * (int)_param.channels;
-                ax[0] = (int8_t)Round(Base::BICUBIC_RANGE * (2.0f - d) * (1.0f - d) * d / 6.0f);
-                ax[1] = (int8_t)Round(Base::BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * (1.0f - d) / 2.0f);
-                ax[2] = (int8_t)Round(Base::BICUBIC_RANGE * (d - 2.0f) * (d + 1.0f) * d / 2.0f);
-                ax[3] = (int8_t)Round(Base::BICUBIC_RANGE * (1.0f + d) * (1.0f - d) * d / 6.0f);
+                int32_t alpha[4];
+                Base::EstimateFilterAlpha(_param.method, d, 4, alpha);
+                for (size_t k = 0; k < 4; ++k)
+                    ax[k] = (int8_t)alpha[k];
             }
         }
 
@@ -267,7 +264,8 @@ namespace Simd
             assert(_xn == 0 && _xt == _param.dstW);
             size_t step = 4 / N;
             size_t body = AlignLoAny(_param.dstW - (N == 3 ? 1 : 0), step);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -368,8 +366,9 @@ namespace Simd
 
         template<int N> void ResizerByteBicubic::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
-            int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            int32_t prev = _iy[_yBeg] - 1;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 int32_t sy = _iy[dy], next = prev;
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
@@ -221,7 +221,8 @@ namespace Simd
             const int32_t* ix = _ix.data;
             size_t dstW = _param.dstW;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm_set1_epi16(int16_t(_ay[yDst]));
@@ -278,7 +279,8 @@ namespace Simd
             const uint8_t* ax = _ax.data;
             const Idx* ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm_set1_epi16(int16_t(_ay[yDst]));
@@ -348,7 +350,8 @@ namespace Simd
             size_t rs4 = AlignLo(rs, 4);
             size_t rs8 = AlignLo(rs, 8);
             __m128 _1 = _mm_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -447,7 +450,8 @@ namespace Simd
             size_t rs4 = AlignLo(rs, 4);
             size_t rs8 = AlignLo(rs, 8);
             __m128 _1 = _mm_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
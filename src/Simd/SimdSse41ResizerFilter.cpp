@@ -0,0 +1,166 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdExtract.h"
+#include "Simd/SimdResizer.h"
+
+namespace Simd
+{
+#ifdef SIMD_SSE41_ENABLE
+    namespace Sse41
+    {
+        ResizerFloatFilter::ResizerFloatFilter(const ResParam& param)
+            : Base::ResizerFloatFilter(param)
+        {
+        }
+
+        SIMD_INLINE __m128 FilterSumX1(const float* src, const float* ax, size_t stride)
+        {
+            __m128 sum = _mm_mul_ps(_mm_loadu_ps(src), _mm_loadu_ps(ax));
+            for (size_t k = F; k < stride; k += F)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + k), _mm_loadu_ps(ax + k)));
+            return sum;
+        }
+
+        void ResizerFloatFilter::RowX(float* dst)
+        {
+            const float* by = _by.data, * ax = _ax.data;
+            const int32_t* ix = _ix.data;
+            size_t N = _param.channels, dstW = _param.dstW, dx = 0;
+            if (N == 1)
+            {
+                size_t dstWF = AlignLo(dstW, F);
+                for (; dx < dstWF; dx += F, ax += F * _sx)
+                {
+                    __m128 s0 = FilterSumX1(by + ix[dx + 0], ax + 0 * _sx, _sx);
+                    __m128 s1 = FilterSumX1(by + ix[dx + 1], ax + 1 * _sx, _sx);
+                    __m128 s2 = FilterSumX1(by + ix[dx + 2], ax + 2 * _sx, _sx);
+                    __m128 s3 = FilterSumX1(by + ix[dx + 3], ax + 3 * _sx, _sx);
+                    _mm_storeu_ps(dst + dx, _mm_hadd_ps(_mm_hadd_ps(s0, s1), _mm_hadd_ps(s2, s3)));
+                }
+                for (; dx < dstW; dx++, ax += _sx)
+                    dst[dx] = ExtractSum(FilterSumX1(by + ix[dx], ax, _sx));
+            }
+            else if (N < F)
+            {
+                for (; dx < dstW - 1; dx++, ax += _sx, dst += N)
+                {
+                    const float* pb = by + ix[dx];
+                    __m128 sum = _mm_mul_ps(_mm_loadu_ps(pb), _mm_set1_ps(ax[0]));
+                    for (size_t k = 1; k < _kx; ++k)
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pb + k * N), _mm_set1_ps(ax[k])));
+                    _mm_storeu_ps(dst, sum);
+                }
+                const float* pb = by + ix[dx];
+                for (size_t c = 0; c < N; ++c)
+                {
+                    float sum = 0.0f;
+                    for (size_t k = 0; k < _kx; ++k)
+                        sum += ax[k] * pb[k * N + c];
+                    dst[c] = sum;
+                }
+            }
+            else
+            {
+                for (; dx < dstW; dx++, ax += _sx, dst += N)
+                {
+                    const float* pb = by + ix[dx];
+                    for (size_t c = 0; c < N; c += F)
+                    {
+                        size_t o = Simd::Min(c, N - F);
+                        __m128 sum = _mm_mul_ps(_mm_loadu_ps(pb + o), _mm_set1_ps(ax[0]));
+                        for (size_t k = 1; k < _kx; ++k)
+                            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pb + k * N + o), _mm_set1_ps(ax[k])));
+                        _mm_storeu_ps(dst + o, sum);
+                    }
+                }
+            }
+        }
+
+        SIMD_INLINE __m128 FilterLoad(const float* src)
+        {
+            return _mm_loadu_ps(src);
+        }
+
+        SIMD_INLINE __m128 FilterLoad(const uint16_t* src)
+        {
+            return _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i*)src)));
+        }
+
+        template<class T> SIMD_INLINE void FilterRowY(const T* src, size_t srcStride, size_t size, const float* ay, size_t ky, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m128 ay0 = _mm_set1_ps(ay[0]);
+            for (; i < sizeF; i += F)
+                _mm_storeu_ps(dst + i, _mm_mul_ps(FilterLoad(src + i), ay0));
+            for (; i < size; ++i)
+                dst[i] = ay[0] * src[i];
+            for (size_t k = 1; k < ky; ++k)
+            {
+                src += srcStride;
+                __m128 ayk = _mm_set1_ps(ay[k]);
+                for (i = 0; i < sizeF; i += F)
+                    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(FilterLoad(src + i), ayk)));
+                for (; i < size; ++i)
+                    dst[i] += ay[k] * src[i];
+            }
+        }
+
+        SIMD_INLINE void FilterStore(const float* src, size_t size, uint16_t* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            for (; i < sizeF; i += F)
+                _mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi32(_mm_cvtps_epi32(_mm_loadu_ps(src + i)), K_ZERO));
+            for (; i < size; ++i)
+                dst[i] = (uint16_t)Base::RestrictRange(Round(src[i]), 0, 0xFFFF);
+        }
+
+        template<class T> void ResizerFloatFilter::RunB(const T* src, size_t srcStride, T* dst, size_t dstStride)
+        {
+            size_t sw = _param.srcW * _param.channels, dw = _param.dstW * _param.channels;
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                FilterRowY(src + _iy[dy] * srcStride, srcStride, sw, _ay.data + dy * _ky, _ky, _by.data);
+                if (_param.type == SimdResizeChannelFloat)
+                    RowX((float*)dst);
+                else
+                {
+                    RowX(_bx.data);
+                    FilterStore(_bx.data, dw, (uint16_t*)dst);
+                }
+            }
+        }
+
+        void ResizerFloatFilter::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            if (_param.type == SimdResizeChannelFloat)
+                RunB((const float*)src, srcStride / sizeof(float), (float*)dst, dstStride / sizeof(float));
+            else
+                RunB((const uint16_t*)src, srcStride / sizeof(uint16_t), (uint16_t*)dst, dstStride / sizeof(uint16_t));
+        }
+    }
+#endif //SIMD_SSE41_ENABLE
+}
@@ -0,0 +1,196 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdResizerCommon.h"
+
+namespace Simd
+{
+#ifdef SIMD_SSE41_ENABLE
+    namespace Sse41
+    {
+        ResizerByteLanczos3::ResizerByteLanczos3(const ResParam& param)
+            : Base::ResizerByteLanczos3(param)
+        {
+        }
+
+        void ResizerByteLanczos3::Init()
+        {
+            if (_iy.data)
+                return;
+            Array32i ax;
+            EstimateIndexAlpha(_param.srcH, _param.dstH, 1, _iy, _ay);
+            EstimateIndexAlpha(_param.srcW, _param.dstW, _param.channels, _ix, ax);
+            _ax.Resize(_param.dstW * 8, true);
+            for (size_t i = 0; i < _param.dstW; ++i)
+                for (size_t k = 0; k < 6; ++k)
+                    _ax[i * 8 + k] = (int16_t)ax[i * 6 + k];
+            for (int i = 0; i < 8; ++i)
+                _bx[i].Resize(_param.dstW * _param.channels + F);
+            int32_t N = (int32_t)_param.channels, size = (int32_t)(_param.srcW * N);
+            int32_t over = N == 1 ? 6 : 2 * N + (N == 2 ? 4 : 8);
+            for (_xn = 0; _xn < _param.dstW && _ix[_xn] < 2 * N; _xn++);
+            for (_xt = _param.dstW; _xt > _xn && _ix[_xt - 1] + over > size; _xt--);
+        }
+
+        template<int N> SIMD_INLINE __m128i LoadLanczos3Pair(const uint8_t* src);
+
+        template<> SIMD_INLINE __m128i LoadLanczos3Pair<2>(const uint8_t* src)
+        {
+            static const __m128i SHUFFLE = SIMD_MM_SETR_EPI8(0x0, 0x2, 0x1, 0x3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            return _mm_cvtepu8_epi16(_mm_shuffle_epi8(_mm_cvtsi32_si128(*(int32_t*)src), SHUFFLE));
+        }
+
+        template<> SIMD_INLINE __m128i LoadLanczos3Pair<3>(const uint8_t* src)
+        {
+            static const __m128i SHUFFLE = SIMD_MM_SETR_EPI8(0x0, 0x3, 0x1, 0x4, 0x2, 0x5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            return _mm_cvtepu8_epi16(_mm_shuffle_epi8(_mm_loadl_epi64((__m128i*)src), SHUFFLE));
+        }
+
+        template<> SIMD_INLINE __m128i LoadLanczos3Pair<4>(const uint8_t* src)
+        {
+            static const __m128i SHUFFLE = SIMD_MM_SETR_EPI8(0x0, 0x4, 0x1, 0x5, 0x2, 0x6, 0x3, 0x7, -1, -1, -1, -1, -1, -1, -1, -1);
+            return _mm_cvtepu8_epi16(_mm_shuffle_epi8(_mm_loadl_epi64((__m128i*)src), SHUFFLE));
+        }
+
+        template<int N> SIMD_INLINE void PixelLanczos3SumX(const uint8_t* src, const int16_t* ax, int32_t* dst)
+        {
+            __m128i _ax = _mm_loadu_si128((__m128i*)ax);
+            __m128i s01 = _mm_madd_epi16(LoadLanczos3Pair<N>(src + 0 * N), _mm_shuffle_epi32(_ax, 0x00));
+            __m128i s23 = _mm_madd_epi16(LoadLanczos3Pair<N>(src + 2 * N), _mm_shuffle_epi32(_ax, 0x55));
+            __m128i s45 = _mm_madd_epi16(LoadLanczos3Pair<N>(src + 4 * N), _mm_shuffle_epi32(_ax, 0xAA));
+            _mm_storeu_si128((__m128i*)dst, _mm_add_epi32(_mm_add_epi32(s01, s23), s45));
+        }
+
+        template<int N> SIMD_INLINE void RowLanczos3SumX(const uint8_t* src, size_t nose, size_t body, size_t tail, int32_t last, const int32_t* ix, const int16_t* ax, int32_t* dst)
+        {
+            size_t dx = 0;
+            for (; dx < nose; dx++, ax += 8, dst += N)
+                Base::PixelLanczos3SumX<N>(src, ix[dx], last, ax, dst);
+            for (; dx < body; dx++, ax += 8, dst += N)
+                PixelLanczos3SumX<N>(src + ix[dx] - 2 * N, ax, dst);
+            for (; dx < tail; dx++, ax += 8, dst += N)
+                Base::PixelLanczos3SumX<N>(src, ix[dx], last, ax, dst);
+        }
+
+        SIMD_INLINE __m128i PixelLanczos3SumX1(const uint8_t* src, const int16_t* ax)
+        {
+            return _mm_madd_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)(src - 2))), _mm_loadu_si128((__m128i*)ax));
+        }
+
+        template<> SIMD_INLINE void RowLanczos3SumX<1>(const uint8_t* src, size_t nose, size_t body, size_t tail, int32_t last, const int32_t* ix, const int16_t* ax, int32_t* dst)
+        {
+            size_t dx = 0, bodyF = nose + AlignLo(body - nose, F);
+            for (; dx < nose; dx++, ax += 8, dst += 1)
+                Base::PixelLanczos3SumX<1>(src, ix[dx], last, ax, dst);
+            for (; dx < bodyF; dx += F, ax += 8 * F, dst += F)
+            {
+                __m128i s0 = PixelLanczos3SumX1(src + ix[dx + 0], ax + 0 * 8);
+                __m128i s1 = PixelLanczos3SumX1(src + ix[dx + 1], ax + 1 * 8);
+                __m128i s2 = PixelLanczos3SumX1(src + ix[dx + 2], ax + 2 * 8);
+                __m128i s3 = PixelLanczos3SumX1(src + ix[dx + 3], ax + 3 * 8);
+                _mm_storeu_si128((__m128i*)dst, _mm_hadd_epi32(_mm_hadd_epi32(s0, s1), _mm_hadd_epi32(s2, s3)));
+            }
+            for (; dx < tail; dx++, ax += 8, dst += 1)
+                Base::PixelLanczos3SumX<1>(src, ix[dx], last, ax, dst);
+        }
+
+        void ResizerByteLanczos3::RowSumX(const uint8_t* src, int32_t* dst)
+        {
+            int32_t last = (int32_t)((_param.srcW - 1) * _param.channels);
+            switch (_param.channels)
+            {
+            case 1: RowLanczos3SumX<1>(src, _xn, _xt, _param.dstW, last, _ix.data, _ax.data, dst); return;
+            case 2: RowLanczos3SumX<2>(src, _xn, _xt, _param.dstW, last, _ix.data, _ax.data, dst); return;
+            case 3: RowLanczos3SumX<3>(src, _xn, _xt, _param.dstW, last, _ix.data, _ax.data, dst); return;
+            case 4: RowLanczos3SumX<4>(src, _xn, _xt, _param.dstW, last, _ix.data, _ax.data, dst); return;
+            default:
+                assert(0);
+            }
+        }
+
+        SIMD_INLINE __m128i Lanczos3MulAdd(const int32_t* src, __m128i ay, __m128i sum)
+        {
+            return _mm_add_epi32(sum, _mm_mullo_epi32(_mm_loadu_si128((__m128i*)src), ay));
+        }
+
+        SIMD_INLINE void Lanczos3RowInt(const int32_t* const* src, size_t n, const int32_t* ay, uint8_t* dst)
+        {
+            size_t nF = AlignLo(n, F);
+            size_t i = 0;
+            if (nF)
+            {
+                static const __m128i ROUND = SIMD_MM_SET1_EPI32(Base::BICUBIC_ROUND);
+                __m128i ay0 = _mm_set1_epi32(ay[0]);
+                __m128i ay1 = _mm_set1_epi32(ay[1]);
+                __m128i ay2 = _mm_set1_epi32(ay[2]);
+                __m128i ay3 = _mm_set1_epi32(ay[3]);
+                __m128i ay4 = _mm_set1_epi32(ay[4]);
+                __m128i ay5 = _mm_set1_epi32(ay[5]);
+                for (; i < nF; i += F)
+                {
+                    __m128i sum = ROUND;
+                    sum = Lanczos3MulAdd(src[0] + i, ay0, sum);
+                    sum = Lanczos3MulAdd(src[1] + i, ay1, sum);
+                    sum = Lanczos3MulAdd(src[2] + i, ay2, sum);
+                    sum = Lanczos3MulAdd(src[3] + i, ay3, sum);
+                    sum = Lanczos3MulAdd(src[4] + i, ay4, sum);
+                    sum = Lanczos3MulAdd(src[5] + i, ay5, sum);
+                    __m128i dst0 = _mm_srai_epi32(sum, Base::BICUBIC_SHIFT);
+                    *((int32_t*)(dst + i)) = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(dst0, K_ZERO), K_ZERO));
+                }
+            }
+            for (; i < n; ++i)
+            {
+                int32_t sum = ay[0] * src[0][i] + ay[1] * src[1][i] + ay[2] * src[2][i] + ay[3] * src[3][i] + ay[4] * src[4][i] + ay[5] * src[5][i];
+                dst[i] = Base::RestrictRange((sum + Base::BICUBIC_ROUND) >> Base::BICUBIC_SHIFT, 0, 255);
+            }
+        }
+
+        void ResizerByteLanczos3::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            int32_t prev = -2;
+            const int32_t* pb[6];
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                int32_t sy = _iy[dy];
+                for (int32_t curr = Max(sy - 2, prev); curr < sy + 4; ++curr)
+                    RowSumX(src + RestrictRange(curr, 0, (int)_param.srcH - 1) * srcStride, _bx[(curr + 2) & 7].data);
+                prev = sy + 4;
+                for (int k = 0; k < 6; ++k)
+                    pb[k] = _bx[(sy + k) & 7].data;
+                Lanczos3RowInt(pb, _param.dstW * _param.channels, _ay.data + dy * 6, dst);
+            }
+        }
+
+        void ResizerByteLanczos3::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Init();
+            RunB(src, srcStride, dst, dstStride);
+        }
+    }
+#endif //SIMD_SSE41_ENABLE
+}
@@ -91,7 +91,8 @@ namespace Simd
         void ResizerNearest::Shuffle16x1(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
             size_t body = _blocks - _tails;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t* srcRow = src + _iy[dy] * srcStride;
                 size_t i = 0, t = 0;
@@ -122,7 +123,8 @@ namespace Simd
         void ResizerNearest::Resize12(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
             size_t body = _param.dstW - 1;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            dst += _yBeg * dstStride;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t* srcRow = src + _iy[dy] * srcStride;
                 size_t dx = 0, offset = 0;
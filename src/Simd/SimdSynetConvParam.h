@@ -0,0 +1,69 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetConvParam_h__
+#define __SimdSynetConvParam_h__
+
+#include "Simd/SimdMath.h"
+#include "Simd/SimdParallel.hpp"
+
+namespace Simd
+{
+    template<class Param> SIMD_INLINE Param RowBand(const Param& p, size_t dstBeg, size_t dstEnd, size_t& srcBeg)
+    {
+        Param band = p;
+        ptrdiff_t beg = dstBeg * p.strideY - p.padY;
+        ptrdiff_t end = (dstEnd - 1) * p.strideY - p.padY + (p.kernelY - 1) * p.dilationY + 1;
+        srcBeg = Simd::Max<ptrdiff_t>(beg, 0);
+        band.padY = Simd::Max<ptrdiff_t>(-beg, 0);
+        band.padH = Simd::Max<ptrdiff_t>(end - p.srcH, 0);
+        band.srcH = Simd::Min<ptrdiff_t>(end, p.srcH) - srcBeg;
+        band.dstH = dstEnd - dstBeg;
+        band.batch = 1;
+        return band;
+    }
+
+    // Splits output rows of the image into at most threadNumber bands and calls function(band, srcY, dstY) for each of them.
+    // Every band re-reads (kernelY - 1) * dilationY halo rows of the source, which is about 2 * pad for 'same' convolutions.
+    // So a band is kept at least max(padY, padH) output rows high: thinner bands would spend more time on the halo than on own rows.
+    template<class Param, class Function> SIMD_INLINE void ParallelRowBands(const Param& p, size_t threadNumber, const Function& function)
+    {
+        size_t bands = Simd::Min(threadNumber, p.dstH / Simd::Max<size_t>(Simd::Max(p.padY, p.padH), 1));
+        if (bands <= 1)
+        {
+            function(p, 0, 0);
+            return;
+        }
+        Simd::Parallel(0, bands, [&](size_t thread, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                size_t dstBeg = i * p.dstH / bands, dstEnd = (i + 1) * p.dstH / bands, srcBeg;
+                Param band = RowBand(p, dstBeg, dstEnd, srcBeg);
+                function(band, srcBeg, dstBeg);
+            }
+        }, bands);
+    }
+}
+
+#endif//__SimdSynetConvParam_h__
@@ -28,6 +28,8 @@
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
 #include "Simd/SimdGemm.h"
+#include "Simd/SimdSynetConvolutionEpilogue.h"
+#include "Simd/SimdSynetConvParam.h"
 
 #ifdef _N
 #undef _N
@@ -41,6 +43,7 @@ namespace Simd
 #else
     const bool NHWC_GEMM_RUNTIME = true;
 #endif
+    const int64_t SYNET_THREAD_FLOP_MIN = 1 << 21;
 
     //---------------------------------------------------------------------------------------------
 
@@ -224,6 +227,7 @@ namespace Simd
             , _nhwcRun(0)
             , _nhwcReorderB(0)
             , _biasAndActivation(0)
+            , _threadNumber(Base::GetThreadNumber())
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
             , _perf(NULL)
 #endif
@@ -259,6 +263,16 @@ namespace Simd
 
         virtual void Forward(const float * src, float * buf, float * dst) = 0;
 
+        virtual bool RowsForwardable() const
+        {
+            return false;
+        }
+
+        virtual void ForwardRows(const float * src, size_t dstBeg, size_t dstEnd, float * dst)
+        {
+            assert(0);
+        }
+
         float * Buffer(float * buffer)
         {
             if (buffer)
@@ -281,6 +295,12 @@ namespace Simd
         }
 
     protected:
+        SIMD_INLINE size_t ThreadNumber(size_t size) const
+        {
+            int64_t limit = Simd::Max<int64_t>(_param.Flop() / _param.batch / SYNET_THREAD_FLOP_MIN, 1);
+            return Simd::Min<size_t>(Simd::Min<size_t>(_threadNumber, size), size_t(Simd::Min<int64_t>(limit, _threadNumber)));
+        }
+
         typedef void(*NhwcReorderB)(size_t M, size_t N, size_t K, const float * B, float * pB, GemmKernelType type, bool compatibility);
         typedef void(*NhwcRun)(size_t M, size_t N, size_t K, const float * A, const float * B, float * C, GemmKernelType type, bool compatibility);
         typedef void(*BiasAndActivation)(const float * bias, size_t count, size_t size, ::SimdConvolutionActivationType activation, const float * params, SimdBool trans, float * dst);
@@ -295,6 +315,7 @@ namespace Simd
         NhwcRun _nhwcRun;
         NhwcReorderB _nhwcReorderB;
         BiasAndActivation _biasAndActivation;
+        size_t _threadNumber;
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
         Base::PerformanceMeasurer * _perf;
 #endif
@@ -362,6 +383,8 @@ namespace Simd
             typedef void(*SetOutput)(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth, SimdBool trans);
 
             void SetBlock(size_t blockY, size_t blockX);
+            void ForwardInput(const float* src, size_t tileBeg, size_t tileEnd, float* dst, size_t dstStride);
+            void ForwardOutput(const float* src, size_t srcStride, size_t tileBeg, size_t tileEnd, float* dst);
             void ForwardMerged(const float * src, float * bufS, float * bufD, float * dst);
             void ForwardSplitted(const float * src, float * bufS, float * bufD, float * dst);
 #ifdef SIMD_PERFORMANCE_STATISTIC
@@ -440,6 +463,8 @@ namespace Simd
             virtual size_t InternalBufferSize() const;
             virtual void SetParams(const float * weight, SimdBool * internal, const float * bias, const float * params);
             virtual void Forward(const float * src, float * buf, float * dst);
+            virtual bool RowsForwardable() const { return true; }
+            virtual void ForwardRows(const float * src, size_t dstBeg, size_t dstEnd, float * dst);
 
             static bool Preferable(const ConvParam32f & p);
 
@@ -465,9 +490,9 @@ namespace Simd
 
             struct RunArgs
             {
-                const float* src; const ConvParam32f& p; const float* weight; const float* bias; const float* params; float* dst;
-                SIMD_INLINE RunArgs(const float* src_, const ConvParam32f& p_, const float* weight_, const float* bias_, const float* params_, float* dst_)
-                    :src(src_), p(p_), weight(weight_), bias(bias_), params(params_), dst(dst_)
+                const float* src; const ConvParam32f& p; const float* weight; const float* bias; const float* params; float* dst; size_t threads;
+                SIMD_INLINE RunArgs(const float* src_, const ConvParam32f& p_, const float* weight_, const float* bias_, const float* params_, float* dst_, size_t threads_)
+                    :src(src_), p(p_), weight(weight_), bias(bias_), params(params_), dst(dst_), threads(threads_)
                 {}
             };
 
@@ -482,17 +507,18 @@ namespace Simd
 
                 SIMD_INLINE void Run(const RunArgs& args)
                 {
-                    Forward(args.src, args.p, alg, args.weight, args.bias, args.params, args.dst);
+                    ParallelRowBands(args.p, args.threads, [&](const ConvParam32f& band, size_t srcY, size_t dstY)
+                    {
+                        Forward(args.src + srcY * band.srcW * band.srcC, band, alg, args.weight, args.bias, args.params, args.dst + dstY * band.dstW * band.dstC);
+                    });
                 }
 
-#ifdef SIMD_RUNTIME_STATISTIC
                 SIMD_INLINE String Info(const RunArgs& args) const
                 {
                     std::stringstream ss;
                     ss << "NhwcDirect [" << args.p.Info() << "]";
                     return ss.str();
                 }
-#endif
 
                 AlgParam alg;
             private:
@@ -581,7 +607,53 @@ namespace Simd
 
         //-----------------------------------------------------------------------------------------
 
+        class SynetConvolution32fBatch : public SynetConvolution32f
+        {
+        public:
+            SynetConvolution32fBatch(size_t batch, SynetConvolution32f * single);
+            virtual ~SynetConvolution32fBatch();
+            virtual String Ext() const { return _single->Ext(); }
+            virtual String Desc() const { return _single->Desc() + "-Batch"; }
+            virtual size_t ExternalBufferSize() const;
+            virtual size_t InternalBufferSize() const;
+            virtual void SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params);
+            virtual void Forward(const float* src, float* buf, float* dst);
+
+            void Forward(const float* src, float* buf, float* dst, size_t batch);
+
+        protected:
+            SynetConvolution32f * _single;
+            size_t _sizeS, _sizeD, _stride;
+        };
+
+        //-----------------------------------------------------------------------------------------
+
+        class SynetConvolution32fEpilogue : public SynetConvolution32f
+        {
+        public:
+            SynetConvolution32fEpilogue(size_t batch, const SimdConvolutionParameters & conv, const SimdConvolutionEpilogue & epilogue, SynetConvolution32f * single, const SynetConvolutionEpilogue::Funcs & funcs);
+            virtual ~SynetConvolution32fEpilogue();
+            virtual String Ext() const { return _single->Ext(); }
+            virtual String Desc() const { return _single->Desc() + (_rows ? "-Epilogue" : "-epilogue"); }
+            virtual size_t ExternalBufferSize() const;
+            virtual size_t InternalBufferSize() const;
+            virtual void SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params);
+            virtual void Forward(const float* src, float* buf, float* dst);
+
+        protected:
+            SynetConvolution32f * _single;
+            SynetConvolutionEpilogue _epilogue;
+            bool _rows;
+            size_t _sizeS, _sizeD, _chunks, _threads, _stride;
+        };
+
+        //-----------------------------------------------------------------------------------------
+
         void * SynetConvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+
+        void * SynetConvolution32fBatchInit(size_t batch, void * single);
+
+        void * SynetConvolution32fEpilogueInit(size_t batch, const SimdConvolutionParameters * conv, const SimdConvolutionEpilogue * epilogue, void * single, const SynetConvolutionEpilogue::Funcs & funcs);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
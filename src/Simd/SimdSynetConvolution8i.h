@@ -26,6 +26,9 @@
 
 #include "Simd/SimdArray.h"
 #include "Simd/SimdPerformance.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdSynetConvolutionEpilogue.h"
+#include "Simd/SimdSynetConvParam.h"
 
 #ifdef _N
 #undef _N
@@ -33,6 +36,8 @@
 
 namespace Simd
 {
+    const int64_t SYNET_INT8_THREAD_FLOP_MIN = 1 << 22;
+
     struct ConvParam8i : public SimdConvolutionParameters
     {
         SimdBool trans;
@@ -125,12 +130,12 @@ namespace Simd
             ss << "-" << (srcT == SimdTensorData8u ? "u" : "f") << (dstT == SimdTensorData8u ? "u" : "f");
             return ss.str();
         }
+#endif
 
         int64_t Flop() const
         {
             return int64_t(batch) * kernelY * kernelX * srcC * dstH * dstW * dstC / group * 2;
         }
-#endif
     };
 
     struct CvtParam
@@ -170,6 +175,23 @@ namespace Simd
 
         virtual void Forward(const uint8_t * src, uint8_t * buf, uint8_t * dst);
 
+        virtual bool RowsForwardable() const
+        {
+            return false;
+        }
+
+        virtual void ForwardRows(const uint8_t* src, size_t dstBeg, size_t dstEnd, float* dst)
+        {
+            assert(0);
+        }
+
+        bool Src8u() const
+        {
+            return _src8u;
+        }
+
+        void ConvertSrc(const float* src, uint8_t* dst) const;
+
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
         Base::PerformanceMeasurer* Perf(const char* func);
 #endif
@@ -183,6 +205,12 @@ namespace Simd
     protected:
         virtual void Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst) = 0;
 
+        SIMD_INLINE size_t ThreadNumber(size_t size) const
+        {
+            int64_t limit = Simd::Max<int64_t>(_param.Flop() / _param.batch / SYNET_INT8_THREAD_FLOP_MIN, 1);
+            return Simd::Min<size_t>(Simd::Min<size_t>(_threadNumber, size), size_t(Simd::Min<int64_t>(limit, _threadNumber)));
+        }
+
         typedef void(*Convert32fTo8u)(const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility);
 
         ConvParam8i _param;
@@ -196,7 +224,7 @@ namespace Simd
         Array8i _weight;
         Array32f _norm, _bias, _params; 
         bool _src8u, _dst8u;
-        size_t _merge, _sizeS, _sizeD;
+        size_t _merge, _sizeS, _sizeD, _threadNumber;
     };
 
     namespace Base
@@ -225,6 +253,8 @@ namespace Simd
             virtual size_t InternalBufferSize() const;
             virtual size_t ExternalBufferSize() const;
             virtual void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats);
+            virtual bool RowsForwardable() const { return _sizeP == 0 && !_dst8u; }
+            virtual void ForwardRows(const uint8_t* src, size_t dstBeg, size_t dstEnd, float* dst);
 
             static bool Preferable(const ConvParam8i& p);
 
@@ -245,6 +275,7 @@ namespace Simd
 
             virtual void Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst);
             void Forward8u(const uint8_t* src, const ConvParam8i & p, int32_t* buf, uint8_t* dst);
+            void Forward8u(const uint8_t* src, const ConvParam8i& p, size_t dstBeg, size_t dstEnd, int32_t* buf, uint8_t* dst);
 
             AlgParam _alg;
             size_t _sizeP, _sizeB;
@@ -278,7 +309,30 @@ namespace Simd
             ConvolutionPtr _convolution;
         };
 
+        class SynetConvolution8iEpilogue : public SynetConvolution8i
+        {
+        public:
+            SynetConvolution8iEpilogue(size_t batch, const SimdConvolutionParameters& conv, const SimdConvolutionEpilogue& epilogue, SynetConvolution8i* single, const SynetConvolutionEpilogue::Funcs& funcs);
+            virtual ~SynetConvolution8iEpilogue();
+            virtual String Ext() const { return _single->Ext(); }
+            virtual String Desc() const { return _single->Desc() + (_rows ? "-Epilogue" : "-epilogue"); }
+            virtual size_t ExternalBufferSize() const;
+            virtual size_t InternalBufferSize() const;
+            virtual void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats);
+            virtual void Forward(const uint8_t* src, uint8_t* buf, uint8_t* dst);
+
+        protected:
+            virtual void Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst);
+
+            SynetConvolution8i* _single;
+            SynetConvolutionEpilogue _epilogue;
+            bool _rows;
+            size_t _chunks, _threads, _stride;
+        };
+
         void * SynetConvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+
+        void * SynetConvolution8iEpilogueInit(size_t batch, const SimdConvolutionParameters* conv, const SimdConvolutionEpilogue* epilogue, void* single, const SynetConvolutionEpilogue::Funcs& funcs);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
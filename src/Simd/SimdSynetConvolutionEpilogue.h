@@ -0,0 +1,155 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetConvolutionEpilogue_h__
+#define __SimdSynetConvolutionEpilogue_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdCpu.h"
+
+namespace Simd
+{
+    class SynetConvolutionEpilogue
+    {
+    public:
+        typedef void(*BiasAndActivationPtr)(const float* bias, size_t count, size_t size, ::SimdConvolutionActivationType activation, const float* params, ::SimdBool trans, float* dst);
+        typedef void(*PoolingAveragePtr)(const float* src, size_t srcC, size_t srcH, size_t srcW, size_t kernelY, size_t kernelX,
+            size_t strideY, size_t strideX, size_t padY, size_t padX, float* dst, size_t dstH, size_t dstW, SimdBool excludePad, SimdTensorFormatType format);
+        typedef void(*PoolingMaxPtr)(const float* src, size_t srcC, size_t srcH, size_t srcW, size_t kernelC, size_t kernelY, size_t kernelX, 
+            size_t strideC, size_t strideY, size_t strideX, size_t padC, size_t padY, size_t padX, float* dst, size_t dstC, size_t dstH, size_t dstW, SimdTensorFormatType format);
+        typedef void(*EltwiseLayerForwardPtr)(float const* const* src, const float* weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float* dst);
+
+        struct Funcs
+        {
+            BiasAndActivationPtr biasAndActivation;
+            PoolingAveragePtr poolingAverage;
+            PoolingMaxPtr poolingMax;
+            EltwiseLayerForwardPtr eltwiseLayerForward;
+        };
+
+        SynetConvolutionEpilogue(const SimdConvolutionEpilogue& epilogue, const SimdConvolutionParameters& conv, const Funcs& funcs)
+            : _epilogue(epilogue)
+            , _activation(epilogue.type == SimdConvolutionEpilogueAdd ? conv.activation : SimdConvolutionActivationIdentity)
+            , _funcs(funcs)
+            , _C(conv.dstC)
+            , _H(conv.dstH)
+            , _W(conv.dstW)
+        {
+        }
+
+        bool Valid() const
+        {
+            const SimdConvolutionEpilogue& e = _epilogue;
+            if (e.type == SimdConvolutionEpilogueIdentity || e.type == SimdConvolutionEpilogueAdd)
+                return true;
+            if (e.type == SimdConvolutionEpiloguePoolingMax || e.type == SimdConvolutionEpiloguePoolingAverage)
+                return e.kernel >= 1 && e.stride >= 1 && e.pad < e.kernel && _H + 2 * e.pad >= e.kernel && _W + 2 * e.pad >= e.kernel;
+            return false;
+        }
+
+        bool Pooling() const
+        {
+            return _epilogue.type == SimdConvolutionEpiloguePoolingMax || _epilogue.type == SimdConvolutionEpiloguePoolingAverage;
+        }
+
+        SimdConvolutionActivationType Activation() const
+        {
+            return _activation;
+        }
+
+        size_t DstH() const
+        {
+            return Pooling() ? (_H + 2 * _epilogue.pad - _epilogue.kernel) / _epilogue.stride + 1 : _H;
+        }
+
+        size_t DstW() const
+        {
+            return Pooling() ? (_W + 2 * _epilogue.pad - _epilogue.kernel) / _epilogue.stride + 1 : _W;
+        }
+
+        void SrcRows(size_t dstBeg, size_t dstEnd, size_t& srcBeg, size_t& srcEnd) const
+        {
+            if (Pooling())
+            {
+                const SimdConvolutionEpilogue& e = _epilogue;
+                srcBeg = dstBeg * e.stride > e.pad ? dstBeg * e.stride - e.pad : 0;
+                srcEnd = Simd::Min((dstEnd - 1) * e.stride + e.kernel - e.pad, _H);
+            }
+            else
+                srcBeg = dstBeg, srcEnd = dstEnd;
+        }
+
+        size_t ChunkRows() const
+        {
+            size_t rowSize = _W * _C * sizeof(float) * (Pooling() ? _epilogue.stride : 1);
+            return Simd::Max<size_t>(Base::AlgCacheL2() / 2 / rowSize, 1);
+        }
+
+        size_t SrcSize(size_t dstRows) const
+        {
+            size_t srcRows = Pooling() ? (dstRows - 1) * _epilogue.stride + _epilogue.kernel : dstRows;
+            return Simd::Min(srcRows, _H) * _W * _C;
+        }
+
+        void SetParams(const float* params)
+        {
+            size_t size = _activation == SimdConvolutionActivationPrelu ? _C : 2;
+            _params.Resize(size, true);
+            if (params && _activation != SimdConvolutionActivationIdentity && _activation != SimdConvolutionActivationRelu)
+                memcpy(_params.data, params, size * sizeof(float));
+        }
+
+        void Run(const float* src, size_t dstBeg, size_t dstEnd, float* dst) const
+        {
+            const SimdConvolutionEpilogue& e = _epilogue;
+            if (e.type == SimdConvolutionEpilogueIdentity)
+                memcpy(dst, src, (dstEnd - dstBeg) * _W * _C * sizeof(float));
+            else if (e.type == SimdConvolutionEpilogueAdd)
+            {
+                const float* add[2] = { dst, src }, weight[2] = { 1.0f, 1.0f };
+                _funcs.eltwiseLayerForward(add, weight, 2, (dstEnd - dstBeg) * _W * _C, SimdSynetEltwiseOperationSum, dst);
+                _funcs.biasAndActivation(NULL, _C, (dstEnd - dstBeg) * _W, _activation, _params.data, SimdTrue, dst);
+            }
+            else
+            {
+                size_t srcBeg, srcEnd, padY = dstBeg * e.stride < e.pad ? e.pad - dstBeg * e.stride : 0;
+                SrcRows(dstBeg, dstEnd, srcBeg, srcEnd);
+                if (e.type == SimdConvolutionEpiloguePoolingMax)
+                    _funcs.poolingMax(src, _C, srcEnd - srcBeg, _W, 1, e.kernel, e.kernel, 1, e.stride, e.stride, 
+                        0, padY, e.pad, dst, _C, dstEnd - dstBeg, DstW(), SimdTensorFormatNhwc);
+                else
+                    _funcs.poolingAverage(src, _C, srcEnd - srcBeg, _W, e.kernel, e.kernel, e.stride, e.stride, 
+                        padY, e.pad, dst, dstEnd - dstBeg, DstW(), SimdTrue, SimdTensorFormatNhwc);
+            }
+        }
+
+    private:
+        SimdConvolutionEpilogue _epilogue;
+        SimdConvolutionActivationType _activation;
+        Funcs _funcs;
+        size_t _C, _H, _W;
+        Array32f _params;
+    };
+}
+
+#endif//__SimdSynetConvolutionEpilogue_h__
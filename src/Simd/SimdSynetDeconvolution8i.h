@@ -0,0 +1,267 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetDeconvolution8i_h__
+#define __SimdSynetDeconvolution8i_h__
+
+#include "Simd/SimdSynetConvolution8i.h"
+
+namespace Simd
+{
+    struct DeconvParam8i : public SimdConvolutionParameters
+    {
+        size_t batch;
+        SimdSynetCompatibilityType compatibility;
+
+        DeconvParam8i(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
+        {
+            *((SimdConvolutionParameters*)this) = *conv;
+            this->batch = batch;
+            this->compatibility = compatibility;
+        }
+
+        bool Valid()
+        {
+            return
+                dstH == strideY * (srcH - 1) + dilationY * (kernelY - 1) + 1 - padY - padH && dstH > 0 &&
+                dstW == strideX * (srcW - 1) + dilationX * (kernelX - 1) + 1 - padX - padW && dstW > 0 &&
+                (srcT == SimdTensorData32f || srcT == SimdTensorData8u) && (dstT == SimdTensorData32f || dstT == SimdTensorData8u) &&
+                srcF == SimdTensorFormatNhwc && dstF == SimdTensorFormatNhwc && srcC % group == 0 && dstC % group == 0;
+        }
+
+        SIMD_INLINE bool IsPad(size_t value) const
+        {
+            return padY == value && padX == value && padH == value && padW == value;
+        }
+
+        SIMD_INLINE bool IsDilation(size_t value) const
+        {
+            return dilationY == value && dilationX == value;
+        }
+
+        SIMD_INLINE bool IsDepthwise() const
+        {
+            return srcC == group && dstC == group;
+        }
+
+        SIMD_INLINE bool IsTiled() const
+        {
+            return IsPad(0) && IsDilation(1) && kernelY == strideY && kernelX == strideX;
+        }
+
+#ifdef SIMD_PERFORMANCE_STATISTIC
+        String Info() const
+        {
+            std::stringstream ss;
+            ss << batch << "x" << srcC << "x" << srcH << "x" << srcW;
+            ss << "-" << dstC << "x" << kernelY << "x" << kernelX;
+            ss << "-" << strideX << "-" << Simd::Max(padX, padW) << "-" << group;
+            ss << "-" << (srcT == SimdTensorData8u ? "u" : "f") << (dstT == SimdTensorData8u ? "u" : "f");
+            return ss.str();
+        }
+
+        int64_t Flop() const
+        {
+            return int64_t(batch) * kernelY * kernelX * srcC * srcH * srcW * dstC / group * 2;
+        }
+#endif
+    };
+
+    class SynetDeconvolution8i : public Deletable
+    {
+    public:
+        SynetDeconvolution8i(const DeconvParam8i& p);
+
+        const DeconvParam8i & Param() const { return _param; }
+
+        virtual String Ext() const = 0;
+        virtual String Desc() const = 0;
+
+        virtual size_t ExternalBufferSize() const;
+        virtual size_t InternalBufferSize() const;
+
+        virtual void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats);
+
+        virtual void Forward(const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        Base::PerformanceMeasurer* Perf(const char* func);
+#endif
+
+        const char* Info() const
+        {
+            _info = Desc();
+            return _info.c_str();
+        }
+
+    protected:
+        virtual void Forward8u(const uint8_t* src, uint8_t* buf, float* dst) = 0;
+
+        typedef void(*Convert32fTo8u)(const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility);
+        typedef void(*BiasAndActivation)(const float* bias, size_t count, size_t size, ::SimdConvolutionActivationType activation, const float* params, SimdBool trans, float* dst);
+
+        DeconvParam8i _param;
+        Array8u _buffer;
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        Base::PerformanceMeasurer * _perf;
+#endif
+        mutable String _info;
+        Convert32fTo8u _convertSrc, _convertDst;
+        BiasAndActivation _biasAndActivation;
+        CvtParam _srcCvt, _dstCvt;
+        Array32f _bias, _params;
+        bool _src8u, _dst8u;
+        size_t _sizeS, _sizeD;
+    };
+
+    namespace Base
+    {
+        class SynetDeconvolution8iGemm : public SynetDeconvolution8i
+        {
+        public:
+            typedef void* (*ConvolutionInitPtr)(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
+            typedef void(*RowToImgPtr)(const float* src, const DeconvParam8i& p, float* dst);
+
+            SynetDeconvolution8iGemm(const DeconvParam8i& p, ConvolutionInitPtr init = SynetConvolution8iInit);
+            virtual ~SynetDeconvolution8iGemm();
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const;
+            virtual size_t ExternalBufferSize() const;
+            virtual size_t InternalBufferSize() const;
+            virtual void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats);
+
+            static bool Preferable(const DeconvParam8i& p);
+
+        protected:
+            virtual void Forward8u(const uint8_t* src, uint8_t* buf, float* dst);
+
+            SynetConvolution8i* _convolution;
+            RowToImgPtr _rowToImg;
+            Array32f _stats;
+            size_t _sizeB;
+        };
+
+        class SynetDeconvolution8iNhwcDirect : public SynetDeconvolution8i
+        {
+        public:
+            SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p);
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const;
+            virtual size_t ExternalBufferSize() const;
+            virtual size_t InternalBufferSize() const;
+            virtual void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats);
+
+            static bool Preferable(const DeconvParam8i& p);
+
+            typedef void(*DeconvolutionPtr)(const uint8_t* src, const DeconvParam8i& p, const uint8_t* zero, const int8_t* weight, int32_t* dst);
+
+        protected:
+            virtual void Forward8u(const uint8_t* src, uint8_t* buf, float* dst);
+
+            Array8i _weight;
+            Array32f _norm;
+            DeconvolutionPtr _deconvolution;
+        };
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+    }
+
+#ifdef SIMD_SSE41_ENABLE    
+    namespace Sse41
+    {
+        class SynetDeconvolution8iGemm : public Base::SynetDeconvolution8iGemm
+        {
+        public:
+            SynetDeconvolution8iGemm(const DeconvParam8i& p);
+            virtual String Ext() const { return "Sse41"; }
+        };
+
+        class SynetDeconvolution8iNhwcDirect : public Base::SynetDeconvolution8iNhwcDirect
+        {
+        public:
+            SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p);
+            virtual String Ext() const { return "Sse41"; }
+        };
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        class SynetDeconvolution8iGemm : public Base::SynetDeconvolution8iGemm
+        {
+        public:
+            SynetDeconvolution8iGemm(const DeconvParam8i& p);
+            virtual String Ext() const { return "Avx2"; }
+        };
+
+        class SynetDeconvolution8iNhwcDirect : public Sse41::SynetDeconvolution8iNhwcDirect
+        {
+        public:
+            SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p);
+            virtual String Ext() const { return "Avx2"; }
+        };
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE    
+    namespace Avx512bw
+    {
+        class SynetDeconvolution8iGemm : public Base::SynetDeconvolution8iGemm
+        {
+        public:
+            SynetDeconvolution8iGemm(const DeconvParam8i& p, ConvolutionInitPtr init = Avx512bw::SynetConvolution8iInit);
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
+        class SynetDeconvolution8iNhwcDirect : public Avx2::SynetDeconvolution8iNhwcDirect
+        {
+        public:
+            SynetDeconvolution8iNhwcDirect(const DeconvParam8i& p);
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX512VNNI_ENABLE    
+    namespace Avx512vnni
+    {
+        class SynetDeconvolution8iGemm : public Avx512bw::SynetDeconvolution8iGemm
+        {
+        public:
+            SynetDeconvolution8iGemm(const DeconvParam8i& p);
+            virtual String Ext() const { return "Avx512vnni"; }
+        };
+
+        void * SynetDeconvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+}
+
+#endif//__SimdSynetDeconvolution8i_h__
@@ -0,0 +1,95 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2020 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetImageToTensor_h__
+#define __SimdSynetImageToTensor_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdResizer.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        struct ImageToTensorParam
+        {
+            size_t srcW, srcH, dstW, dstH, channels;
+            SimdPixelFormatType srcFormat;
+            SimdYuvType yuvType;
+            SimdResizeMethodType method;
+            SimdTensorFormatType dstFormat;
+            SimdTensorDataType dstType;
+
+            ImageToTensorParam(size_t sw, size_t sh, SimdPixelFormatType sf, SimdYuvType yt, size_t dw, size_t dh, SimdResizeMethodType rm, size_t ch, SimdTensorFormatType df, SimdTensorDataType dt)
+                : srcW(sw), srcH(sh), dstW(dw), dstH(dh), channels(ch), srcFormat(sf), yuvType(yt), method(rm), dstFormat(df), dstType(dt)
+            {
+            }
+
+            bool Valid() const;
+
+            SIMD_INLINE bool IsYuv() const
+            {
+                return yuvType != SimdYuvUnknown;
+            }
+
+            size_t Planes() const;
+
+            size_t PlaneChannels(size_t plane) const;
+        };
+
+        typedef void(*SynetSetInputPtr)(const uint8_t* src, size_t width, size_t height, size_t stride, SimdPixelFormatType srcFormat,
+            const float* lower, const float* upper, float* dst, size_t channels, SimdTensorFormatType dstFormat);
+
+        class SynetImageToTensor : public Deletable
+        {
+        public:
+            typedef void(*ToPixelsPtr)(const uint8_t* const* src, size_t width, uint8_t* dst);
+            typedef void(*ToTensorPtr)(const uint8_t* src, size_t width, size_t height, size_t channels, size_t align, size_t y, const float* scale, const float* shift, uint8_t* dst);
+
+            SynetImageToTensor(const ImageToTensorParam& param, const float* mean, const float* std, ResizerInitPtr resizerInit, SynetSetInputPtr setInput);
+            virtual ~SynetImageToTensor();
+
+            bool Valid() const;
+
+            void Forward(const uint8_t* const* src, const size_t* stride, uint8_t* dst);
+
+        protected:
+            void SetConverters();
+            void SetInput(size_t thread, size_t yBeg, size_t yEnd, uint8_t* dst);
+
+            ImageToTensorParam _param;
+            ToPixelsPtr _toPixels;
+            ToTensorPtr _toTensor;
+            SynetSetInputPtr _setInput;
+            size_t _planes, _threads, _band, _align, _stride[3];
+            std::vector<Resizer*> _resizers;
+            Array8u _buffer[3], _pixels;
+            Array32f _scale, _shift, _lower, _upper, _tensor;
+        };
+
+        void* SynetImageToTensorInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method,
+            const float* mean, const float* std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType, ResizerInitPtr resizerInit, SynetSetInputPtr setInput);
+    }
+}
+
+#endif
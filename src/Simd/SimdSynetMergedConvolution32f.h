@@ -28,6 +28,8 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdBase.h"
 
 #ifdef _N
 #undef _N
@@ -35,6 +37,18 @@
 
 namespace Simd
 {
+    SIMD_INLINE size_t SrcRowBeg(const ConvParam32f& p, size_t dstRow)
+    {
+        return Simd::Max<ptrdiff_t>(ptrdiff_t(dstRow * p.strideY) - ptrdiff_t(p.padY), 0);
+    }
+
+    SIMD_INLINE size_t SrcRowEnd(const ConvParam32f& p, size_t dstRow)
+    {
+        return Simd::Min((dstRow - 1) * p.strideY + p.kernelY - p.padY, p.srcH);
+    }
+
+    //---------------------------------------------------------------------------------------------
+
     struct MergConvParam32f
     {
         SimdBool add;
@@ -143,6 +157,7 @@ namespace Simd
     public:
         SynetMergedConvolution32f(const MergConvParam32f& p)
             : _param(p)
+            , _threads(1)
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
             , _perf(NULL)
 #endif
@@ -184,6 +199,16 @@ namespace Simd
     protected:
         MergConvParam32f _param;
         Array32f _buffer;
+        size_t _threads;
+
+        void SetThreads(size_t dstH)
+        {
+            int64_t flop = 0;
+            for (size_t i = 0; i < _param.count; ++i)
+                flop += _param.conv[i].Flop();
+            int64_t limit = Simd::Max<int64_t>(flop / _param.conv[0].batch / SYNET_THREAD_FLOP_MIN, 1);
+            _threads = Simd::Min<size_t>(Simd::Min<size_t>(Base::GetThreadNumber(), dstH), size_t(limit));
+        }
 
         float* Buffer(float* buffer)
         {
@@ -315,6 +340,7 @@ namespace Simd
             void SetOutputWeight(const float* src, const ConvParam32f& p);
             void SetBias(const float* src, const ConvParam32f& p, Array32f & dst);
             void SetParams(const float* src, const ConvParam32f& p, Array32f& dst);
+            size_t ThreadBufferSize() const;
 
             bool _dw0, _1x1;
             ConvertPtr _convert;
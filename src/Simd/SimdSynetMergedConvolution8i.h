@@ -112,6 +112,7 @@ namespace Simd
             ss << "-" << (conv[0].srcT == SimdTensorData32f ? "f" : "u") << (conv[count - 1].dstT == SimdTensorData32f ? "f" : "u");
             return ss.str();
         }
+#endif
 
         int64_t Flop() const
         {
@@ -120,7 +121,6 @@ namespace Simd
                 flop += conv[i].Flop();
             return flop;
         }
-#endif
     };
 
     class SynetMergedConvolution8i : public Deletable
@@ -191,6 +191,7 @@ namespace Simd
 
         protected:
             uint8_t* GetBuffer(uint8_t* buffer);
+            void SetThreads(size_t dstH);
             void Quantize(const float* weight, const float* bias, size_t i, size_t q);
             void ReorderInputWeight(const ConvParam8i& p, Array8i & weight);
             void ReorderDepthwiseWeight(const ConvParam8i& p, Array32f & weight);
@@ -199,7 +200,7 @@ namespace Simd
 
             MergConvParam8i _param;
             bool _s8u, _d8u, _dw0, _1x1;
-            size_t _sizeS, _sizeD, _sizeI[2], _sizeB[5];
+            size_t _sizeS, _sizeD, _sizeI[2], _sizeB[5], _threads;
             CvtParam _cvt[3];
             Array8u _buffer;
             Array8i _weight8i[2];
@@ -540,7 +540,7 @@ namespace Simd
 
             \param [in] path - a path to image file.
             \param [in] format - a desired format of loaded image.
-                Supported values are View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 and View::None.
+                Supported values are View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32, View::Int16 (16-bit PGM and PNG files), View::Float (PFM files) and View::None.
                 Default value is View::None (loads image in native pixel format of image file).
             \return - a result of loading.
         */
@@ -556,7 +556,7 @@ namespace Simd
             \param [in] src - a pointer to memory buffer.
             \param [in] size - a buffer size.
             \param [in] format - a desired format of loaded image.
-                Supported values are View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 and View::None.
+                Supported values are View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32, View::Int16 (16-bit PGM and PNG files), View::Float (PFM files) and View::None.
                 Default value is View::None (loads image in native pixel format of image file).
             \return - a result of loading.
         */
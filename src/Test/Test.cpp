@@ -209,11 +209,20 @@ namespace Test
 
     TEST_ADD_GROUP_A0(Gemm32fNN);
     TEST_ADD_GROUP_A0(Gemm32fNT);
+    TEST_ADD_GROUP_A0(RuntimeDatabase);
 
     TEST_ADD_GROUP_A0(ImageSaveToMemory);
+    TEST_ADD_GROUP_A0(ImageSaveToMemoryJpegThreads);
     TEST_ADD_GROUP_A0(Nv12SaveAsJpegToMemory);
     TEST_ADD_GROUP_A0(Yuv420pSaveAsJpegToMemory);
     TEST_ADD_GROUP_AS(ImageLoadFromMemory);
+    TEST_ADD_GROUP_A0(ImageLoadFromFile);
+    TEST_ADD_GROUP_A0(ImageLoadFromMemoryScaled);
+    TEST_ADD_GROUP_A0(ImageLoadFromMemoryFourComponentJpeg);
+    TEST_ADD_GROUP_A0(ImagePngDecodeLine);
+    TEST_ADD_GROUP_A0(Yuv420pLoadFromJpegMemory);
+    TEST_ADD_GROUP_A0(ImageDecoderDecode);
+    TEST_ADD_GROUP_A0(ImageDecoderDecodeBatch);
 
     TEST_ADD_GROUP_A0(MeanFilter3x3);
     TEST_ADD_GROUP_A0(MedianFilterRhomb3x3);
@@ -306,6 +315,8 @@ namespace Test
     TEST_ADD_GROUP_A0(OperationBinary16i);
     TEST_ADD_GROUP_A0(VectorProduct);
 
+    TEST_ADD_GROUP_A0(ParallelFor);
+
     TEST_ADD_GROUP_A0(ReduceColor2x2);
     TEST_ADD_GROUP_A0(ReduceGray2x2);
     TEST_ADD_GROUP_A0(ReduceGray3x3);
@@ -318,6 +329,8 @@ namespace Test
 
     TEST_ADD_GROUP_AS(ResizeBilinear);
     TEST_ADD_GROUP_A0(Resizer);
+    TEST_ADD_GROUP_A0(ResizerBands);
+    TEST_ADD_GROUP_A0(ResizerCropBatch);
     TEST_ADD_GROUP_0S(ResizeYuv420p);
 
     TEST_ADD_GROUP_A0(SegmentationShrinkRegion);
@@ -352,6 +365,7 @@ namespace Test
 #if defined(SIMD_SYNET_ENABLE)
     TEST_ADD_GROUP_A0(SynetAddBias);
     TEST_ADD_GROUP_A0(SynetAdd8i);
+    TEST_ADD_GROUP_A0(SynetArenaPlan);
     TEST_ADD_GROUP_A0(SynetEltwiseLayerForward);
     TEST_ADD_GROUP_A0(SynetLrnLayerCrossChannels);
     TEST_ADD_GROUP_A0(SynetShuffleLayerForward);
@@ -373,14 +387,22 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetConvert32fTo8u);
     TEST_ADD_GROUP_A0(SynetConvert8uTo32f);
     TEST_ADD_GROUP_A0(SynetSetInput);
+    TEST_ADD_GROUP_A0(SynetImageToTensor);
     TEST_ADD_GROUP_A0(SynetReorderImage);
     TEST_ADD_GROUP_A0(SynetReorderFilter);
 
     TEST_ADD_GROUP_A0(SynetConvolution8iForward);
+    TEST_ADD_GROUP_A0(SynetConvolution8iEpilogue);
+    TEST_ADD_GROUP_A0(SynetConvolution8iRowBands);
 
     TEST_ADD_GROUP_A0(SynetConvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetConvolution32fBatchForward);
+    TEST_ADD_GROUP_A0(SynetConvolution32fEpilogue);
+    TEST_ADD_GROUP_A0(SynetConvolution32fShared);
+    TEST_ADD_GROUP_A0(SynetConvolution32fThreads);
 
     TEST_ADD_GROUP_A0(SynetDeconvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetDeconvolution8iForward);
 
     TEST_ADD_GROUP_A0(SynetFusedLayerForward0);
     TEST_ADD_GROUP_A0(SynetFusedLayerForward1);
@@ -397,6 +419,7 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetMergedConvolution8iForward);
 
     TEST_ADD_GROUP_A0(SynetMergedConvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetMergedConvolution32fThreads);
 
     TEST_ADD_GROUP_A0(SynetPoolingAverage);
     TEST_ADD_GROUP_A0(SynetPoolingMax32f);
@@ -26,6 +26,8 @@
 #include "Test/TestTensor.h"
 #include "Test/TestRandom.h"
 
+#include "Simd/SimdRuntime.h"
+
 namespace Test
 {
     namespace
@@ -291,4 +293,102 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        String RuntimeDatabaseExport()
+        {
+            String data(::SimdRuntimeDatabaseExport(NULL, 0), 0);
+            ::SimdRuntimeDatabaseExport(&data[0], data.size());
+            data.resize(data.size() - 1);
+            return data;
+        }
+
+        String RuntimeDatabaseRecord(const String & data, const String & key)
+        {
+            size_t beg = data.find(key);
+            if (beg == String::npos)
+                return String();
+            beg = data.rfind('\n', beg);
+            beg = beg == String::npos ? 0 : beg + 1;
+            return data.substr(beg, data.find('\n', beg) - beg);
+        }
+    }
+
+    bool RuntimeDatabaseAutoTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdRuntimeDatabase export/import.");
+
+        const size_t M = 7, N = 13, K = 11;
+        Tensor32f A({ M, K }), B({ K, N }), C({ M, N });
+        FillRandom(A.Data(), A.Size(), -1.0, 1.0f);
+        FillRandom(B.Data(), B.Size(), -1.0, 1.0f);
+        const float alpha = 1.0f, beta = 0.0f;
+        Simd::GemmArgs args(M, N, K, &alpha, A.Data(), K, B.Data(), N, &beta, C.Data(), N);
+        const String names[2] = { "Gemm32fNN-0", "Gemm32fNN-1" };
+        Simd::GemmFuncs funcs = Simd::InitGemmFuncs(Simd::Base::Gemm32fNN, names[0], Simd::Base::Gemm32fNN, names[1]);
+
+        Simd::RuntimeGemm tuned;
+        tuned.Init(funcs);
+        {
+            TEST_PERFORMANCE_TEST("SimdRuntimeDatabase");
+            for (size_t i = 0; i < 16; ++i)
+                tuned.Run(args);
+        }
+
+        String data = RuntimeDatabaseExport();
+        std::stringstream key;
+        key << "Gemm [" << M << ", " << N << ", " << K << "] threads=" << ::SimdGetThreadNumber() << " : " << names[0] << "," << names[1];
+        String record = RuntimeDatabaseRecord(data, key.str());
+        if (record.empty() || record.substr(record.rfind('\t') + 1) != tuned.Selected().Name())
+        {
+            TEST_LOG_SS(Error, "Exported database has no valid record for '" << key.str() << "'!");
+            return false;
+        }
+
+        String path = "runtime_database.txt";
+        if (!::SimdRuntimeDatabaseSave(path.c_str()) || !::SimdRuntimeDatabaseLoad(path.c_str()) || RuntimeDatabaseExport() != data)
+        {
+            TEST_LOG_SS(Error, "Database is changed after save/load round trip!");
+            result = false;
+        }
+        ::remove(path.c_str());
+
+        String other = tuned.Selected().Name() == names[0] ? names[1] : names[0];
+        String imported = record.substr(0, record.rfind('\t') + 1) + other + "\n";
+        if (!::SimdRuntimeDatabaseImport(imported.c_str()) || RuntimeDatabaseRecord(RuntimeDatabaseExport(), key.str()) + "\n" != imported)
+        {
+            TEST_LOG_SS(Error, "Can't import record '" << imported << "'!");
+            return false;
+        }
+
+        Simd::RuntimeGemm loaded;
+        loaded.Init(funcs);
+        loaded.Run(args);
+        if (loaded.Selected().Name() != other)
+        {
+            TEST_LOG_SS(Error, "Imported record is not used: " << loaded.Selected().Name() << " instead of " << other << "!");
+            result = false;
+        }
+
+        if (::SimdRuntimeDatabaseImport("invalid record\n"))
+        {
+            TEST_LOG_SS(Error, "Invalid record is imported!");
+            result = false;
+        }
+
+        data = RuntimeDatabaseExport();
+        String partial = record.substr(0, record.rfind('\t') + 1) + tuned.Selected().Name() + "\ninvalid record\n";
+        if (::SimdRuntimeDatabaseImport(partial.c_str()) || RuntimeDatabaseExport() != data)
+        {
+            TEST_LOG_SS(Error, "Database is changed by failed import!");
+            result = false;
+        }
+
+        return result;
+    }
 }
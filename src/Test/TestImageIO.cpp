@@ -42,15 +42,22 @@ namespace Test
     {
         bool result = true;
         String path;
-        if (REAL_IMAGE.empty())
+        if (REAL_IMAGE.empty() || format == View::Int16 || format == View::Float)
         {
             TEST_LOG_SS(Info, "Test " << desc1 << " & " << desc2 << " [" << width << ", " << height << "].");
             image.Recreate(width, height, format, NULL, TEST_ALIGN(width));
 #if 1
             ::srand(0);
-            View buffer(image.Size(), image.format);
-            FillRandom(buffer);
-            Simd::MeanFilter3x3(buffer, image);
+            if (format == View::Int16)
+                FillRandom16u(image);
+            else if (format == View::Float)
+                FillRandom32f(image, -4096.0f, 4096.0f);
+            else
+            {
+                View buffer(image.Size(), image.format);
+                FillRandom(buffer);
+                Simd::MeanFilter3x3(buffer, image);
+            }
 #else
             CreateTestImage(image, 10, 10);
 #endif
@@ -91,6 +98,8 @@ namespace Test
             ss << suffix << ".png";
         if (file == SimdImageFileJpeg)
             ss << "_" << ToString(quality) << suffix << ".jpg";
+        if (file == SimdImageFilePfm)
+            ss << suffix << ".pfm";
         const String dir = "_out";
         String path = MakePath(dir, ss.str());
         return CreatePathIfNotExist(dir, false) && image.Save(path, file, quality);
@@ -112,7 +121,7 @@ namespace Test
             void Update(View::Format format, SimdImageFileType file, int quality)
             {
                 desc = desc + "[" + ToString(format) + "-" + ToString(file) + 
-                    (file == SimdImageFileJpeg ? String("-") + ToString(quality) : String("")) + "]";
+                    (file == SimdImageFileJpeg || file == SimdImageFilePng ? String("-") + ToString(quality) : String("")) + "]";
             }
 
             void Call(const View& src, SimdImageFileType file, int quality, uint8_t** data, size_t* size) const
@@ -167,6 +176,21 @@ namespace Test
         else
             result = result && Compare(data1, size1, data2, size2, 0, true, 64);
 
+        if (file == SimdImageFilePng && result)
+        {
+            View dst1, dst2;
+            if (dst1.Load(data1, size1, format) && dst2.Load(data2, size2, format))
+            {
+                result = result && Compare(src, dst1, 0, true, 64, 0, "src & dst1");
+                result = result && Compare(src, dst2, 0, true, 64, 0, "src & dst2");
+            }
+            else
+            {
+                TEST_LOG_SS(Error, "Can't load PNG images from memory!");
+                result = false;
+            }
+        }
+
         if (data1)
             Simd::Free(data1);
         if (data2)
@@ -196,8 +220,13 @@ namespace Test
         std::vector<View::Format> formats({ View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32});
         for (int format = 0; format < formats.size(); format++)
         {
-            for (int file = (int)SimdImageFileJpeg; file <= (int)SimdImageFileJpeg; file++)
+            for (int file = (int)SimdImageFilePng; file <= (int)SimdImageFileJpeg; file++)
             {
+                if (file == SimdImageFilePng)
+                {
+                    result = result && ImageSaveToMemoryAutoTest(formats[format], (SimdImageFileType)file, 10, f1, f2);
+                    result = result && ImageSaveToMemoryAutoTest(formats[format], (SimdImageFileType)file, 30, f1, f2);
+                }
                 if (file == SimdImageFileJpeg)
                 {
                     result = result && ImageSaveToMemoryAutoTest(formats[format], (SimdImageFileType)file, 100, f1, f2);
@@ -208,6 +237,16 @@ namespace Test
                 result = result && ImageSaveToMemoryAutoTest(formats[format], (SimdImageFileType)file, 65, f1, f2);
             }
         }
+        result = result && ImageSaveToMemoryAutoTest(View::Int16, SimdImageFilePgmBin, 65, f1, f2);
+        result = result && ImageSaveToMemoryAutoTest(View::Int16, SimdImageFilePng, 10, f1, f2);
+        result = result && ImageSaveToMemoryAutoTest(View::Int16, SimdImageFilePng, 65, f1, f2);
+        result = result && ImageSaveToMemoryAutoTest(View::Float, SimdImageFilePfm, 65, f1, f2);
+
+        size_t threads = ::SimdGetThreadNumber();
+        ::SimdSetThreadNumber(4);
+        for (int quality = 10; quality <= 70; quality += 30)
+            result = result && ImageSaveToMemoryAutoTest(512, 384, View::Bgr24, SimdImageFilePng, quality, f1, f2);
+        ::SimdSetThreadNumber(threads);
 
         return result;
     }
@@ -243,6 +282,119 @@ namespace Test
 
     //-----------------------------------------------------------------------
 
+    static bool JpegHasMarker(const uint8_t* data, size_t size, uint8_t marker)
+    {
+        for (size_t i = 1; i < size; ++i)
+            if (data[i - 1] == 0xFF && data[i] == marker)
+                return true;
+        return false;
+    }
+
+    bool ImageSaveToMemoryJpegThreadsAutoTest(size_t width, size_t height, View::Format format, int quality, size_t threads, FuncSM f)
+    {
+        bool result = true;
+
+        f.Update(format, SimdImageFileJpeg, quality);
+        f.desc = f.desc + "-t" + ToString(threads);
+
+        View src;
+        if (!GetTestImage(src, width, height, format, f.desc, "1 thread", SimdImageFileJpeg, quality, NULL, NULL))
+            return false;
+
+        uint8_t* data1 = NULL, * data2 = NULL;
+        size_t size1 = 0, size2 = 0;
+
+        size_t threadNumber = ::SimdGetThreadNumber();
+        ::SimdSetThreadNumber(1);
+        f.Call(src, SimdImageFileJpeg, quality, &data1, &size1);
+        ::SimdSetThreadNumber(threads);
+        bool restart = ::SimdGetThreadNumber() > 1 && height > 16;
+        f.Call(src, SimdImageFileJpeg, quality, &data2, &size2);
+        ::SimdSetThreadNumber(threadNumber);
+
+        if (data1 == NULL || data2 == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't save JPEG image to memory!");
+            result = false;
+        }
+        else if (JpegHasMarker(data1, size1, 0xDD))
+        {
+            TEST_LOG_SS(Error, "Unexpected restart interval in JPEG image saved in 1 thread!");
+            result = false;
+        }
+        else if (restart && !(JpegHasMarker(data2, size2, 0xDD) && JpegHasMarker(data2, size2, 0xD0)))
+        {
+            TEST_LOG_SS(Error, "There are no restart markers in JPEG image saved in " << threads << " threads!");
+            result = false;
+        }
+        else
+        {
+            View dst1, dst2;
+            if (dst1.Load(data1, size1, format) && dst2.Load(data2, size2, format))
+                result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+            else
+            {
+                TEST_LOG_SS(Error, "Can't load images from memory!");
+                result = false;
+            }
+        }
+
+        if (data1)
+            SimdFree(data1);
+        if (data2)
+            SimdFree(data2);
+
+        return result;
+    }
+
+    bool ImageSaveToMemoryJpegThreadsAutoTest(const FuncSM& f)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats({ View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 });
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (size_t threads = 2; threads <= 8; threads *= 2)
+            {
+                result = result && ImageSaveToMemoryJpegThreadsAutoTest(W, H, formats[format], 95, threads, f);
+                result = result && ImageSaveToMemoryJpegThreadsAutoTest(W + O, H - O, formats[format], 65, threads, f);
+            }
+        }
+
+        return result;
+    }
+
+    bool ImageSaveToMemoryJpegThreadsAutoTest()
+    {
+        bool result = true;
+
+        result = result && ImageSaveToMemoryJpegThreadsAutoTest(FUNC_SM(Simd::Base::ImageSaveToMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageSaveToMemoryJpegThreadsAutoTest(FUNC_SM(Simd::Sse41::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImageSaveToMemoryJpegThreadsAutoTest(FUNC_SM(Simd::Avx2::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImageSaveToMemoryJpegThreadsAutoTest(FUNC_SM(Simd::Avx512bw::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && ImageSaveToMemoryJpegThreadsAutoTest(FUNC_SM(Simd::Neon::ImageSaveToMemory));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
     namespace
     {
         struct FuncSNJM
@@ -565,6 +717,8 @@ namespace Test
 
     bool SaveLoadCompatible(View::Format format, SimdImageFileType file, int quality)
     {
+        if (format == View::Int16 || format == View::Float)
+            return true;
         if (file == SimdImageFilePgmTxt || file == SimdImageFilePgmBin)
             return format == View::Gray8;
         if (file == SimdImageFilePpmTxt || file == SimdImageFilePpmBin)
@@ -638,7 +792,7 @@ namespace Test
         std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
         for (size_t format = 0; format < formats.size(); format++)
         {
-            for (int file = (int)SimdImageFilePng; file <= (int)SimdImageFilePng; file++)
+            for (int file = (int)SimdImageFilePng; file <= (int)SimdImageFileJpeg; file++)
             {
                 if (file == SimdImageFileJpeg)
                 {
@@ -649,6 +803,9 @@ namespace Test
                 result = result && ImageLoadFromMemoryAutoTest(formats[format], (SimdImageFileType)file, 65, f1, f2);
             }
         }
+        result = result && ImageLoadFromMemoryAutoTest(View::Int16, SimdImageFilePgmBin, 65, f1, f2);
+        result = result && ImageLoadFromMemoryAutoTest(View::Int16, SimdImageFilePng, 65, f1, f2);
+        result = result && ImageLoadFromMemoryAutoTest(View::Float, SimdImageFilePfm, 65, f1, f2);
 
         return result;
     }
@@ -664,15 +821,15 @@ namespace Test
             result = result && ImageLoadFromMemoryAutoTest(FUNC_LM(Simd::Sse41::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
 #endif 
 
-//#ifdef SIMD_AVX2_ENABLE
-//        if (Simd::Avx2::Enable)
-//            result = result && ImageLoadFromMemoryAutoTest(FUNC_LM(Simd::Avx2::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
-//#endif 
-//
-//#ifdef SIMD_AVX512BW_ENABLE
-//        if (Simd::Avx512bw::Enable)
-//            result = result && ImageLoadFromMemoryAutoTest(FUNC_LM(Simd::Avx512bw::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
-//#endif 
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImageLoadFromMemoryAutoTest(FUNC_LM(Simd::Avx2::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImageLoadFromMemoryAutoTest(FUNC_LM(Simd::Avx512bw::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+#endif 
 
 #ifdef SIMD_NEON_ENABLE
         if (Simd::Neon::Enable)
@@ -684,6 +841,1004 @@ namespace Test
 
     //-----------------------------------------------------------------------
 
+    bool ImageLoadFromFileAutoTest(size_t width, size_t height, View::Format format, SimdImageFileType file, int quality)
+    {
+        bool result = true;
+
+        String desc = String("SimdImageLoadFromFile[") + ToString(format) + "-" + ToString(file) + "]";
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, desc, "SimdImageLoadFromMemory", file, quality, &data, &size))
+            return false;
+
+        const String dir = "_out";
+        String path = MakePath(dir, "load_from_file." + ToExtension(file));
+        if (!CreatePathIfNotExist(dir, false) || !FileSave(data, size, path.c_str()))
+        {
+            TEST_LOG_SS(Error, "Can't save image to '" << path << "'!");
+            SimdFree(data);
+            return false;
+        }
+
+        View dst1, dst2;
+        ((View::Format&)dst1.format) = format;
+        ((View::Format&)dst2.format) = format;
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            *(uint8_t**)&dst1.data = SimdImageLoadFromFile(path.c_str(), (size_t*)&dst1.stride, (size_t*)&dst1.width, (size_t*)&dst1.height, (SimdPixelFormatType*)&dst1.format);
+        }
+        *(uint8_t**)&dst2.data = SimdImageLoadFromMemory(data, size, (size_t*)&dst2.stride, (size_t*)&dst2.width, (size_t*)&dst2.height, (SimdPixelFormatType*)&dst2.format);
+
+        if (dst1.data == NULL || dst2.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't load image from '" << path << "'!");
+            result = false;
+        }
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+
+        if (dst1.data)
+            SimdFree(dst1.data);
+        if (dst2.data)
+            SimdFree(dst2.data);
+        SimdFree(data);
+        ::remove(path.c_str());
+
+        return result;
+    }
+
+    bool ImageLoadFromFileAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageLoadFromFileAutoTest(W, H, formats[format], SimdImageFilePpmBin, 65);
+            result = result && ImageLoadFromFileAutoTest(W, H, formats[format], SimdImageFilePng, 65);
+            result = result && ImageLoadFromFileAutoTest(W + O, H - O, formats[format], SimdImageFileJpeg, 95);
+            result = result && ImageLoadFromFileAutoTest(W / 8, H / 8, formats[format], SimdImageFilePng, 65);
+            result = result && ImageLoadFromFileAutoTest(W / 8 + O, H / 8 - O, formats[format], SimdImageFileJpeg, 95);
+        }
+
+        const String dir = "_out", path = MakePath(dir, "load_from_file_empty.png");
+        if (CreatePathIfNotExist(dir, false) && FileSave(NULL, 0, path.c_str()))
+        {
+            size_t stride = 0, width = 0, height = 0;
+            SimdPixelFormatType format = SimdPixelFormatBgr24;
+            uint8_t* empty = SimdImageLoadFromFile(path.c_str(), &stride, &width, &height, &format);
+            uint8_t* missing = SimdImageLoadFromFile(MakePath(dir, "load_from_file_missing.png").c_str(), &stride, &width, &height, &format);
+            if (empty || missing)
+            {
+                TEST_LOG_SS(Error, "SimdImageLoadFromFile returns image for empty or missing file!");
+                result = false;
+            }
+            SimdFree(empty);
+            SimdFree(missing);
+            ::remove(path.c_str());
+        }
+        else
+        {
+            TEST_LOG_SS(Error, "Can't create empty file '" << path << "'!");
+            result = false;
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct JpegBitWriter
+        {
+            JpegBitWriter(std::vector<uint8_t>& data) : _data(data), _buffer(0), _count(0) {}
+
+            void Write(uint32_t bits, int size)
+            {
+                for (int i = size - 1; i >= 0; --i)
+                {
+                    _buffer = (_buffer << 1) | ((bits >> i) & 1);
+                    if (++_count == 8)
+                    {
+                        _data.push_back(uint8_t(_buffer));
+                        if (_data.back() == 0xFF)
+                            _data.push_back(0x00);
+                        _buffer = 0, _count = 0;
+                    }
+                }
+            }
+
+            void Flush()
+            {
+                while (_count)
+                    Write(1, 1);
+            }
+
+        private:
+            std::vector<uint8_t>& _data;
+            uint32_t _buffer;
+            int _count;
+        };
+
+        void JpegPutSegment(std::vector<uint8_t>& jpeg, uint8_t marker, const std::vector<uint8_t>& payload)
+        {
+            size_t size = payload.size() + 2;
+            jpeg.push_back(0xFF);
+            jpeg.push_back(marker);
+            jpeg.push_back(uint8_t(size >> 8));
+            jpeg.push_back(uint8_t(size));
+            jpeg.insert(jpeg.end(), payload.begin(), payload.end());
+        }
+
+        // Creates baseline JPEG with 4 components (without subsampling) where each 8x8 block has constant value. 
+        // Negative transform means absence of Adobe APP14 segment.
+        void CreateFourComponentJpeg(size_t blocksX, size_t blocksY, const uint8_t* blocks, int transform, std::vector<uint8_t>& jpeg)
+        {
+            size_t width = blocksX * 8, height = blocksY * 8;
+            jpeg.assign({ 0xFF, 0xD8 });
+            if (transform >= 0)
+                JpegPutSegment(jpeg, 0xEE, { 'A', 'd', 'o', 'b', 'e', 0, 100, 0, 0, 0, 0, uint8_t(transform) });
+            std::vector<uint8_t> dqt(65, 1);
+            dqt[0] = 0;
+            JpegPutSegment(jpeg, 0xDB, dqt);
+            std::vector<uint8_t> sof = { 8, uint8_t(height >> 8), uint8_t(height), uint8_t(width >> 8), uint8_t(width), 4 };
+            for (uint8_t c = 1; c <= 4; ++c)
+                sof.insert(sof.end(), { c, 0x11, 0 });
+            JpegPutSegment(jpeg, 0xC0, sof);
+            std::vector<uint8_t> dc(29, 0), ac(18, 0);
+            dc[4] = 12;
+            for (uint8_t i = 0; i < 12; ++i)
+                dc[17 + i] = i;
+            ac[0] = 0x10, ac[1] = 1;
+            JpegPutSegment(jpeg, 0xC4, dc);
+            JpegPutSegment(jpeg, 0xC4, ac);
+            std::vector<uint8_t> sos = { 4 };
+            for (uint8_t c = 1; c <= 4; ++c)
+                sos.insert(sos.end(), { c, 0x00 });
+            sos.insert(sos.end(), { 0, 63, 0 });
+            JpegPutSegment(jpeg, 0xDA, sos);
+            JpegBitWriter writer(jpeg);
+            int pred[4] = { 0, 0, 0, 0 };
+            for (size_t b = 0; b < blocksX * blocksY; ++b)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    int value = (blocks[b * 4 + c] - 128) * 8, diff = value - pred[c], category = 0;
+                    for (int abs = diff < 0 ? -diff : diff; abs; abs >>= 1)
+                        category++;
+                    writer.Write(category, 4);
+                    if (category)
+                        writer.Write(diff < 0 ? diff + (1 << category) - 1 : diff, category);
+                    writer.Write(0, 1);
+                    pred[c] = value;
+                }
+            }
+            writer.Flush();
+            jpeg.insert(jpeg.end(), { 0xFF, 0xD9 });
+        }
+    }
+
+    bool ImageLoadFromMemoryFourComponentJpegAutoTest(int transform, View::Format format, FuncLM f1, FuncLM f2)
+    {
+        bool result = true;
+
+        f1.Update(format, SimdImageFileJpeg, transform);
+        f2.Update(format, SimdImageFileJpeg, transform);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " for 4-component JPEG.");
+
+        const size_t blocksX = W / 8, blocksY = H / 8;
+        std::vector<uint8_t> blocks(blocksX * blocksY * 4), jpeg;
+        for (size_t b = 0; b < blocksX * blocksY; ++b)
+        {
+            blocks[b * 4 + 0] = uint8_t(16 + Random(220));
+            blocks[b * 4 + 1] = uint8_t(108 + Random(40));
+            blocks[b * 4 + 2] = uint8_t(108 + Random(40));
+            blocks[b * 4 + 3] = uint8_t(Random(256));
+        }
+        CreateFourComponentJpeg(blocksX, blocksY, blocks.data(), transform, jpeg);
+
+        View dst1, dst2;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst1.data) Simd::Free(dst1.data); f1.Call(jpeg.data(), jpeg.size(), format, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst2.data) SimdFree(dst2.data); f2.Call(jpeg.data(), jpeg.size(), format, dst2));
+
+        if (dst1.data == NULL || dst2.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't load 4-component JPEG image!");
+            result = false;
+        }
+        else
+        {
+            result = result && Compare(dst1, dst2, 1, true, 64, 0, "dst1 & dst2");
+            if (format == View::Gray8 && (transform == 1 || transform < 0))
+            {
+                View y(blocksX * 8, blocksY * 8, View::Gray8);
+                for (size_t row = 0; row < y.height; ++row)
+                    for (size_t col = 0; col < y.width; ++col)
+                        y.At<uint8_t>(col, row) = blocks[((row / 8) * blocksX + col / 8) * 4];
+                result = result && Compare(dst1, y, 0, true, 64, 0, "dst1 & y");
+            }
+        }
+
+        if (dst1.data)
+            Simd::Free(dst1.data);
+        if (dst2.data)
+            SimdFree(dst2.data);
+
+        return result;
+    }
+
+    bool ImageLoadFromMemoryFourComponentJpegAutoTest(const FuncLM& f1, const FuncLM& f2)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (int transform = -1; transform <= 2; transform++)
+                result = result && ImageLoadFromMemoryFourComponentJpegAutoTest(transform, formats[format], f1, f2);
+        }
+
+        return result;
+    }
+
+    bool ImageLoadFromMemoryFourComponentJpegAutoTest()
+    {
+        bool result = true;
+
+        result = result && ImageLoadFromMemoryFourComponentJpegAutoTest(FUNC_LM(Simd::Base::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageLoadFromMemoryFourComponentJpegAutoTest(FUNC_LM(Simd::Sse41::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImageLoadFromMemoryFourComponentJpegAutoTest(FUNC_LM(Simd::Avx2::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImageLoadFromMemoryFourComponentJpegAutoTest(FUNC_LM(Simd::Avx512bw::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncLMS
+        {
+            typedef Simd::CreateImageLoaderPtr FuncPtr;
+
+            FuncPtr func;
+            String desc;
+
+            FuncLMS(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(View::Format format, int quality, size_t scale)
+            {
+                desc = desc + "[" + ToString(format) + "-" + ToString(quality) + "-1/" + ToString(scale) + "]";
+            }
+
+            void Call(const uint8_t* data, size_t size, View::Format format, size_t scale, View& dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                ((View::Format&)dst.format) = format;
+                if (func)
+                {
+                    Simd::ImageLoaderParam param(data, size, (SimdPixelFormatType)format);
+                    param.scale = scale;
+                    *(uint8_t**)&dst.data = Simd::ImageLoadFromMemory(func, param, (size_t*)&dst.stride, (size_t*)&dst.width, (size_t*)&dst.height, (SimdPixelFormatType*)&dst.format);
+                }
+                else
+                    *(uint8_t**)&dst.data = SimdImageLoadFromMemoryScaled(data, size, (size_t*)&dst.stride, (size_t*)&dst.width, (size_t*)&dst.height, (SimdPixelFormatType*)&dst.format, scale);
+            }
+        };
+    }
+
+#define FUNC_LMS(func) \
+    FuncLMS(func, std::string(#func))
+
+    bool ImageLoadFromMemoryScaledAutoTest(size_t width, size_t height, View::Format format, int quality, size_t scale, FuncLMS f1, FuncLMS f2)
+    {
+        bool result = true;
+
+        f1.Update(format, quality, scale);
+        f2.Update(format, quality, scale);
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, f1.desc, f2.desc, SimdImageFileJpeg, quality, &data, &size))
+            return false;
+
+        View dst1, dst2;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst1.data) Simd::Free(dst1.data); f1.Call(data, size, format, scale, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst2.data) SimdFree(dst2.data); f2.Call(data, size, format, scale, dst2));
+
+        if (dst1.width != Simd::DivHi(src.width, scale) || dst1.height != Simd::DivHi(src.height, scale))
+        {
+            TEST_LOG_SS(Error, "Wrong size of scaled image: [" << dst1.width << "x" << dst1.height << "]!");
+            result = false;
+        }
+
+        result = result && Compare(dst1, dst2, 4, true, 64, 0, "dst1 & dst2");
+
+        if (result && scale > 1 && width % scale == 0 && height % scale == 0)
+        {
+            View smooth(width, height, format);
+            for (size_t y = 0; y < height; ++y)
+                for (size_t x = 0; x < width; ++x)
+                    for (size_t c = 0; c < smooth.PixelSize(); ++c)
+                        smooth.data[y * smooth.stride + x * smooth.PixelSize() + c] = uint8_t(128 + 100 * ::sin(x * 0.006 + c * 1.7) * ::cos(y * 0.008 + c * 0.9));
+            size_t smoothSize = 0;
+            uint8_t* smoothData = SimdImageSaveToMemory(smooth.data, smooth.stride, width, height, (SimdPixelFormatType)format, SimdImageFileJpeg, quality, &smoothSize);
+            View full, scaled;
+            ((View::Format&)scaled.format) = format;
+            *(uint8_t**)&scaled.data = SimdImageLoadFromMemoryScaled(smoothData, smoothSize, (size_t*)&scaled.stride, 
+                (size_t*)&scaled.width, (size_t*)&scaled.height, (SimdPixelFormatType*)&scaled.format, scale);
+            if (scaled.data && full.Load(smoothData, smoothSize, format))
+            {
+                View area(scaled.width, scaled.height, format);
+                Simd::Resize(full, area, SimdResizeMethodArea);
+                result = result && Compare(scaled, area, 6, true, 64, 0, "scaled & area");
+            }
+            else
+            {
+                TEST_LOG_SS(Error, "Can't load smooth JPEG image!");
+                result = false;
+            }
+            if (scaled.data)
+                SimdFree(scaled.data);
+            SimdFree(smoothData);
+        }
+
+        if (dst1.data)
+            Simd::Free(dst1.data);
+        if (dst2.data)
+            SimdFree(dst2.data);
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageLoadFromMemoryScaledAutoTest(const FuncLMS& f1, const FuncLMS& f2)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (size_t scale = 1; scale <= 8; scale *= 2)
+            {
+                result = result && ImageLoadFromMemoryScaledAutoTest(W, H, formats[format], 95, scale, f1, f2);
+                result = result && ImageLoadFromMemoryScaledAutoTest(W + O, H - O, formats[format], 65, scale, f1, f2);
+            }
+        }
+
+        return result;
+    }
+
+    bool ImageLoadFromMemoryScaledAutoTest()
+    {
+        bool result = true;
+
+        FuncLMS f2(NULL, "SimdImageLoadFromMemoryScaled");
+
+        result = result && ImageLoadFromMemoryScaledAutoTest(FUNC_LMS(Simd::Base::CreateImageLoader), f2);
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageLoadFromMemoryScaledAutoTest(FUNC_LMS(Simd::Sse41::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImageLoadFromMemoryScaledAutoTest(FUNC_LMS(Simd::Avx2::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImageLoadFromMemoryScaledAutoTest(FUNC_LMS(Simd::Avx512bw::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && ImageLoadFromMemoryScaledAutoTest(FUNC_LMS(Simd::Neon::CreateImageLoader), f2);
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncPDL
+        {
+            typedef void(*FuncPtr)(const uint8_t* src, const uint8_t* prev, size_t size, size_t bpp, uint8_t* dst);
+
+            FuncPtr func;
+            String desc;
+
+            FuncPDL(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(size_t bpp)
+            {
+                desc = desc + "[" + ToString(bpp) + "]";
+            }
+
+            void Call(const View& src, const View& prev, size_t bpp, View& dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                func(src.data, prev.data, src.width, bpp, dst.data);
+            }
+        };
+    }
+
+#define FUNC_PDL(func) \
+    FuncPDL(func, std::string(#func))
+
+    bool ImagePngDecodeLineAutoTest(size_t width, size_t bpp, FuncPDL f1, FuncPDL f2)
+    {
+        bool result = true;
+
+        f1.Update(bpp);
+        f2.Update(bpp);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << width << "].");
+
+        size_t size = width * bpp;
+        View src(size, 1, View::Gray8), prev(size, 1, View::Gray8);
+        FillRandom(src);
+        FillRandom(prev);
+
+        View dst1(size, 1, View::Gray8), dst2(size, 1, View::Gray8);
+        Simd::Fill(dst1, 1);
+        Simd::Fill(dst2, 2);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, prev, bpp, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, prev, bpp, dst2));
+
+        result = result && Compare(dst1, dst2, 0, true, 64);
+
+        return result;
+    }
+
+    bool ImagePngDecodeLineAutoTest(const FuncPDL& f1, const FuncPDL& f2)
+    {
+        bool result = true;
+
+        const size_t bpps[] = { 1, 2, 3, 4, 6, 8 };
+        for (size_t i = 0; i < 6; ++i)
+        {
+            result = result && ImagePngDecodeLineAutoTest(W, bpps[i], f1, f2);
+            result = result && ImagePngDecodeLineAutoTest(W + O, bpps[i], f1, f2);
+            result = result && ImagePngDecodeLineAutoTest(5, bpps[i], f1, f2);
+        }
+
+        return result;
+    }
+
+    bool ImagePngDecodeLineAutoTest()
+    {
+        bool result = true;
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+        {
+            result = result && ImagePngDecodeLineAutoTest(FUNC_PDL(Simd::Sse41::PngDecodeLineSub), FUNC_PDL(Simd::Base::PngDecodeLineSub));
+            result = result && ImagePngDecodeLineAutoTest(FUNC_PDL(Simd::Sse41::PngDecodeLineUp), FUNC_PDL(Simd::Base::PngDecodeLineUp));
+            result = result && ImagePngDecodeLineAutoTest(FUNC_PDL(Simd::Sse41::PngDecodeLineAvg), FUNC_PDL(Simd::Base::PngDecodeLineAvg));
+            result = result && ImagePngDecodeLineAutoTest(FUNC_PDL(Simd::Sse41::PngDecodeLinePaeth), FUNC_PDL(Simd::Base::PngDecodeLinePaeth));
+        }
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImagePngDecodeLineAutoTest(FUNC_PDL(Simd::Avx2::PngDecodeLineUp), FUNC_PDL(Simd::Base::PngDecodeLineUp));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImagePngDecodeLineAutoTest(FUNC_PDL(Simd::Avx512bw::PngDecodeLineUp), FUNC_PDL(Simd::Base::PngDecodeLineUp));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncYLJ
+        {
+            typedef Simd::CreateImageLoaderPtr FuncPtr;
+
+            FuncPtr func;
+            String desc;
+
+            FuncYLJ(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(View::Format format, int quality)
+            {
+                desc = desc + "[" + ToString(format) + "-" + ToString(quality) + "]";
+            }
+
+            void Call(const uint8_t* data, size_t size, uint8_t** buf, View& y, View& u, View& v) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                size_t width = 0, height = 0, yStride = 0, uStride = 0, vStride = 0;
+                uint8_t* py = NULL, * pu = NULL, * pv = NULL;
+                if (func)
+                {
+                    Simd::ImageLoaderParam param(data, size, SimdPixelFormatBgr24);
+                    param.planes = 3;
+                    param.yuvType = SimdYuvTrect871;
+                    *buf = Simd::ImageLoadPlanesFromMemory(func, param, &width, &height, &py, &yStride, &pu, &uStride, &pv, &vStride);
+                }
+                else
+                    *buf = SimdYuv420pLoadFromJpegMemory(data, size, SimdYuvTrect871, &width, &height, &yStride, &pu, &uStride, &pv, &vStride);
+                if (*buf)
+                {
+                    y = View(width, height, yStride, View::Gray8, *buf);
+                    u = View((width + 1) / 2, (height + 1) / 2, uStride, View::Gray8, pu);
+                    v = View((width + 1) / 2, (height + 1) / 2, vStride, View::Gray8, pv);
+                }
+            }
+        };
+    }
+
+#define FUNC_YLJ(func) \
+    FuncYLJ(func, std::string(#func))
+
+    bool Yuv420pLoadFromJpegMemoryAutoTest(size_t width, size_t height, View::Format format, int quality, FuncYLJ f1, FuncYLJ f2)
+    {
+        bool result = true;
+
+        f1.Update(format, quality);
+        f2.Update(format, quality);
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, f1.desc, f2.desc, SimdImageFileJpeg, quality, &data, &size))
+            return false;
+
+        uint8_t* buf1 = NULL, * buf2 = NULL;
+        View y1, u1, v1, y2, u2, v2;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (buf1) Simd::Free(buf1); f1.Call(data, size, &buf1, y1, u1, v1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (buf2) SimdFree(buf2); f2.Call(data, size, &buf2, y2, u2, v2));
+
+        if (buf1 == NULL || buf2 == NULL || y1.width != width || y1.height != height)
+        {
+            TEST_LOG_SS(Error, "Can't load YUV420P image from memory!");
+            result = false;
+        }
+
+        result = result && Compare(y1, y2, 0, true, 64, 0, "y1 & y2");
+        result = result && Compare(u1, u2, 0, true, 64, 0, "u1 & u2");
+        result = result && Compare(v1, v2, 0, true, 64, 0, "v1 & v2");
+
+        if (result)
+        {
+            View gray;
+            if (gray.Load(data, size, View::Gray8))
+                result = result && Compare(y1, gray, 0, true, 64, 0, "y1 & gray");
+            else
+                result = false;
+        }
+
+        if (result)
+        {
+            size_t w = 0, h = 0, yStride = 0, uvStride = 0;
+            uint8_t* uv = NULL;
+            uint8_t* buf3 = SimdNv12LoadFromJpegMemory(data, size, SimdYuvTrect871, &w, &h, &yStride, &uv, &uvStride);
+            if (buf3 && w == width && h == height)
+            {
+                View y3(w, h, yStride, View::Gray8, buf3), u3(u1.width, u1.height, View::Gray8), v3(v1.width, v1.height, View::Gray8);
+                SimdDeinterleaveUv(uv, uvStride, u3.width, u3.height, u3.data, u3.stride, v3.data, v3.stride);
+                result = result && Compare(y1, y3, 0, true, 64, 0, "y1 & y3");
+                result = result && Compare(u1, u3, 0, true, 64, 0, "u1 & u3");
+                result = result && Compare(v1, v3, 0, true, 64, 0, "v1 & v3");
+            }
+            else
+            {
+                TEST_LOG_SS(Error, "Can't load NV12 image from memory!");
+                result = false;
+            }
+            if (buf3)
+                SimdFree(buf3);
+        }
+
+        if (buf1)
+            Simd::Free(buf1);
+        if (buf2)
+            SimdFree(buf2);
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool Yuv420pLoadFromJpegMemoryAutoTest(const FuncYLJ& f1, const FuncYLJ& f2)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && Yuv420pLoadFromJpegMemoryAutoTest(W, H, formats[format], 95, f1, f2);
+            result = result && Yuv420pLoadFromJpegMemoryAutoTest(W + O, H - O, formats[format], 65, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool Yuv420pLoadFromJpegMemoryAutoTest()
+    {
+        bool result = true;
+
+        FuncYLJ f2(NULL, "SimdYuv420pLoadFromJpegMemory");
+
+        result = result && Yuv420pLoadFromJpegMemoryAutoTest(FUNC_YLJ(Simd::Base::CreateImageLoader), f2);
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && Yuv420pLoadFromJpegMemoryAutoTest(FUNC_YLJ(Simd::Sse41::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Yuv420pLoadFromJpegMemoryAutoTest(FUNC_YLJ(Simd::Avx2::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && Yuv420pLoadFromJpegMemoryAutoTest(FUNC_YLJ(Simd::Avx512bw::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && Yuv420pLoadFromJpegMemoryAutoTest(FUNC_YLJ(Simd::Neon::CreateImageLoader), f2);
+#endif 
+
+        if (result)
+        {
+            View src(W, H, View::Bgr24);
+            FillRandom(src);
+            size_t size = 0, w = 0, h = 0, yStride = 0, uStride = 0, vStride = 0;
+            uint8_t* data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, SimdImageFilePng, 0, &size);
+            uint8_t* u = NULL, * v = NULL;
+            uint8_t* buf = SimdYuv420pLoadFromJpegMemory(data, size, SimdYuvTrect871, &w, &h, &yStride, &u, &uStride, &v, &vStride);
+            if (buf)
+            {
+                TEST_LOG_SS(Error, "SimdYuv420pLoadFromJpegMemory must reject PNG image!");
+                SimdFree(buf);
+                result = false;
+            }
+            SimdFree(data);
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncID
+        {
+            typedef Simd::CreateImageLoaderPtr FuncPtr;
+
+            FuncPtr func;
+            String desc;
+
+            FuncID(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(View::Format format, SimdImageFileType file, int quality)
+            {
+                desc = desc + "[" + ToString(format) + "-" + ToString(file) +
+                    (file == SimdImageFileJpeg ? String("-") + ToString(quality) : String("")) + "]";
+            }
+
+            void* Init(View::Format format) const
+            {
+                if (func)
+                    return new Simd::ImageDecoder(func, (SimdPixelFormatType)format);
+                else
+                    return SimdImageDecoderInit((SimdPixelFormatType)format);
+            }
+
+            bool Probe(void* context, const uint8_t* data, size_t size, size_t* width, size_t* height, View::Format* format) const
+            {
+                if (func)
+                    return ((Simd::ImageDecoder*)context)->Probe(data, size, width, height, (SimdPixelFormatType*)format);
+                else
+                    return SimdImageDecoderProbe(context, data, size, width, height, (SimdPixelFormatType*)format) == SimdTrue;
+            }
+
+            bool Call(void* context, const uint8_t* data, size_t size, View& dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                if (func)
+                    return ((Simd::ImageDecoder*)context)->Decode(data, size, dst.data, dst.stride, dst.width, dst.height);
+                else
+                    return SimdImageDecoderDecode(context, data, size, dst.data, dst.stride, dst.width, dst.height) == SimdTrue;
+            }
+        };
+    }
+
+#define FUNC_ID(func) \
+    FuncID(func, std::string(#func))
+
+    bool ImageDecoderDecodeAutoTest(size_t width, size_t height, View::Format format, SimdImageFileType file, int quality, 
+        FuncID f1, FuncID f2, void* context1, void* context2)
+    {
+        bool result = true;
+
+        f1.Update(format, file, quality);
+        f2.Update(format, file, quality);
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, f1.desc, f2.desc, file, quality, &data, &size))
+            return false;
+
+        size_t w1 = 0, h1 = 0, w2 = 0, h2 = 0;
+        View::Format format1 = View::None, format2 = View::None;
+        if (!(f1.Probe(context1, data, size, &w1, &h1, &format1) && f2.Probe(context2, data, size, &w2, &h2, &format2)) || 
+            w1 != src.width || h1 != src.height || format1 != format || w2 != w1 || h2 != h1 || format2 != format1)
+        {
+            TEST_LOG_SS(Error, "Can't probe image header!");
+            SimdFree(data);
+            return false;
+        }
+
+        View buf1(w1 + 3, h1, format1), buf2(w2 + 5, h2, format2);
+        View dst1 = buf1.Region(0, 0, w1, h1), dst2 = buf2.Region(0, 0, w2, h2);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = f1.Call(context1, data, size, dst1) && result);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = f2.Call(context2, data, size, dst2) && result);
+
+        if (!result)
+            TEST_LOG_SS(Error, "Can't decode image to external buffer!");
+
+        View ref;
+        if (result && !ref.Load(data, size, format))
+        {
+            TEST_LOG_SS(Error, "Can't load reference image!");
+            result = false;
+        }
+
+        int differenceMax = file == SimdImageFileJpeg ? 4 : 0;
+        result = result && Compare(dst1, dst2, differenceMax, true, 64, 0, "dst1 & dst2");
+        result = result && Compare(dst1, ref, differenceMax, true, 64, 0, "dst1 & ref");
+
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageDecoderDecodeAutoTest(const FuncID& f1, const FuncID& f2)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            void* context1 = f1.Init(formats[format]);
+            void* context2 = f2.Init(formats[format]);
+            for (int file = (int)SimdImageFilePpmBin; file <= (int)SimdImageFileJpeg; file++)
+            {
+                int quality = file == SimdImageFileJpeg ? 95 : 65;
+                result = result && ImageDecoderDecodeAutoTest(W, H, formats[format], (SimdImageFileType)file, quality, f1, f2, context1, context2);
+                result = result && ImageDecoderDecodeAutoTest(W + O, H - O, formats[format], (SimdImageFileType)file, quality, f1, f2, context1, context2);
+            }
+            SimdRelease(context1);
+            SimdRelease(context2);
+        }
+
+        return result;
+    }
+
+    bool ImageDecoderDecodeAutoTest()
+    {
+        bool result = true;
+
+        FuncID f2(NULL, "SimdImageDecoderDecode");
+
+        result = result && ImageDecoderDecodeAutoTest(FUNC_ID(Simd::Base::CreateImageLoader), f2);
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageDecoderDecodeAutoTest(FUNC_ID(Simd::Sse41::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImageDecoderDecodeAutoTest(FUNC_ID(Simd::Avx2::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImageDecoderDecodeAutoTest(FUNC_ID(Simd::Avx512bw::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && ImageDecoderDecodeAutoTest(FUNC_ID(Simd::Neon::CreateImageLoader), f2);
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncIDB
+        {
+            typedef Simd::CreateImageLoaderPtr FuncPtr;
+
+            FuncPtr func;
+            String desc;
+
+            FuncIDB(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(View::Format format, size_t count)
+            {
+                desc = desc + "[" + ToString(format) + "-" + ToString(count) + "]";
+            }
+
+            size_t Call(void* context, size_t count, const uint8_t* const* data, const size_t* size, uint8_t* const* dst,
+                const size_t* stride, const size_t* width, const size_t* height, SimdBool* status) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                if (func)
+                    return ((Simd::ImageDecoder*)context)->DecodeBatch(count, data, size, dst, stride, width, height, status);
+                else
+                    return SimdImageDecoderDecodeBatch(context, count, data, size, dst, stride, width, height, status);
+            }
+        };
+    }
+
+#define FUNC_IDB(func) \
+    FuncIDB(func, std::string(#func))
+
+    bool ImageDecoderDecodeBatchAutoTest(View::Format format, size_t count, FuncIDB f1, FuncIDB f2)
+    {
+        bool result = true;
+
+        f1.Update(format, count);
+        f2.Update(format, count);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << W << ", " << H << "].");
+
+        std::vector<uint8_t*> data(count, NULL), dst1(count), dst2(count);
+        std::vector<size_t> size(count), stride(count), width(count), height(count);
+        std::vector<SimdImageFileType> file(count);
+        std::vector<View> src(count), buf1(count), buf2(count);
+        std::vector<SimdBool> status1(count, SimdFalse), status2(count, SimdFalse);
+        for (size_t i = 0; i < count && result; ++i)
+        {
+            file[i] = i & 1 ? SimdImageFilePng : SimdImageFileJpeg;
+            width[i] = W / 4 + i * O;
+            height[i] = H / 4 + (count - i) * O;
+            src[i].Recreate(width[i], height[i], format);
+            View noise(width[i], height[i], format);
+            FillRandom(noise);
+            Simd::MeanFilter3x3(noise, src[i]);
+            data[i] = SimdImageSaveToMemory(src[i].data, src[i].stride, width[i], height[i], (SimdPixelFormatType)format, file[i], 85, &size[i]);
+            buf1[i].Recreate(width[i] + 1, height[i], format);
+            buf2[i].Recreate(width[i] + 1, height[i], format);
+            dst1[i] = buf1[i].data;
+            dst2[i] = buf2[i].data;
+            stride[i] = buf1[i].stride;
+            result = data[i] && size[i];
+        }
+
+        void* context1 = f1.func ? (void*)new Simd::ImageDecoder(f1.func, (SimdPixelFormatType)format) : SimdImageDecoderInit((SimdPixelFormatType)format);
+        void* context2 = SimdImageDecoderInit((SimdPixelFormatType)format);
+
+        size_t decoded1 = 0, decoded2 = 0;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(decoded1 = f1.Call(context1, count, data.data(), size.data(), dst1.data(), stride.data(), width.data(), height.data(), status1.data()));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(decoded2 = f2.Call(context2, count, data.data(), size.data(), dst2.data(), stride.data(), width.data(), height.data(), status2.data()));
+
+        if (result && (decoded1 != count || decoded2 != count))
+        {
+            TEST_LOG_SS(Error, "Can't decode batch of images: " << decoded1 << " and " << decoded2 << " from " << count << " are decoded!");
+            result = false;
+        }
+
+        for (size_t i = 0; i < count && result; ++i)
+        {
+            View ref;
+            if (status1[i] != SimdTrue || status2[i] != SimdTrue || !ref.Load(data[i], size[i], format))
+            {
+                TEST_LOG_SS(Error, "Can't decode image " << i << " of batch!");
+                result = false;
+                break;
+            }
+            int differenceMax = file[i] == SimdImageFileJpeg ? 4 : 0;
+            View d1 = buf1[i].Region(0, 0, width[i], height[i]), d2 = buf2[i].Region(0, 0, width[i], height[i]);
+            result = result && Compare(d1, d2, differenceMax, true, 64, 0, "dst1 & dst2");
+            result = result && Compare(d1, ref, differenceMax, true, 64, 0, "dst1 & ref");
+        }
+
+        SimdRelease(context1);
+        SimdRelease(context2);
+        for (size_t i = 0; i < count; ++i)
+            if (data[i])
+                SimdFree(data[i]);
+
+        return result;
+    }
+
+    bool ImageDecoderDecodeBatchAutoTest(const FuncIDB& f1, const FuncIDB& f2)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageDecoderDecodeBatchAutoTest(formats[format], 1, f1, f2);
+            result = result && ImageDecoderDecodeBatchAutoTest(formats[format], 9, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool ImageDecoderDecodeBatchAutoTest()
+    {
+        bool result = true;
+
+        FuncIDB f2(NULL, "SimdImageDecoderDecodeBatch");
+
+        result = result && ImageDecoderDecodeBatchAutoTest(FUNC_IDB(Simd::Base::CreateImageLoader), f2);
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageDecoderDecodeBatchAutoTest(FUNC_IDB(Simd::Sse41::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ImageDecoderDecodeBatchAutoTest(FUNC_IDB(Simd::Avx2::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ImageDecoderDecodeBatchAutoTest(FUNC_IDB(Simd::Avx512bw::CreateImageLoader), f2);
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && ImageDecoderDecodeBatchAutoTest(FUNC_IDB(Simd::Neon::CreateImageLoader), f2);
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
     bool ImageLoadFromMemorySpecialTest(const String & name, View::Format format, const FuncLM& f1, const FuncLM& f2)
     {
         bool result = true;
@@ -152,6 +152,9 @@ namespace Test
         case SimdResizeMethodBicubic: return "BcO";
         case SimdResizeMethodArea: return "ArO";
         case SimdResizeMethodAreaFast: return "ArF";
+        case SimdResizeMethodMitchell: return "MtO";
+        case SimdResizeMethodLanczos2: return "Lz2";
+        case SimdResizeMethodLanczos3: return "Lz3";
         default: assert(0); return "";
         }
     }
@@ -215,6 +218,23 @@ namespace Test
 
 //#define TEST_RESIZE_REAL_IMAGE
 
+    View::Format ResizerFormat(SimdResizeChannelType type, size_t channels)
+    {
+        if (type == SimdResizeChannelFloat)
+            return View::Float;
+        if (type == SimdResizeChannelShort)
+            return View::Int16;
+        switch (channels)
+        {
+        case 1: return View::Gray8;
+        case 2: return View::Uv16;
+        case 3: return View::Bgr24;
+        case 4: return View::Bgra32;
+        default:
+            assert(0); return View::None;
+        }
+    }
+
     bool ResizerAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH, FuncRS f1, FuncRS f2)
     {
         bool result = true;
@@ -224,33 +244,12 @@ namespace Test
 
         TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << srcW << ", " << srcH << "] -> [" << dstW << ", " << dstH << "].");
 
-        View::Format format;
-        if (type == SimdResizeChannelFloat)
+        View::Format format = ResizerFormat(type, channels);
+        if (type != SimdResizeChannelByte)
         {
-            format = View::Float;
             srcW *= channels;
             dstW *= channels;
         }
-        else if (type == SimdResizeChannelShort)
-        {
-            format = View::Int16;
-            srcW *= channels;
-            dstW *= channels;
-        }
-        else if (type == SimdResizeChannelByte)
-        {
-            switch (channels)
-            {
-            case 1: format = View::Gray8; break;
-            case 2: format = View::Uv16; break;
-            case 3: format = View::Bgr24; break;
-            case 4: format = View::Bgra32; break;
-            default:
-                assert(0);
-            }
-        }
-        else
-            assert(0);
 
         View src(srcW, srcH, format, NULL, TEST_ALIGN(srcW));
         if (format == View::Float)
@@ -287,7 +286,7 @@ namespace Test
         TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, dst2, channels, type, method));
 
         if (format == View::Float)
-            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceAbsolute);
+            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
         else if(format == View::Int16)
             result = result && Compare(dst1, dst2, 1, true, 64);
         else
@@ -310,6 +309,132 @@ namespace Test
         return result;
     }
 
+    //---------------------------------------------------------------------------------------------
+
+    SIMD_INLINE double ResizerGet(const View& view, size_t x, size_t y)
+    {
+        const uint8_t* row = view.data + y * view.stride;
+        if (view.format == View::Float)
+            return ((const float*)row)[x];
+        if (view.format == View::Int16)
+            return ((const uint16_t*)row)[x];
+        return row[x];
+    }
+
+    SIMD_INLINE void ResizerSet(View& view, size_t x, size_t y, double value)
+    {
+        uint8_t* row = view.data + y * view.stride;
+        if (view.format == View::Float)
+            ((float*)row)[x] = (float)value;
+        else if (view.format == View::Int16)
+            ((uint16_t*)row)[x] = (uint16_t)Simd::Round(value);
+        else
+            row[x] = (uint8_t)Simd::Round(value);
+    }
+
+    // Resizes an image filled by linear function of pixel coordinates (or constant if ramp is false) and checks
+    // that the result is the same function sampled at the mapped pixel centers.
+    // Pixels which filter support crosses image border are not checked for ramp.
+    bool ResizerRampAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels,
+        size_t srcW, size_t srcH, size_t dstW, size_t dstH, bool ramp, FuncRS f)
+    {
+        bool result = true;
+
+        f.Update(method, type, channels, srcW, srcH, dstW, dstH);
+        f.description += ramp ? "-ramp" : "-const";
+
+        TEST_LOG_SS(Info, "Test " << f.description << ".");
+
+        double base, range, error;
+        if (type == SimdResizeChannelFloat)
+            base = -100.0, range = 200.0, error = 0.01;
+        else if (type == SimdResizeChannelShort)
+            base = 1000.0, range = 20000.0, error = 1.0;
+        else
+            base = 20.0, range = 200.0, error = 1.0;
+        double dX = ramp ? range * 0.6 / srcW : 0.0, dY = ramp ? range * 0.4 / srcH : 0.0, dC = range * 0.05;
+        if (ramp)
+            error += Simd::Max(dX, dY);
+
+        View::Format format = ResizerFormat(type, channels);
+        size_t size = format == View::Float || format == View::Int16 ? channels : 1;
+        View src(srcW * size, srcH, format, NULL, TEST_ALIGN(srcW));
+        View dst(dstW * size, dstH, format, NULL, TEST_ALIGN(dstW));
+        for (size_t y = 0; y < srcH; ++y)
+            for (size_t x = 0; x < srcW; ++x)
+                for (size_t c = 0; c < channels; ++c)
+                    ResizerSet(src, x * channels + c, y, base + dC * c + dX * x + dY * y);
+        Simd::Fill(dst, 0);
+
+        f.Call(src, dst, channels, type, method);
+
+        double scaleX = double(srcW) / dstW, scaleY = double(srcH) / dstH;
+        double borderX = 3.0 * Simd::Max(scaleX, 1.0) + 1.0, borderY = 3.0 * Simd::Max(scaleY, 1.0) + 1.0;
+        for (size_t y = 0; y < dstH && result; ++y)
+        {
+            double sy = (y + 0.5) * scaleY - 0.5;
+            if (ramp && (sy < borderY || sy > srcH - 1 - borderY))
+                continue;
+            for (size_t x = 0; x < dstW && result; ++x)
+            {
+                double sx = (x + 0.5) * scaleX - 0.5;
+                if (ramp && (sx < borderX || sx > srcW - 1 - borderX))
+                    continue;
+                for (size_t c = 0; c < channels && result; ++c)
+                {
+                    double expected = base + dC * c + dX * sx + dY * sy;
+                    double actual = ResizerGet(dst, x * channels + c, y);
+                    if (std::abs(actual - expected) > error)
+                    {
+                        TEST_LOG_SS(Error, "Error at [" << x << ", " << y << ", " << c << "]: " << actual << " != " << expected << " !");
+                        result = false;
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    bool ResizerRampAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, const FuncRS& f)
+    {
+        bool result = true;
+
+        for (int ramp = 0; ramp <= 1; ++ramp)
+        {
+            result = result && ResizerRampAutoTest(method, type, channels, 200, 150, 317, 223, ramp != 0, f);
+            result = result && ResizerRampAutoTest(method, type, channels, 640, 480, 213, 161, ramp != 0, f);
+        }
+
+        return result;
+    }
+
+    bool ResizerRampAutoTest(const FuncRS& f)
+    {
+        bool result = true;
+
+        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodMitchell, SimdResizeMethodLanczos2, SimdResizeMethodLanczos3 };
+        for (size_t m = 0; m < methods.size(); ++m)
+        {
+            for (size_t channels = 1; channels <= 4; ++channels)
+                result = result && ResizerRampAutoTest(methods[m], SimdResizeChannelByte, channels, f);
+        }
+
+        methods = { SimdResizeMethodBicubic, SimdResizeMethodArea };
+        for (size_t m = 0; m < methods.size(); ++m)
+        {
+            for (size_t channels = 1; channels <= 3; channels += 2)
+            {
+                result = result && ResizerRampAutoTest(methods[m], SimdResizeChannelShort, channels, f);
+                result = result && ResizerRampAutoTest(methods[m], SimdResizeChannelFloat, channels, f);
+            }
+        }
+
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------------------
+
     bool ResizerAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, int channels, int width, int height, double k, FuncRS f1, FuncRS f2)
     {
         return ResizerAutoTest(method, type, channels, int(width*k), int(height*k), width, height, f1, f2);
@@ -342,14 +467,15 @@ namespace Test
         bool result = true;
 
 #if !defined(__aarch64__) || 1  
-        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodBilinear, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast };
+        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodBilinear, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast,
+            SimdResizeMethodMitchell, SimdResizeMethodLanczos2, SimdResizeMethodLanczos3 };
         for (size_t m = 0; m < methods.size(); ++m)
         {
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 1, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 2, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 3, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 4, f1, f2);
-            if (methods[m] == SimdResizeMethodBicubic || methods[m] == SimdResizeMethodArea || methods[m] == SimdResizeMethodAreaFast)
+            if (methods[m] == SimdResizeMethodMitchell || methods[m] == SimdResizeMethodLanczos2 || methods[m] == SimdResizeMethodLanczos3)
                 continue;
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 1, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 2, f1, f2);
@@ -357,8 +483,16 @@ namespace Test
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 4, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 1, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 3, f1, f2);
+            if (methods[m] == SimdResizeMethodBicubic || methods[m] == SimdResizeMethodArea)
+            {
+                result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 5, f1, f2);
+                result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 16, f1, f2);
+                result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 5, f1, f2);
+                result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 16, f1, f2);
+            }
         }
 #endif
+        result = result && ResizerRampAutoTest(f1);
 
         return result;
     }
@@ -399,6 +533,299 @@ namespace Test
 
     //---------------------------------------------------------------------------------------------
 
+    static bool ResizerCompare(const View& a, const View& b, const String& description)
+    {
+        if (a.format == View::Float)
+            return Compare(a, b, EPS, true, 64, DifferenceBoth, description);
+        else
+            return Compare(a, b, 0, true, 64, 0, description);
+    }
+
+    bool ResizerBandsAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH, size_t bands, FuncRS f)
+    {
+        bool result = true;
+
+        f.Update(method, type, channels, srcW, srcH, dstW, dstH);
+        f.description += "-" + ToString(bands) + "bands";
+
+        TEST_LOG_SS(Info, "Test " << f.description << " against single resizer.");
+
+        View::Format format = ResizerFormat(type, channels);
+        size_t size = format == View::Float || format == View::Int16 ? channels : 1;
+        View src(srcW * size, srcH, format, NULL, TEST_ALIGN(srcW));
+        if (format == View::Float)
+            FillRandom32f(src);
+        else if (format == View::Int16)
+            FillRandom16u(src);
+        else
+            FillRandom(src);
+
+        View dst1(dstW * size, dstH, format, NULL, TEST_ALIGN(dstW));
+        View dst2(dstW * size, dstH, format, NULL, TEST_ALIGN(dstW));
+        View dst3(dstW * size, dstH, format, NULL, TEST_ALIGN(dstW));
+        View dst4(dstW * size, dstH, format, NULL, TEST_ALIGN(dstW));
+        Simd::Fill(dst1, 0x01);
+        Simd::Fill(dst2, 0x02);
+        Simd::Fill(dst3, 0x5A);
+        Simd::Fill(dst4, 0x5A);
+
+        void* single = f.func(srcW, srcH, dstW, dstH, channels, type, method);
+        std::vector<Simd::Resizer*> parts;
+        for (size_t i = 0; i < bands; ++i)
+            parts.push_back((Simd::Resizer*)f.func(srcW, srcH, dstW, dstH, channels, type, method));
+        Simd::Resizer* part = (Simd::Resizer*)f.func(srcW, srcH, dstW, dstH, channels, type, method);
+        if (single == NULL || parts[0] == NULL || part == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't create resizer!");
+            SimdRelease(single);
+            for (size_t i = 0; i < bands; ++i)
+                SimdRelease(parts[i]);
+            SimdRelease(part);
+            return false;
+        }
+        void* parallel = new Simd::Base::ResizerParallel(Simd::ResParam(srcW, srcH, dstW, dstH, channels, type, method, sizeof(void*)), parts);
+        size_t yBeg = dstH / 3, yEnd = dstH * 2 / 3;
+        part->SetBand(yBeg, yEnd);
+
+        SimdResizerRun(single, src.data, src.stride, dst1.data, dst1.stride);
+        {
+            TEST_PERFORMANCE_TEST(f.description);
+            SimdResizerRun(parallel, src.data, src.stride, dst2.data, dst2.stride);
+        }
+        SimdResizerRun(part, src.data, src.stride, dst3.data, dst3.stride);
+
+        SimdRelease(single);
+        SimdRelease(parallel);
+        SimdRelease(part);
+
+        result = result && ResizerCompare(dst1, dst2, "single & parallel");
+        result = result && ResizerCompare(dst1.Region(0, yBeg, dst1.width, yEnd), dst3.Region(0, yBeg, dst3.width, yEnd), "single & band");
+        result = result && ResizerCompare(dst4.Region(0, 0, dst4.width, yBeg), dst3.Region(0, 0, dst3.width, yBeg), "above band");
+        result = result && ResizerCompare(dst4.Region(0, yEnd, dst4.width, dstH), dst3.Region(0, yEnd, dst3.width, dstH), "below band");
+
+        return result;
+    }
+
+    bool ResizerBandsAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, const FuncRS& f)
+    {
+        bool result = true;
+
+        for (size_t bands = 2; bands <= 7; bands += 5)
+        {
+            result = result && ResizerBandsAutoTest(method, type, channels, 319, 239, 641, 479, bands, f);
+            result = result && ResizerBandsAutoTest(method, type, channels, 1920, 1080, 480, 270, bands, f);
+            result = result && ResizerBandsAutoTest(method, type, channels, 999, 749, 319, 239, bands, f);
+        }
+
+        return result;
+    }
+
+    bool ResizerBandsAutoTest(const FuncRS& f)
+    {
+        bool result = true;
+
+        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodBilinear, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast,
+            SimdResizeMethodMitchell, SimdResizeMethodLanczos2, SimdResizeMethodLanczos3 };
+        for (size_t m = 0; m < methods.size(); ++m)
+        {
+            result = result && ResizerBandsAutoTest(methods[m], SimdResizeChannelByte, 1, f);
+            result = result && ResizerBandsAutoTest(methods[m], SimdResizeChannelByte, 3, f);
+            if (methods[m] == SimdResizeMethodMitchell || methods[m] == SimdResizeMethodLanczos2 || methods[m] == SimdResizeMethodLanczos3)
+                continue;
+            result = result && ResizerBandsAutoTest(methods[m], SimdResizeChannelShort, 2, f);
+            result = result && ResizerBandsAutoTest(methods[m], SimdResizeChannelFloat, 3, f);
+        }
+
+        return result;
+    }
+
+    bool ResizerBandsAutoTest()
+    {
+        bool result = true;
+
+        result = result && ResizerBandsAutoTest(FUNC_RS(Simd::Base::ResizerInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ResizerBandsAutoTest(FUNC_RS(Simd::Sse41::ResizerInit));
+#endif
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && ResizerBandsAutoTest(FUNC_RS(Simd::Avx::ResizerInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ResizerBandsAutoTest(FUNC_RS(Simd::Avx2::ResizerInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ResizerBandsAutoTest(FUNC_RS(Simd::Avx512bw::ResizerInit));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && ResizerBandsAutoTest(FUNC_RS(Simd::Neon::ResizerInit));
+#endif 
+
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncRC
+        {
+            typedef void*(*FuncPtr)(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+            FuncPtr func;
+            String description;
+
+            FuncRC(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Update(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t count, size_t dstW, size_t dstH)
+            {
+                std::stringstream ss;
+                ss << description << "[" << channels << ":" << srcW << "x" << srcH << "->" << count << "x" << dstW << "x" << dstH;
+                ss << ":" << ToString(method) << "-" << ToString(type) << "]";
+                description = ss.str();
+            }
+
+            void Call(const View & src, size_t srcW, const Buffer32f & rects, View & dst, size_t dstW, size_t dstH, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method) const
+            {
+                void * resizer = func(dstW, dstH, channels, type, method);
+                if (resizer)
+                {
+                    {
+                        TEST_PERFORMANCE_TEST(description);
+                        SimdResizerCropBatchRun(resizer, src.data, srcW, src.height, src.stride, rects.data(), rects.size() / 4, dst.data);
+                    }
+                    SimdRelease(resizer);
+                }
+            }
+        };
+    }
+
+#define FUNC_RC(function) \
+    FuncRC(function, std::string(#function))
+
+    bool ResizerCropBatchAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t count, size_t dstW, size_t dstH, FuncRC f1, FuncRC f2)
+    {
+        bool result = true;
+
+        f1.Update(method, type, channels, srcW, srcH, count, dstW, dstH);
+        f2.Update(method, type, channels, srcW, srcH, count, dstW, dstH);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << srcW << ", " << srcH << "] -> " << count << "x[" << dstW << ", " << dstH << "].");
+
+        View::Format format;
+        size_t k = 1;
+        switch (type)
+        {
+        case SimdResizeChannelFloat: format = View::Float, k = channels; break;
+        case SimdResizeChannelShort: format = View::Int16, k = channels; break;
+        case SimdResizeChannelByte: format = channels == 1 ? View::Gray8 : (channels == 3 ? View::Bgr24 : View::Bgra32); break;
+        default:
+            assert(0);
+        }
+
+        View src(srcW * k, srcH, format, NULL, TEST_ALIGN(srcW * k));
+        if (format == View::Float)
+            FillRandom32f(src);
+        else if (format == View::Int16)
+            FillRandom16u(src);
+        else
+            FillRandom(src);
+
+        Buffer32f rects(count * 4);
+        rects[0] = 0, rects[1] = 0, rects[2] = float(srcW), rects[3] = float(srcH);
+        for (size_t i = 1; i < count; ++i)
+        {
+            float w = float(srcW * (0.05 + 0.5 * Random())), h = float(srcH * (0.05 + 0.5 * Random()));
+            float x = float((srcW - w * 0.5) * Random() - w * 0.25), y = float((srcH - h * 0.5) * Random() - h * 0.25);
+            rects[i * 4 + 0] = x, rects[i * 4 + 1] = y, rects[i * 4 + 2] = x + w, rects[i * 4 + 3] = y + h;
+        }
+
+        View dst1(dstW * k, dstH * count, format, NULL, 1);
+        View dst2(dstW * k, dstH * count, format, NULL, 1);
+        Simd::Fill(dst1, 0x01);
+        Simd::Fill(dst2, 0x02);
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, srcW, rects, dst1, dstW, dstH, channels, type, method));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, srcW, rects, dst2, dstW, dstH, channels, type, method));
+
+        if (format == View::Float)
+            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64);
+
+        View dst3(dstW * k, dstH, format, NULL, 1);
+        void* resizer = Simd::Base::ResizerInit(srcW, srcH, dstW, dstH, channels, type, method);
+        SimdResizerRun(resizer, src.data, src.stride, dst3.data, dst3.stride);
+        SimdRelease(resizer);
+        if (format == View::Float)
+            result = result && Compare(dst1.Region(0, 0, dstW * k, dstH), dst3, EPS, true, 64, DifferenceBoth, "whole image");
+        else
+            result = result && Compare(dst1.Region(0, 0, dstW * k, dstH), dst3, format == View::Int16 ? 1 : 0, true, 64, 0, "whole image");
+
+        // region with fractional borders and exact step 1.5 samples the same points as resizing of integer crop to 2/3 of its size:
+        size_t cropW = dstW * 3, cropH = dstH * 3, cropX = (srcW - cropW) / 2, cropY = (srcH - cropH) / 2;
+        size_t kx = (dstW / 2) | 1, ky = (dstH / 2) | 1;
+        Buffer32f roi(4);
+        roi[0] = float(cropX + 1.5 * kx), roi[1] = float(cropY + 1.5 * ky);
+        roi[2] = float(cropX + 1.5 * (kx + dstW)), roi[3] = float(cropY + 1.5 * (ky + dstH));
+        View dst4(dstW * k, dstH, format, NULL, 1);
+        void* batch = SimdResizerCropBatchInit(dstW, dstH, channels, type, method);
+        SimdResizerCropBatchRun(batch, src.data, srcW, srcH, src.stride, roi.data(), 1, dst4.data);
+        SimdRelease(batch);
+        View crop = src.Region(cropX * k, cropY, (cropX + cropW) * k, cropY + cropH);
+        View dst5(dstW * 2 * k, dstH * 2, format, NULL, 1);
+        resizer = Simd::Base::ResizerInit(cropW, cropH, dstW * 2, dstH * 2, channels, type, method);
+        SimdResizerRun(resizer, crop.data, crop.stride, dst5.data, dst5.stride);
+        SimdRelease(resizer);
+        if (format == View::Float)
+            result = result && Compare(dst4, dst5.Region(kx * k, ky, (kx + dstW) * k, ky + dstH), EPS, true, 64, DifferenceBoth, "fractional region");
+        else
+            result = result && Compare(dst4, dst5.Region(kx * k, ky, (kx + dstW) * k, ky + dstH), 0, true, 64, 0, "fractional region");
+
+        return result;
+    }
+
+    bool ResizerCropBatchAutoTest(const FuncRC & f1, const FuncRC & f2)
+    {
+        bool result = true;
+
+        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodBilinear };
+        for (size_t m = 0; m < methods.size(); ++m)
+        {
+            result = result && ResizerCropBatchAutoTest(methods[m], SimdResizeChannelByte, 1, 1920, 1080, 64, 64, 64, f1, f2);
+            result = result && ResizerCropBatchAutoTest(methods[m], SimdResizeChannelByte, 3, 1920, 1080, 64, 112, 112, f1, f2);
+            result = result && ResizerCropBatchAutoTest(methods[m], SimdResizeChannelByte, 4, 1919, 1081, 33, 97, 129, f1, f2);
+            result = result && ResizerCropBatchAutoTest(methods[m], SimdResizeChannelShort, 1, 1920, 1080, 64, 64, 64, f1, f2);
+            result = result && ResizerCropBatchAutoTest(methods[m], SimdResizeChannelFloat, 1, 1920, 1080, 64, 64, 64, f1, f2);
+            result = result && ResizerCropBatchAutoTest(methods[m], SimdResizeChannelFloat, 3, 1919, 1081, 33, 97, 129, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool ResizerCropBatchAutoTest()
+    {
+        bool result = true;
+
+        result = result && ResizerCropBatchAutoTest(FUNC_RC(Simd::Base::ResizerCropBatchInit), FUNC_RC(SimdResizerCropBatchInit));
+
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------------------
+
     bool ResizeSpecialTest(View::Format format, const Size & src, const Size & dst, const FuncRB & f1, const FuncRB & f2)
     {
         bool result = true;
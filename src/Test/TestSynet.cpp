@@ -260,6 +260,69 @@ namespace Test
 
     //-------------------------------------------------------------------------
 
+    bool SynetArenaPlanAutoTest(size_t count, size_t steps, size_t align)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdSynetArenaPlan [" << count << ", " << steps << ", " << align << "].");
+
+        std::vector<size_t> sizes(count), begins(count), ends(count), offsets(count);
+        size_t sum = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sizes[i] = Random(1 << 16);
+            begins[i] = Random((int)steps);
+            ends[i] = begins[i] + Random(4);
+            sum += Simd::AlignHiAny(sizes[i], align);
+        }
+
+        size_t arena = 0;
+        {
+            TEST_PERFORMANCE_TEST("SimdSynetArenaPlan");
+            arena = SimdSynetArenaPlan(sizes.data(), begins.data(), ends.data(), count, align, offsets.data());
+        }
+
+        for (size_t i = 0; i < count && result; ++i)
+        {
+            if (offsets[i] % align || offsets[i] + sizes[i] > arena)
+            {
+                TEST_LOG_SS(Error, "Buffer " << i << " has wrong offset " << offsets[i] << " (arena size " << arena << ")!");
+                result = false;
+            }
+            for (size_t j = 0; j < i && result; ++j)
+            {
+                bool time = begins[i] <= ends[j] && begins[j] <= ends[i];
+                bool space = offsets[i] < offsets[j] + sizes[j] && offsets[j] < offsets[i] + sizes[i];
+                if (time && space)
+                {
+                    TEST_LOG_SS(Error, "Buffers " << j << " and " << i << " are overlapped!");
+                    result = false;
+                }
+            }
+        }
+        if (arena > sum)
+        {
+            TEST_LOG_SS(Error, "Arena size " << arena << " exceeds total size of buffers " << sum << "!");
+            result = false;
+        }
+
+        return result;
+    }
+
+    bool SynetArenaPlanAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetArenaPlanAutoTest(1, 1, 1);
+        result = result && SynetArenaPlanAutoTest(32, 8, 64);
+        result = result && SynetArenaPlanAutoTest(150, 150, 64);
+        result = result && SynetArenaPlanAutoTest(300, 100, 4);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
     SIMD_INLINE String ToString(SimdSynetEltwiseOperationType type)
     {
         switch (type)
@@ -28,6 +28,7 @@
 #include "Test/TestRandom.h"
 
 #include "Simd/SimdSynet.h"
+#include "Simd/SimdSynetImageToTensor.h"
 
 namespace Test
 {
@@ -334,6 +335,172 @@ namespace Test
 
     //-------------------------------------------------------------------------
 
+    String ToString(SimdResizeMethodType method);
+
+    namespace
+    {
+        struct FuncIT
+        {
+            typedef void*(*FuncPtr)(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method,
+                const float* mean, const float* std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType);
+
+            FuncPtr func;
+            String desc;
+
+            FuncIT(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(const Size& src, View::Format srcFormat, SimdYuvType yuv, size_t c, const Size& dst, SimdResizeMethodType method, SimdTensorFormatType format, SimdTensorDataType type)
+            {
+                String srcDesc = yuv == SimdYuvUnknown ? ToString(srcFormat) : (srcFormat == View::Uv16 ? "Nv12" : "Yuv420p");
+                desc = desc + "[" + ToString(src.x) + "x" + ToString(src.y) + ":" + srcDesc + "->" + ToString(c) + "x" +
+                    ToString(dst.y) + "x" + ToString(dst.x) + ":" + ToString(method) + ":" + ToString(format) + (type == SimdTensorData32f ? "-f" : "-b") + "]";
+            }
+
+            void Call(void * context, const uint8_t* const* src, const size_t* stride, uint8_t* dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                SimdSynetImageToTensorForward(context, src, stride, dst);
+            }
+        };
+    }
+
+#define FUNC_IT(function) FuncIT(function, #function)
+
+    bool SynetImageToTensorAutoTest(size_t srcW, size_t srcH, View::Format srcFormat, SimdYuvType yuv, size_t c, size_t dstW, size_t dstH,
+        SimdResizeMethodType method, SimdTensorFormatType format, SimdTensorDataType type, FuncIT f1, FuncIT f2)
+    {
+        bool result = true;
+
+        Views src(yuv == SimdYuvUnknown ? 1 : (srcFormat == View::Uv16 ? 2 : 3));
+        if (yuv == SimdYuvUnknown)
+            src[0].Recreate(srcW, srcH, srcFormat);
+        else
+        {
+            src[0].Recreate(srcW, srcH, View::Gray8);
+            for (size_t i = 1; i < src.size(); ++i)
+                src[i].Recreate(srcW / 2, srcH / 2, srcFormat);
+        }
+
+        SimdTensorFormatType specified = format == SimdTensorFormatNchwXc ? SimdSynetSpecifyTensorFormat(format) : format;
+
+        f1.Update(Size(srcW, srcH), srcFormat, yuv, c, Size(dstW, dstH), method, specified, type);
+        f2.Update(Size(srcW, srcH), srcFormat, yuv, c, Size(dstW, dstH), method, specified, type);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc);
+
+        const uint8_t* data[3] = { NULL, NULL, NULL };
+        size_t stride[3] = { 0, 0, 0 };
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            FillRandom(src[i]);
+            data[i] = src[i].data;
+            stride[i] = src[i].stride;
+        }
+
+        float mean[3] = { 0.406f, 0.456f, 0.485f };
+        float std[3] = { 0.225f, 0.224f, 0.229f };
+
+        Shape shape = ToShape(1, c, dstH, dstW, specified);
+        Tensor32f dst1f(shape, specified), dst2f(shape, specified);
+        Tensor8u dst1b(shape, specified), dst2b(shape, specified);
+        uint8_t* dst1 = type == SimdTensorData32f ? (uint8_t*)dst1f.Data() : dst1b.Data();
+        uint8_t* dst2 = type == SimdTensorData32f ? (uint8_t*)dst2f.Data() : dst2b.Data();
+
+        void* context1 = f1.func(src[0].width, src[0].height, (SimdPixelFormatType)srcFormat, yuv, dstW, dstH, method, mean, std, c, format, type);
+        void* context2 = f2.func(src[0].width, src[0].height, (SimdPixelFormatType)srcFormat, yuv, dstW, dstH, method, mean, std, c, format, type);
+
+        if (context1 == NULL || context2 == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't create image to tensor conversion context!");
+            result = false;
+        }
+        else
+        {
+            TEST_ALIGN(SIMD_ALIGN);
+
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(context1, data, stride, dst1));
+
+            TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(context2, data, stride, dst2));
+
+            if (type == SimdTensorData32f)
+                result = result && Compare(dst1f, dst2f, EPS, true, 64, DifferenceBoth);
+            else
+                result = result && Compare(dst1b, dst2b, 0, true, 64);
+        }
+
+        if (result && yuv == SimdYuvUnknown && srcFormat != View::Rgba32 && type == SimdTensorData32f && 
+            (specified == SimdTensorFormatNchw || specified == SimdTensorFormatNhwc))
+        {
+            float lower[3], upper[3];
+            for (size_t i = 0; i < c; ++i)
+            {
+                lower[i] = -mean[i] / std[i];
+                upper[i] = lower[i] + 1.0f / std[i];
+            }
+            View resized(dstW, dstH, srcFormat);
+            void* resizer = SimdResizerInit(srcW, srcH, dstW, dstH, src[0].PixelSize(), SimdResizeChannelByte, method);
+            SimdResizerRun(resizer, src[0].data, src[0].stride, resized.data, resized.stride);
+            SimdRelease(resizer);
+            Tensor32f dst3f(shape, specified);
+            SimdSynetSetInput(resized.data, dstW, dstH, resized.stride, (SimdPixelFormatType)srcFormat, lower, upper, dst3f.Data(), c, specified);
+            result = result && Compare(dst3f, dst2f, EPS, true, 64, DifferenceBoth, "reference");
+        }
+
+        SimdRelease(context1);
+        SimdRelease(context2);
+
+        return result;
+    }
+
+    bool SynetImageToTensorAutoTest(const FuncIT& f1, const FuncIT& f2)
+    {
+        bool result = true;
+
+        View::Format packed[4] = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24 };
+        SimdTensorFormatType formats[3] = { SimdTensorFormatNchw, SimdTensorFormatNhwc, SimdTensorFormatNchwXc };
+        SimdTensorDataType types[2] = { SimdTensorData32f, SimdTensorData8u };
+        size_t channels[2] = { 1, 3 };
+        size_t srcW = W * 2 + O, srcH = H * 2 - O, dstW = W / 3 + O, dstH = H / 3 - O;
+
+        for (int s = 0; s < 4; ++s)
+            for (int c = 0; c < 2; ++c)
+                for (int f = 0; f < 3; ++f)
+                    result = result && SynetImageToTensorAutoTest(srcW, srcH, packed[s], SimdYuvUnknown, channels[c], dstW, dstH, SimdResizeMethodBilinear, formats[f], SimdTensorData32f, f1, f2);
+
+        for (int c = 0; c < 2; ++c)
+            for (int t = 0; t < 2; ++t)
+            {
+                result = result && SynetImageToTensorAutoTest(srcW & (~1), srcH & (~1), View::Gray8, SimdYuvBt601, channels[c], dstW, dstH, SimdResizeMethodArea, SimdTensorFormatNchw, types[t], f1, f2);
+                result = result && SynetImageToTensorAutoTest(srcW & (~1), srcH & (~1), View::Uv16, SimdYuvBt709, channels[c], dstW, dstH, SimdResizeMethodBilinear, SimdTensorFormatNhwc, types[t], f1, f2);
+            }
+
+        result = result && SynetImageToTensorAutoTest(srcW, srcH, View::Bgra32, SimdYuvUnknown, 3, dstW, dstH, SimdResizeMethodNearest, SimdTensorFormatNchwXc, SimdTensorData8u, f1, f2);
+        result = result && SynetImageToTensorAutoTest(srcW, srcH, View::Bgr24, SimdYuvUnknown, 3, dstW * 2, dstH * 2, SimdResizeMethodBicubic, SimdTensorFormatNchw, SimdTensorData32f, f1, f2);
+        result = result && SynetImageToTensorAutoTest(W / 2, H / 2, View::Rgb24, SimdYuvUnknown, 3, W / 2, H / 2, SimdResizeMethodBilinear, SimdTensorFormatNchw, SimdTensorData32f, f1, f2);
+
+        return result;
+    }
+
+    namespace
+    {
+        void* SynetImageToTensorInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, SimdResizeMethodType method,
+            const float* mean, const float* std, size_t channels, SimdTensorFormatType dstFormat, SimdTensorDataType dstType)
+        {
+            return Simd::Base::SynetImageToTensorInit(srcW, srcH, srcFormat, yuvType, dstW, dstH, method, mean, std, channels, dstFormat, dstType, Simd::Base::ResizerInit, Simd::Base::SynetSetInput);
+        }
+    }
+
+    bool SynetImageToTensorAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetImageToTensorAutoTest(FUNC_IT(SynetImageToTensorInit), FUNC_IT(SimdSynetImageToTensorInit));
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
     namespace
     {
         struct FuncRT
@@ -24,12 +24,15 @@
 #include "Test/TestCompare.h"
 #include "Test/TestPerformance.h"
 #include "Test/TestTensor.h"
+#include "Test/TestString.h"
 #include "Test/TestSynetConvolutionParam.h"
 #include "Test/TestRandom.h"
 
 #include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdSynet.h"
 
+#include <thread>
+
 namespace Test
 {
 #if defined(SIMD_SYNET_ENABLE)
@@ -659,5 +662,325 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------
+
+    bool SynetConvolution32fBatchForwardAutoTest(float eps, const Param & p, size_t batch)
+    {
+        bool result = true;
+
+        String desc = p.Decription("-batch");
+        TEST_LOG_SS(Info, "Test [SimdSynetConvolution32fForward & SimdSynetConvolution32fBatchForward" << desc << " " << batch << "].");
+
+        const SimdConvolutionParameters & c = p.conv;
+        Tensor32f src({ p.batch, p.trans ? c.srcH : c.srcC, p.trans ? c.srcW : c.srcH, p.trans ? c.srcC : c.srcW });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight({ p.trans ? c.kernelY : c.dstC, p.trans ? c.kernelX : c.srcC / c.group,
+            p.trans ? c.srcC / c.group : c.kernelY, p.trans ? c.dstC : c.kernelX });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst1({ p.batch, p.trans ? c.dstH : c.dstC, p.trans ? c.dstW : c.dstH, p.trans ? c.dstC : c.dstW });
+        Tensor32f dst2({ p.batch, p.trans ? c.dstH : c.dstC, p.trans ? c.dstW : c.dstH, p.trans ? c.dstC : c.dstW });
+        ::SimdFill32f(dst1.Data(), dst1.Size(), params.Data() + 0);
+        ::SimdFill32f(dst2.Data(), dst2.Size(), params.Data() + 0);
+
+        void * context1 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        void * context2 = ::SimdSynetConvolution32fBatchInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+
+        Tensor32f buf({ ::SimdSynetConvolution32fExternalBufferSize(context2) });
+
+        ::SimdSynetConvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
+
+        ::SimdSynetConvolution32fForward(context1, src.Data(), NULL, dst1.Data());
+        {
+            TEST_PERFORMANCE_TEST(String("SimdSynetConvolution32fBatchForward") + desc);
+            ::SimdSynetConvolution32fBatchForward(context2, src.Data(), buf.Data(), dst2.Data(), batch);
+        }
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        size_t size = dst1.Size() / p.batch * batch;
+        memcpy(dst2.Data() + size, dst1.Data() + size, (dst1.Size() - size) * sizeof(float));
+
+        result = result && Compare(dst1, dst2, eps, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetConvolution32fBatchForwardAutoTest()
+    {
+        const float EPS = 0.001f;
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+
+        result = result && SynetConvolution32fBatchForwardAutoTest(EPS, Param(4, 32, 19, 16, 64, _1, _1, _1, _0, _0, 1, a, SimdTrue), 4);
+        result = result && SynetConvolution32fBatchForwardAutoTest(EPS, Param(4, 16, 24, 20, 32, _3, _1, _1, _1, _1, 1, a, SimdTrue), 3);
+        result = result && SynetConvolution32fBatchForwardAutoTest(EPS, Param(3, 64, 19, 16, 64, _3, _1, _2, _1, _1, 64, a, SimdTrue), 3);
+        result = result && SynetConvolution32fBatchForwardAutoTest(EPS, Param(5, 16, 24, 20, 32, _3, _1, _1, _1, _1, 1, a, SimdFalse), 2);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool SynetConvolution32fEpilogueAutoTest(float eps, const Param& p, SimdConvolutionEpilogueType type, size_t kernel, size_t stride, size_t pad)
+    {
+        bool result = true;
+
+        const char* types[] = { "-id", "-add", "-max", "-avg" };
+        String desc = p.Decription(String(types[type]) + "-" + ToString((int)p.conv.activation));
+        TEST_LOG_SS(Info, "Test [SimdSynetConvolution32fInitEpilogue" << desc << "].");
+
+        const SimdConvolutionParameters& c = p.conv;
+        SimdConvolutionEpilogue e = { type, kernel, stride, pad };
+        bool add = type == SimdConvolutionEpilogueAdd, pooling = type == SimdConvolutionEpiloguePoolingMax || type == SimdConvolutionEpiloguePoolingAverage;
+        size_t dstH = pooling ? (c.dstH + 2 * pad - kernel) / stride + 1 : c.dstH, dstW = pooling ? (c.dstW + 2 * pad - kernel) / stride + 1 : c.dstW;
+
+        Tensor32f src({ p.batch, c.srcH, c.srcW, c.srcC });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight({ c.kernelY, c.kernelX, c.srcC / c.group, c.dstC });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+        if (c.activation == SimdConvolutionActivationRestrictRange)
+        {
+            params.Data()[0] = -0.5f;
+            params.Data()[1] = 1.5f;
+        }
+
+        Tensor32f conv({ p.batch, c.dstH, c.dstW, c.dstC });
+        Tensor32f dst1({ p.batch, dstH, dstW, c.dstC });
+        Tensor32f dst2({ p.batch, dstH, dstW, c.dstC });
+        FillRandom(dst1.Data(), dst1.Size(), -1.0, 1.0f);
+        memcpy(dst2.Data(), dst1.Data(), dst1.Size() * sizeof(float));
+
+        SimdConvolutionParameters single = c;
+        if (add)
+            single.activation = SimdConvolutionActivationIdentity;
+        void* context1 = ::SimdSynetConvolution32fInit(p.batch, &single, SimdSynetCompatibilityDefault);
+        void* context2 = ::SimdSynetConvolution32fInitEpilogue(p.batch, &c, &e, SimdSynetCompatibilityDefault);
+
+        Tensor32f buf({ ::SimdSynetConvolution32fExternalBufferSize(context2) });
+
+        ::SimdSynetConvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
+
+        ::SimdSynetConvolution32fForward(context1, src.Data(), NULL, conv.Data());
+        {
+            TEST_PERFORMANCE_TEST(String("SimdSynetConvolution32fInitEpilogue") + desc);
+            ::SimdSynetConvolution32fForward(context2, src.Data(), buf.Data(), dst2.Data());
+        }
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        SynetConvolutionEpilogueRef(c, e, params.Data(), p.batch, conv.Data(), dst1.Data());
+
+        result = result && Compare(dst1, dst2, eps, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetConvolution32fEpilogueAutoTest()
+    {
+        const float EPS = 0.001f;
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu, aLr = SimdConvolutionActivationLeakyRelu,
+            aRr = SimdConvolutionActivationRestrictRange, aPr = SimdConvolutionActivationPrelu;
+        const SimdConvolutionEpilogueType eAdd = SimdConvolutionEpilogueAdd, eMax = SimdConvolutionEpiloguePoolingMax, eAvg = SimdConvolutionEpiloguePoolingAverage;
+
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue), eAdd, 0, 0, 0);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(2, 32, 40, 40, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue), eMax, 2, 2, 0);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(1, 16, 38, 37, 32, _3, _1, _1, _1, _1, 1, a, SimdTrue), eMax, 3, 2, 1);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(2, 32, 20, 20, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue), eAvg, 3, 1, 1);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(1, 64, 19, 16, 64, _3, _1, _2, _1, _1, 64, a, SimdTrue), eMax, 3, 2, 1);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(1, 32, 24, 22, 48, _3, _1, _1, _1, _1, 1, aLr, SimdTrue), eAdd, 0, 0, 0);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(2, 32, 24, 22, 48, _1, _1, _1, _0, _0, 1, aRr, SimdTrue), eAdd, 0, 0, 0);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(1, 48, 20, 21, 48, _3, _1, _1, _1, _1, 48, aPr, SimdTrue), eAdd, 0, 0, 0);
+        result = result && SynetConvolution32fEpilogueAutoTest(EPS, Param(1, 32, 24, 22, 48, _3, _1, _1, _1, _1, 1, aPr, SimdTrue), eAvg, 2, 2, 0);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool SynetConvolution32fSharedAutoTest(float eps, const Param& p, size_t threads)
+    {
+        bool result = true;
+
+        String desc = p.Decription("-shared");
+        TEST_LOG_SS(Info, "Test [SimdSynetConvolution32fForward" << desc << " from " << threads << " threads].");
+
+        const SimdConvolutionParameters& c = p.conv;
+        Tensor32f src({ p.batch, c.srcH, c.srcW, c.srcC });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight(p.WeightShape()), other(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        FillRandom(other.Data(), other.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst({ p.batch, c.dstH, c.dstW, c.dstC });
+        std::vector<Tensor32f> dsts(threads, Tensor32f({ p.batch, c.dstH, c.dstW, c.dstC }));
+
+        void* context = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        ::SimdSynetConvolution32fSetParams(context, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fForward(context, src.Data(), NULL, dst.Data());
+
+        std::vector<void*> replicas(threads);
+        for (size_t t = 0; t < threads; ++t)
+            replicas[t] = ::SimdAddRef(context);
+        ::SimdRelease(context);
+
+        if (::SimdSynetConvolution32fSetParams(replicas[0], other.Data(), NULL, bias.Data(), params.Data()) != SimdFalse)
+        {
+            TEST_LOG_SS(Error, "SimdSynetConvolution32fSetParams accepts parameters of shared context!");
+            result = false;
+        }
+
+        {
+            TEST_PERFORMANCE_TEST(String("SimdSynetConvolution32fForward") + desc);
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t)
+            {
+                workers.push_back(std::thread([&, t]
+                {
+                    Tensor32f buf({ ::SimdSynetConvolution32fExternalBufferSize(replicas[t]) });
+                    for (size_t i = 0; i < 4; ++i)
+                        ::SimdSynetConvolution32fForward(replicas[t], src.Data(), buf.Data(), dsts[t].Data());
+                }));
+            }
+            for (size_t t = 0; t < threads; ++t)
+                workers[t].join();
+        }
+
+        for (size_t t = 0; t < threads; ++t)
+        {
+            ::SimdRelease(replicas[t]);
+            result = result && Compare(dst, dsts[t], eps, true, 64, DifferenceBoth, String("replica ") + ToString(t));
+        }
+
+        return result;
+    }
+
+    bool SynetConvolution32fSharedAutoTest()
+    {
+        const float EPS = 0.001f;
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+
+        result = result && SynetConvolution32fSharedAutoTest(EPS, Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue), 2);
+        result = result && SynetConvolution32fSharedAutoTest(EPS, Param(1, 128, 28, 28, 128, _3, _1, _2, _1, _1, 128, a, SimdTrue), 3);
+        result = result && SynetConvolution32fSharedAutoTest(EPS, Param(2, 64, 19, 16, 96, _1, _1, _1, _0, _0, 1, a, SimdTrue), 2);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool SynetConvolution32fThreadsAutoTest(float eps, const Param& p, SimdSynetCompatibilityType comp, size_t threads)
+    {
+        bool result = true;
+
+        String desc = p.Decription(String(Simd::Base::Bf16Soft(comp) ? "-bf16" : "-fp32") + "-t" + ToString(threads));
+        TEST_LOG_SS(Info, "Test [SimdSynetConvolution32fForward" << desc << "] in " << threads << " threads against 1 thread.");
+
+        const SimdConvolutionParameters& c = p.conv;
+        Tensor32f src({ p.batch, p.trans ? c.srcH : c.srcC, p.trans ? c.srcW : c.srcH, p.trans ? c.srcC : c.srcW });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+        params.Data()[0] = 0.1f;
+        params.Data()[1] = 1.1f;
+
+        Tensor32f dst1({ p.batch, p.trans ? c.dstH : c.dstC, p.trans ? c.dstW : c.dstH, p.trans ? c.dstC : c.dstW });
+        Tensor32f dst2({ p.batch, p.trans ? c.dstH : c.dstC, p.trans ? c.dstW : c.dstH, p.trans ? c.dstC : c.dstW });
+        FillRandom(dst1.Data(), dst1.Size(), 1.0f, 1.0f);
+        FillRandom(dst2.Data(), dst2.Size(), 2.0f, 2.0f);
+
+        size_t threadNumber = ::SimdGetThreadNumber();
+        ::SimdSetThreadNumber(1);
+        void* context1 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, comp);
+        ::SimdSetThreadNumber(threads);
+        void* context2 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, comp);
+
+        Tensor32f buf1({ ::SimdSynetConvolution32fExternalBufferSize(context1) });
+        Tensor32f buf2({ ::SimdSynetConvolution32fExternalBufferSize(context2) });
+
+        ::SimdSynetConvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
+
+        ::SimdSynetConvolution32fForward(context1, src.Data(), buf1.Data(), dst1.Data());
+        {
+            TEST_PERFORMANCE_TEST(String("SimdSynetConvolution32fForward") + desc);
+            ::SimdSynetConvolution32fForward(context2, src.Data(), buf2.Data(), dst2.Data());
+        }
+        ::SimdSetThreadNumber(threadNumber);
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        result = result && Compare(dst1, dst2, eps, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetConvolution32fThreadsAutoTest()
+    {
+        const float EPS = 0.001f;
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3), _5(5, 5);
+        const SimdConvolutionActivationType a = SimdConvolutionActivationPrelu;
+        const SimdBool t = SimdTrue, f = SimdFalse;
+        SimdSynetCompatibilityType fp32 = SimdSynetCompatibilityDefault;
+        SimdSynetCompatibilityType bf16 = (SimdSynetCompatibilityType)(SimdSynetCompatibility16bfSoft | SimdSynetCompatibilityFmaAvoid);
+
+        for (size_t threads = 2; threads <= 8; threads *= 2)
+        {
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 32, 61, 47, 48, _3, _1, _1, _1, _1, 1, a, t), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 24, 57, 43, 40, _5, _1, _2, _2, _2, 1, a, t), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 64, 38, 38, 64, _3, _1, _1, _1, _1, 64, a, t), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 64, 38, 38, 64, _3, _1, _2, _0, _1, 64, a, f), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 16, 45, 39, 24, _3, _1, _1, _1, _1, 1, a, f), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 128, 28, 28, 128, _3, _1, _1, _1, _1, 1, a, t), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(2, 48, 33, 31, 64, _1, _1, _1, _0, _0, 1, a, t), fp32, threads);
+            result = result && SynetConvolution32fThreadsAutoTest(EPS, Param(1, 32, 61, 47, 48, _3, _1, _1, _1, _1, 1, a, t), bf16, threads);
+        }
+
+        return result;
+    }
 #endif
 }
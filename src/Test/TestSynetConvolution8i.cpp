@@ -25,10 +25,12 @@
 #include "Test/TestCompare.h"
 #include "Test/TestPerformance.h"
 #include "Test/TestTensor.h"
+#include "Test/TestString.h"
 #include "Test/TestSynetConvolutionParam.h"
 #include "Test/TestRandom.h"
 
 #include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdSynet.h"
 
 namespace Test
@@ -270,6 +272,170 @@ namespace Test
         return result;
     }
 
+    //-------------------------------------------------------------------------
+
+    bool SynetConvolution8iEpilogueAutoTest(float eps, const Param& p, int neg, SimdSynetCompatibilityType comp, SimdConvolutionEpilogueType type, size_t kernel, size_t stride, size_t pad)
+    {
+        bool result = true;
+
+        const char* types[] = { "-id", "-add", "-max", "-avg" };
+        String desc = p.Decription(String(types[type]) + "-" + ToString((int)p.conv.activation));
+        TEST_LOG_SS(Info, "Test [SimdSynetConvolution8iInitEpilogue" << desc << "].");
+
+        const SimdConvolutionParameters& c = p.conv;
+        SimdConvolutionEpilogue e = { type, kernel, stride, pad };
+        bool add = type == SimdConvolutionEpilogueAdd, pooling = type == SimdConvolutionEpiloguePoolingMax || type == SimdConvolutionEpiloguePoolingAverage;
+        size_t dstH = pooling ? (c.dstH + 2 * pad - kernel) / stride + 1 : c.dstH, dstW = pooling ? (c.dstW + 2 * pad - kernel) / stride + 1 : c.dstW;
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+        if (c.activation == SimdConvolutionActivationRestrictRange)
+        {
+            params.Data()[0] = -0.5f;
+            params.Data()[1] = 1.5f;
+        }
+
+        Tensor32f srcMin({ c.srcC }), srcMax({ c.srcC }), dstMin({ c.dstC }), dstMax({ c.dstC });
+        Tensor32f src32f(p.SrcShape(), c.srcF), conv(p.DstShape(), c.dstF), buf32f;
+        Tensor8u src8u(p.SrcShape(), c.srcF);
+        Tensor32f dst1({ p.batch, dstH, dstW, c.dstC }), dst2({ p.batch, dstH, dstW, c.dstC });
+
+        FillRandom(src32f, srcMin.Data(), srcMax.Data(), c.srcC, neg);
+        SetSrc32fTo8u(src32f, srcMin.Data(), srcMax.Data(), c.srcC, neg, comp, NULL, NULL, src8u);
+        FillDstStat(p, neg, comp, weight, bias, params, src32f, buf32f, conv, dstMin.Data(), dstMax.Data(), NULL, NULL);
+        FillRandom(dst1.Data(), dst1.Size(), -1.0, 1.0f);
+        memcpy(dst2.Data(), dst1.Data(), dst1.Size() * sizeof(float));
+
+        const float* stats[4] = { srcMin.Data(), srcMax.Data(), dstMin.Data(), dstMax.Data() };
+        const uint8_t* src = c.srcT == SimdTensorData32f ? (uint8_t*)src32f.Data() : src8u.Data();
+
+        SimdConvolutionParameters single = c;
+        if (add)
+            single.activation = SimdConvolutionActivationIdentity;
+        void* context1 = ::SimdSynetConvolution8iInit(p.batch, &single, comp);
+        void* context2 = ::SimdSynetConvolution8iInitEpilogue(p.batch, &c, &e, comp);
+
+        Tensor8u buf({ ::SimdSynetConvolution8iExternalBufferSize(context2) });
+
+        ::SimdSynetConvolution8iSetParams(context1, weight.Data(), bias.Data(), params.Data(), stats);
+        ::SimdSynetConvolution8iSetParams(context2, weight.Data(), bias.Data(), params.Data(), stats);
+
+        ::SimdSynetConvolution8iForward(context1, src, NULL, (uint8_t*)conv.Data());
+        {
+            TEST_PERFORMANCE_TEST(String("SimdSynetConvolution8iInitEpilogue") + desc);
+            ::SimdSynetConvolution8iForward(context2, src, buf.Data(), (uint8_t*)dst2.Data());
+        }
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        SynetConvolutionEpilogueRef(c, e, params.Data(), p.batch, conv.Data(), dst1.Data());
+
+        result = result && Compare(dst1, dst2, eps, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetConvolution8iEpilogueAutoTest()
+    {
+        bool result = true;
+
+        const Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        const SimdBool t1 = SimdTrue;
+        const SimdTensorDataType f32 = SimdTensorData32f, u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType aRe = SimdConvolutionActivationRelu, aLr = SimdConvolutionActivationLeakyRelu, aRr = SimdConvolutionActivationRestrictRange;
+        const SimdConvolutionEpilogueType eAdd = SimdConvolutionEpilogueAdd, eMax = SimdConvolutionEpiloguePoolingMax, eAvg = SimdConvolutionEpiloguePoolingAverage;
+        SimdSynetCompatibilityType c = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iNarrowed | SimdSynetCompatibilityFmaAvoid);
+
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, aRe, t1, u8, f32), 1, c, eAdd, 0, 0, 0);
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(2, 32, 40, 40, 64, _3, _1, _1, _1, _1, 1, aRe, t1, f32, f32), 0, c, eMax, 2, 2, 0);
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(1, 48, 38, 37, 32, _1, _1, _1, _0, _0, 1, aRe, t1, u8, f32), 1, c, eMax, 3, 2, 1);
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(1, 32, 20, 20, 48, _3, _1, _1, _1, _1, 1, aRe, t1, u8, f32), 1, c, eAvg, 3, 1, 1);
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(1, 64, 19, 16, 64, _3, _1, _2, _1, _1, 64, aRe, t1, u8, f32), 1, c, eMax, 3, 2, 1);
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(1, 32, 24, 22, 48, _3, _1, _1, _1, _1, 1, aLr, t1, u8, f32), 1, c, eAdd, 0, 0, 0);
+        result = result && SynetConvolution8iEpilogueAutoTest(EPS, Param(1, 32, 24, 22, 48, _1, _1, _1, _0, _0, 1, aRr, t1, u8, f32), 1, c, eAdd, 0, 0, 0);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    template<class ConvParam> bool SynetConvolutionRowBandsAutoTest(const Param& p, size_t threads)
+    {
+        bool result = true;
+
+        String desc = p.Decription(String("-") + ToString(threads));
+        TEST_LOG_SS(Info, "Test ParallelRowBands" << desc << ".");
+
+        ConvParam c(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        std::vector<int> count(c.dstH, 0), error(c.dstH, 0);
+        {
+            TEST_PERFORMANCE_TEST("ParallelRowBands" + desc);
+            Simd::ParallelRowBands(c, threads, [&](const ConvParam& band, size_t srcY, size_t dstY)
+            {
+                if (band.dstH != (band.srcH + band.padY + band.padH - (band.dilationY * (band.kernelY - 1) + 1)) / band.strideY + 1 ||
+                    dstY + band.dstH > c.dstH || srcY + band.srcH > c.srcH ||
+                    ptrdiff_t(srcY) - ptrdiff_t(band.padY) != ptrdiff_t(dstY * c.strideY) - ptrdiff_t(c.padY))
+                    error[dstY] = 1;
+                for (size_t y = 0; y < band.dstH && dstY + y < c.dstH; ++y)
+                    count[dstY + y]++;
+            });
+        }
+
+        for (size_t y = 0; y < c.dstH && result; ++y)
+        {
+            if (error[y])
+            {
+                TEST_LOG_SS(Error, "Wrong geometry of the band started at row " << y << "!");
+                result = false;
+            }
+            if (count[y] != 1)
+            {
+                TEST_LOG_SS(Error, "Row " << y << " is processed " << count[y] << " times!");
+                result = false;
+            }
+        }
+
+        return result;
+    }
+
+    bool SynetConvolutionRowBandsAutoTest(const Param& p)
+    {
+        bool result = true;
+
+        for (size_t threads = 1; threads <= 9 && result; threads += 2)
+        {
+            result = result && SynetConvolutionRowBandsAutoTest<Simd::ConvParam8i>(p, threads);
+            result = result && SynetConvolutionRowBandsAutoTest<Simd::ConvParam32f>(p, threads);
+        }
+
+        return result;
+    }
+
+    bool SynetConvolution8iRowBandsAutoTest()
+    {
+        bool result = true;
+
+        const Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3), _5(5, 5);
+        const SimdBool t1 = SimdTrue;
+        const SimdTensorDataType u8 = SimdTensorData8u, f32 = SimdTensorData32f;
+        const SimdConvolutionActivationType aRe = SimdConvolutionActivationRelu;
+
+        result = result && SynetConvolutionRowBandsAutoTest(Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, aRe, t1, u8, f32));
+        result = result && SynetConvolutionRowBandsAutoTest(Param(1, 32, 37, 40, 32, _3, _1, _2, _1, _1, 32, aRe, t1, u8, u8));
+        result = result && SynetConvolutionRowBandsAutoTest(Param(1, 32, 41, 41, 32, _3, _2, _1, _2, _2, 32, aRe, t1, u8, u8));
+        result = result && SynetConvolutionRowBandsAutoTest(Param(1, 16, 30, 30, 16, _5, _1, _2, _0, _0, 1, aRe, t1, u8, u8));
+        result = result && SynetConvolutionRowBandsAutoTest(Param(1, 16, 7, 7, 16, _3, _1, _1, _1, _1, 1, aRe, t1, u8, u8));
+
+        return result;
+    }
+
     bool SynetConvolution8iForwardAutoTest()
     {
         bool result = true;
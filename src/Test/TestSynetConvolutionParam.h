@@ -26,6 +26,8 @@
 
 #include "Test/TestConfig.h"
 
+#include "Simd/SimdSynetConvolution32f.h"
+
 namespace Test
 {
     template<bool back> struct SynetConvolutionParam
@@ -155,6 +157,32 @@ namespace Test
             }
         }
     };
+
+    //-------------------------------------------------------------------------
+
+    inline void SynetConvolutionEpilogueRef(const SimdConvolutionParameters& c, const SimdConvolutionEpilogue& e, const float* params, size_t batch, const float* conv, float* dst)
+    {
+        bool pooling = e.type == SimdConvolutionEpiloguePoolingMax || e.type == SimdConvolutionEpiloguePoolingAverage;
+        size_t dstH = pooling ? (c.dstH + 2 * e.pad - e.kernel) / e.stride + 1 : c.dstH;
+        size_t dstW = pooling ? (c.dstW + 2 * e.pad - e.kernel) / e.stride + 1 : c.dstW;
+        for (size_t b = 0; b < batch; ++b)
+        {
+            if (e.type == SimdConvolutionEpilogueAdd)
+            {
+                for (size_t i = 0, n = c.dstH * c.dstW * c.dstC; i < n; ++i)
+                    dst[i] += conv[i];
+                Simd::Base::ConvolutionBiasAndActivation(NULL, c.dstC, c.dstH * c.dstW, c.activation, params, SimdTrue, dst);
+            }
+            else if (e.type == SimdConvolutionEpiloguePoolingMax)
+                ::SimdSynetPoolingMax32f(conv, c.dstC, c.dstH, c.dstW, 1, e.kernel, e.kernel, 1, e.stride, e.stride, 0, e.pad, e.pad, dst, c.dstC, dstH, dstW, SimdTensorFormatNhwc);
+            else if (e.type == SimdConvolutionEpiloguePoolingAverage)
+                ::SimdSynetPoolingAverage(conv, c.dstC, c.dstH, c.dstW, e.kernel, e.kernel, e.stride, e.stride, e.pad, e.pad, dst, dstH, dstW, SimdTrue, SimdTensorFormatNhwc);
+            else
+                memcpy(dst, conv, c.dstH * c.dstW * c.dstC * sizeof(float));
+            conv += c.dstH * c.dstW * c.dstC;
+            dst += dstH * dstW * c.dstC;
+        }
+    }
 }
 
 #endif//__TestSynetConvolutionParam_h__
@@ -129,6 +129,41 @@ namespace Test
                 ::SimdSynetMergedConvolution32fForward(context, src.Data(), buf.Data(), dst.Data());
             }
         };
+
+        void InitParams(const Param& p, Tensor32f* weight, Tensor32f* bias, Tensor32f* params)
+        {
+            for (size_t i = 0; i < p.count; ++i)
+            {
+                weight[i].Reshape(Shp(p.conv[i].kernelY, p.conv[i].kernelX, p.conv[i].srcC / p.conv[i].group, p.conv[i].dstC));
+                FillRandom(weight[i].Data(), weight[i].Size(), -1.0, 1.0f);
+                p.weight[i] = weight[i].Data();
+
+                bias[i].Reshape(Shp(p.conv[i].dstC));
+                FillRandom(bias[i].Data(), bias[i].Size(), -1.0, 1.0f);
+                p.bias[i] = bias[i].Data();
+
+                params[i].Reshape(Shp(Simd::Max<size_t>(2, p.conv[i].dstC)));
+                FillRandom(params[i].Data(), params[i].Size(), -1.0, 1.0f);
+                if (p.conv[i].activation == ::SimdConvolutionActivationHswish)
+                {
+                    params[i].Data()[0] = 3.0f;
+                    params[i].Data()[1] = 1.0f / 6.0f;
+                }
+                else if (p.conv[i].activation == ::SimdConvolutionActivationMish)
+                    params[i].Data()[0] = 20.0f;
+                else if (p.conv[i].activation == ::SimdConvolutionActivationHardSigmoid)
+                {
+                    params[i].Data()[0] = 1.0f / 6.0f;
+                    params[i].Data()[1] = 0.5f;
+                }
+                else
+                {
+                    params[i].Data()[0] = 0.0f + 0.1f * float(i);
+                    params[i].Data()[1] = 1.0f + 0.1f * float(i);
+                }
+                p.params[i] = params[i].Data();
+            }
+        }
     }
 
 #define FUNC_MC(function) \
@@ -147,37 +182,7 @@ namespace Test
         FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
 
         Tensor32f weight[3], bias[3], params[3];
-        for (size_t i = 0; i < p.count; ++i)
-        {
-            weight[i].Reshape(Shp(p.conv[i].kernelY, p.conv[i].kernelX, p.conv[i].srcC / p.conv[i].group, p.conv[i].dstC));
-            FillRandom(weight[i].Data(), weight[i].Size(), -1.0, 1.0f);
-            p.weight[i] = weight[i].Data();
-
-            bias[i].Reshape(Shp(p.conv[i].dstC));
-            FillRandom(bias[i].Data(), bias[i].Size(), -1.0, 1.0f);
-            p.bias[i] = bias[i].Data();
-
-            params[i].Reshape(Shp(Simd::Max<size_t>(2, p.conv[i].dstC)));
-            FillRandom(params[i].Data(), params[i].Size(), -1.0, 1.0f);
-            if (p.conv[i].activation == ::SimdConvolutionActivationHswish)
-            {
-                params[i].Data()[0] = 3.0f;
-                params[i].Data()[1] = 1.0f / 6.0f;
-            }
-            else if (p.conv[i].activation == ::SimdConvolutionActivationMish)
-                params[i].Data()[0] = 20.0f;
-            else if (p.conv[i].activation == ::SimdConvolutionActivationHardSigmoid)
-            {
-                params[i].Data()[0] = 1.0f / 6.0f;
-                params[i].Data()[1] = 0.5f;
-            }
-            else
-            {
-                params[i].Data()[0] = 0.0f + 0.1f * float(i);
-                params[i].Data()[1] = 1.0f + 0.1f * float(i);
-            }
-            p.params[i] = params[i].Data();
-        }
+        InitParams(p, weight, bias, params);
 
         Tensor32f buf;
 
@@ -374,5 +379,80 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetMergedConvolution32fThreadsAutoTest(const Param& p, SimdSynetCompatibilityType c, FuncMC f, size_t threads)
+    {
+        bool result = true;
+
+        f.Update(p, c);
+        f.description += "-t" + ToString(threads);
+
+        TEST_LOG_SS(Info, "Test [" << f.description << "] in " << threads << " threads against 1 thread.");
+
+        Tensor32f src(Shp(p.batch, p.conv[0].srcH, p.conv[0].srcW, p.conv[0].srcC));
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight[3], bias[3], params[3];
+        InitParams(p, weight, bias, params);
+
+        const SimdConvolutionParameters& end = p.conv[p.count - 1];
+        Tensor32f dst1(Shp(p.batch, end.dstH, end.dstW, end.dstC), SimdTensorFormatNhwc, 0.01f);
+        Tensor32f dst2(Shp(p.batch, end.dstH, end.dstW, end.dstC), SimdTensorFormatNhwc, 0.02f);
+
+        size_t threadNumber = ::SimdGetThreadNumber();
+        ::SimdSetThreadNumber(1);
+        void* context1 = f.func(p.batch, p.conv, p.count, p.add, c);
+        ::SimdSetThreadNumber(threads);
+        void* context2 = f.func(p.batch, p.conv, p.count, p.add, c);
+        ::SimdSetThreadNumber(threadNumber);
+
+        Tensor32f buf1({ ::SimdSynetMergedConvolution32fExternalBufferSize(context1) });
+        Tensor32f buf2({ ::SimdSynetMergedConvolution32fExternalBufferSize(context2) });
+
+        ::SimdSynetMergedConvolution32fSetParams(context1, p.weight, NULL, p.bias, p.params);
+        ::SimdSynetMergedConvolution32fSetParams(context2, p.weight, NULL, p.bias, p.params);
+
+        f.Call(context1, src, buf1, dst1, p.add);
+        f.Call(context2, src, buf2, dst2, p.add);
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetMergedConvolution32fThreadsAutoTest(SimdSynetCompatibilityType c, const FuncMC& func, size_t threads)
+    {
+        bool result = true;
+        const SimdBool t = SimdTrue, f = SimdFalse;
+        const ::SimdConvolutionActivationType a0 = ::SimdConvolutionActivationRestrictRange, a1 = ::SimdConvolutionActivationHswish, a2 = ::SimdConvolutionActivationPrelu;
+
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 16, 61, 67), Cnv(a0, 1, 1, 96), Cnv(a1, 3, 2), Cnv(a2, 1, 1, 24), f), c, func, threads);
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 24, 53, 49), Cnv(a0, 1, 1, 144), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 24), t), c, func, threads);
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 19, 63, 81), Cnv(a0, 1, 1, 51), Cnv(a1, 3, 2)), c, func, threads);
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 48, 70, 81), Cnv(a0, 3, 2), Cnv(a1, 1, 1, 64)), c, func, threads);
+
+        return result;
+    }
+
+    bool SynetMergedConvolution32fThreadsAutoTest()
+    {
+        bool result = true;
+
+        SimdSynetCompatibilityType fp32 = SimdSynetCompatibilityDefault;
+        SimdSynetCompatibilityType bf16 = (SimdSynetCompatibilityType)(SimdSynetCompatibility16bfSoft | SimdSynetCompatibilityFmaAvoid);
+
+        for (size_t threads = 2; threads <= 8; threads *= 2)
+        {
+            result = result && SynetMergedConvolution32fThreadsAutoTest(fp32, FUNC_MC(SimdSynetMergedConvolution32fInit), threads);
+            result = result && SynetMergedConvolution32fThreadsAutoTest(bf16, FUNC_MC(SimdSynetMergedConvolution32fInit), threads);
+        }
+
+        return result;
+    }
 #endif
 }
@@ -0,0 +1,135 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestString.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestLog.h"
+
+#include <thread>
+#include <atomic>
+
+namespace Test
+{
+    namespace
+    {
+        struct ParallelForContext
+        {
+            std::vector<int> dst;
+            size_t threadNumber, seed;
+            std::atomic<bool> error;
+
+            ParallelForContext(size_t size, size_t threads, size_t s)
+                : dst(size, 0)
+                , threadNumber(threads)
+                , seed(s)
+                , error(false)
+            {
+            }
+        };
+
+        void ParallelForTask(void* context, size_t thread, size_t begin, size_t end)
+        {
+            ParallelForContext& c = *(ParallelForContext*)context;
+            if (thread >= c.threadNumber || begin >= end || end > c.dst.size())
+                c.error = true;
+            for (size_t i = begin; i < end; ++i)
+                c.dst[i] += int(i ^ c.seed);
+        }
+
+        void NestedParallelForTask(void* context, size_t thread, size_t begin, size_t end)
+        {
+            ParallelForContext& c = *(ParallelForContext*)context;
+            ::SimdParallelFor(begin, end, ParallelForTask, context, c.threadNumber, 1);
+        }
+
+        bool ParallelForCheck(const ParallelForContext& c, size_t count, const String& desc)
+        {
+            if (c.error)
+            {
+                TEST_LOG_SS(Error, desc << " : wrong arguments of the task!");
+                return false;
+            }
+            for (size_t i = 0; i < c.dst.size(); ++i)
+            {
+                if (c.dst[i] != int(count * (i ^ c.seed)))
+                {
+                    TEST_LOG_SS(Error, desc << " : error at " << i << ": " << c.dst[i] << " != " << count * (i ^ c.seed) << " !");
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    bool ParallelForAutoTest(size_t size, size_t hostThreads, size_t threadNumber, size_t count)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdParallelFor from " << hostThreads << " host threads [" << size << "] with " << threadNumber << " threads.");
+
+        std::vector<ParallelForContext*> contexts(hostThreads);
+        for (size_t t = 0; t < hostThreads; ++t)
+            contexts[t] = new ParallelForContext(size, threadNumber, t * 7 + 1);
+        {
+            TEST_PERFORMANCE_TEST("SimdParallelFor");
+            std::vector<std::thread> threads(hostThreads);
+            for (size_t t = 0; t < hostThreads; ++t)
+            {
+                ParallelForContext* context = contexts[t];
+                threads[t] = std::thread([context, count, t]
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        if ((i + t) % 4 == 3)
+                            ::SimdParallelFor(0, context->dst.size(), NestedParallelForTask, context, context->threadNumber, 1);
+                        else
+                            ::SimdParallelFor(0, context->dst.size(), ParallelForTask, context, context->threadNumber, 1);
+                    }
+                });
+            }
+            for (size_t t = 0; t < hostThreads; ++t)
+                threads[t].join();
+        }
+
+        for (size_t t = 0; t < hostThreads; ++t)
+        {
+            result = result && ParallelForCheck(*contexts[t], count, String("Host thread ") + ToString(t));
+            delete contexts[t];
+        }
+
+        return result;
+    }
+
+    bool ParallelForAutoTest()
+    {
+        bool result = true;
+
+        result = result && ParallelForAutoTest(W * H, 1, 4, 64);
+        result = result && ParallelForAutoTest(W * H, 4, 4, 64);
+        result = result && ParallelForAutoTest(W * H, 8, 3, 64);
+        result = result && ParallelForAutoTest(17, 4, 16, 256);
+
+        return result;
+    }
+}